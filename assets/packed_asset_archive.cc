@@ -0,0 +1,229 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_archive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if OS_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace flutter {
+
+PackedAssetArchive::PackedAssetArchive(const fml::UniqueFD& file,
+                                       bool is_valid_after_asset_manager_change,
+                                       bool prefetch_startup_assets)
+    : PackedAssetArchive(fml::FileMapping::CreateReadOnly(file),
+                         is_valid_after_asset_manager_change,
+                         prefetch_startup_assets) {}
+
+PackedAssetArchive::PackedAssetArchive(
+    std::shared_ptr<fml::Mapping> archive,
+    bool is_valid_after_asset_manager_change,
+    bool prefetch_startup_assets)
+    : archive_(std::move(archive)) {
+  TRACE_EVENT0("flutter", "PackedAssetArchive::PackedAssetArchive");
+  if (!archive_ || !ReadIndex()) {
+    entries_ = nullptr;
+    entry_count_ = 0;
+    names_ = nullptr;
+    return;
+  }
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+
+  if (prefetch_startup_assets) {
+    PackedAssetArchiveHeader header;
+    memcpy(&header, archive_->GetMapping(), sizeof(header));
+    Prefetch(header.prefetch_offset, header.prefetch_size);
+  }
+}
+
+PackedAssetArchive::~PackedAssetArchive() = default;
+
+bool PackedAssetArchive::ReadIndex() {
+  const uint8_t* data = archive_->GetMapping();
+  const uint64_t size = archive_->GetSize();
+
+  PackedAssetArchiveHeader header;
+  if (data == nullptr || size < sizeof(header)) {
+    FML_LOG(ERROR) << "Packed asset archive is too small.";
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, kPackedAssetArchiveMagic, sizeof(header.magic)) !=
+      0) {
+    FML_LOG(ERROR) << "Packed asset archive has an invalid header.";
+    return false;
+  }
+  if (header.version != kPackedAssetArchiveVersion) {
+    FML_LOG(ERROR) << "Packed asset archive has unsupported version "
+                   << header.version << ".";
+    return false;
+  }
+
+  // All of the sizes are checked against the remaining space rather than by
+  // adding offsets, so that corrupt values cannot overflow.
+  const uint64_t index_size =
+      static_cast<uint64_t>(header.entry_count) *
+      sizeof(PackedAssetArchiveEntry);
+  if (index_size > size - sizeof(header) ||
+      header.names_offset < sizeof(header) + index_size ||
+      header.names_offset > size ||
+      header.names_size > size - header.names_offset ||
+      header.prefetch_offset > size ||
+      header.prefetch_size > size - header.prefetch_offset) {
+    FML_LOG(ERROR) << "Packed asset archive has an invalid index.";
+    return false;
+  }
+
+  entries_ =
+      reinterpret_cast<const PackedAssetArchiveEntry*>(data + sizeof(header));
+  entry_count_ = header.entry_count;
+  names_ = reinterpret_cast<const char*>(data + header.names_offset);
+
+  // The lookups rely on the entries being valid and sorted, so they are all
+  // checked once up front.
+  for (size_t i = 0; i < entry_count_; i++) {
+    const PackedAssetArchiveEntry& entry = entries_[i];
+    if (entry.name_offset > header.names_size ||
+        entry.name_size > header.names_size - entry.name_offset ||
+        entry.data_offset > size ||
+        entry.data_size > size - entry.data_offset) {
+      FML_LOG(ERROR) << "Packed asset archive has an invalid entry.";
+      return false;
+    }
+    if (i > 0 && GetName(entries_[i - 1]) >= GetName(entry)) {
+      FML_LOG(ERROR) << "Packed asset archive index is not sorted.";
+      return false;
+    }
+  }
+  return true;
+}
+
+void PackedAssetArchive::Prefetch(uint64_t offset, uint64_t size) const {
+#if OS_POSIX
+  if (size == 0) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PackedAssetArchive::Prefetch");
+  // madvise requires a page aligned address.
+  const uintptr_t page_size = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const uintptr_t start =
+      reinterpret_cast<uintptr_t>(archive_->GetMapping() + offset);
+  const uintptr_t aligned_start = start & ~(page_size - 1);
+  // This is only a hint, so failures are not reported.
+  ::madvise(reinterpret_cast<void*>(aligned_start),
+            static_cast<size_t>(size + (start - aligned_start)),
+            MADV_WILLNEED);
+#endif  // OS_POSIX
+}
+
+std::string_view PackedAssetArchive::GetName(
+    const PackedAssetArchiveEntry& entry) const {
+  return std::string_view(names_ + entry.name_offset, entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetArchive::GetContents(
+    const PackedAssetArchiveEntry& entry) const {
+  // The mapping holds a reference to the archive, as it may outlive this
+  // resolver.
+  std::shared_ptr<fml::Mapping> archive = archive_;
+  return std::make_unique<fml::NonOwnedMapping>(
+      archive->GetMapping() + entry.data_offset, entry.data_size,
+      [archive](const uint8_t* data, size_t size) {},
+      archive->IsDontNeedSafe());
+}
+
+size_t PackedAssetArchive::GetAssetCount() const {
+  return entry_count_;
+}
+
+// |AssetResolver|
+bool PackedAssetArchive::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetArchive::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetArchive::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetArchive;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetArchive::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Packed asset archive was not valid.";
+    return nullptr;
+  }
+
+  const PackedAssetArchiveEntry* end = entries_ + entry_count_;
+  const PackedAssetArchiveEntry* entry = std::lower_bound(
+      entries_, end, std::string_view(asset_name),
+      [this](const PackedAssetArchiveEntry& entry, std::string_view name) {
+        return GetName(entry) < name;
+      });
+  if (entry == end || GetName(*entry) != asset_name) {
+    return nullptr;
+  }
+  return GetContents(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetArchive::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Packed asset archive was not valid.";
+    return mappings;
+  }
+  TRACE_EVENT0("flutter", "PackedAssetArchive::GetAsMappings");
+
+  // As with a DirectoryAssetBundle, the pattern is matched against the file
+  // names of the assets, and a subdirectory limits the search to the assets
+  // directly inside of it. The assets of a subdirectory are adjacent in the
+  // sorted index.
+  std::string prefix = subdir ? subdir.value() + "/" : "";
+  const PackedAssetArchiveEntry* end = entries_ + entry_count_;
+  const PackedAssetArchiveEntry* entry = std::lower_bound(
+      entries_, end, std::string_view(prefix),
+      [this](const PackedAssetArchiveEntry& entry, std::string_view name) {
+        return GetName(entry) < name;
+      });
+
+  std::regex asset_regex(asset_pattern);
+  for (; entry != end; entry++) {
+    std::string_view name = GetName(*entry);
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      break;
+    }
+    size_t separator = name.rfind('/');
+    if (subdir && separator != prefix.size() - 1) {
+      continue;
+    }
+    std::string_view file_name =
+        separator == std::string_view::npos ? name : name.substr(separator + 1);
+    if (std::regex_match(file_name.begin(), file_name.end(), asset_regex)) {
+      mappings.push_back(GetContents(*entry));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+// The layout of a packed asset archive. All integers are little endian.
+//
+// The file starts with a PackedAssetArchiveHeader, followed by |entry_count|
+// PackedAssetArchiveEntry records sorted by asset name, the asset names, and
+// finally the contents of the assets. The contents of each asset start on a
+// kPackedAssetArchiveAlignment boundary so that they can be paged in and out
+// independently of each other. The contents of the startup-critical assets
+// are stored first, in the range described by the prefetch fields of the
+// header.
+constexpr char kPackedAssetArchiveFileName[] = "assets.flutterpack";
+constexpr uint8_t kPackedAssetArchiveMagic[8] = {'F', 'L', 'T', 'P',
+                                                 'A', 'C', 'K', '\0'};
+constexpr uint32_t kPackedAssetArchiveVersion = 1;
+constexpr uint64_t kPackedAssetArchiveAlignment = 4096;
+
+struct PackedAssetArchiveHeader {
+  uint8_t magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint64_t names_offset;
+  uint64_t names_size;
+  uint64_t prefetch_offset;
+  uint64_t prefetch_size;
+};
+
+struct PackedAssetArchiveEntry {
+  // The name is relative to the start of the names.
+  uint32_t name_offset;
+  uint32_t name_size;
+  // The contents are relative to the start of the file.
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+static_assert(sizeof(PackedAssetArchiveHeader) == 48,
+              "The archive header must not contain padding.");
+static_assert(sizeof(PackedAssetArchiveEntry) == 24,
+              "The archive entries must not contain padding.");
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for the assets of a packed asset archive, as
+///             written by the asset_packer host tool.
+///
+///             Unlike a DirectoryAssetBundle, which opens and maps a file for
+///             every asset it returns, the archive is mapped once and assets
+///             are looked up in its sorted index. The mappings returned are
+///             views into the archive that keep it mapped while they are
+///             alive.
+///
+class PackedAssetArchive : public AssetResolver {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a resolver for the archive mapped from the file.
+  ///
+  /// @param[in]  file  The archive file.
+  /// @param[in]  is_valid_after_asset_manager_change  Whether the resolver
+  ///             stays valid when the asset manager is replaced.
+  /// @param[in]  prefetch_startup_assets  Whether to ask the kernel to read
+  ///             the contents of the startup-critical assets ahead of their
+  ///             first use.
+  ///
+  PackedAssetArchive(const fml::UniqueFD& file,
+                     bool is_valid_after_asset_manager_change,
+                     bool prefetch_startup_assets = true);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a resolver for an archive that is already in memory.
+  ///             The archive must be aligned to kPackedAssetArchiveAlignment
+  ///             for startup-critical assets to be prefetched.
+  ///
+  PackedAssetArchive(std::shared_ptr<fml::Mapping> archive,
+                     bool is_valid_after_asset_manager_change,
+                     bool prefetch_startup_assets = true);
+
+  ~PackedAssetArchive() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of assets in the archive, or zero if the archive
+  ///             is not valid.
+  ///
+  size_t GetAssetCount() const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+ private:
+  std::shared_ptr<fml::Mapping> archive_;
+  const PackedAssetArchiveEntry* entries_ = nullptr;
+  size_t entry_count_ = 0;
+  const char* names_ = nullptr;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  bool ReadIndex();
+
+  void Prefetch(uint64_t offset, uint64_t size) const;
+
+  std::string_view GetName(const PackedAssetArchiveEntry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetContents(
+      const PackedAssetArchiveEntry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetArchive);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_H_
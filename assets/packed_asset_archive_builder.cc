@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_archive_builder.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/assets/packed_asset_archive.h"
+
+namespace flutter {
+
+static uint64_t AlignUp(uint64_t offset) {
+  return (offset + kPackedAssetArchiveAlignment - 1) &
+         ~(kPackedAssetArchiveAlignment - 1);
+}
+
+PackedAssetArchiveBuilder::PackedAssetArchiveBuilder() = default;
+
+PackedAssetArchiveBuilder::~PackedAssetArchiveBuilder() = default;
+
+void PackedAssetArchiveBuilder::AddAsset(const std::string& name,
+                                         std::shared_ptr<fml::Mapping> contents,
+                                         bool startup_critical) {
+  assets_[name] = {std::move(contents), startup_critical};
+}
+
+bool PackedAssetArchiveBuilder::SetStartupCritical(const std::string& name) {
+  auto found = assets_.find(name);
+  if (found == assets_.end()) {
+    return false;
+  }
+  found->second.startup_critical = true;
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetArchiveBuilder::Build() const {
+  PackedAssetArchiveHeader header = {};
+  memcpy(header.magic, kPackedAssetArchiveMagic, sizeof(header.magic));
+  header.version = kPackedAssetArchiveVersion;
+  header.entry_count = assets_.size();
+
+  std::vector<PackedAssetArchiveEntry> entries;
+  std::string names;
+  for (const auto& [name, asset] : assets_) {
+    PackedAssetArchiveEntry entry = {};
+    entry.name_offset = names.size();
+    entry.name_size = name.size();
+    entry.data_size = asset.contents ? asset.contents->GetSize() : 0;
+    entries.push_back(entry);
+    names += name;
+  }
+  header.names_offset =
+      sizeof(header) + entries.size() * sizeof(PackedAssetArchiveEntry);
+  header.names_size = names.size();
+
+  // The startup-critical assets are laid out first so that they can be
+  // prefetched with a single request.
+  uint64_t offset = AlignUp(header.names_offset + header.names_size);
+  header.prefetch_offset = offset;
+  for (bool startup_critical : {true, false}) {
+    size_t index = 0;
+    for (const auto& [name, asset] : assets_) {
+      PackedAssetArchiveEntry& entry = entries[index++];
+      if (asset.startup_critical != startup_critical) {
+        continue;
+      }
+      entry.data_offset = offset;
+      offset = AlignUp(offset + entry.data_size);
+    }
+    if (startup_critical) {
+      header.prefetch_size = offset - header.prefetch_offset;
+    }
+  }
+
+  std::vector<uint8_t> archive(offset, 0);
+  memcpy(archive.data(), &header, sizeof(header));
+  memcpy(archive.data() + sizeof(header), entries.data(),
+         entries.size() * sizeof(PackedAssetArchiveEntry));
+  memcpy(archive.data() + header.names_offset, names.data(), names.size());
+  size_t index = 0;
+  for (const auto& [name, asset] : assets_) {
+    const PackedAssetArchiveEntry& entry = entries[index++];
+    if (entry.data_size > 0) {
+      memcpy(archive.data() + entry.data_offset, asset.contents->GetMapping(),
+             entry.data_size);
+    }
+  }
+  return std::make_unique<fml::DataMapping>(std::move(archive));
+}
+
+}  // namespace flutter
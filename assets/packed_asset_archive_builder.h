@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_BUILDER_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_BUILDER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Writes the assets added to it into a packed asset archive that
+///             can be read by a PackedAssetArchive.
+///
+class PackedAssetArchiveBuilder {
+ public:
+  PackedAssetArchiveBuilder();
+
+  ~PackedAssetArchiveBuilder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an asset to the archive, replacing any asset that was
+  ///             added with the same name.
+  ///
+  /// @param[in]  name              The name the asset is looked up with,
+  ///                               relative to the assets directory and with
+  ///                               '/' separators.
+  /// @param[in]  contents          The contents of the asset.
+  /// @param[in]  startup_critical  Whether the asset is read when the
+  ///                               application launches. The contents of
+  ///                               these assets are stored together and
+  ///                               prefetched when the archive is opened.
+  ///
+  void AddAsset(const std::string& name,
+                std::shared_ptr<fml::Mapping> contents,
+                bool startup_critical = false);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks an asset that was already added as startup-critical.
+  ///
+  /// @return     Whether an asset with the name was found.
+  ///
+  bool SetStartupCritical(const std::string& name);
+
+  size_t GetAssetCount() const { return assets_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Builds the archive.
+  ///
+  /// @return     The contents of the archive file.
+  ///
+  std::unique_ptr<fml::Mapping> Build() const;
+
+ private:
+  struct Asset {
+    std::shared_ptr<fml::Mapping> contents;
+    bool startup_critical = false;
+  };
+
+  // Sorted by name, which is the order of the archive index.
+  std::map<std::string, Asset> assets_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetArchiveBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_ARCHIVE_BUILDER_H_
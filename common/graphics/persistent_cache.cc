@@ -20,6 +20,8 @@
 #include "flutter/shell/version/version.h"
 #include "openssl/sha.h"
 #include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
@@ -155,6 +157,18 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     return std::make_shared<fml::UniqueFD>();
   }
 }
+
+static std::shared_ptr<fml::UniqueFD> MakeRuntimeEffectDirectory(
+    const fml::UniqueFD& cache_directory,
+    bool read_only) {
+  if (!cache_directory.is_valid()) {
+    return std::make_shared<fml::UniqueFD>();
+  }
+  return std::make_shared<fml::UniqueFD>(fml::CreateDirectory(
+      cache_directory, {PersistentCache::kRuntimeEffectSubdirName},
+      read_only ? fml::FilePermission::kRead
+                : fml::FilePermission::kReadWrite));
+}
 }  // namespace
 
 sk_sp<SkData> ParseBase32(const std::string& input) {
@@ -271,11 +285,74 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   return result;
 }
 
+std::vector<std::string> PersistentCache::LoadRuntimeEffectSkSLs() const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadRuntimeEffectSkSLs");
+  std::vector<std::string> result;
+  if (!IsValid()) {
+    return result;
+  }
+
+  fml::UniqueFD directory =
+      fml::OpenDirectoryReadOnly(*cache_directory_, kRuntimeEffectSubdirName);
+  if (!directory.is_valid()) {
+    return result;
+  }
+  fml::VisitFiles(directory, [&result](const fml::UniqueFD& directory,
+                                       const std::string& filename) {
+    SkSLCache cache = LoadFile(directory, filename, true);
+    if (cache.key != nullptr) {
+      result.emplace_back(static_cast<const char*>(cache.key->data()),
+                          cache.key->size());
+    } else {
+      FML_LOG(ERROR) << "Failed to load: " << filename;
+    }
+    return true;
+  });
+  return result;
+}
+
+std::string PersistentCache::SerializeSkSLBundle(
+    const std::vector<SkSLCache>& sksls,
+    const std::string& platform) {
+  rapidjson::Document document;
+  auto& allocator = document.GetAllocator();
+  document.SetObject();
+  document.AddMember("platform", rapidjson::Value(platform.c_str(), allocator),
+                     allocator);
+  document.AddMember(
+      "engineRevision",
+      rapidjson::Value(GetFlutterEngineVersion(), allocator).Move(), allocator);
+
+  rapidjson::Value data(rapidjson::kObjectType);
+  for (const auto& sksl : sksls) {
+    std::string_view key_view(reinterpret_cast<const char*>(sksl.key->data()),
+                              sksl.key->size());
+    auto encode_result = fml::Base32Encode(key_view);
+    if (!encode_result.first) {
+      continue;
+    }
+    size_t b64_size =
+        SkBase64::Encode(sksl.value->data(), sksl.value->size(), nullptr);
+    std::string b64_value(b64_size, '\0');
+    SkBase64::Encode(sksl.value->data(), sksl.value->size(), b64_value.data());
+    data.AddMember(rapidjson::Value(encode_result.second.c_str(), allocator),
+                   rapidjson::Value(b64_value.c_str(), allocator), allocator);
+  }
+  document.AddMember("data", data, allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  return buffer.GetString();
+}
+
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      runtime_effect_directory_(
+          MakeRuntimeEffectDirectory(*cache_directory_, read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -416,6 +493,28 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::StoreRuntimeEffectSkSL(const std::string& sksl) {
+  if (is_read_only_ || !runtime_effect_directory_->is_valid()) {
+    return;
+  }
+
+  // The source is the key of the cache object, which has no data.
+  sk_sp<SkData> key = SkData::MakeWithCopy(sksl.data(), sksl.size());
+  auto file_name = SkKeyToFilePath(*key);
+  if (file_name.size() == 0) {
+    return;
+  }
+
+  std::unique_ptr<fml::MallocMapping> mapping =
+      BuildCacheObject(*key, *SkData::MakeEmpty());
+  if (!mapping) {
+    return;
+  }
+
+  PersistentCacheStore(GetWorkerTaskRunner(), runtime_effect_directory_,
+                       std::move(file_name), std::move(mapping));
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
@@ -96,6 +96,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   /// Load all the SkSL shader caches in the right directory.
   std::vector<SkSLCache> LoadSkSLs() const;
 
+  /// Serialize SkSLs into the JSON bundle format that |LoadSkSLs| reads from
+  /// the |kAssetFileName| asset. The platform names the target the SkSLs were
+  /// captured for, as in the bundles written by the `flutter` tool.
+  static std::string SerializeSkSLBundle(const std::vector<SkSLCache>& sksls,
+                                         const std::string& platform);
+
   //----------------------------------------------------------------------------
   /// @brief      Precompile SkSLs packaged with the application and gathered
   ///             during previous runs in the given context.
@@ -111,6 +117,15 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  /// Record the SkSL source of a runtime effect used by the application, so
+  /// that the effect can be compiled ahead of its first use on the next
+  /// launch.
+  void StoreRuntimeEffectSkSL(const std::string& sksl);
+
+  /// Load the SkSL sources of the runtime effects recorded by
+  /// |StoreRuntimeEffectSkSL| in previous runs.
+  std::vector<std::string> LoadRuntimeEffectSkSLs() const;
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -128,6 +143,7 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static void MarkStrategySet() { strategy_set_ = true; }
 
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kRuntimeEffectSubdirName[] = "runtime_effects";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
  private:
@@ -151,6 +167,7 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> runtime_effect_directory_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
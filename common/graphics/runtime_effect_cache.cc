@@ -0,0 +1,221 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/runtime_effect_cache.h"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace flutter {
+
+namespace {
+
+// Fulfills the promise of a compilation posted to the worker task runner. A
+// task runner whose message loop shuts down destroys its queued tasks without
+// running them, which would otherwise leave the promise broken.
+class PendingCompilation {
+ public:
+  explicit PendingCompilation(
+      std::shared_ptr<std::promise<RuntimeEffectCache::Result>> promise)
+      : promise_(std::move(promise)) {}
+
+  ~PendingCompilation() {
+    if (!fulfilled_) {
+      promise_->set_value({nullptr, "The compilation was cancelled.", true});
+    }
+  }
+
+  void Fulfill(RuntimeEffectCache::Result result) {
+    promise_->set_value(std::move(result));
+    fulfilled_ = true;
+  }
+
+ private:
+  std::shared_ptr<std::promise<RuntimeEffectCache::Result>> promise_;
+  bool fulfilled_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PendingCompilation);
+};
+
+bool IsCancelled(const RuntimeEffectCache::Future& future) {
+  return future.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready &&
+         future.get().cancelled;
+}
+
+}  // namespace
+
+std::mutex RuntimeEffectCache::instance_mutex_;
+std::unique_ptr<RuntimeEffectCache> RuntimeEffectCache::gRuntimeEffectCache;
+
+RuntimeEffectCache* RuntimeEffectCache::GetCacheForProcess() {
+  std::scoped_lock lock(instance_mutex_);
+  if (gRuntimeEffectCache == nullptr) {
+    gRuntimeEffectCache.reset(new RuntimeEffectCache());
+  }
+  return gRuntimeEffectCache.get();
+}
+
+void RuntimeEffectCache::ResetCacheForProcess() {
+  std::scoped_lock lock(instance_mutex_);
+  gRuntimeEffectCache.reset(new RuntimeEffectCache());
+}
+
+uint64_t RuntimeEffectCache::HashSkSL(const std::string& sksl) {
+  // 64-bit FNV-1a, which is stable across runs and platforms.
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (char c : sksl) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+RuntimeEffectCache::RuntimeEffectCache() = default;
+
+RuntimeEffectCache::~RuntimeEffectCache() = default;
+
+void RuntimeEffectCache::SetWorkerTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> worker_task_runner) {
+  std::scoped_lock lock(mutex_);
+  worker_task_runner_ = std::move(worker_task_runner);
+}
+
+RuntimeEffectCache::Result RuntimeEffectCache::Get(const std::string& sksl) {
+  while (true) {
+    std::shared_ptr<std::promise<Result>> promise;
+    Future result = Lookup(sksl, &promise);
+    if (promise) {
+      promise->set_value(Compile(sksl, true));
+    } else if (result.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready) {
+      TRACE_EVENT0("flutter", "RuntimeEffectCache::WaitForCompilation");
+      result.wait();
+    }
+    // The next lookup replaces a compilation cancelled while waiting for it.
+    if (!result.get().cancelled) {
+      return result.get();
+    }
+  }
+}
+
+RuntimeEffectCache::Future RuntimeEffectCache::GetAsync(
+    const std::string& sksl) {
+  std::shared_ptr<std::promise<Result>> promise;
+  Future result = Lookup(sksl, &promise);
+  if (promise) {
+    CompileOnWorker(std::move(promise), sksl, true);
+  }
+  return result;
+}
+
+size_t RuntimeEffectCache::PrecompileKnownEffects() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (precompiled_known_effects_) {
+      return 0;
+    }
+    precompiled_known_effects_ = true;
+  }
+
+  std::vector<std::string> known_sksls =
+      PersistentCache::GetCacheForProcess()->LoadRuntimeEffectSkSLs();
+  FML_TRACE_EVENT("flutter", "RuntimeEffectCache::PrecompileKnownEffects",
+                  "count", known_sksls.size());
+  for (auto& sksl : known_sksls) {
+    std::shared_ptr<std::promise<Result>> promise;
+    Lookup(sksl, &promise);
+    if (promise) {
+      // The source is already recorded in the persistent cache.
+      CompileOnWorker(std::move(promise), std::move(sksl), false);
+    }
+  }
+  return known_sksls.size();
+}
+
+void RuntimeEffectCache::SchedulePrecompileKnownEffects() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (scheduled_precompile_ || precompiled_known_effects_) {
+      return;
+    }
+    scheduled_precompile_ = true;
+  }
+  RunOnWorker([]() {
+    RuntimeEffectCache::GetCacheForProcess()->PrecompileKnownEffects();
+  });
+}
+
+size_t RuntimeEffectCache::size() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+RuntimeEffectCache::Future RuntimeEffectCache::Lookup(
+    const std::string& sksl,
+    std::shared_ptr<std::promise<Result>>* promise) {
+  uint64_t hash = HashSkSL(sksl);
+
+  std::scoped_lock lock(mutex_);
+  auto found = entries_.find(hash);
+  if (found != entries_.end() && found->second.sksl == sksl) {
+    if (!IsCancelled(found->second.result)) {
+      return found->second.result;
+    }
+    entries_.erase(found);
+    found = entries_.end();
+  }
+
+  *promise = std::make_shared<std::promise<Result>>();
+  Future result = (*promise)->get_future().share();
+  // A source whose hash collides with a cached one is compiled every time.
+  if (found == entries_.end()) {
+    entries_.emplace(hash, Entry{sksl, result});
+  }
+  return result;
+}
+
+void RuntimeEffectCache::RunOnWorker(const fml::closure& task) {
+  std::shared_ptr<fml::BasicTaskRunner> worker;
+  {
+    std::scoped_lock lock(mutex_);
+    worker = worker_task_runner_;
+  }
+  if (worker) {
+    worker->PostTask(task);
+  } else {
+    task();
+  }
+}
+
+void RuntimeEffectCache::CompileOnWorker(
+    std::shared_ptr<std::promise<Result>> promise,
+    std::string sksl,
+    bool record) {
+  auto pending = std::make_shared<PendingCompilation>(std::move(promise));
+  RunOnWorker([pending, sksl = std::move(sksl), record]() {
+    pending->Fulfill(Compile(sksl, record));
+  });
+}
+
+RuntimeEffectCache::Result RuntimeEffectCache::Compile(const std::string& sksl,
+                                                       bool record) {
+  TRACE_EVENT0("flutter", "RuntimeEffectCache::Compile");
+  SkRuntimeEffect::Result result =
+      SkRuntimeEffect::MakeForShader(SkString(sksl));
+  if (result.effect == nullptr) {
+    return {nullptr, result.errorText.c_str()};
+  }
+  if (record) {
+    PersistentCache::GetCacheForProcess()->StoreRuntimeEffectSkSL(sksl);
+  }
+  return {std::move(result.effect), ""};
+}
+
+}  // namespace flutter
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_RUNTIME_EFFECT_CACHE_H_
+#define FLUTTER_COMMON_GRAPHICS_RUNTIME_EFFECT_CACHE_H_
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/effects/SkRuntimeEffect.h"
+
+namespace flutter {
+
+/// A process-wide cache of the runtime effects compiled from SkSL.
+///
+/// Compiling SkSL into an SkRuntimeEffect is expensive, and the same source is
+/// often compiled by every isolate or engine instance that creates a fragment
+/// program for it. The cache compiles each source once per process and shares
+/// the resulting effect, which is immutable and can be used from any thread.
+///
+/// Effects compiled for the application are recorded in the |PersistentCache|
+/// so that |PrecompileKnownEffects| can compile them ahead of their first use
+/// on the next launch. It is thread-safe.
+class RuntimeEffectCache {
+ public:
+  struct Result {
+    sk_sp<SkRuntimeEffect> effect;
+    // The compilation error when |effect| is null.
+    std::string error;
+    // Whether the compilation was dropped by the worker task runner before
+    // it ran, for example because its message loop was shut down. The cache
+    // compiles the source again the next time it is asked for.
+    bool cancelled = false;
+  };
+
+  using Future = std::shared_future<Result>;
+
+  static RuntimeEffectCache* GetCacheForProcess();
+  static void ResetCacheForProcess();
+
+  // Returns the hash that the cache uses as the key of the source.
+  static uint64_t HashSkSL(const std::string& sksl);
+
+  ~RuntimeEffectCache();
+
+  // Sets the task runner that compiles effects for |GetAsync| and
+  // |PrecompileKnownEffects|. Without one, they compile on the calling
+  // thread.
+  void SetWorkerTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> worker_task_runner);
+
+  // Returns the effect compiled from |sksl|, compiling it on the calling
+  // thread unless it is cached. If the effect is being compiled on a worker,
+  // waits for that compilation instead. The result is never cancelled.
+  Result Get(const std::string& sksl);
+
+  // Returns a future for the effect compiled from |sksl|, starting its
+  // compilation on the worker task runner unless it is cached.
+  Future GetAsync(const std::string& sksl);
+
+  // Starts compiling the effects recorded in the persistent cache by previous
+  // runs of the application on the worker task runner. Only the first call
+  // in the process has an effect. Returns the number of effects found.
+  size_t PrecompileKnownEffects();
+
+  // Posts |PrecompileKnownEffects| to the worker task runner, which reads the
+  // persistent cache off the calling thread. Only the first call in the
+  // process posts a task.
+  void SchedulePrecompileKnownEffects();
+
+  // The number of sources the cache holds an effect or compilation for.
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::string sksl;
+    Future result;
+  };
+
+  static std::mutex instance_mutex_;
+  static std::unique_ptr<RuntimeEffectCache> gRuntimeEffectCache;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, Entry> entries_;
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
+  bool precompiled_known_effects_ = false;
+  bool scheduled_precompile_ = false;
+
+  RuntimeEffectCache();
+
+  // Returns the cached future for |sksl|. Otherwise returns a new future and
+  // sets |promise| to the promise that fulfills it, which the caller must
+  // fulfill by compiling the source. A cancelled compilation is replaced by
+  // a new one.
+  Future Lookup(const std::string& sksl,
+                std::shared_ptr<std::promise<Result>>* promise);
+
+  // Posts |task| to the worker task runner, or runs it if there is none.
+  void RunOnWorker(const fml::closure& task);
+
+  // Compiles |sksl| on the worker task runner to fulfill |promise|. The
+  // promise is fulfilled with a cancelled result if the task is destroyed
+  // without running.
+  void CompileOnWorker(std::shared_ptr<std::promise<Result>> promise,
+                       std::string sksl,
+                       bool record);
+
+  static Result Compile(const std::string& sksl, bool record);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RuntimeEffectCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_RUNTIME_EFFECT_CACHE_H_
@@ -62,6 +62,20 @@ std::string Settings::ToString() const {
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
+  stream << "pointer_resampling_offset_us: " << pointer_resampling_offset_us
+         << std::endl;
+  stream << "pointer_prediction_horizon_us: " << pointer_prediction_horizon_us
+         << std::endl;
+  stream << "ui_thread_policy: " << ui_thread_policy.ToString() << std::endl;
+  stream << "raster_thread_policy: " << raster_thread_policy.ToString()
+         << std::endl;
+  stream << "io_thread_policy: " << io_thread_policy.ToString() << std::endl;
+  stream << "worker_thread_policy: " << worker_thread_policy.ToString()
+         << std::endl;
+  stream << "cache_memory_budgets: " << std::endl;
+  for (const auto& budget : cache_memory_budgets) {
+    stream << "  " << budget.first << ": " << budget.second << std::endl;
+  }
   return stream.str();
 }
 
@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -16,6 +17,7 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/thread_policy.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -39,11 +41,34 @@ class FrameTiming {
 
   static constexpr int kStatisticsCount = kCount + 5;
 
+  // Work that happened while the frame was rasterized and that commonly makes
+  // frames slow. A frame may have any combination of these.
+  enum Annotation : uint32_t {
+    kNoAnnotation = 0,
+    // New shaders were compiled and stored in the persistent cache.
+    kShaderCompilation = 1 << 0,
+    // Raster cache entries had to be rasterized.
+    kRasterCacheMiss = 1 << 1,
+    // The platform and raster threads were merged or unmerged.
+    kThreadMerge = 1 << 2,
+    // Images were uploaded to the GPU by the raster thread.
+    kImageUpload = 1 << 3,
+  };
+
+  static constexpr Annotation kAnnotations[] = {
+      kShaderCompilation, kRasterCacheMiss, kThreadMerge, kImageUpload};
+
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
     return data_[phase] = value;
   }
 
+  uint32_t GetAnnotations() const { return annotations_; }
+  bool HasAnnotation(Annotation annotation) const {
+    return (annotations_ & annotation) != 0;
+  }
+  void AddAnnotation(Annotation annotation) { annotations_ |= annotation; }
+
   uint64_t GetFrameNumber() const { return frame_number_; }
   void SetFrameNumber(uint64_t frame_number) { frame_number_ = frame_number; }
   uint64_t GetLayerCacheCount() const { return layer_cache_count_; }
@@ -62,6 +87,7 @@ class FrameTiming {
 
  private:
   fml::TimePoint data_[kCount];
+  uint32_t annotations_ = kNoAnnotation;
   uint64_t frame_number_;
   size_t layer_cache_count_;
   size_t layer_cache_bytes_;
@@ -87,6 +113,9 @@ using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+using ShellPhaseCallback =
+    std::function<void(const char* /* phase */, fml::TimeDelta /* duration */)>;
+
 class DartIsolate;
 
 struct Settings {
@@ -140,7 +169,27 @@ struct Settings {
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // Adapt the number of frames that may be in flight between the UI and
+  // raster threads to the build and raster durations of recent frames. One
+  // frame gives the lowest input latency, and more frames are allowed when the
+  // raster thread falls behind. Otherwise up to two frames are in flight.
+  bool adaptive_pipeline_depth = false;
+  // Cache pictures and display lists in the raster cache when their measured
+  // draw time, over the frames they are reused in, justifies the memory of
+  // their cached images, instead of by their op count.
+  bool raster_cache_cost_admission = false;
+  // Outline the pictures and display lists considered by the cost based
+  // admission of the raster cache, by whether they are cached.
+  bool show_raster_cache_admission = false;
   bool endless_trace_buffer = false;
+  // The number of trace events kept for each thread by the
+  // `fml::tracing::TraceBuffer`, which records in all build modes. Zero
+  // disables the buffer. Its contents are returned by the
+  // _flutter.dumpTraceBuffer service extension.
+  size_t trace_buffer_capacity = 0;
+  // If not empty, the trace buffer is written to this file in the Chrome trace
+  // format when the engine receives a low memory warning.
+  std::string trace_buffer_dump_path;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
 
@@ -192,9 +241,27 @@ struct Settings {
   // Selects the SkParagraph implementation of the text layout engine.
   bool enable_skparagraph = false;
 
+  // Drops the semantics nodes that did not change since they were last sent
+  // to the platform from semantics updates, and records which fields of the
+  // remaining nodes changed.
+  bool diff_semantics_updates = true;
+
   // Selects the DisplayList for storage of rendering operations.
   bool enable_display_list = true;
 
+  // Rewrites the display lists recorded by the framework to remove redundant
+  // records before they are used for rendering.
+  bool optimize_display_lists = false;
+
+  // Allocates the layers of each frame that cannot be retained by the
+  // framework from an arena that is freed in bulk with the frame.
+  bool enable_layer_arena = false;
+
+  // Compiles the runtime effects of fragment programs on a worker thread, so
+  // that creating a program does not wait for the compilation. Invalid
+  // programs are then reported when their first shader is created.
+  bool compile_runtime_effects_in_background = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -271,6 +338,12 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback to handle the duration of each phase of the startup and teardown
+  // of a shell, such as the setup of the rasterizer or the destruction of the
+  // engine. Independent phases run concurrently, so this is called from the
+  // thread that ran the phase, possibly at the same time as other calls.
+  ShellPhaseCallback shell_phase_callback;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
@@ -286,6 +359,45 @@ struct Settings {
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t old_gen_heap_size = -1;
 
+  /// Pointer device kinds ("touch", "mouse", "stylus" or "inverted-stylus")
+  /// whose events are buffered until vsync, with the move events of each
+  /// pointer coalesced into one per frame.
+  ///
+  /// See also: |ResamplingPointerDataDispatcher|.
+  std::vector<std::string> pointer_coalescing_device_kinds;
+
+  /// Pointer device kinds whose events are coalesced like those in
+  /// |pointer_coalescing_device_kinds|, and whose positions are additionally
+  /// resampled at the vsync target time minus
+  /// |pointer_resampling_offset_us|.
+  std::vector<std::string> pointer_resampling_device_kinds;
+
+  /// How far behind the vsync target time pointer positions are resampled,
+  /// in microseconds.
+  int64_t pointer_resampling_offset_us = 0;
+
+  /// The maximum duration, in microseconds, that resampled pointer positions
+  /// are extrapolated past the newest sample. 0 disables prediction.
+  int64_t pointer_prediction_horizon_us = 0;
+
+  /// The scheduling policies of the UI, raster and IO threads created by the
+  /// engine. Threads provided by the embedder through custom task runners
+  /// keep the scheduling chosen by the embedder.
+  fml::ThreadPolicy ui_thread_policy;
+  fml::ThreadPolicy raster_thread_policy;
+  fml::ThreadPolicy io_thread_policy;
+
+  /// The scheduling policy of the worker threads of the concurrent message
+  /// loop owned by the Dart VM, used for image decoding and other background
+  /// work. Only the settings of the first shell to create the VM are used.
+  fml::ThreadPolicy worker_thread_policy;
+
+  /// Memory budgets, in bytes, of the caches registered with the
+  /// `fml::MemoryPressureManager`, keyed by cache name. A cache that grows past
+  /// its budget is asked to trim. Budgets are process-wide, so the last shell
+  /// to be created with a budget for a cache sets it.
+  std::map<std::string, size_t> cache_memory_budgets;
+
   /// A timestamp representing when the engine started. The value is based
   /// on the clock used by the Dart timeline APIs. This timestamp is used
   /// to log a timeline event that tracks the latency of engine startup.
@@ -0,0 +1,274 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/bounds_utils.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FLUTTER_BOUNDS_UTILS_SSE 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define FLUTTER_BOUNDS_UTILS_NEON 1
+#endif
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kInfinity = std::numeric_limits<SkScalar>::infinity();
+
+}  // namespace
+
+#if FLUTTER_BOUNDS_UTILS_SSE
+
+SkRect ComputePointExtents(const SkPoint points[], int count) {
+  // Each register holds two points as (x0, y0, x1, y1). Two pairs of
+  // accumulators keep consecutive iterations independent.
+  const float* coords = reinterpret_cast<const float*>(points);
+  __m128 min0 = _mm_set1_ps(kInfinity);
+  __m128 max0 = _mm_set1_ps(-kInfinity);
+  __m128 min1 = min0;
+  __m128 max1 = max0;
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 v0 = _mm_loadu_ps(coords + 2 * i);
+    __m128 v1 = _mm_loadu_ps(coords + 2 * i + 4);
+    min0 = _mm_min_ps(v0, min0);
+    max0 = _mm_max_ps(v0, max0);
+    min1 = _mm_min_ps(v1, min1);
+    max1 = _mm_max_ps(v1, max1);
+  }
+  for (; i < count; i++) {
+    __m128 v = _mm_setr_ps(points[i].fX, points[i].fY, points[i].fX,
+                           points[i].fY);
+    min0 = _mm_min_ps(v, min0);
+    max0 = _mm_max_ps(v, max0);
+  }
+  min0 = _mm_min_ps(min0, min1);
+  max0 = _mm_max_ps(max0, max1);
+  min0 = _mm_min_ps(min0, _mm_movehl_ps(min0, min0));
+  max0 = _mm_max_ps(max0, _mm_movehl_ps(max0, max0));
+
+  float min[4];
+  float max[4];
+  _mm_storeu_ps(min, min0);
+  _mm_storeu_ps(max, max0);
+  return SkRect::MakeLTRB(min[0], min[1], max[0], max[1]);
+}
+
+SkRect ComputeAtlasExtents(const SkRSXform xform[],
+                           const SkRect tex[],
+                           int count) {
+  // The four corners of a quad are computed at once, with one register for
+  // their x coordinates and one for their y coordinates. The operations are
+  // grouped as in SkRSXform::toQuad so that the results are identical.
+  __m128 min_x = _mm_set1_ps(kInfinity);
+  __m128 min_y = min_x;
+  __m128 max_x = _mm_set1_ps(-kInfinity);
+  __m128 max_y = max_x;
+  for (int i = 0; i < count; i++) {
+    const SkScalar width = tex[i].width();
+    const SkScalar height = tex[i].height();
+    const __m128 w = _mm_setr_ps(0, width, width, 0);
+    const __m128 h = _mm_setr_ps(0, 0, height, height);
+    const __m128 scos = _mm_set1_ps(xform[i].fSCos);
+    const __m128 ssin = _mm_set1_ps(xform[i].fSSin);
+    const __m128 x = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(scos, w),
+                   _mm_mul_ps(_mm_set1_ps(-xform[i].fSSin), h)),
+        _mm_set1_ps(xform[i].fTx));
+    const __m128 y = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(ssin, w), _mm_mul_ps(scos, h)),
+        _mm_set1_ps(xform[i].fTy));
+    min_x = _mm_min_ps(x, min_x);
+    max_x = _mm_max_ps(x, max_x);
+    min_y = _mm_min_ps(y, min_y);
+    max_y = _mm_max_ps(y, max_y);
+  }
+  // Reduces each register to its extreme in the first lane.
+  min_x = _mm_min_ps(min_x, _mm_movehl_ps(min_x, min_x));
+  min_x = _mm_min_ps(min_x, _mm_shuffle_ps(min_x, min_x, 1));
+  min_y = _mm_min_ps(min_y, _mm_movehl_ps(min_y, min_y));
+  min_y = _mm_min_ps(min_y, _mm_shuffle_ps(min_y, min_y, 1));
+  max_x = _mm_max_ps(max_x, _mm_movehl_ps(max_x, max_x));
+  max_x = _mm_max_ps(max_x, _mm_shuffle_ps(max_x, max_x, 1));
+  max_y = _mm_max_ps(max_y, _mm_movehl_ps(max_y, max_y));
+  max_y = _mm_max_ps(max_y, _mm_shuffle_ps(max_y, max_y, 1));
+  return SkRect::MakeLTRB(_mm_cvtss_f32(min_x), _mm_cvtss_f32(min_y),
+                          _mm_cvtss_f32(max_x), _mm_cvtss_f32(max_y));
+}
+
+SkRect JoinRects(const SkRect rects[], int count) {
+  // The (left, top) lanes of |min| and the (right, bottom) lanes of |max|
+  // hold the union.
+  __m128 min = _mm_set1_ps(kInfinity);
+  __m128 max = _mm_set1_ps(-kInfinity);
+  for (int i = 0; i < count; i++) {
+    const __m128 ltrb = _mm_loadu_ps(&rects[i].fLeft);
+    const __m128 rblt = _mm_shuffle_ps(ltrb, ltrb, _MM_SHUFFLE(1, 0, 3, 2));
+    // Joins the rect if left < right and top < bottom.
+    if ((_mm_movemask_ps(_mm_cmplt_ps(ltrb, rblt)) & 3) == 3) {
+      min = _mm_min_ps(ltrb, min);
+      max = _mm_max_ps(ltrb, max);
+    }
+  }
+  float min_ltrb[4];
+  float max_ltrb[4];
+  _mm_storeu_ps(min_ltrb, min);
+  _mm_storeu_ps(max_ltrb, max);
+  if (min_ltrb[0] == kInfinity) {
+    return SkRect::MakeEmpty();
+  }
+  return SkRect::MakeLTRB(min_ltrb[0], min_ltrb[1], max_ltrb[2], max_ltrb[3]);
+}
+
+#elif FLUTTER_BOUNDS_UTILS_NEON
+
+SkRect ComputePointExtents(const SkPoint points[], int count) {
+  // Each register holds two points as (x0, y0, x1, y1). Two pairs of
+  // accumulators keep consecutive iterations independent.
+  const float* coords = reinterpret_cast<const float*>(points);
+  float32x4_t min0 = vdupq_n_f32(kInfinity);
+  float32x4_t max0 = vdupq_n_f32(-kInfinity);
+  float32x4_t min1 = min0;
+  float32x4_t max1 = max0;
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    float32x4_t v0 = vld1q_f32(coords + 2 * i);
+    float32x4_t v1 = vld1q_f32(coords + 2 * i + 4);
+    min0 = vminnmq_f32(v0, min0);
+    max0 = vmaxnmq_f32(v0, max0);
+    min1 = vminnmq_f32(v1, min1);
+    max1 = vmaxnmq_f32(v1, max1);
+  }
+  min0 = vminnmq_f32(min0, min1);
+  max0 = vmaxnmq_f32(max0, max1);
+  float32x2_t min = vminnm_f32(vget_low_f32(min0), vget_high_f32(min0));
+  float32x2_t max = vmaxnm_f32(vget_low_f32(max0), vget_high_f32(max0));
+  for (; i < count; i++) {
+    float32x2_t v = vld1_f32(coords + 2 * i);
+    min = vminnm_f32(v, min);
+    max = vmaxnm_f32(v, max);
+  }
+  return SkRect::MakeLTRB(vget_lane_f32(min, 0), vget_lane_f32(min, 1),
+                          vget_lane_f32(max, 0), vget_lane_f32(max, 1));
+}
+
+SkRect ComputeAtlasExtents(const SkRSXform xform[],
+                           const SkRect tex[],
+                           int count) {
+  // The four corners of a quad are computed at once, with one register for
+  // their x coordinates and one for their y coordinates. The operations are
+  // grouped as in SkRSXform::toQuad so that the results are identical.
+  float32x4_t min_x = vdupq_n_f32(kInfinity);
+  float32x4_t min_y = min_x;
+  float32x4_t max_x = vdupq_n_f32(-kInfinity);
+  float32x4_t max_y = max_x;
+  for (int i = 0; i < count; i++) {
+    const SkScalar width = tex[i].width();
+    const SkScalar height = tex[i].height();
+    const float w_lanes[4] = {0, width, width, 0};
+    const float h_lanes[4] = {0, 0, height, height};
+    const float32x4_t w = vld1q_f32(w_lanes);
+    const float32x4_t h = vld1q_f32(h_lanes);
+    const float32x4_t x = vaddq_f32(
+        vaddq_f32(vmulq_n_f32(w, xform[i].fSCos),
+                  vmulq_n_f32(h, -xform[i].fSSin)),
+        vdupq_n_f32(xform[i].fTx));
+    const float32x4_t y =
+        vaddq_f32(vaddq_f32(vmulq_n_f32(w, xform[i].fSSin),
+                            vmulq_n_f32(h, xform[i].fSCos)),
+                  vdupq_n_f32(xform[i].fTy));
+    min_x = vminnmq_f32(x, min_x);
+    max_x = vmaxnmq_f32(x, max_x);
+    min_y = vminnmq_f32(y, min_y);
+    max_y = vmaxnmq_f32(y, max_y);
+  }
+  return SkRect::MakeLTRB(vminnmvq_f32(min_x), vminnmvq_f32(min_y),
+                          vmaxnmvq_f32(max_x), vmaxnmvq_f32(max_y));
+}
+
+SkRect JoinRects(const SkRect rects[], int count) {
+  // The (left, top) lanes of |min| and the (right, bottom) lanes of |max|
+  // hold the union.
+  float32x4_t min = vdupq_n_f32(kInfinity);
+  float32x4_t max = vdupq_n_f32(-kInfinity);
+  for (int i = 0; i < count; i++) {
+    const float32x4_t ltrb = vld1q_f32(&rects[i].fLeft);
+    const float32x4_t rblt = vextq_f32(ltrb, ltrb, 2);
+    // Joins the rect if left < right and top < bottom.
+    const uint32x2_t less = vget_low_u32(vcltq_f32(ltrb, rblt));
+    if (vget_lane_u32(less, 0) && vget_lane_u32(less, 1)) {
+      min = vminnmq_f32(ltrb, min);
+      max = vmaxnmq_f32(ltrb, max);
+    }
+  }
+  if (vgetq_lane_f32(min, 0) == kInfinity) {
+    return SkRect::MakeEmpty();
+  }
+  return SkRect::MakeLTRB(vgetq_lane_f32(min, 0), vgetq_lane_f32(min, 1),
+                          vgetq_lane_f32(max, 2), vgetq_lane_f32(max, 3));
+}
+
+#else  // !FLUTTER_BOUNDS_UTILS_SSE && !FLUTTER_BOUNDS_UTILS_NEON
+
+// The comparisons are written so that NaN coordinates leave the extents
+// unchanged, which is what the min and max instructions of SSE and the
+// minnm and maxnm instructions of NEON do with a NaN first operand.
+static void ExtendScalar(SkScalar value, SkScalar& min, SkScalar& max) {
+  if (min > value) {
+    min = value;
+  }
+  if (max < value) {
+    max = value;
+  }
+}
+
+SkRect ComputePointExtents(const SkPoint points[], int count) {
+  SkRect extents = SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity,
+                                    -kInfinity);
+  for (int i = 0; i < count; i++) {
+    ExtendScalar(points[i].fX, extents.fLeft, extents.fRight);
+    ExtendScalar(points[i].fY, extents.fTop, extents.fBottom);
+  }
+  return extents;
+}
+
+SkRect ComputeAtlasExtents(const SkRSXform xform[],
+                           const SkRect tex[],
+                           int count) {
+  SkRect extents = SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity,
+                                    -kInfinity);
+  SkPoint quad[4];
+  for (int i = 0; i < count; i++) {
+    xform[i].toQuad(tex[i].width(), tex[i].height(), quad);
+    for (const SkPoint& point : quad) {
+      ExtendScalar(point.fX, extents.fLeft, extents.fRight);
+      ExtendScalar(point.fY, extents.fTop, extents.fBottom);
+    }
+  }
+  return extents;
+}
+
+SkRect JoinRects(const SkRect rects[], int count) {
+  SkRect extents = SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity,
+                                    -kInfinity);
+  for (int i = 0; i < count; i++) {
+    const SkRect& rect = rects[i];
+    if (rect.fLeft < rect.fRight && rect.fTop < rect.fBottom) {
+      extents.fLeft = std::min(extents.fLeft, rect.fLeft);
+      extents.fTop = std::min(extents.fTop, rect.fTop);
+      extents.fRight = std::max(extents.fRight, rect.fRight);
+      extents.fBottom = std::max(extents.fBottom, rect.fBottom);
+    }
+  }
+  return extents.fLeft == kInfinity ? SkRect::MakeEmpty() : extents;
+}
+
+#endif  // FLUTTER_BOUNDS_UTILS_SSE
+
+}  // namespace flutter
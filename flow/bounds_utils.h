@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_BOUNDS_UTILS_H_
+#define FLUTTER_FLOW_BOUNDS_UTILS_H_
+
+#include "third_party/skia/include/core/SkPoint.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+// Bounds computations over many points or rects in one call.
+//
+// The computations process several coordinates at a time with SSE on x86
+// and NEON on arm64, and fall back to scalar code on other architectures.
+// All of them give the same results as the equivalent loops over the
+// individual points or rects.
+
+namespace flutter {
+
+// Returns the extents of the points as the rect (min x, min y, max x, max y).
+//
+// NaN coordinates are ignored, independently on each axis. An axis without
+// any coordinate has the extents (+infinity, -infinity), so that the result
+// of an empty array is an inverted rect.
+SkRect ComputePointExtents(const SkPoint points[], int count);
+
+// Returns the extents, as in |ComputePointExtents|, of the quads that the
+// sprites of a drawAtlas call are drawn into. Each sprite is the size of its
+// |tex| rect, transformed by its |xform|, as computed by SkRSXform::toQuad.
+SkRect ComputeAtlasExtents(const SkRSXform xform[],
+                           const SkRect tex[],
+                           int count);
+
+// Returns the union of the rects, as computed by joining each of them to an
+// empty rect with SkRect::join. Empty rects are skipped.
+SkRect JoinRects(const SkRect rects[], int count);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_BOUNDS_UTILS_H_
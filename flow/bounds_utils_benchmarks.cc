@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the batched bounds computations with the loops over individual
+// points and rects that DisplayListBoundsCalculator and DiffContext used.
+
+#include "flutter/flow/bounds_utils.h"
+
+#include <random>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/display_list_utils.h"
+
+namespace flutter {
+namespace {
+
+std::vector<SkPoint> MakePoints(int count) {
+  std::mt19937 random(count);
+  std::uniform_real_distribution<float> coordinate(-1000, 1000);
+  std::vector<SkPoint> points(count);
+  for (SkPoint& point : points) {
+    point.set(coordinate(random), coordinate(random));
+  }
+  return points;
+}
+
+std::vector<SkRect> MakeRects(int count) {
+  std::mt19937 random(count);
+  std::uniform_real_distribution<float> coordinate(-1000, 1000);
+  std::uniform_real_distribution<float> size(1, 100);
+  std::vector<SkRect> rects(count);
+  for (SkRect& rect : rects) {
+    rect = SkRect::MakeXYWH(coordinate(random), coordinate(random),
+                            size(random), size(random));
+  }
+  return rects;
+}
+
+std::vector<SkRSXform> MakeXforms(int count) {
+  std::mt19937 random(count);
+  std::uniform_real_distribution<float> radians(0, 6.28f);
+  std::uniform_real_distribution<float> coordinate(-1000, 1000);
+  std::vector<SkRSXform> xforms;
+  for (int i = 0; i < count; i++) {
+    xforms.push_back(SkRSXform::MakeFromRadians(
+        1, radians(random), coordinate(random), coordinate(random), 0, 0));
+  }
+  return xforms;
+}
+
+}  // namespace
+
+static void BM_PointBoundsLoop(benchmark::State& state) {  // NOLINT
+  auto points = MakePoints(state.range(0));
+  while (state.KeepRunning()) {
+    BoundsAccumulator accumulator;
+    for (const SkPoint& point : points) {
+      accumulator.accumulate(point);
+    }
+    benchmark::DoNotOptimize(accumulator.bounds());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_PointBoundsBatched(benchmark::State& state) {  // NOLINT
+  auto points = MakePoints(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect extents =
+        ComputePointExtents(points.data(), static_cast<int>(points.size()));
+    benchmark::DoNotOptimize(extents);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_AtlasBoundsLoop(benchmark::State& state) {  // NOLINT
+  auto xforms = MakeXforms(state.range(0));
+  auto tex = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    BoundsAccumulator accumulator;
+    SkPoint quad[4];
+    for (size_t i = 0; i < xforms.size(); i++) {
+      xforms[i].toQuad(tex[i].width(), tex[i].height(), quad);
+      for (const SkPoint& point : quad) {
+        accumulator.accumulate(point);
+      }
+    }
+    benchmark::DoNotOptimize(accumulator.bounds());
+  }
+  state.SetItemsProcessed(state.iterations() * xforms.size());
+}
+
+static void BM_AtlasBoundsBatched(benchmark::State& state) {  // NOLINT
+  auto xforms = MakeXforms(state.range(0));
+  auto tex = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect extents = ComputeAtlasExtents(xforms.data(), tex.data(),
+                                         static_cast<int>(xforms.size()));
+    benchmark::DoNotOptimize(extents);
+  }
+  state.SetItemsProcessed(state.iterations() * xforms.size());
+}
+
+static void BM_JoinRectsLoop(benchmark::State& state) {  // NOLINT
+  auto rects = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect bounds = SkRect::MakeEmpty();
+    for (const SkRect& rect : rects) {
+      bounds.join(rect);
+    }
+    benchmark::DoNotOptimize(bounds);
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+
+static void BM_JoinRectsBatched(benchmark::State& state) {  // NOLINT
+  auto rects = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect bounds = JoinRects(rects.data(), static_cast<int>(rects.size()));
+    benchmark::DoNotOptimize(bounds);
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+
+BENCHMARK(BM_PointBoundsLoop)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_PointBoundsBatched)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_AtlasBoundsLoop)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_AtlasBoundsBatched)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_JoinRectsLoop)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_JoinRectsBatched)->RangeMultiplier(8)->Range(8, 4096);
+
+}  // namespace flutter
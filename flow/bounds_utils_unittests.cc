@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/bounds_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr SkScalar kInfinity = std::numeric_limits<SkScalar>::infinity();
+
+void ExpectSameRect(const SkRect& actual, const SkRect& expected) {
+  EXPECT_EQ(actual.fLeft, expected.fLeft);
+  EXPECT_EQ(actual.fTop, expected.fTop);
+  EXPECT_EQ(actual.fRight, expected.fRight);
+  EXPECT_EQ(actual.fBottom, expected.fBottom);
+}
+
+SkRect ReferencePointExtents(const std::vector<SkPoint>& points) {
+  SkRect extents =
+      SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity, -kInfinity);
+  for (const SkPoint& point : points) {
+    if (extents.fLeft > point.fX) {
+      extents.fLeft = point.fX;
+    }
+    if (extents.fRight < point.fX) {
+      extents.fRight = point.fX;
+    }
+    if (extents.fTop > point.fY) {
+      extents.fTop = point.fY;
+    }
+    if (extents.fBottom < point.fY) {
+      extents.fBottom = point.fY;
+    }
+  }
+  return extents;
+}
+
+}  // namespace
+
+TEST(BoundsUtilsTest, PointExtentsOfNoPoints) {
+  SkRect inverted =
+      SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity, -kInfinity);
+  ExpectSameRect(ComputePointExtents(nullptr, 0), inverted);
+}
+
+TEST(BoundsUtilsTest, PointExtentsMatchScalarLoop) {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> coordinate(-1000, 1000);
+  // Covers the counts that leave every possible remainder after the
+  // vectorized loop.
+  for (int count = 1; count <= 11; count++) {
+    std::vector<SkPoint> points(count);
+    for (SkPoint& point : points) {
+      point.set(coordinate(random), coordinate(random));
+    }
+    ExpectSameRect(ComputePointExtents(points.data(), count),
+                   ReferencePointExtents(points));
+  }
+}
+
+TEST(BoundsUtilsTest, PointExtentsIgnoreNaN) {
+  const SkScalar nan = std::numeric_limits<SkScalar>::quiet_NaN();
+  std::vector<SkPoint> points = {
+      {nan, 5}, {3, nan}, {-2, 7}, {nan, nan}, {10, -4},
+  };
+  ExpectSameRect(ComputePointExtents(points.data(), points.size()),
+                 SkRect::MakeLTRB(-2, -4, 10, 7));
+
+  std::vector<SkPoint> only_y = {{nan, 1}, {nan, 2}};
+  ExpectSameRect(ComputePointExtents(only_y.data(), only_y.size()),
+                 SkRect::MakeLTRB(kInfinity, 1, -kInfinity, 2));
+}
+
+TEST(BoundsUtilsTest, AtlasExtentsMatchQuads) {
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float> unit(-1, 1);
+  std::uniform_real_distribution<float> coordinate(-500, 500);
+  std::uniform_real_distribution<float> size(0, 100);
+  for (int count = 1; count <= 9; count++) {
+    std::vector<SkRSXform> xforms;
+    std::vector<SkRect> tex;
+    std::vector<SkPoint> corners;
+    for (int i = 0; i < count; i++) {
+      xforms.push_back(SkRSXform::Make(unit(random), unit(random),
+                                       coordinate(random), coordinate(random)));
+      tex.push_back(SkRect::MakeXYWH(coordinate(random), coordinate(random),
+                                     size(random), size(random)));
+      SkPoint quad[4];
+      xforms.back().toQuad(tex.back().width(), tex.back().height(), quad);
+      corners.insert(corners.end(), quad, quad + 4);
+    }
+    ExpectSameRect(ComputeAtlasExtents(xforms.data(), tex.data(), count),
+                   ReferencePointExtents(corners));
+  }
+}
+
+TEST(BoundsUtilsTest, JoinRectsMatchesSkRectJoin) {
+  std::mt19937 random(3);
+  std::uniform_real_distribution<float> coordinate(-1000, 1000);
+  std::vector<SkRect> rects;
+  for (int i = 0; i < 50; i++) {
+    // Some of the rects are empty or inverted.
+    rects.push_back(SkRect::MakeLTRB(coordinate(random), coordinate(random),
+                                     coordinate(random), coordinate(random)));
+    SkRect expected = SkRect::MakeEmpty();
+    for (const SkRect& rect : rects) {
+      expected.join(rect);
+    }
+    ExpectSameRect(JoinRects(rects.data(), rects.size()), expected);
+  }
+}
+
+TEST(BoundsUtilsTest, JoinRectsOfEmptyRectsIsEmpty) {
+  std::vector<SkRect> rects = {
+      SkRect::MakeLTRB(10, 10, 10, 20),
+      SkRect::MakeLTRB(10, 10, 20, 10),
+      SkRect::MakeLTRB(20, 20, 10, 10),
+  };
+  ExpectSameRect(JoinRects(rects.data(), rects.size()), SkRect::MakeEmpty());
+  ExpectSameRect(JoinRects(nullptr, 0), SkRect::MakeEmpty());
+}
+
+}  // namespace testing
+}  // namespace flutter
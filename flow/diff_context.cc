@@ -163,9 +163,7 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
-  for (const auto& r : damage) {
-    damage_.join(r);
-  }
+  damage_.join(damage.ComputeBounds());
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
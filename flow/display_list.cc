@@ -865,6 +865,7 @@ void DisplayList::ComputeBounds() {
   DisplayListBoundsCalculator calculator(&bounds_cull_);
   Dispatch(calculator);
   bounds_ = calculator.bounds();
+  can_apply_group_opacity_ = calculator.can_apply_group_opacity();
 }
 
 void DisplayList::Dispatch(Dispatcher& dispatcher,
@@ -981,8 +982,10 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
-void DisplayList::RenderTo(SkCanvas* canvas) const {
-  DisplayListCanvasDispatcher dispatcher(canvas);
+void DisplayList::RenderTo(SkCanvas* canvas,
+                           SkScalar opacity,
+                           const RasterCache* raster_cache) const {
+  DisplayListCanvasDispatcher dispatcher(canvas, opacity, raster_cache);
   Dispatch(dispatcher);
 }
 
@@ -1010,7 +1013,8 @@ DisplayList::DisplayList(uint8_t* ptr,
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
       bounds_({0, 0, -1, -1}),
-      bounds_cull_(cull_rect) {
+      bounds_cull_(cull_rect),
+      can_apply_group_opacity_(false) {
   static std::atomic<uint32_t> nextID{1};
   do {
     unique_id_ = nextID.fetch_add(+1, std::memory_order_relaxed);
@@ -155,6 +155,7 @@ enum class DisplayListOpType { FOR_EACH_DISPLAY_LIST_OP(DL_OP_TO_ENUM_VALUE) };
 
 class Dispatcher;
 class DisplayListBuilder;
+class RasterCache;
 
 // The base class that contains a sequence of rendering operations
 // for dispatch to a Dispatcher. These objects must be instantiated
@@ -173,7 +174,8 @@ class DisplayList : public SkRefCnt {
         nested_op_count_(0),
         unique_id_(0),
         bounds_({0, 0, 0, 0}),
-        bounds_cull_({0, 0, 0, 0}) {}
+        bounds_cull_({0, 0, 0, 0}),
+        can_apply_group_opacity_(true) {}
 
   ~DisplayList();
 
@@ -182,7 +184,13 @@ class DisplayList : public SkRefCnt {
     Dispatch(ctx, ptr, ptr + byte_count_);
   }
 
-  void RenderTo(SkCanvas* canvas) const;
+  // Renders the list to the canvas. An |opacity| other than SK_Scalar1
+  // is only rendered correctly if |can_apply_group_opacity| is true.
+  // Display lists nested in the list are drawn from the |raster_cache|,
+  // if one is given, once they are reused often enough.
+  void RenderTo(SkCanvas* canvas,
+                SkScalar opacity = SK_Scalar1,
+                const RasterCache* raster_cache = nullptr) const;
 
   // SkPicture always includes nested bytes, but nested ops are
   // only included if requested. The defaults used here for these
@@ -205,6 +213,20 @@ class DisplayList : public SkRefCnt {
     return bounds_;
   }
 
+  // Whether the list can be rendered with an opacity applied to each of its
+  // rendering operations, rather than by rendering it into a saveLayer with
+  // that opacity. See DisplayListBoundsCalculator::can_apply_group_opacity.
+  bool can_apply_group_opacity() {
+    if (bounds_.width() < 0.0) {
+      ComputeBounds();
+    }
+    return can_apply_group_opacity_;
+  }
+
+  // The cull rect the list was built with, which bounds the ops that
+  // are otherwise unbounded such as drawPaint() and drawColor().
+  const SkRect& cull_rect() const { return bounds_cull_; }
+
   bool Equals(const DisplayList& other) const;
 
  private:
@@ -228,6 +250,9 @@ class DisplayList : public SkRefCnt {
   // Only used for drawPaint() and drawColor()
   SkRect bounds_cull_;
 
+  // Computed along with |bounds_|.
+  bool can_apply_group_opacity_;
+
   void ComputeBounds();
   void Dispatch(Dispatcher& ctx, uint8_t* ptr, uint8_t* end) const;
 
@@ -5,6 +5,7 @@
 #include "flutter/flow/display_list_canvas.h"
 
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/raster_cache.h"
 
 #include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
@@ -13,13 +14,17 @@ namespace flutter {
 
 void DisplayListCanvasDispatcher::save() {
   canvas_->save();
+  save_opacity(false);
 }
 void DisplayListCanvasDispatcher::restore() {
   canvas_->restore();
+  restore_opacity();
 }
 void DisplayListCanvasDispatcher::saveLayer(const SkRect* bounds,
                                             bool restore_with_paint) {
-  canvas_->saveLayer(bounds, restore_with_paint ? &paint() : nullptr);
+  canvas_->saveLayer(bounds, safe_paint(restore_with_paint));
+  // The opacity is applied to the layer rather than to its contents.
+  save_opacity(true);
 }
 
 void DisplayListCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
@@ -79,7 +84,9 @@ void DisplayListCanvasDispatcher::drawPaint() {
   canvas_->drawPaint(paint());
 }
 void DisplayListCanvasDispatcher::drawColor(SkColor color, SkBlendMode mode) {
-  canvas_->drawColor(color, mode);
+  SkColor4f color4f = SkColor4f::FromColor(color);
+  color4f.fA *= opacity();
+  canvas_->drawColor(color4f, mode);
 }
 void DisplayListCanvasDispatcher::drawLine(const SkPoint& p0,
                                            const SkPoint& p1) {
@@ -125,7 +132,7 @@ void DisplayListCanvasDispatcher::drawImage(const sk_sp<SkImage> image,
                                             const SkSamplingOptions& sampling,
                                             bool render_with_attributes) {
   canvas_->drawImage(image, point.fX, point.fY, sampling,
-                     render_with_attributes ? &paint() : nullptr);
+                     safe_paint(render_with_attributes));
 }
 void DisplayListCanvasDispatcher::drawImageRect(
     const sk_sp<SkImage> image,
@@ -135,8 +142,7 @@ void DisplayListCanvasDispatcher::drawImageRect(
     bool render_with_attributes,
     SkCanvas::SrcRectConstraint constraint) {
   canvas_->drawImageRect(image, src, dst, sampling,
-                         render_with_attributes ? &paint() : nullptr,
-                         constraint);
+                         safe_paint(render_with_attributes), constraint);
 }
 void DisplayListCanvasDispatcher::drawImageNine(const sk_sp<SkImage> image,
                                                 const SkIRect& center,
@@ -144,7 +150,7 @@ void DisplayListCanvasDispatcher::drawImageNine(const sk_sp<SkImage> image,
                                                 SkFilterMode filter,
                                                 bool render_with_attributes) {
   canvas_->drawImageNine(image.get(), center, dst, filter,
-                         render_with_attributes ? &paint() : nullptr);
+                         safe_paint(render_with_attributes));
 }
 void DisplayListCanvasDispatcher::drawImageLattice(
     const sk_sp<SkImage> image,
@@ -153,7 +159,7 @@ void DisplayListCanvasDispatcher::drawImageLattice(
     SkFilterMode filter,
     bool render_with_attributes) {
   canvas_->drawImageLattice(image.get(), lattice, dst, filter,
-                            render_with_attributes ? &paint() : nullptr);
+                            safe_paint(render_with_attributes));
 }
 void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<SkImage> atlas,
                                             const SkRSXform xform[],
@@ -165,19 +171,27 @@ void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<SkImage> atlas,
                                             const SkRect* cullRect,
                                             bool render_with_attributes) {
   canvas_->drawAtlas(atlas.get(), xform, tex, colors, count, mode, sampling,
-                     cullRect, render_with_attributes ? &paint() : nullptr);
+                     cullRect, safe_paint(render_with_attributes));
 }
 void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture> picture,
                                               const SkMatrix* matrix,
                                               bool render_with_attributes) {
-  canvas_->drawPicture(picture, matrix,
-                       render_with_attributes ? &paint() : nullptr);
+  canvas_->drawPicture(picture, matrix, safe_paint(render_with_attributes));
 }
 void DisplayListCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
+  if (raster_cache_) {
+    // The cached image is a single draw, so it can always take the opacity.
+    SkPaint paint;
+    paint.setAlphaf(opacity());
+    if (raster_cache_->DrawNested(*display_list, *canvas_,
+                                  opacity() < SK_Scalar1 ? &paint : nullptr)) {
+      return;
+    }
+  }
   int save_count = canvas_->save();
   {
-    DisplayListCanvasDispatcher dispatcher(canvas_);
+    DisplayListCanvasDispatcher dispatcher(canvas_, opacity(), raster_cache_);
     display_list->Dispatch(dispatcher);
   }
   canvas_->restoreToCount(save_count);
@@ -193,7 +207,8 @@ void DisplayListCanvasDispatcher::drawShadow(const SkPath& path,
                                              bool transparent_occluder,
                                              SkScalar dpr) {
   flutter::PhysicalShapeLayer::DrawShadow(canvas_, path, color, elevation,
-                                          transparent_occluder, dpr);
+                                          transparent_occluder, dpr,
+                                          raster_cache_);
 }
 
 DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
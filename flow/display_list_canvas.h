@@ -23,11 +23,22 @@
 
 namespace flutter {
 
+class RasterCache;
+
 // Receives all methods on Dispatcher and sends them to an SkCanvas
+//
+// Nested display lists and the shadows of rounded rectangles are drawn
+// from the |raster_cache|, if one is given, under transforms that only
+// scale and translate.
 class DisplayListCanvasDispatcher : public virtual Dispatcher,
                                     public SkPaintDispatchHelper {
  public:
-  DisplayListCanvasDispatcher(SkCanvas* canvas) : canvas_(canvas) {}
+  DisplayListCanvasDispatcher(SkCanvas* canvas,
+                              SkScalar opacity = SK_Scalar1,
+                              const RasterCache* raster_cache = nullptr)
+      : SkPaintDispatchHelper(opacity),
+        canvas_(canvas),
+        raster_cache_(raster_cache) {}
 
   void save() override;
   void restore() override;
@@ -115,6 +126,7 @@ class DisplayListCanvasDispatcher : public virtual Dispatcher,
 
  private:
   SkCanvas* canvas_;
+  const RasterCache* raster_cache_;
 };
 
 // Receives all methods on SkCanvas and sends them to a DisplayListBuilder
@@ -0,0 +1,687 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_optimizer.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/display_list_utils.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
+
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+namespace {
+
+using OptimizedDisplayLists =
+    std::unordered_map<const DisplayList*, sk_sp<DisplayList>>;
+
+// Receives the records of a display list and keeps those that are needed
+// to render it. The records are held until the end of the display list, as
+// whether the records of a save or saveLayer can be dropped is only known
+// when it is restored.
+class DisplayListOptimizer final : public virtual Dispatcher {
+ public:
+  DisplayListOptimizer(DisplayListOptimizationStats* stats,
+                       OptimizedDisplayLists* optimized)
+      : stats_(stats), optimized_(optimized) {}
+
+  sk_sp<DisplayList> Optimize(DisplayList* display_list) {
+    display_list->Dispatch(*this);
+    DisplayListBuilder builder(display_list->cull_rect());
+    for (const auto& record : records_) {
+      record.replay(builder);
+    }
+    return builder.Build();
+  }
+
+  void setAntiAlias(bool aa) override {
+    SetAttribute(&aa_, aa, [aa](Dispatcher& d) { d.setAntiAlias(aa); });
+  }
+  void setDither(bool dither) override {
+    SetAttribute(&dither_, dither,
+                 [dither](Dispatcher& d) { d.setDither(dither); });
+  }
+  void setStyle(SkPaint::Style style) override {
+    SetAttribute(&style_, style, [style](Dispatcher& d) { d.setStyle(style); });
+  }
+  void setColor(SkColor color) override {
+    SetAttribute(&color_, color, [color](Dispatcher& d) { d.setColor(color); });
+  }
+  void setStrokeWidth(SkScalar width) override {
+    SetAttribute(&stroke_width_, width,
+                 [width](Dispatcher& d) { d.setStrokeWidth(width); });
+  }
+  void setStrokeMiter(SkScalar limit) override {
+    SetAttribute(&stroke_miter_, limit,
+                 [limit](Dispatcher& d) { d.setStrokeMiter(limit); });
+  }
+  void setStrokeCap(SkPaint::Cap cap) override {
+    SetAttribute(&stroke_cap_, cap,
+                 [cap](Dispatcher& d) { d.setStrokeCap(cap); });
+  }
+  void setStrokeJoin(SkPaint::Join join) override {
+    SetAttribute(&stroke_join_, join,
+                 [join](Dispatcher& d) { d.setStrokeJoin(join); });
+  }
+  void setShader(sk_sp<SkShader> shader) override {
+    SetAttribute(&shader_, shader,
+                 [shader](Dispatcher& d) { d.setShader(shader); });
+  }
+  void setColorFilter(sk_sp<SkColorFilter> filter) override {
+    SetAttribute(&color_filter_, filter,
+                 [filter](Dispatcher& d) { d.setColorFilter(filter); });
+  }
+  void setInvertColors(bool invert) override {
+    SetAttribute(&invert_colors_, invert,
+                 [invert](Dispatcher& d) { d.setInvertColors(invert); });
+  }
+  void setBlendMode(SkBlendMode mode) override {
+    if (!blender_ && blend_mode_ == mode) {
+      stats_->redundant_attributes++;
+      return;
+    }
+    blender_ = nullptr;
+    blend_mode_ = mode;
+    EmitAttribute([mode](Dispatcher& d) { d.setBlendMode(mode); });
+  }
+  void setBlender(sk_sp<SkBlender> blender) override {
+    // A null blender resets the blend mode to srcOver.
+    if (blender ? blender == blender_ : RendersSrcOver()) {
+      stats_->redundant_attributes++;
+      return;
+    }
+    blender_ = blender;
+    blend_mode_ = SkBlendMode::kSrcOver;
+    EmitAttribute([blender](Dispatcher& d) { d.setBlender(blender); });
+  }
+  void setPathEffect(sk_sp<SkPathEffect> effect) override {
+    SetAttribute(&path_effect_, effect,
+                 [effect](Dispatcher& d) { d.setPathEffect(effect); });
+  }
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override {
+    if (!mask_is_blur_ && mask_filter_ == filter) {
+      stats_->redundant_attributes++;
+      return;
+    }
+    mask_filter_ = filter;
+    mask_is_blur_ = false;
+    EmitAttribute([filter](Dispatcher& d) { d.setMaskFilter(filter); });
+  }
+  void setMaskBlurFilter(SkBlurStyle style, SkScalar sigma) override {
+    if (mask_is_blur_ && mask_blur_style_ == style &&
+        mask_blur_sigma_ == sigma) {
+      stats_->redundant_attributes++;
+      return;
+    }
+    mask_filter_ = nullptr;
+    mask_is_blur_ = true;
+    mask_blur_style_ = style;
+    mask_blur_sigma_ = sigma;
+    EmitAttribute(
+        [style, sigma](Dispatcher& d) { d.setMaskBlurFilter(style, sigma); });
+  }
+  void setImageFilter(sk_sp<SkImageFilter> filter) override {
+    SetAttribute(&image_filter_, filter,
+                 [filter](Dispatcher& d) { d.setImageFilter(filter); });
+  }
+
+  void save() override {
+    scopes_.push_back({records_.size()});
+    EmitState([](Dispatcher& d) { d.save(); });
+  }
+  void saveLayer(const SkRect* bounds, bool restore_with_paint) override {
+    Scope scope = {records_.size()};
+    scope.is_layer = true;
+    scope.has_bounds = bounds != nullptr;
+    scope.bounds = bounds ? *bounds : SkRect::MakeEmpty();
+    scope.composites_src_over = !restore_with_paint || RendersSrcOver();
+    scope.composites_unmodified =
+        !restore_with_paint ||
+        (SkColorGetA(color_) == 0xFF && RendersSrcOver() && !shader_ &&
+         !color_filter_ && !invert_colors_ && !image_filter_ && !mask_filter_ &&
+         !mask_is_blur_);
+    if (scope.has_bounds && scope.composites_unmodified) {
+      scope.replay_bounds_attributes = BoundsAttributesReplay();
+    }
+    scopes_.push_back(scope);
+    SkRect layer_bounds = scope.bounds;
+    bool has_bounds = scope.has_bounds;
+    EmitState([layer_bounds, has_bounds, restore_with_paint](Dispatcher& d) {
+      d.saveLayer(has_bounds ? &layer_bounds : nullptr, restore_with_paint);
+    });
+  }
+  void restore() override {
+    if (scopes_.empty()) {
+      EmitState([](Dispatcher& d) { d.restore(); });
+      return;
+    }
+    Scope scope = scopes_.back();
+    scopes_.pop_back();
+
+    // A layer can be replaced by a save if drawing its contents directly
+    // gives the same result as compositing them, which is true if all of
+    // them are drawn with srcOver, since it is associative. The bounds of a
+    // layer clip its contents to the device pixels they cover, which no clip
+    // in local coordinates can reproduce without knowing the transform the
+    // display list is drawn with, so a layer with bounds is only collapsed if
+    // its contents do not reach beyond them.
+    bool collapse_layer =
+        scope.is_layer && scope.composites_unmodified &&
+        scope.contents_src_over &&
+        (!scope.has_bounds || !scope.has_draws || DrawsWithinBounds(scope));
+    if (!scope.has_draws && (!scope.is_layer || collapse_layer)) {
+      DropScope(scope);
+      stats_->empty_saves++;
+      return;
+    }
+    if (collapse_layer) {
+      records_[scope.start].replay = [](Dispatcher& d) { d.save(); };
+      stats_->collapsed_save_layers++;
+    }
+    EmitState([](Dispatcher& d) { d.restore(); });
+    if (!scopes_.empty()) {
+      Scope& parent = scopes_.back();
+      parent.has_draws = true;
+      parent.contents_src_over &=
+          (scope.is_layer && !collapse_layer) ? scope.composites_src_over
+                                              : scope.contents_src_over;
+    }
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    if (tx == 0 && ty == 0) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([tx, ty](Dispatcher& d) { d.translate(tx, ty); });
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    if (sx == 1 && sy == 1) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([sx, sy](Dispatcher& d) { d.scale(sx, sy); });
+  }
+  void rotate(SkScalar degrees) override {
+    if (degrees == 0) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([degrees](Dispatcher& d) { d.rotate(degrees); });
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    if (sx == 0 && sy == 0) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([sx, sy](Dispatcher& d) { d.skew(sx, sy); });
+  }
+
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    if (mxx == 1 && mxy == 0 && mxt == 0 &&
+        myx == 0 && myy == 1 && myt == 0) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([=](Dispatcher& d) {
+      d.transform2DAffine(mxx, mxy, mxt,
+                          myx, myy, myt);
+    });
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    if (mxx == 1 && mxy == 0 && mxz == 0 && mxt == 0 &&
+        myx == 0 && myy == 1 && myz == 0 && myt == 0 &&
+        mzx == 0 && mzy == 0 && mzz == 1 && mzt == 0 &&
+        mwx == 0 && mwy == 0 && mwz == 0 && mwt == 1) {
+      stats_->identity_transforms++;
+      return;
+    }
+    EmitState([=](Dispatcher& d) {
+      d.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                 myx, myy, myz, myt,
+                                 mzx, mzy, mzz, mzt,
+                                 mwx, mwy, mwz, mwt);
+    });
+  }
+  // clang-format on
+
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override {
+    EmitState([=](Dispatcher& d) { d.clipRect(rect, clip_op, is_aa); });
+  }
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override {
+    EmitState([=](Dispatcher& d) { d.clipRRect(rrect, clip_op, is_aa); });
+  }
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override {
+    EmitState([=](Dispatcher& d) { d.clipPath(path, clip_op, is_aa); });
+  }
+
+  void drawColor(SkColor color, SkBlendMode mode) override {
+    EmitDraw(mode == SkBlendMode::kSrcOver,
+             [=](Dispatcher& d) { d.drawColor(color, mode); });
+  }
+  void drawPaint() override {
+    EmitDraw(RendersSrcOver(), [](Dispatcher& d) { d.drawPaint(); });
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    EmitDraw(RendersSrcOver(), [=](Dispatcher& d) { d.drawLine(p0, p1); });
+  }
+  void drawRect(const SkRect& rect) override {
+    bool mergeable = !aa_ && RendersSrcOver() && IsOpaqueFill();
+    SkRect merged;
+    if (mergeable && last_draw_is_mergeable_rect_ &&
+        MergeRects(last_rect_, rect, &merged)) {
+      last_rect_ = merged;
+      records_.back().replay = [merged](Dispatcher& d) { d.drawRect(merged); };
+      stats_->merged_draws++;
+      return;
+    }
+    EmitDraw(RendersSrcOver(), [rect](Dispatcher& d) { d.drawRect(rect); });
+    last_draw_is_mergeable_rect_ = mergeable;
+    last_rect_ = rect;
+  }
+  void drawOval(const SkRect& bounds) override {
+    EmitDraw(RendersSrcOver(), [bounds](Dispatcher& d) { d.drawOval(bounds); });
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    EmitDraw(RendersSrcOver(),
+             [=](Dispatcher& d) { d.drawCircle(center, radius); });
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    EmitDraw(RendersSrcOver(), [rrect](Dispatcher& d) { d.drawRRect(rrect); });
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    EmitDraw(RendersSrcOver(),
+             [=](Dispatcher& d) { d.drawDRRect(outer, inner); });
+  }
+  void drawPath(const SkPath& path) override {
+    EmitDraw(RendersSrcOver(), [path](Dispatcher& d) { d.drawPath(path); });
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    EmitDraw(RendersSrcOver(), [=](Dispatcher& d) {
+      d.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+    });
+  }
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    std::vector<SkPoint> copy(points, points + count);
+    EmitDraw(RendersSrcOver(), [mode, copy = std::move(copy)](Dispatcher& d) {
+      d.drawPoints(mode, static_cast<uint32_t>(copy.size()), copy.data());
+    });
+  }
+  void drawVertices(const sk_sp<SkVertices> vertices,
+                    SkBlendMode mode) override {
+    EmitDraw(RendersSrcOver(),
+             [=](Dispatcher& d) { d.drawVertices(vertices, mode); });
+  }
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override {
+    EmitDraw(!render_with_attributes || RendersSrcOver(), [=](Dispatcher& d) {
+      d.drawImage(image, point, sampling, render_with_attributes);
+    });
+  }
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    EmitDraw(!render_with_attributes || RendersSrcOver(), [=](Dispatcher& d) {
+      d.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                      constraint);
+    });
+  }
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override {
+    EmitDraw(!render_with_attributes || RendersSrcOver(), [=](Dispatcher& d) {
+      d.drawImageNine(image, center, dst, filter, render_with_attributes);
+    });
+  }
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override {
+    // The lattice points to arrays owned by the caller, so it is copied.
+    int cell_count = (lattice.fXCount + 1) * (lattice.fYCount + 1);
+    std::vector<int> x_divs(lattice.fXDivs, lattice.fXDivs + lattice.fXCount);
+    std::vector<int> y_divs(lattice.fYDivs, lattice.fYDivs + lattice.fYCount);
+    std::vector<SkCanvas::Lattice::RectType> rect_types;
+    if (lattice.fRectTypes) {
+      rect_types.assign(lattice.fRectTypes, lattice.fRectTypes + cell_count);
+    }
+    std::vector<SkColor> colors;
+    if (lattice.fColors) {
+      colors.assign(lattice.fColors, lattice.fColors + cell_count);
+    }
+    bool has_bounds = lattice.fBounds != nullptr;
+    SkIRect bounds = has_bounds ? *lattice.fBounds : SkIRect::MakeEmpty();
+    EmitDraw(!render_with_attributes || RendersSrcOver(),
+             [=, x_divs = std::move(x_divs), y_divs = std::move(y_divs),
+              rect_types = std::move(rect_types),
+              colors = std::move(colors)](Dispatcher& d) {
+               SkCanvas::Lattice copy = {
+                   x_divs.data(),
+                   y_divs.data(),
+                   rect_types.empty() ? nullptr : rect_types.data(),
+                   static_cast<int>(x_divs.size()),
+                   static_cast<int>(y_divs.size()),
+                   has_bounds ? &bounds : nullptr,
+                   colors.empty() ? nullptr : colors.data(),
+               };
+               d.drawImageLattice(image, copy, dst, filter,
+                                  render_with_attributes);
+             });
+  }
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    std::vector<SkRSXform> xform_copy(xform, xform + count);
+    std::vector<SkRect> tex_copy(tex, tex + count);
+    std::vector<SkColor> colors_copy;
+    if (colors) {
+      colors_copy.assign(colors, colors + count);
+    }
+    bool has_cull = cull_rect != nullptr;
+    SkRect cull = has_cull ? *cull_rect : SkRect::MakeEmpty();
+    EmitDraw(!render_with_attributes || RendersSrcOver(),
+             [=, xform_copy = std::move(xform_copy),
+              tex_copy = std::move(tex_copy),
+              colors_copy = std::move(colors_copy)](Dispatcher& d) {
+               d.drawAtlas(atlas, xform_copy.data(), tex_copy.data(),
+                           colors_copy.empty() ? nullptr : colors_copy.data(),
+                           count, mode, sampling, has_cull ? &cull : nullptr,
+                           render_with_attributes);
+             });
+  }
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override {
+    bool has_matrix = matrix != nullptr;
+    SkMatrix matrix_copy = has_matrix ? *matrix : SkMatrix::I();
+    // The blend modes used by the picture are not known.
+    EmitDraw(false, [=](Dispatcher& d) {
+      d.drawPicture(picture, has_matrix ? &matrix_copy : nullptr,
+                    render_with_attributes);
+    });
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    sk_sp<DisplayList>& optimized = (*optimized_)[display_list.get()];
+    if (!optimized) {
+      optimized = DisplayListOptimizer(stats_, optimized_)
+                      .Optimize(display_list.get());
+    }
+    sk_sp<DisplayList> nested = optimized;
+    // Not inspected for the blend modes it uses.
+    EmitDraw(false, [nested](Dispatcher& d) { d.drawDisplayList(nested); });
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    EmitDraw(RendersSrcOver(),
+             [=](Dispatcher& d) { d.drawTextBlob(blob, x, y); });
+  }
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    EmitDraw(true, [=](Dispatcher& d) {
+      d.drawShadow(path, color, elevation, transparent_occluder, dpr);
+    });
+  }
+
+ private:
+  enum class RecordType { kAttribute, kState, kDraw };
+
+  struct Record {
+    RecordType type;
+    std::function<void(Dispatcher&)> replay;
+  };
+
+  // An open save or saveLayer.
+  struct Scope {
+    // The index of the save or saveLayer record.
+    size_t start;
+    bool is_layer = false;
+    bool has_draws = false;
+    // Whether everything drawn in the scope is drawn with srcOver.
+    bool contents_src_over = true;
+
+    // For layers only.
+    bool has_bounds = false;
+    SkRect bounds = SkRect::MakeEmpty();
+    // Replays the attributes that the bounds of draws depend on as they were
+    // when the layer was saved. Only set for layers with bounds that may be
+    // collapsed.
+    std::function<void(Dispatcher&)> replay_bounds_attributes;
+    // Whether the layer is composited with srcOver.
+    bool composites_src_over = true;
+    // Whether the layer is composited with srcOver and without any change
+    // to its contents.
+    bool composites_unmodified = true;
+  };
+
+  DisplayListOptimizationStats* stats_;
+  OptimizedDisplayLists* optimized_;
+
+  std::vector<Record> records_;
+  std::vector<Scope> scopes_;
+
+  // Set while the last record is an aliased opaque rect that may be merged
+  // with the next one.
+  bool last_draw_is_mergeable_rect_ = false;
+  SkRect last_rect_;
+
+  // The current attributes, starting from the defaults of SkPaint.
+  bool aa_ = false;
+  bool dither_ = false;
+  bool invert_colors_ = false;
+  SkPaint::Style style_ = SkPaint::kFill_Style;
+  SkColor color_ = SK_ColorBLACK;
+  SkScalar stroke_width_ = 0;
+  SkScalar stroke_miter_ = 4;
+  SkPaint::Cap stroke_cap_ = SkPaint::kButt_Cap;
+  SkPaint::Join stroke_join_ = SkPaint::kMiter_Join;
+  SkBlendMode blend_mode_ = SkBlendMode::kSrcOver;
+  sk_sp<SkBlender> blender_;
+  sk_sp<SkShader> shader_;
+  sk_sp<SkColorFilter> color_filter_;
+  sk_sp<SkPathEffect> path_effect_;
+  sk_sp<SkImageFilter> image_filter_;
+  sk_sp<SkMaskFilter> mask_filter_;
+  bool mask_is_blur_ = false;
+  SkBlurStyle mask_blur_style_ = kNormal_SkBlurStyle;
+  SkScalar mask_blur_sigma_ = 0;
+
+  std::function<void(Dispatcher&)> BoundsAttributesReplay() const {
+    return [style = style_, stroke_width = stroke_width_,
+            stroke_miter = stroke_miter_, stroke_cap = stroke_cap_,
+            stroke_join = stroke_join_, path_effect = path_effect_,
+            mask_filter = mask_filter_, mask_is_blur = mask_is_blur_,
+            mask_blur_style = mask_blur_style_,
+            mask_blur_sigma = mask_blur_sigma_,
+            image_filter = image_filter_](Dispatcher& d) {
+      d.setStyle(style);
+      d.setStrokeWidth(stroke_width);
+      d.setStrokeMiter(stroke_miter);
+      d.setStrokeCap(stroke_cap);
+      d.setStrokeJoin(stroke_join);
+      d.setPathEffect(path_effect);
+      if (mask_is_blur) {
+        d.setMaskBlurFilter(mask_blur_style, mask_blur_sigma);
+      } else {
+        d.setMaskFilter(mask_filter);
+      }
+      d.setImageFilter(image_filter);
+    };
+  }
+
+  // Whether everything drawn in the layer of |scope| lies within the bounds
+  // of the layer, in the coordinates the layer was saved in.
+  bool DrawsWithinBounds(const Scope& scope) const {
+    DisplayListBoundsCalculator calculator;
+    scope.replay_bounds_attributes(calculator);
+    for (size_t i = scope.start + 1; i < records_.size(); i++) {
+      records_[i].replay(calculator);
+    }
+    return !calculator.is_unbounded() &&
+           scope.bounds.contains(calculator.bounds());
+  }
+
+  bool RendersSrcOver() const {
+    return !blender_ && blend_mode_ == SkBlendMode::kSrcOver;
+  }
+
+  bool IsOpaqueFill() const {
+    return style_ == SkPaint::kFill_Style && SkColorGetA(color_) == 0xFF &&
+           !shader_ && !color_filter_ && !invert_colors_ && !path_effect_ &&
+           !image_filter_ && !mask_filter_ && !mask_is_blur_;
+  }
+
+  // Merges |second|, drawn right after |first| with the same opaque paint,
+  // into a single rect covering the same pixels.
+  static bool MergeRects(const SkRect& first,
+                         const SkRect& second,
+                         SkRect* merged) {
+    if (!first.isSorted() || !second.isSorted()) {
+      return false;
+    }
+    if (first.contains(second)) {
+      *merged = first;
+      return true;
+    }
+    if (second.contains(first)) {
+      *merged = second;
+      return true;
+    }
+    bool same_rows = first.top() == second.top() &&
+                     first.bottom() == second.bottom() &&
+                     first.left() <= second.right() &&
+                     second.left() <= first.right();
+    bool same_columns = first.left() == second.left() &&
+                        first.right() == second.right() &&
+                        first.top() <= second.bottom() &&
+                        second.top() <= first.bottom();
+    if (same_rows || same_columns) {
+      *merged = first;
+      merged->join(second);
+      return true;
+    }
+    return false;
+  }
+
+  template <typename T, typename Replay>
+  void SetAttribute(T* current, const T& value, Replay replay) {
+    if (*current == value) {
+      stats_->redundant_attributes++;
+      return;
+    }
+    *current = value;
+    EmitAttribute(std::move(replay));
+  }
+
+  // Changing an attribute ends a run of mergeable rects, as the rects after
+  // it are drawn differently.
+  void EmitAttribute(std::function<void(Dispatcher&)> replay) {
+    records_.push_back({RecordType::kAttribute, std::move(replay)});
+    last_draw_is_mergeable_rect_ = false;
+  }
+
+  void EmitState(std::function<void(Dispatcher&)> replay) {
+    records_.push_back({RecordType::kState, std::move(replay)});
+    last_draw_is_mergeable_rect_ = false;
+  }
+
+  void EmitDraw(bool src_over, std::function<void(Dispatcher&)> replay) {
+    records_.push_back({RecordType::kDraw, std::move(replay)});
+    last_draw_is_mergeable_rect_ = false;
+    if (!scopes_.empty()) {
+      scopes_.back().has_draws = true;
+      scopes_.back().contents_src_over &= src_over;
+    }
+  }
+
+  // Drops the records of a scope without draws, except for the attributes,
+  // which persist after the scope is restored.
+  void DropScope(const Scope& scope) {
+    std::vector<Record> attributes;
+    for (size_t i = scope.start; i < records_.size(); i++) {
+      if (records_[i].type == RecordType::kAttribute) {
+        attributes.push_back(std::move(records_[i]));
+      }
+    }
+    records_.resize(scope.start);
+    for (auto& attribute : attributes) {
+      records_.push_back(std::move(attribute));
+    }
+    last_draw_is_mergeable_rect_ = false;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListOptimizer);
+};
+
+}  // namespace
+
+void DisplayListOptimizationStats::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "DisplayListOptimizer", 0,          //
+                    "OpsBefore", ops_before,                       //
+                    "OpsAfter", ops_after,                         //
+                    "BytesBefore", bytes_before,                   //
+                    "BytesAfter", bytes_after,                     //
+                    "RedundantAttributes", redundant_attributes,   //
+                    "IdentityTransforms", identity_transforms,     //
+                    "EmptySaves", empty_saves,                     //
+                    "CollapsedSaveLayers", collapsed_save_layers,  //
+                    "MergedDraws", merged_draws);
+#endif  // !FLUTTER_RELEASE
+}
+
+sk_sp<DisplayList> OptimizeDisplayList(const sk_sp<DisplayList>& display_list,
+                                       DisplayListOptimizationStats* stats) {
+  TRACE_EVENT0("flutter", "OptimizeDisplayList");
+  FML_DCHECK(display_list);
+  DisplayListOptimizationStats local_stats;
+  if (!stats) {
+    stats = &local_stats;
+  }
+  *stats = {};
+  OptimizedDisplayLists optimized;
+  sk_sp<DisplayList> result =
+      DisplayListOptimizer(stats, &optimized).Optimize(display_list.get());
+  stats->ops_before = display_list->op_count(true);
+  stats->ops_after = result->op_count(true);
+  stats->bytes_before = display_list->bytes(true);
+  stats->bytes_after = result->bytes(true);
+  return result;
+}
+
+}  // namespace flutter
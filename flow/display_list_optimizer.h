@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_OPTIMIZER_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_OPTIMIZER_H_
+
+#include "flutter/flow/display_list.h"
+
+// A pass that rewrites a DisplayList into an equivalent one with fewer
+// records, for display lists that are dispatched many more times than
+// they are built.
+//
+// The pass drops:
+// - attribute records that set an attribute to the value it already has,
+// - transforms that leave the matrix unchanged,
+// - save/restore pairs with no rendering in between, along with the
+//   transforms and clips inside them,
+// - saveLayer/restore pairs whose layer would be composited back with
+//   an opaque, unfiltered srcOver paint and whose contents all render
+//   with srcOver, which are replaced by a plain save/restore. Since the
+//   pass cannot clip to the device pixels covered by the layer bounds,
+//   a layer with bounds is only collapsed if its contents lie within
+//   them,
+// - and aliased opaque rects drawn with the same attributes that contain,
+//   or together form, another such rect, which are merged into one draw.
+//
+// Nested display lists are optimized as well.
+
+namespace flutter {
+
+struct DisplayListOptimizationStats {
+  // The sizes of the display list before and after the pass, including the
+  // nested display lists.
+  int ops_before = 0;
+  int ops_after = 0;
+  size_t bytes_before = 0;
+  size_t bytes_after = 0;
+
+  // The number of records removed by each optimization. Attribute records
+  // are not counted in the op counts of a DisplayList.
+  int redundant_attributes = 0;
+  int identity_transforms = 0;
+  int empty_saves = 0;
+  int collapsed_save_layers = 0;
+  int merged_draws = 0;
+
+  void TraceStatsToTimeline() const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Optimizes the display list.
+///
+/// @param[in]  display_list  The display list to optimize.
+/// @param[out] stats         If not null, receives the effect of the pass.
+///
+/// @return     An equivalent display list. It is a new display list even if
+///             no record could be removed.
+///
+sk_sp<DisplayList> OptimizeDisplayList(
+    const sk_sp<DisplayList>& display_list,
+    DisplayListOptimizationStats* stats = nullptr);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_OPTIMIZER_H_
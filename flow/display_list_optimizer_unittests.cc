@@ -0,0 +1,295 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_optimizer.h"
+
+#include <cstring>
+
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr int kRenderSize = 100;
+
+static void AssertRenderedEqual(const sk_sp<DisplayList>& expected,
+                                const sk_sp<DisplayList>& actual) {
+  sk_sp<SkSurface> expected_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  sk_sp<SkSurface> actual_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  expected->RenderTo(expected_surface->getCanvas());
+  actual->RenderTo(actual_surface->getCanvas());
+
+  SkPixmap expected_pixels, actual_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual_surface->peekPixels(&actual_pixels));
+  ASSERT_EQ(expected_pixels.computeByteSize(),
+            actual_pixels.computeByteSize());
+  ASSERT_EQ(memcmp(expected_pixels.addr(), actual_pixels.addr(),
+                   expected_pixels.computeByteSize()),
+            0);
+}
+
+TEST(DisplayListOptimizer, RemovesRedundantAttributes) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLACK);
+  builder.setAntiAlias(true);
+  builder.drawOval({10, 10, 50, 50});
+  builder.setAntiAlias(true);
+  builder.setBlendMode(SkBlendMode::kSrcOver);
+  builder.drawOval({50, 50, 90, 90});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.redundant_attributes, 3);
+  ASSERT_LT(optimized->bytes(), display_list->bytes());
+  ASSERT_EQ(optimized->op_count(), display_list->op_count());
+
+  DisplayListBuilder expected;
+  expected.setAntiAlias(true);
+  expected.drawOval({10, 10, 50, 50});
+  expected.drawOval({50, 50, 90, 90});
+  ASSERT_TRUE(optimized->Equals(*expected.Build()));
+}
+
+TEST(DisplayListOptimizer, RemovesIdentityTransforms) {
+  DisplayListBuilder builder;
+  builder.translate(0, 0);
+  builder.scale(1, 1);
+  builder.rotate(0);
+  builder.skew(0, 0);
+  builder.drawRect({10, 10, 20, 20});
+  builder.translate(10, 0);
+  builder.drawRect({30, 30, 40, 40});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.identity_transforms, 4);
+  ASSERT_EQ(stats.ops_before, 7);
+  ASSERT_EQ(stats.ops_after, 3);
+  AssertRenderedEqual(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, RemovesSavesWithoutDraws) {
+  DisplayListBuilder builder;
+  builder.save();
+  builder.translate(10, 10);
+  builder.clipRect({0, 0, 10, 10}, SkClipOp::kIntersect, false);
+  builder.setColor(SK_ColorRED);
+  builder.restore();
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.empty_saves, 1);
+
+  // The color set inside of the save is still used after the restore.
+  DisplayListBuilder expected;
+  expected.setColor(SK_ColorRED);
+  expected.drawRect({10, 10, 20, 20});
+  ASSERT_TRUE(optimized->Equals(*expected.Build()));
+}
+
+TEST(DisplayListOptimizer, KeepsSaveLayersWithFilters) {
+  DisplayListBuilder builder;
+  builder.setImageFilter(SkImageFilters::Blur(2, 2, nullptr));
+  builder.saveLayer(nullptr, true);
+  builder.setImageFilter(nullptr);
+  builder.drawRect({10, 10, 50, 50});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.collapsed_save_layers, 0);
+  ASSERT_TRUE(optimized->Equals(*display_list));
+}
+
+TEST(DisplayListOptimizer, KeepsSaveLayersWithNonSrcOverContents) {
+  DisplayListBuilder builder;
+  builder.saveLayer(nullptr, false);
+  builder.setBlendMode(SkBlendMode::kClear);
+  builder.drawRect({10, 10, 50, 50});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.collapsed_save_layers, 0);
+  ASSERT_TRUE(optimized->Equals(*display_list));
+}
+
+TEST(DisplayListOptimizer, CollapsesOpaqueSrcOverSaveLayers) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({0, 0, 100, 100});
+  SkRect bounds = SkRect::MakeLTRB(10, 10, 70, 70);
+  builder.saveLayer(&bounds, false);
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({10, 10, 50, 50});
+  builder.setColor(SkColorSetARGB(0x80, 0, 0xFF, 0));
+  builder.drawRect({30, 30, 70, 70});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.collapsed_save_layers, 1);
+
+  DisplayListBuilder expected;
+  expected.setColor(SK_ColorBLUE);
+  expected.drawRect({0, 0, 100, 100});
+  expected.save();
+  expected.setColor(SK_ColorRED);
+  expected.drawRect({10, 10, 50, 50});
+  expected.setColor(SkColorSetARGB(0x80, 0, 0xFF, 0));
+  expected.drawRect({30, 30, 70, 70});
+  expected.restore();
+  ASSERT_TRUE(optimized->Equals(*expected.Build()));
+  AssertRenderedEqual(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, KeepsSaveLayersThatClipTheirContents) {
+  DisplayListBuilder builder;
+  SkRect bounds = SkRect::MakeLTRB(20, 20, 60, 60);
+  builder.saveLayer(&bounds, false);
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({10, 10, 50, 50});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.collapsed_save_layers, 0);
+  ASSERT_TRUE(optimized->Equals(*display_list));
+}
+
+TEST(DisplayListOptimizer, PreservesEdgePixelsOfFractionalSaveLayerBounds) {
+  // The layer keeps the pixels its fractional bounds partially cover, which
+  // an aliased clip to the same bounds would drop.
+  DisplayListBuilder builder;
+  builder.translate(0.3, 0.3);
+  builder.scale(1.5, 1.5);
+  SkRect bounds = SkRect::MakeLTRB(10.25, 10.25, 40.75, 40.75);
+  builder.saveLayer(&bounds, false);
+  builder.setAntiAlias(true);
+  builder.setColor(SK_ColorRED);
+  builder.drawCircle({25, 25}, 20);
+  builder.restore();
+  builder.saveLayer(&bounds, false);
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({15.5, 15.5, 35.5, 35.5});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  // Only the layer whose contents lie within its bounds is collapsed.
+  ASSERT_EQ(stats.collapsed_save_layers, 1);
+  AssertRenderedEqual(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, MergesAdjacentOpaqueRects) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({10, 10, 30, 50});
+  builder.drawRect({30, 10, 60, 50});
+  builder.drawRect({20, 20, 40, 40});
+  // Not merged, as the rects do not have the same height.
+  builder.drawRect({60, 10, 80, 40});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.merged_draws, 2);
+  ASSERT_EQ(optimized->op_count(), 2);
+
+  DisplayListBuilder expected;
+  expected.setColor(SK_ColorRED);
+  expected.drawRect({10, 10, 60, 50});
+  expected.drawRect({60, 10, 80, 40});
+  ASSERT_TRUE(optimized->Equals(*expected.Build()));
+  AssertRenderedEqual(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, DoesNotMergeTranslucentOrAntiAliasedRects) {
+  DisplayListBuilder builder;
+  builder.setColor(SkColorSetARGB(0x80, 0xFF, 0, 0));
+  builder.drawRect({10, 10, 30, 50});
+  builder.drawRect({20, 10, 60, 50});
+  builder.setColor(SK_ColorRED);
+  builder.setAntiAlias(true);
+  builder.drawRect({10, 60, 30.5, 90});
+  builder.drawRect({30.5, 60, 60, 90});
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_EQ(stats.merged_draws, 0);
+  ASSERT_TRUE(optimized->Equals(*display_list));
+}
+
+TEST(DisplayListOptimizer, OptimizesNestedDisplayLists) {
+  DisplayListBuilder nested_builder;
+  nested_builder.translate(0, 0);
+  nested_builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> nested = nested_builder.Build();
+
+  DisplayListBuilder builder;
+  builder.drawDisplayList(nested);
+  builder.translate(20, 20);
+  builder.drawDisplayList(nested);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  // The nested display list is only optimized once.
+  ASSERT_EQ(stats.identity_transforms, 1);
+  ASSERT_EQ(stats.ops_before, 5);
+  ASSERT_EQ(stats.ops_after, 3);
+  AssertRenderedEqual(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, PreservesRendering) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorYELLOW);
+  builder.drawPaint();
+  builder.save();
+  builder.translate(0, 0);
+  builder.restore();
+  builder.setAntiAlias(true);
+  builder.setColor(SK_ColorBLUE);
+  builder.drawCircle({50, 50}, 30);
+  builder.setAntiAlias(false);
+  builder.saveLayer(nullptr, false);
+  builder.setColor(SK_ColorGREEN);
+  builder.drawRect({10, 10, 40, 40});
+  builder.drawRect({10, 40, 40, 70});
+  builder.save();
+  builder.clipRect({0, 0, 50, 50}, SkClipOp::kIntersect, false);
+  builder.restore();
+  builder.restore();
+  builder.setColor(SkColorSetARGB(0x80, 0xFF, 0, 0));
+  builder.saveLayer(nullptr, true);
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({30, 30, 90, 90});
+  builder.restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListOptimizationStats stats;
+  sk_sp<DisplayList> optimized = OptimizeDisplayList(display_list, &stats);
+  ASSERT_LT(stats.ops_after, stats.ops_before);
+  ASSERT_LT(stats.bytes_after, stats.bytes_before);
+  AssertRenderedEqual(display_list, optimized);
+}
+
+}  // namespace testing
+}  // namespace flutter
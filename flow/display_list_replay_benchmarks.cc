@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of replaying frames captured from running applications
+// with the `_flutter.screenshotDisplayList` service extension.
+//
+// Every serialized display list given on the command line, and every one in
+// the directories given, gets a benchmark for the traversal of its op stream
+// by DisplayList::Dispatch() and one for rendering it to a raster surface
+// with DisplayList::RenderTo().
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/display_list_serialization.h"
+#include "flutter/flow/display_list_utils.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace {
+
+struct CapturedFrame {
+  std::string name;
+  sk_sp<DisplayList> display_list;
+};
+
+void PrintUsage() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "display_list_replay_benchmarks [--benchmark_<option>...] "
+               "<file.dl or directory>..."
+            << std::endl;
+}
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+sk_sp<DisplayList> LoadFrame(const fml::Mapping* mapping) {
+  if (!mapping) {
+    return nullptr;
+  }
+  return DeserializeDisplayList(mapping->GetMapping(), mapping->GetSize());
+}
+
+// Loads the frame at the path, or every .dl file in the directory at the path.
+bool LoadFrames(const std::string& path, std::vector<CapturedFrame>* frames) {
+  fml::UniqueFD directory =
+      fml::OpenDirectory(path.c_str(), false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    auto display_list =
+        LoadFrame(fml::FileMapping::CreateReadOnly(path).get());
+    if (!display_list) {
+      std::cerr << "Could not load '" << path << "'." << std::endl;
+      return false;
+    }
+    frames->push_back({path, std::move(display_list)});
+    return true;
+  }
+
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& dir,
+                                 const std::string& file_name) {
+    if (!EndsWith(file_name, ".dl")) {
+      return true;
+    }
+    auto display_list =
+        LoadFrame(fml::FileMapping::CreateReadOnly(dir, file_name).get());
+    if (display_list) {
+      frames->push_back({file_name, std::move(display_list)});
+    } else {
+      std::cerr << "Skipping '" << file_name << "' in '" << path
+                << "', which is not a valid serialized DisplayList."
+                << std::endl;
+    }
+    return true;
+  });
+  return true;
+}
+
+void BM_DisplayListDispatch(benchmark::State& state,
+                            const sk_sp<DisplayList>& display_list) {
+  while (state.KeepRunning()) {
+    DisplayListBoundsCalculator calculator(&display_list->cull_rect());
+    display_list->Dispatch(calculator);
+    benchmark::DoNotOptimize(calculator.bounds());
+  }
+  state.SetItemsProcessed(state.iterations() * display_list->op_count(true));
+}
+
+void BM_DisplayListRenderTo(benchmark::State& state,
+                            const sk_sp<DisplayList>& display_list) {
+  SkIRect size = display_list->bounds().roundOut();
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+      std::max(size.right(), 1), std::max(size.bottom(), 1));
+  if (!surface) {
+    state.SkipWithError("Could not create the raster surface.");
+    return;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  while (state.KeepRunning()) {
+    canvas->clear(SK_ColorTRANSPARENT);
+    display_list->RenderTo(canvas);
+    surface->flushAndSubmit();
+  }
+  state.SetItemsProcessed(state.iterations() * display_list->op_count(true));
+}
+
+int DisplayListReplayBenchmarksMain(int argc, char** argv) {
+  fml::CommandLine command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  if (command_line.HasOption("help") ||
+      command_line.positional_args().empty()) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<CapturedFrame> frames;
+  for (const auto& path : command_line.positional_args()) {
+    if (!LoadFrames(path, &frames)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (const auto& frame : frames) {
+    benchmark::RegisterBenchmark(
+        ("BM_DisplayListDispatch/" + frame.name).c_str(),
+        BM_DisplayListDispatch, frame.display_list);
+    benchmark::RegisterBenchmark(
+        ("BM_DisplayListRenderTo/" + frame.name).c_str(),
+        BM_DisplayListRenderTo, frame.display_list)
+        ->Unit(benchmark::kMicrosecond);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  return flutter::DisplayListReplayBenchmarksMain(argc, argv);
+}
@@ -0,0 +1,1430 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_serialization.h"
+
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+namespace {
+
+// "FDLS" in little endian.
+constexpr uint32_t kMagic = 0x534C4446;
+
+// Must be incremented whenever the layout of any record changes, including
+// when records are added to or removed from |SerializedOp|.
+constexpr uint32_t kVersion = 1;
+
+// The index written in place of a null object.
+constexpr uint32_t kNullIndex = 0xFFFFFFFF;
+
+// Bounds the recursion of the reader on malformed data.
+constexpr int kMaxNestingDepth = 64;
+
+// One record for every method of the Dispatcher, plus a record marking the
+// end of a display list.
+enum class SerializedOp : uint8_t {
+  kEnd,
+
+  kSetAntiAlias,
+  kSetDither,
+  kSetStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetShader,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetBlender,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetMaskBlurFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawImageLattice,
+  kDrawAtlas,
+  kDrawPicture,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+
+  kLastOp = kDrawShadow,
+};
+
+// Records the calls made on it by DisplayList::Dispatch().
+class DisplayListWriter final : public virtual Dispatcher {
+ public:
+  explicit DisplayListWriter(const SkSerialProcs& procs) : procs_(procs) {}
+
+  sk_sp<SkData> Serialize(const sk_sp<DisplayList>& display_list) {
+    Write(kMagic);
+    Write(kVersion);
+    WriteDisplayList(display_list.get());
+    if (failed_) {
+      return nullptr;
+    }
+    return stream_.detachAsData();
+  }
+
+  void setAntiAlias(bool aa) override {
+    WriteOp(SerializedOp::kSetAntiAlias);
+    WriteBool(aa);
+  }
+  void setDither(bool dither) override {
+    WriteOp(SerializedOp::kSetDither);
+    WriteBool(dither);
+  }
+  void setStyle(SkPaint::Style style) override {
+    WriteOp(SerializedOp::kSetStyle);
+    WriteEnum(style);
+  }
+  void setColor(SkColor color) override {
+    WriteOp(SerializedOp::kSetColor);
+    Write(color);
+  }
+  void setStrokeWidth(SkScalar width) override {
+    WriteOp(SerializedOp::kSetStrokeWidth);
+    Write(width);
+  }
+  void setStrokeMiter(SkScalar limit) override {
+    WriteOp(SerializedOp::kSetStrokeMiter);
+    Write(limit);
+  }
+  void setStrokeCap(SkPaint::Cap cap) override {
+    WriteOp(SerializedOp::kSetStrokeCap);
+    WriteEnum(cap);
+  }
+  void setStrokeJoin(SkPaint::Join join) override {
+    WriteOp(SerializedOp::kSetStrokeJoin);
+    WriteEnum(join);
+  }
+  void setShader(sk_sp<SkShader> shader) override {
+    WriteOp(SerializedOp::kSetShader);
+    WriteFlattenable(shader.get());
+  }
+  void setColorFilter(sk_sp<SkColorFilter> filter) override {
+    WriteOp(SerializedOp::kSetColorFilter);
+    WriteFlattenable(filter.get());
+  }
+  void setInvertColors(bool invert) override {
+    WriteOp(SerializedOp::kSetInvertColors);
+    WriteBool(invert);
+  }
+  void setBlendMode(SkBlendMode mode) override {
+    WriteOp(SerializedOp::kSetBlendMode);
+    WriteEnum(mode);
+  }
+  void setBlender(sk_sp<SkBlender> blender) override {
+    WriteOp(SerializedOp::kSetBlender);
+    WriteFlattenable(blender.get());
+  }
+  void setPathEffect(sk_sp<SkPathEffect> effect) override {
+    WriteOp(SerializedOp::kSetPathEffect);
+    WriteFlattenable(effect.get());
+  }
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override {
+    WriteOp(SerializedOp::kSetMaskFilter);
+    WriteFlattenable(filter.get());
+  }
+  void setMaskBlurFilter(SkBlurStyle style, SkScalar sigma) override {
+    WriteOp(SerializedOp::kSetMaskBlurFilter);
+    WriteEnum(style);
+    Write(sigma);
+  }
+  void setImageFilter(sk_sp<SkImageFilter> filter) override {
+    WriteOp(SerializedOp::kSetImageFilter);
+    WriteFlattenable(filter.get());
+  }
+
+  void save() override { WriteOp(SerializedOp::kSave); }
+  void saveLayer(const SkRect* bounds, bool restore_with_paint) override {
+    WriteOp(SerializedOp::kSaveLayer);
+    WriteOptional(bounds);
+    WriteBool(restore_with_paint);
+  }
+  void restore() override { WriteOp(SerializedOp::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    WriteOp(SerializedOp::kTranslate);
+    Write(tx);
+    Write(ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    WriteOp(SerializedOp::kScale);
+    Write(sx);
+    Write(sy);
+  }
+  void rotate(SkScalar degrees) override {
+    WriteOp(SerializedOp::kRotate);
+    Write(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    WriteOp(SerializedOp::kSkew);
+    Write(sx);
+    Write(sy);
+  }
+
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    WriteOp(SerializedOp::kTransform2DAffine);
+    const SkScalar values[] = {mxx, mxy, mxt,
+                               myx, myy, myt};
+    Write(values);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    WriteOp(SerializedOp::kTransformFullPerspective);
+    const SkScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    Write(values);
+  }
+  // clang-format on
+
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipRect);
+    Write(rect);
+    WriteEnum(clip_op);
+    WriteBool(is_aa);
+  }
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipRRect);
+    WriteRRect(rrect);
+    WriteEnum(clip_op);
+    WriteBool(is_aa);
+  }
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipPath);
+    WritePath(path);
+    WriteEnum(clip_op);
+    WriteBool(is_aa);
+  }
+
+  void drawColor(SkColor color, SkBlendMode mode) override {
+    WriteOp(SerializedOp::kDrawColor);
+    Write(color);
+    WriteEnum(mode);
+  }
+  void drawPaint() override { WriteOp(SerializedOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    WriteOp(SerializedOp::kDrawLine);
+    Write(p0);
+    Write(p1);
+  }
+  void drawRect(const SkRect& rect) override {
+    WriteOp(SerializedOp::kDrawRect);
+    Write(rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    WriteOp(SerializedOp::kDrawOval);
+    Write(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    WriteOp(SerializedOp::kDrawCircle);
+    Write(center);
+    Write(radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    WriteOp(SerializedOp::kDrawRRect);
+    WriteRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    WriteOp(SerializedOp::kDrawDRRect);
+    WriteRRect(outer);
+    WriteRRect(inner);
+  }
+  void drawPath(const SkPath& path) override {
+    WriteOp(SerializedOp::kDrawPath);
+    WritePath(path);
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    WriteOp(SerializedOp::kDrawArc);
+    Write(oval_bounds);
+    Write(start_degrees);
+    Write(sweep_degrees);
+    WriteBool(use_center);
+  }
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    WriteOp(SerializedOp::kDrawPoints);
+    WriteEnum(mode);
+    Write(count);
+    WriteArray(points, count);
+  }
+  void drawVertices(const sk_sp<SkVertices> vertices,
+                    SkBlendMode mode) override {
+    // Skia does not expose a way to serialize SkVertices.
+    FML_LOG(ERROR) << "DisplayList serialization does not support vertices.";
+    failed_ = true;
+  }
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawImage);
+    WriteImage(image.get());
+    Write(point);
+    WriteSampling(sampling);
+    WriteBool(render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    WriteOp(SerializedOp::kDrawImageRect);
+    WriteImage(image.get());
+    Write(src);
+    Write(dst);
+    WriteSampling(sampling);
+    WriteBool(render_with_attributes);
+    WriteEnum(constraint);
+  }
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawImageNine);
+    WriteImage(image.get());
+    Write(center);
+    Write(dst);
+    WriteEnum(filter);
+    WriteBool(render_with_attributes);
+  }
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawImageLattice);
+    WriteImage(image.get());
+    Write(lattice.fXCount);
+    WriteArray(lattice.fXDivs, lattice.fXCount);
+    Write(lattice.fYCount);
+    WriteArray(lattice.fYDivs, lattice.fYCount);
+    int cell_count = (lattice.fXCount + 1) * (lattice.fYCount + 1);
+    WriteBool(lattice.fRectTypes != nullptr);
+    if (lattice.fRectTypes) {
+      for (int i = 0; i < cell_count; i++) {
+        WriteEnum(lattice.fRectTypes[i]);
+      }
+    }
+    WriteBool(lattice.fColors != nullptr);
+    if (lattice.fColors) {
+      WriteArray(lattice.fColors, cell_count);
+    }
+    WriteOptional(lattice.fBounds);
+    Write(dst);
+    WriteEnum(filter);
+    WriteBool(render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawAtlas);
+    WriteImage(atlas.get());
+    Write(count);
+    WriteArray(xform, count);
+    WriteArray(tex, count);
+    WriteBool(colors != nullptr);
+    if (colors) {
+      WriteArray(colors, count);
+    }
+    WriteEnum(mode);
+    WriteSampling(sampling);
+    WriteOptional(cull_rect);
+    WriteBool(render_with_attributes);
+  }
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawPicture);
+    if (BeginObject(&pictures_, picture.get())) {
+      WriteData(picture->serialize(&procs_));
+    }
+    WriteBool(matrix != nullptr);
+    if (matrix) {
+      SkScalar values[9];
+      matrix->get9(values);
+      Write(values);
+    }
+    WriteBool(render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    WriteOp(SerializedOp::kDrawDisplayList);
+    WriteDisplayList(display_list.get());
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    WriteOp(SerializedOp::kDrawTextBlob);
+    if (BeginObject(&text_blobs_, blob.get())) {
+      WriteData(blob->serialize(procs_));
+    }
+    Write(x);
+    Write(y);
+  }
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    WriteOp(SerializedOp::kDrawShadow);
+    WritePath(path);
+    Write(color);
+    Write(elevation);
+    WriteBool(transparent_occluder);
+    Write(dpr);
+  }
+
+ private:
+  using ObjectIndices = std::unordered_map<const void*, uint32_t>;
+
+  const SkSerialProcs& procs_;
+  SkDynamicMemoryWStream stream_;
+  bool failed_ = false;
+
+  ObjectIndices flattenables_;
+  ObjectIndices images_;
+  ObjectIndices pictures_;
+  ObjectIndices text_blobs_;
+  ObjectIndices display_lists_;
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be written directly.");
+    stream_.write(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, int count) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be written directly.");
+    if (count > 0) {
+      stream_.write(values, sizeof(T) * count);
+    }
+  }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    Write(static_cast<uint32_t>(value));
+  }
+
+  template <typename T>
+  void WriteOptional(const T* value) {
+    WriteBool(value != nullptr);
+    if (value) {
+      Write(*value);
+    }
+  }
+
+  void WriteOp(SerializedOp op) { Write(op); }
+
+  void WriteBool(bool value) { Write(static_cast<uint8_t>(value ? 1 : 0)); }
+
+  void WriteData(const sk_sp<SkData>& data) {
+    if (!data) {
+      failed_ = true;
+      return;
+    }
+    Write(static_cast<uint32_t>(data->size()));
+    stream_.write(data->data(), data->size());
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t buffer[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(buffer);
+    Write(buffer);
+  }
+
+  void WritePath(const SkPath& path) {
+    size_t size = path.writeToMemory(nullptr);
+    std::vector<uint8_t> buffer(size);
+    path.writeToMemory(buffer.data());
+    Write(static_cast<uint32_t>(size));
+    stream_.write(buffer.data(), size);
+  }
+
+  void WriteSampling(const SkSamplingOptions& sampling) {
+    WriteBool(sampling.useCubic);
+    Write(sampling.cubic.B);
+    Write(sampling.cubic.C);
+    WriteEnum(sampling.filter);
+    WriteEnum(sampling.mipmap);
+  }
+
+  // Writes the index of the object. Returns true if the object has not been
+  // written before, in which case the caller must write it out in full.
+  bool BeginObject(ObjectIndices* indices, const void* object) {
+    if (!object) {
+      Write(kNullIndex);
+      return false;
+    }
+    auto found = indices->find(object);
+    if (found != indices->end()) {
+      Write(found->second);
+      return false;
+    }
+    uint32_t index = indices->size();
+    indices->emplace(object, index);
+    Write(index);
+    return true;
+  }
+
+  void WriteFlattenable(SkFlattenable* flattenable) {
+    if (BeginObject(&flattenables_, flattenable)) {
+      WriteEnum(flattenable->getFlattenableType());
+      WriteData(flattenable->serialize(&procs_));
+    }
+  }
+
+  void WriteImage(SkImage* image) {
+    if (!BeginObject(&images_, image)) {
+      return;
+    }
+    sk_sp<SkData> data;
+    if (procs_.fImageProc) {
+      data = procs_.fImageProc(image, procs_.fImageCtx);
+    }
+    if (!data) {
+      data = image->refEncodedData();
+    }
+    if (!data) {
+      // Reads texture backed images back from the GPU.
+      sk_sp<SkImage> raster_image = image->makeNonTextureImage();
+      if (raster_image) {
+        data = raster_image->encodeToData();
+      }
+    }
+    WriteData(data);
+  }
+
+  void WriteDisplayList(DisplayList* display_list) {
+    if (!BeginObject(&display_lists_, display_list)) {
+      return;
+    }
+    Write(display_list->cull_rect());
+    display_list->Dispatch(*this);
+    WriteOp(SerializedOp::kEnd);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListWriter);
+};
+
+// Replays the records written by DisplayListWriter into a Dispatcher.
+// Every read is bounds checked, as the data may come from anywhere.
+class DisplayListReader {
+ public:
+  DisplayListReader(const void* data,
+                    size_t length,
+                    const SkDeserialProcs& procs)
+      : ptr_(static_cast<const uint8_t*>(data)),
+        end_(ptr_ + length),
+        procs_(procs) {}
+
+  sk_sp<DisplayList> Deserialize() {
+    uint32_t magic, version;
+    if (!Read(&magic) || magic != kMagic) {
+      FML_LOG(ERROR) << "Data is not a serialized DisplayList.";
+      return nullptr;
+    }
+    if (!Read(&version) || version != kVersion) {
+      FML_LOG(ERROR) << "Unsupported DisplayList serialization version "
+                     << version << ", expected " << kVersion << ".";
+      return nullptr;
+    }
+    sk_sp<DisplayList> display_list;
+    if (!ReadDisplayList(&display_list, 0) || !display_list || ptr_ != end_) {
+      FML_LOG(ERROR) << "Malformed serialized DisplayList.";
+      return nullptr;
+    }
+    return display_list;
+  }
+
+ private:
+  struct Flattenable {
+    SkFlattenable::Type type;
+    sk_sp<SkFlattenable> object;
+  };
+
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+  const SkDeserialProcs& procs_;
+
+  std::vector<Flattenable> flattenables_;
+  std::vector<sk_sp<SkImage>> images_;
+  std::vector<sk_sp<SkPicture>> pictures_;
+  std::vector<sk_sp<SkTextBlob>> text_blobs_;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be read directly.");
+    if (static_cast<size_t>(end_ - ptr_) < sizeof(T)) {
+      return false;
+    }
+    memcpy(value, ptr_, sizeof(T));
+    ptr_ += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>* values, int count) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be read directly.");
+    if (count < 0 ||
+        static_cast<size_t>(end_ - ptr_) / sizeof(T) <
+            static_cast<size_t>(count)) {
+      return false;
+    }
+    values->resize(count);
+    if (count > 0) {
+      memcpy(values->data(), ptr_, sizeof(T) * count);
+      ptr_ += sizeof(T) * count;
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool ReadEnum(T* value, T last) {
+    uint32_t raw;
+    if (!Read(&raw) || raw > static_cast<uint32_t>(last)) {
+      return false;
+    }
+    *value = static_cast<T>(raw);
+    return true;
+  }
+
+  bool ReadBool(bool* value) {
+    uint8_t raw;
+    if (!Read(&raw) || raw > 1) {
+      return false;
+    }
+    *value = raw == 1;
+    return true;
+  }
+
+  template <typename T>
+  bool ReadOptional(T* storage, const T** value) {
+    bool present;
+    if (!ReadBool(&present)) {
+      return false;
+    }
+    if (!present) {
+      *value = nullptr;
+      return true;
+    }
+    *value = storage;
+    return Read(storage);
+  }
+
+  // Points |data| at the next length prefixed blob of bytes.
+  bool ReadData(const void** data, size_t* length) {
+    uint32_t size;
+    if (!Read(&size) || static_cast<size_t>(end_ - ptr_) < size) {
+      return false;
+    }
+    *data = ptr_;
+    *length = size;
+    ptr_ += size;
+    return true;
+  }
+
+  bool ReadRRect(SkRRect* rrect) {
+    if (static_cast<size_t>(end_ - ptr_) < SkRRect::kSizeInMemory) {
+      return false;
+    }
+    size_t read = rrect->readFromMemory(ptr_, SkRRect::kSizeInMemory);
+    ptr_ += SkRRect::kSizeInMemory;
+    return read == SkRRect::kSizeInMemory;
+  }
+
+  bool ReadPath(SkPath* path) {
+    const void* data;
+    size_t length;
+    return ReadData(&data, &length) &&
+           path->readFromMemory(data, length) == length;
+  }
+
+  // SkSamplingOptions cannot be assigned to, so it is read into an optional.
+  bool ReadSampling(std::optional<SkSamplingOptions>* sampling) {
+    bool use_cubic;
+    SkCubicResampler cubic;
+    SkFilterMode filter;
+    SkMipmapMode mipmap;
+    if (!ReadBool(&use_cubic) || !Read(&cubic.B) || !Read(&cubic.C) ||
+        !ReadEnum(&filter, SkFilterMode::kLast) ||
+        !ReadEnum(&mipmap, SkMipmapMode::kLast)) {
+      return false;
+    }
+    if (use_cubic) {
+      sampling->emplace(cubic);
+    } else {
+      sampling->emplace(filter, mipmap);
+    }
+    return true;
+  }
+
+  // Reads an object written by DisplayListWriter::BeginObject, calling
+  // |read_object| to read it if it is written out in full. Null objects are
+  // only accepted if |nullable| is true.
+  //
+  // The writer numbers an object before writing it out, so the objects it
+  // references are numbered after it. The slot of the object is reserved
+  // before |read_object| runs to match. The slot stays empty until the
+  // object has been read, so a reference to an object from within itself
+  // reads as null.
+  template <typename T, typename ReadObject>
+  bool ReadObjectIndex(std::vector<T>* objects,
+                       bool nullable,
+                       T* object,
+                       ReadObject read_object) {
+    uint32_t index;
+    if (!Read(&index)) {
+      return false;
+    }
+    if (index == kNullIndex) {
+      *object = T();
+      return nullable;
+    }
+    if (index < objects->size()) {
+      *object = (*objects)[index];
+      return true;
+    }
+    if (index != objects->size()) {
+      return false;
+    }
+    objects->emplace_back();
+    if (!read_object(object)) {
+      return false;
+    }
+    (*objects)[index] = *object;
+    return true;
+  }
+
+  template <typename T>
+  bool ReadFlattenable(SkFlattenable::Type type, sk_sp<T>* value) {
+    Flattenable flattenable;
+    bool result = ReadObjectIndex(
+        &flattenables_, true, &flattenable, [this, type](Flattenable* result) {
+          uint32_t raw_type;
+          const void* data;
+          size_t length;
+          if (!Read(&raw_type) || raw_type != static_cast<uint32_t>(type) ||
+              !ReadData(&data, &length)) {
+            return false;
+          }
+          result->type = type;
+          result->object =
+              SkFlattenable::Deserialize(type, data, length, &procs_);
+          return result->object != nullptr;
+        });
+    if (!result) {
+      return false;
+    }
+    if (!flattenable.object) {
+      *value = nullptr;
+      return true;
+    }
+    // A shared object is always used in the same role.
+    if (flattenable.type != type) {
+      return false;
+    }
+    *value = sk_sp<T>(static_cast<T*>(flattenable.object.release()));
+    return true;
+  }
+
+  bool ReadImage(sk_sp<SkImage>* image) {
+    return ReadObjectIndex(&images_, false, image,
+                           [this](sk_sp<SkImage>* result) {
+                             const void* data;
+                             size_t length;
+                             if (!ReadData(&data, &length)) {
+                               return false;
+                             }
+                             if (procs_.fImageProc) {
+                               *result = procs_.fImageProc(data, length,
+                                                           procs_.fImageCtx);
+                             }
+                             if (!*result) {
+                               *result = SkImage::MakeFromEncoded(
+                                   SkData::MakeWithCopy(data, length));
+                             }
+                             return *result != nullptr;
+                           });
+  }
+
+  bool ReadPicture(sk_sp<SkPicture>* picture) {
+    return ReadObjectIndex(
+        &pictures_, false, picture, [this](sk_sp<SkPicture>* result) {
+          const void* data;
+          size_t length;
+          if (!ReadData(&data, &length)) {
+            return false;
+          }
+          *result = SkPicture::MakeFromData(data, length, &procs_);
+          return *result != nullptr;
+        });
+  }
+
+  bool ReadTextBlob(sk_sp<SkTextBlob>* blob) {
+    return ReadObjectIndex(
+        &text_blobs_, false, blob, [this](sk_sp<SkTextBlob>* result) {
+          const void* data;
+          size_t length;
+          if (!ReadData(&data, &length)) {
+            return false;
+          }
+          *result = SkTextBlob::Deserialize(data, length, procs_);
+          return *result != nullptr;
+        });
+  }
+
+  bool ReadDisplayList(sk_sp<DisplayList>* display_list, int depth) {
+    bool result = ReadObjectIndex(
+        &display_lists_, false, display_list,
+        [this, depth](sk_sp<DisplayList>* result) {
+          SkRect cull_rect;
+          if (depth > kMaxNestingDepth || !Read(&cull_rect)) {
+            return false;
+          }
+          DisplayListBuilder builder(cull_rect);
+          if (!ReadOps(builder, depth)) {
+            return false;
+          }
+          *result = builder.Build();
+          return true;
+        });
+    // A display list that draws itself, which the writer never produces,
+    // reads as null.
+    return result && *display_list != nullptr;
+  }
+
+  bool ReadOps(Dispatcher& dispatcher, int depth) {
+    while (true) {
+      uint8_t raw_op;
+      if (!Read(&raw_op) ||
+          raw_op > static_cast<uint8_t>(SerializedOp::kLastOp)) {
+        return false;
+      }
+      if (!ReadOp(dispatcher, static_cast<SerializedOp>(raw_op), depth)) {
+        return false;
+      }
+      if (raw_op == static_cast<uint8_t>(SerializedOp::kEnd)) {
+        return true;
+      }
+    }
+  }
+
+  bool ReadOp(Dispatcher& dispatcher, SerializedOp op, int depth) {
+    switch (op) {
+      case SerializedOp::kEnd:
+        return true;
+
+      case SerializedOp::kSetAntiAlias: {
+        bool aa;
+        if (!ReadBool(&aa)) {
+          return false;
+        }
+        dispatcher.setAntiAlias(aa);
+        return true;
+      }
+      case SerializedOp::kSetDither: {
+        bool dither;
+        if (!ReadBool(&dither)) {
+          return false;
+        }
+        dispatcher.setDither(dither);
+        return true;
+      }
+      case SerializedOp::kSetStyle: {
+        SkPaint::Style style;
+        if (!ReadEnum(&style, SkPaint::kStrokeAndFill_Style)) {
+          return false;
+        }
+        dispatcher.setStyle(style);
+        return true;
+      }
+      case SerializedOp::kSetColor: {
+        SkColor color;
+        if (!Read(&color)) {
+          return false;
+        }
+        dispatcher.setColor(color);
+        return true;
+      }
+      case SerializedOp::kSetStrokeWidth: {
+        SkScalar width;
+        if (!Read(&width)) {
+          return false;
+        }
+        dispatcher.setStrokeWidth(width);
+        return true;
+      }
+      case SerializedOp::kSetStrokeMiter: {
+        SkScalar limit;
+        if (!Read(&limit)) {
+          return false;
+        }
+        dispatcher.setStrokeMiter(limit);
+        return true;
+      }
+      case SerializedOp::kSetStrokeCap: {
+        SkPaint::Cap cap;
+        if (!ReadEnum(&cap, SkPaint::kLast_Cap)) {
+          return false;
+        }
+        dispatcher.setStrokeCap(cap);
+        return true;
+      }
+      case SerializedOp::kSetStrokeJoin: {
+        SkPaint::Join join;
+        if (!ReadEnum(&join, SkPaint::kLast_Join)) {
+          return false;
+        }
+        dispatcher.setStrokeJoin(join);
+        return true;
+      }
+      case SerializedOp::kSetShader: {
+        sk_sp<SkShader> shader;
+        if (!ReadFlattenable(SkFlattenable::kSkShaderBase_Type, &shader)) {
+          return false;
+        }
+        dispatcher.setShader(std::move(shader));
+        return true;
+      }
+      case SerializedOp::kSetColorFilter: {
+        sk_sp<SkColorFilter> filter;
+        if (!ReadFlattenable(SkFlattenable::kSkColorFilter_Type, &filter)) {
+          return false;
+        }
+        dispatcher.setColorFilter(std::move(filter));
+        return true;
+      }
+      case SerializedOp::kSetInvertColors: {
+        bool invert;
+        if (!ReadBool(&invert)) {
+          return false;
+        }
+        dispatcher.setInvertColors(invert);
+        return true;
+      }
+      case SerializedOp::kSetBlendMode: {
+        SkBlendMode mode;
+        if (!ReadEnum(&mode, SkBlendMode::kLastMode)) {
+          return false;
+        }
+        dispatcher.setBlendMode(mode);
+        return true;
+      }
+      case SerializedOp::kSetBlender: {
+        sk_sp<SkBlender> blender;
+        if (!ReadFlattenable(SkFlattenable::kSkBlender_Type, &blender)) {
+          return false;
+        }
+        dispatcher.setBlender(std::move(blender));
+        return true;
+      }
+      case SerializedOp::kSetPathEffect: {
+        sk_sp<SkPathEffect> effect;
+        if (!ReadFlattenable(SkFlattenable::kSkPathEffect_Type, &effect)) {
+          return false;
+        }
+        dispatcher.setPathEffect(std::move(effect));
+        return true;
+      }
+      case SerializedOp::kSetMaskFilter: {
+        sk_sp<SkMaskFilter> filter;
+        if (!ReadFlattenable(SkFlattenable::kSkMaskFilter_Type, &filter)) {
+          return false;
+        }
+        dispatcher.setMaskFilter(std::move(filter));
+        return true;
+      }
+      case SerializedOp::kSetMaskBlurFilter: {
+        SkBlurStyle style;
+        SkScalar sigma;
+        if (!ReadEnum(&style, kLastEnum_SkBlurStyle) || !Read(&sigma)) {
+          return false;
+        }
+        dispatcher.setMaskBlurFilter(style, sigma);
+        return true;
+      }
+      case SerializedOp::kSetImageFilter: {
+        sk_sp<SkImageFilter> filter;
+        if (!ReadFlattenable(SkFlattenable::kSkImageFilter_Type, &filter)) {
+          return false;
+        }
+        dispatcher.setImageFilter(std::move(filter));
+        return true;
+      }
+
+      case SerializedOp::kSave:
+        dispatcher.save();
+        return true;
+      case SerializedOp::kSaveLayer: {
+        SkRect storage;
+        const SkRect* bounds;
+        bool restore_with_paint;
+        if (!ReadOptional(&storage, &bounds) ||
+            !ReadBool(&restore_with_paint)) {
+          return false;
+        }
+        dispatcher.saveLayer(bounds, restore_with_paint);
+        return true;
+      }
+      case SerializedOp::kRestore:
+        dispatcher.restore();
+        return true;
+
+      case SerializedOp::kTranslate: {
+        SkScalar tx, ty;
+        if (!Read(&tx) || !Read(&ty)) {
+          return false;
+        }
+        dispatcher.translate(tx, ty);
+        return true;
+      }
+      case SerializedOp::kScale: {
+        SkScalar sx, sy;
+        if (!Read(&sx) || !Read(&sy)) {
+          return false;
+        }
+        dispatcher.scale(sx, sy);
+        return true;
+      }
+      case SerializedOp::kRotate: {
+        SkScalar degrees;
+        if (!Read(&degrees)) {
+          return false;
+        }
+        dispatcher.rotate(degrees);
+        return true;
+      }
+      case SerializedOp::kSkew: {
+        SkScalar sx, sy;
+        if (!Read(&sx) || !Read(&sy)) {
+          return false;
+        }
+        dispatcher.skew(sx, sy);
+        return true;
+      }
+      case SerializedOp::kTransform2DAffine: {
+        SkScalar m[6];
+        if (!Read(&m)) {
+          return false;
+        }
+        dispatcher.transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        return true;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        SkScalar m[16];
+        if (!Read(&m)) {
+          return false;
+        }
+        // clang-format off
+        dispatcher.transformFullPerspective(m[0],  m[1],  m[2],  m[3],
+                                            m[4],  m[5],  m[6],  m[7],
+                                            m[8],  m[9],  m[10], m[11],
+                                            m[12], m[13], m[14], m[15]);
+        // clang-format on
+        return true;
+      }
+
+      case SerializedOp::kClipRect: {
+        SkRect rect;
+        SkClipOp clip_op;
+        bool is_aa;
+        if (!Read(&rect) || !ReadEnum(&clip_op, SkClipOp::kMax_EnumValue) ||
+            !ReadBool(&is_aa)) {
+          return false;
+        }
+        dispatcher.clipRect(rect, clip_op, is_aa);
+        return true;
+      }
+      case SerializedOp::kClipRRect: {
+        SkRRect rrect;
+        SkClipOp clip_op;
+        bool is_aa;
+        if (!ReadRRect(&rrect) ||
+            !ReadEnum(&clip_op, SkClipOp::kMax_EnumValue) ||
+            !ReadBool(&is_aa)) {
+          return false;
+        }
+        dispatcher.clipRRect(rrect, clip_op, is_aa);
+        return true;
+      }
+      case SerializedOp::kClipPath: {
+        SkPath path;
+        SkClipOp clip_op;
+        bool is_aa;
+        if (!ReadPath(&path) || !ReadEnum(&clip_op, SkClipOp::kMax_EnumValue) ||
+            !ReadBool(&is_aa)) {
+          return false;
+        }
+        dispatcher.clipPath(path, clip_op, is_aa);
+        return true;
+      }
+
+      case SerializedOp::kDrawColor: {
+        SkColor color;
+        SkBlendMode mode;
+        if (!Read(&color) || !ReadEnum(&mode, SkBlendMode::kLastMode)) {
+          return false;
+        }
+        dispatcher.drawColor(color, mode);
+        return true;
+      }
+      case SerializedOp::kDrawPaint:
+        dispatcher.drawPaint();
+        return true;
+      case SerializedOp::kDrawLine: {
+        SkPoint p0, p1;
+        if (!Read(&p0) || !Read(&p1)) {
+          return false;
+        }
+        dispatcher.drawLine(p0, p1);
+        return true;
+      }
+      case SerializedOp::kDrawRect: {
+        SkRect rect;
+        if (!Read(&rect)) {
+          return false;
+        }
+        dispatcher.drawRect(rect);
+        return true;
+      }
+      case SerializedOp::kDrawOval: {
+        SkRect bounds;
+        if (!Read(&bounds)) {
+          return false;
+        }
+        dispatcher.drawOval(bounds);
+        return true;
+      }
+      case SerializedOp::kDrawCircle: {
+        SkPoint center;
+        SkScalar radius;
+        if (!Read(&center) || !Read(&radius)) {
+          return false;
+        }
+        dispatcher.drawCircle(center, radius);
+        return true;
+      }
+      case SerializedOp::kDrawRRect: {
+        SkRRect rrect;
+        if (!ReadRRect(&rrect)) {
+          return false;
+        }
+        dispatcher.drawRRect(rrect);
+        return true;
+      }
+      case SerializedOp::kDrawDRRect: {
+        SkRRect outer, inner;
+        if (!ReadRRect(&outer) || !ReadRRect(&inner)) {
+          return false;
+        }
+        dispatcher.drawDRRect(outer, inner);
+        return true;
+      }
+      case SerializedOp::kDrawPath: {
+        SkPath path;
+        if (!ReadPath(&path)) {
+          return false;
+        }
+        dispatcher.drawPath(path);
+        return true;
+      }
+      case SerializedOp::kDrawArc: {
+        SkRect bounds;
+        SkScalar start, sweep;
+        bool use_center;
+        if (!Read(&bounds) || !Read(&start) || !Read(&sweep) ||
+            !ReadBool(&use_center)) {
+          return false;
+        }
+        dispatcher.drawArc(bounds, start, sweep, use_center);
+        return true;
+      }
+      case SerializedOp::kDrawPoints: {
+        SkCanvas::PointMode mode;
+        uint32_t count;
+        std::vector<SkPoint> points;
+        if (!ReadEnum(&mode, SkCanvas::kPolygon_PointMode) || !Read(&count) ||
+            count > static_cast<uint32_t>(Dispatcher::kMaxDrawPointsCount) ||
+            !ReadArray(&points, count)) {
+          return false;
+        }
+        dispatcher.drawPoints(mode, count, points.data());
+        return true;
+      }
+      case SerializedOp::kDrawVertices:
+        // Never written.
+        return false;
+      case SerializedOp::kDrawImage: {
+        sk_sp<SkImage> image;
+        SkPoint point;
+        std::optional<SkSamplingOptions> sampling;
+        bool with_attributes;
+        if (!ReadImage(&image) || !Read(&point) || !ReadSampling(&sampling) ||
+            !ReadBool(&with_attributes)) {
+          return false;
+        }
+        dispatcher.drawImage(std::move(image), point, *sampling,
+                             with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawImageRect: {
+        sk_sp<SkImage> image;
+        SkRect src, dst;
+        std::optional<SkSamplingOptions> sampling;
+        bool with_attributes;
+        SkCanvas::SrcRectConstraint constraint;
+        if (!ReadImage(&image) || !Read(&src) || !Read(&dst) ||
+            !ReadSampling(&sampling) || !ReadBool(&with_attributes) ||
+            !ReadEnum(&constraint, SkCanvas::kFast_SrcRectConstraint)) {
+          return false;
+        }
+        dispatcher.drawImageRect(std::move(image), src, dst, *sampling,
+                                 with_attributes, constraint);
+        return true;
+      }
+      case SerializedOp::kDrawImageNine: {
+        sk_sp<SkImage> image;
+        SkIRect center;
+        SkRect dst;
+        SkFilterMode filter;
+        bool with_attributes;
+        if (!ReadImage(&image) || !Read(&center) || !Read(&dst) ||
+            !ReadEnum(&filter, SkFilterMode::kLast) ||
+            !ReadBool(&with_attributes)) {
+          return false;
+        }
+        dispatcher.drawImageNine(std::move(image), center, dst, filter,
+                                 with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawImageLattice: {
+        sk_sp<SkImage> image;
+        int x_count, y_count;
+        std::vector<int> x_divs, y_divs;
+        if (!ReadImage(&image) || !Read(&x_count) ||
+            !ReadArray(&x_divs, x_count) || !Read(&y_count) ||
+            !ReadArray(&y_divs, y_count)) {
+          return false;
+        }
+        size_t cell_count = static_cast<size_t>(x_count + 1) * (y_count + 1);
+        bool has_rect_types, has_colors;
+        std::vector<SkCanvas::Lattice::RectType> rect_types;
+        if (!ReadBool(&has_rect_types)) {
+          return false;
+        }
+        if (has_rect_types) {
+          // Each rect type takes 4 bytes.
+          if (static_cast<size_t>(end_ - ptr_) / 4 < cell_count) {
+            return false;
+          }
+          rect_types.resize(cell_count);
+          for (auto& rect_type : rect_types) {
+            if (!ReadEnum(&rect_type, SkCanvas::Lattice::kFixedColor)) {
+              return false;
+            }
+          }
+        }
+        std::vector<SkColor> colors;
+        if (!ReadBool(&has_colors) ||
+            (has_colors && !ReadArray(&colors, cell_count))) {
+          return false;
+        }
+        SkIRect bounds_storage;
+        SkCanvas::Lattice lattice;
+        SkRect dst;
+        SkFilterMode filter;
+        bool with_attributes;
+        if (!ReadOptional(&bounds_storage, &lattice.fBounds) || !Read(&dst) ||
+            !ReadEnum(&filter, SkFilterMode::kLast) ||
+            !ReadBool(&with_attributes)) {
+          return false;
+        }
+        lattice.fXDivs = x_divs.data();
+        lattice.fYDivs = y_divs.data();
+        lattice.fRectTypes = has_rect_types ? rect_types.data() : nullptr;
+        lattice.fXCount = x_count;
+        lattice.fYCount = y_count;
+        lattice.fColors = has_colors ? colors.data() : nullptr;
+        dispatcher.drawImageLattice(std::move(image), lattice, dst, filter,
+                                    with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawAtlas: {
+        sk_sp<SkImage> atlas;
+        int count;
+        std::vector<SkRSXform> xforms;
+        std::vector<SkRect> tex;
+        std::vector<SkColor> colors;
+        bool has_colors;
+        if (!ReadImage(&atlas) || !Read(&count) || !ReadArray(&xforms, count) ||
+            !ReadArray(&tex, count) || !ReadBool(&has_colors) ||
+            (has_colors && !ReadArray(&colors, count))) {
+          return false;
+        }
+        SkBlendMode mode;
+        std::optional<SkSamplingOptions> sampling;
+        SkRect cull_storage;
+        const SkRect* cull_rect;
+        bool with_attributes;
+        if (!ReadEnum(&mode, SkBlendMode::kLastMode) ||
+            !ReadSampling(&sampling) ||
+            !ReadOptional(&cull_storage, &cull_rect) ||
+            !ReadBool(&with_attributes)) {
+          return false;
+        }
+        dispatcher.drawAtlas(std::move(atlas), xforms.data(), tex.data(),
+                             has_colors ? colors.data() : nullptr, count, mode,
+                             *sampling, cull_rect, with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawPicture: {
+        sk_sp<SkPicture> picture;
+        bool has_matrix, with_attributes;
+        SkMatrix matrix;
+        if (!ReadPicture(&picture) || !ReadBool(&has_matrix)) {
+          return false;
+        }
+        if (has_matrix) {
+          SkScalar values[9];
+          if (!Read(&values)) {
+            return false;
+          }
+          matrix.set9(values);
+        }
+        if (!ReadBool(&with_attributes)) {
+          return false;
+        }
+        dispatcher.drawPicture(std::move(picture),
+                               has_matrix ? &matrix : nullptr,
+                               with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        sk_sp<DisplayList> display_list;
+        if (!ReadDisplayList(&display_list, depth + 1)) {
+          return false;
+        }
+        dispatcher.drawDisplayList(std::move(display_list));
+        return true;
+      }
+      case SerializedOp::kDrawTextBlob: {
+        sk_sp<SkTextBlob> blob;
+        SkScalar x, y;
+        if (!ReadTextBlob(&blob) || !Read(&x) || !Read(&y)) {
+          return false;
+        }
+        dispatcher.drawTextBlob(std::move(blob), x, y);
+        return true;
+      }
+      case SerializedOp::kDrawShadow: {
+        SkPath path;
+        SkColor color;
+        SkScalar elevation, dpr;
+        bool transparent_occluder;
+        if (!ReadPath(&path) || !Read(&color) || !Read(&elevation) ||
+            !ReadBool(&transparent_occluder) || !Read(&dpr)) {
+          return false;
+        }
+        dispatcher.drawShadow(path, color, elevation, transparent_occluder,
+                              dpr);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListReader);
+};
+
+}  // namespace
+
+sk_sp<SkData> SerializeDisplayList(const sk_sp<DisplayList>& display_list,
+                                   const SkSerialProcs& procs) {
+  FML_DCHECK(display_list);
+  DisplayListWriter writer(procs);
+  return writer.Serialize(display_list);
+}
+
+sk_sp<DisplayList> DeserializeDisplayList(const void* data,
+                                          size_t length,
+                                          const SkDeserialProcs& procs) {
+  DisplayListReader reader(data, length, procs);
+  return reader.Deserialize();
+}
+
+}  // namespace flutter
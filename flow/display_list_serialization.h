@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
+
+#include "flutter/flow/display_list.h"
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+
+// A versioned binary format for DisplayList objects, used to capture
+// frames from a running application so that they can be inspected,
+// replayed and benchmarked offline.
+//
+// The format is a stream of records, one for each call made on the
+// Dispatcher by DisplayList::Dispatch(), so reading it back through
+// a DisplayListBuilder reproduces the original list op for op.
+// Objects referenced by the records (images, pictures, text blobs,
+// nested display lists and the Skia shader, filter and effect
+// objects) are written out in full the first time they are used
+// and by index after that.
+//
+// Images are encoded with the |fImageProc| of the SkSerialProcs, or
+// as PNG if there is none. The procs are also used for the objects
+// that Skia serializes itself, such as pictures and text blobs.
+//
+// SkVertices cannot be serialized with the public Skia API, so display
+// lists that draw vertices cannot be serialized.
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes the display list and the objects it references.
+///
+/// @return     The serialized display list, or nullptr if it references an
+///             object that cannot be serialized.
+///
+sk_sp<SkData> SerializeDisplayList(const sk_sp<DisplayList>& display_list,
+                                   const SkSerialProcs& procs = {});
+
+//------------------------------------------------------------------------------
+/// @brief      Recreates a display list from the output of
+///             |SerializeDisplayList|.
+///
+/// @return     The display list, or nullptr if the data is malformed or was
+///             written by an incompatible version of the format.
+///
+sk_sp<DisplayList> DeserializeDisplayList(const void* data,
+                                          size_t length,
+                                          const SkDeserialProcs& procs = {});
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_SERIALIZATION_H_
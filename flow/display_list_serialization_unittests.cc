@@ -0,0 +1,230 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_serialization.h"
+
+#include <cstring>
+
+#include "flutter/flow/display_list_canvas.h"
+
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/include/effects/SkDashPathEffect.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr int kRenderSize = 100;
+
+static sk_sp<SkImage> MakeTestImage(int size, SkColor color) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(size, size);
+  SkPaint paint;
+  paint.setColor(color);
+  surface->getCanvas()->drawCircle(size / 2, size / 2, size / 3, paint);
+  return surface->makeImageSnapshot();
+}
+
+static sk_sp<DisplayList> BuildPrimitives() {
+  DisplayListBuilder builder;
+  builder.setAntiAlias(true);
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({10, 10, 40, 40});
+  builder.save();
+  builder.translate(5, 5);
+  builder.clipRRect(SkRRect::MakeRectXY({0, 0, 80, 80}, 10, 10),
+                    SkClipOp::kIntersect, true);
+  builder.setStyle(SkPaint::kStroke_Style);
+  builder.setStrokeWidth(3);
+  builder.drawPath(SkPath().moveTo(0, 0).cubicTo(20, 80, 60, -20, 80, 80));
+  builder.restore();
+  builder.saveLayer(nullptr, false);
+  builder.transform2DAffine(1, 0.5, 3, 0, 1, 7);
+  SkPoint points[] = {{1, 1}, {20, 30}, {50, 10}};
+  builder.drawPoints(SkCanvas::kPolygon_PointMode, 3, points);
+  builder.restore();
+  builder.drawShadow(SkPath::Circle(50, 50, 20), SK_ColorBLACK, 4, false, 2);
+  return builder.Build();
+}
+
+static sk_sp<DisplayList> BuildWithObjects() {
+  sk_sp<SkImage> image = MakeTestImage(30, SK_ColorRED);
+
+  DisplayListBuilder nested_builder;
+  nested_builder.setColor(SK_ColorGREEN);
+  nested_builder.drawOval({0, 0, 20, 10});
+  sk_sp<DisplayList> nested = nested_builder.Build();
+
+  SkPictureRecorder recorder;
+  recorder.beginRecording({0, 0, 20, 20})->drawColor(SK_ColorYELLOW);
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+  const SkPoint end_points[] = {{0, 0}, {100, 100}};
+  const SkColor colors[] = {SK_ColorMAGENTA, SK_ColorCYAN};
+  const SkScalar dashes[] = {4, 2};
+
+  DisplayListBuilder builder;
+  builder.setShader(SkGradientShader::MakeLinear(end_points, colors, nullptr,
+                                                 2, SkTileMode::kClamp));
+  builder.drawRect({0, 0, 50, 50});
+  builder.setShader(nullptr);
+  builder.setImageFilter(SkImageFilters::Blur(2, 2, nullptr));
+  builder.drawImage(image, {50, 0}, DisplayList::LinearSampling, true);
+  builder.setImageFilter(nullptr);
+  builder.setStyle(SkPaint::kStroke_Style);
+  builder.setPathEffect(SkDashPathEffect::Make(dashes, 2, 0));
+  builder.drawCircle({25, 75}, 20);
+  builder.drawImageRect(image, {0, 0, 30, 30}, {50, 50, 100, 100},
+                        DisplayList::NearestSampling, false);
+  builder.drawDisplayList(nested);
+  builder.translate(60, 10);
+  builder.drawDisplayList(nested);
+  builder.drawPicture(picture, nullptr, false);
+  return builder.Build();
+}
+
+static sk_sp<DisplayList> RoundTrip(const sk_sp<DisplayList>& display_list) {
+  sk_sp<SkData> data = SerializeDisplayList(display_list);
+  if (!data) {
+    return nullptr;
+  }
+  return DeserializeDisplayList(data->data(), data->size());
+}
+
+static void AssertRenderedEqual(const sk_sp<DisplayList>& expected,
+                                const sk_sp<DisplayList>& actual) {
+  sk_sp<SkSurface> expected_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  sk_sp<SkSurface> actual_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  expected->RenderTo(expected_surface->getCanvas());
+  actual->RenderTo(actual_surface->getCanvas());
+
+  SkPixmap expected_pixels, actual_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual_surface->peekPixels(&actual_pixels));
+  ASSERT_EQ(expected_pixels.computeByteSize(),
+            actual_pixels.computeByteSize());
+  ASSERT_EQ(memcmp(expected_pixels.addr(), actual_pixels.addr(),
+                   expected_pixels.computeByteSize()),
+            0);
+}
+
+TEST(DisplayListSerialization, RoundTripReproducesOps) {
+  sk_sp<DisplayList> display_list = BuildPrimitives();
+  sk_sp<DisplayList> copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_EQ(copy->op_count(true), display_list->op_count(true));
+  ASSERT_EQ(copy->bytes(true), display_list->bytes(true));
+  ASSERT_EQ(copy->bounds(), display_list->bounds());
+  ASSERT_EQ(copy->cull_rect(), display_list->cull_rect());
+  ASSERT_TRUE(copy->Equals(*display_list));
+}
+
+TEST(DisplayListSerialization, RoundTripReproducesReferencedObjects) {
+  sk_sp<DisplayList> display_list = BuildWithObjects();
+  sk_sp<DisplayList> copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_EQ(copy->op_count(true), display_list->op_count(true));
+  ASSERT_EQ(copy->bounds(), display_list->bounds());
+  AssertRenderedEqual(display_list, copy);
+}
+
+TEST(DisplayListSerialization, RoundTripReproducesNestedDisplayLists) {
+  DisplayListBuilder inner_builder;
+  inner_builder.setColor(SK_ColorRED);
+  inner_builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> inner = inner_builder.Build();
+
+  DisplayListBuilder middle_builder;
+  middle_builder.drawDisplayList(inner);
+  middle_builder.translate(20, 0);
+  middle_builder.drawDisplayList(inner);
+  sk_sp<DisplayList> middle = middle_builder.Build();
+
+  // Draws both levels, and refers to each of them again after it was written
+  // out within another display list.
+  DisplayListBuilder builder;
+  builder.drawDisplayList(middle);
+  builder.translate(0, 20);
+  builder.drawDisplayList(middle);
+  builder.translate(0, 20);
+  builder.drawDisplayList(inner);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  sk_sp<DisplayList> copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_EQ(copy->op_count(true), display_list->op_count(true));
+  ASSERT_EQ(copy->bounds(), display_list->bounds());
+  AssertRenderedEqual(display_list, copy);
+}
+
+TEST(DisplayListSerialization, SharedObjectsAreWrittenOnce) {
+  sk_sp<SkImage> image = MakeTestImage(50, SK_ColorRED);
+  DisplayListBuilder once_builder;
+  once_builder.drawImage(image, {0, 0}, DisplayList::NearestSampling, false);
+  DisplayListBuilder twice_builder;
+  twice_builder.drawImage(image, {0, 0}, DisplayList::NearestSampling, false);
+  twice_builder.drawImage(image, {50, 0}, DisplayList::NearestSampling, false);
+
+  sk_sp<SkData> once = SerializeDisplayList(once_builder.Build());
+  sk_sp<SkData> twice = SerializeDisplayList(twice_builder.Build());
+  ASSERT_NE(once, nullptr);
+  ASSERT_NE(twice, nullptr);
+  sk_sp<SkData> encoded_image = image->encodeToData();
+  ASSERT_LT(twice->size() - once->size(), encoded_image->size());
+}
+
+TEST(DisplayListSerialization, RejectsMalformedData) {
+  sk_sp<SkData> data = SerializeDisplayList(BuildWithObjects());
+  ASSERT_NE(data, nullptr);
+
+  for (size_t length = 0; length < data->size(); length++) {
+    ASSERT_EQ(DeserializeDisplayList(data->data(), length), nullptr)
+        << "truncated to " << length << " bytes";
+  }
+
+  std::vector<uint8_t> bytes(data->bytes(), data->bytes() + data->size());
+  // The version follows the 4 byte magic number.
+  bytes[4]++;
+  ASSERT_EQ(DeserializeDisplayList(bytes.data(), bytes.size()), nullptr);
+  bytes[4]--;
+  ASSERT_NE(DeserializeDisplayList(bytes.data(), bytes.size()), nullptr);
+  bytes.push_back(0);
+  ASSERT_EQ(DeserializeDisplayList(bytes.data(), bytes.size()), nullptr);
+}
+
+TEST(DisplayListSerialization, VerticesAreNotSupported) {
+  const SkPoint positions[] = {{0, 0}, {10, 0}, {0, 10}};
+  DisplayListBuilder builder;
+  builder.drawVertices(
+      SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, 3, positions,
+                           nullptr, nullptr),
+      SkBlendMode::kSrcOver);
+  ASSERT_EQ(SerializeDisplayList(builder.Build()), nullptr);
+}
+
+TEST(DisplayListSerialization, CapturedCanvasOutputRoundTrips) {
+  DisplayListCanvasRecorder recorder({0, 0, kRenderSize, kRenderSize});
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  recorder.drawRRect(SkRRect::MakeOval({10, 10, 90, 60}), paint);
+  paint.setImageFilter(SkImageFilters::Blur(3, 3, nullptr));
+  recorder.drawImage(MakeTestImage(20, SK_ColorBLUE), 40, 40,
+                     DisplayList::NearestSampling, &paint);
+  sk_sp<DisplayList> display_list = recorder.Build();
+
+  sk_sp<DisplayList> copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  AssertRenderedEqual(display_list, copy);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -1117,5 +1117,107 @@ TEST(DisplayList, NestedOpCountMetricsSameAsSkPicture) {
   ASSERT_EQ(display_list->op_count(true), 36);
 }
 
+TEST(DisplayList, NonOverlappingOpsCanApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({20, 0, 30, 10});
+  builder.drawOval({0, 20, 10, 30});
+  ASSERT_TRUE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OverlappingOpsCannotApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({5, 5, 15, 15});
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, AdjacentAntiAliasedOpsCannotApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.setAntiAlias(true);
+  builder.drawRect({0, 0, 10.5, 10});
+  builder.drawRect({10.5, 0, 20, 10});
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonSrcOverOpsCannotApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.setBlendMode(SkBlendMode::kSrc);
+  builder.drawRect({0, 0, 10, 10});
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OverlappingPointsCannotApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.setStrokeWidth(4);
+  SkPoint points[] = {{10, 10}, {11, 10}, {40, 40}};
+  builder.drawPoints(SkCanvas::kPoints_PointMode, 3, points);
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OverlappingAtlasSpritesCannotApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  SkRSXform xforms[] = {{1, 0, 0, 0}, {1, 0, 5, 5}};
+  SkRect texs[] = {{0, 0, 10, 10}, {0, 0, 10, 10}};
+  builder.drawAtlas(TestImage1, xforms, texs, nullptr, 2,
+                    SkBlendMode::kSrcOver, DisplayList::NearestSampling,
+                    nullptr, false);
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OverlappingGlyphsCannotApplyGroupOpacity) {
+  const SkPoint positions[] = {{10, 10}, {12, 10}};
+  sk_sp<SkTextBlob> blob =
+      SkTextBlob::MakeFromPosText("AB", 2, positions, SkFont());
+  DisplayListBuilder builder;
+  builder.drawTextBlob(blob, 0, 0);
+  ASSERT_FALSE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, SaveLayerCanApplyGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.saveLayer(nullptr, false);
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({5, 5, 15, 15});
+  builder.restore();
+  builder.drawRect({20, 20, 30, 30});
+  ASSERT_TRUE(builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, RenderWithOpacityMatchesSaveLayer) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({10, 10, 40, 40});
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({50, 10, 80, 40});
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(display_list->can_apply_group_opacity());
+
+  sk_sp<SkSurface> expected_surface = SkSurface::MakeRasterN32Premul(100, 50);
+  SkCanvas* expected_canvas = expected_surface->getCanvas();
+  SkPaint alpha_paint;
+  alpha_paint.setAlphaf(0.5f);
+  expected_canvas->saveLayer(nullptr, &alpha_paint);
+  display_list->RenderTo(expected_canvas);
+  expected_canvas->restore();
+
+  sk_sp<SkSurface> actual_surface = SkSurface::MakeRasterN32Premul(100, 50);
+  display_list->RenderTo(actual_surface->getCanvas(), 0.5f);
+
+  SkPixmap expected_pixels, actual_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual_surface->peekPixels(&actual_pixels));
+  for (int y = 0; y < 50; y++) {
+    for (int x = 0; x < 100; x++) {
+      SkColor expected = expected_pixels.getColor(x, y);
+      SkColor actual = actual_pixels.getColor(x, y);
+      // The two paths can round the alpha differently by one step.
+      ASSERT_NEAR(SkColorGetA(expected), SkColorGetA(actual), 1);
+      ASSERT_NEAR(SkColorGetR(expected), SkColorGetR(actual), 1);
+      ASSERT_NEAR(SkColorGetB(expected), SkColorGetB(actual), 1);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -52,7 +52,11 @@ void SkPaintDispatchHelper::setStrokeMiter(SkScalar limit) {
   paint_.setStrokeMiter(limit);
 }
 void SkPaintDispatchHelper::setColor(SkColor color) {
+  current_color_ = color;
   paint_.setColor(color);
+  if (opacity_ < SK_Scalar1) {
+    paint_.setAlphaf(paint_.getAlphaf() * opacity_);
+  }
 }
 void SkPaintDispatchHelper::setBlendMode(SkBlendMode mode) {
   paint_.setBlendMode(mode);
@@ -81,6 +85,37 @@ void SkPaintDispatchHelper::setMaskBlurFilter(SkBlurStyle style,
   paint_.setMaskFilter(SkMaskFilter::MakeBlur(style, sigma));
 }
 
+const SkPaint* SkPaintDispatchHelper::safe_paint(bool use_attributes) {
+  if (use_attributes) {
+    return &paint_;
+  }
+  if (opacity_ < SK_Scalar1) {
+    opacity_paint_.setAlphaf(opacity_);
+    return &opacity_paint_;
+  }
+  return nullptr;
+}
+
+void SkPaintDispatchHelper::save_opacity(bool reset_opacity) {
+  save_stack_.push_back(opacity_);
+  if (reset_opacity) {
+    set_opacity(SK_Scalar1);
+  }
+}
+void SkPaintDispatchHelper::restore_opacity() {
+  if (save_stack_.empty()) {
+    return;
+  }
+  set_opacity(save_stack_.back());
+  save_stack_.pop_back();
+}
+void SkPaintDispatchHelper::set_opacity(SkScalar opacity) {
+  if (opacity_ != opacity) {
+    opacity_ = opacity;
+    setColor(current_color_);
+  }
+}
+
 sk_sp<SkColorFilter> SkPaintDispatchHelper::makeColorFilter() {
   if (!invert_colors_) {
     return color_filter_;
@@ -227,6 +262,9 @@ DisplayListBoundsCalculator::DisplayListBoundsCalculator(
   layer_infos_.emplace_back(std::make_unique<RootLayerData>());
   accumulator_ = layer_infos_.back()->layer_accumulator();
 }
+void DisplayListBoundsCalculator::setInvertColors(bool invert) {
+  invert_colors_ = invert;
+}
 void DisplayListBoundsCalculator::setStrokeCap(SkPaint::Cap cap) {
   cap_is_square_ = (cap == SkPaint::kSquare_Cap);
 }
@@ -279,6 +317,7 @@ void DisplayListBoundsCalculator::saveLayer(const SkRect* bounds,
                                             bool with_paint) {
   SkMatrixDispatchHelper::save();
   ClipBoundsDispatchHelper::save();
+  layer_supports_opacity_.push_back(!with_paint || paint_supports_opacity());
   if (with_paint) {
     layer_infos_.emplace_back(std::make_unique<SaveLayerData>(
         accumulator_, image_filter_, paint_nops_on_transparency()));
@@ -296,12 +335,21 @@ void DisplayListBoundsCalculator::restore() {
   if (layer_infos_.size() > 1) {
     SkMatrixDispatchHelper::restore();
     ClipBoundsDispatchHelper::restore();
+    bool is_layer = layer_infos_.back()->layer_accumulator() !=
+                    layer_infos_.back()->restore_accumulator();
     accumulator_ = layer_infos_.back()->restore_accumulator();
     SkRect layer_bounds = layer_infos_.back()->layer_bounds();
     // Must read unbounded state after layer_bounds
     bool layer_unbounded = layer_infos_.back()->is_unbounded();
     layer_infos_.pop_back();
 
+    if (is_layer) {
+      if (!layer_supports_opacity_.back()) {
+        DisallowGroupOpacity();
+      }
+      layer_supports_opacity_.pop_back();
+    }
+
     // We accumulate the bounds even if the layer was unbounded because
     // the unbounded state may be contained at a higher level, so we at
     // least accumulate our best estimate about what we have.
@@ -319,9 +367,15 @@ void DisplayListBoundsCalculator::restore() {
 }
 
 void DisplayListBoundsCalculator::drawPaint() {
+  if (!paint_supports_opacity()) {
+    DisallowGroupOpacity();
+  }
   AccumulateUnbounded();
 }
 void DisplayListBoundsCalculator::drawColor(SkColor color, SkBlendMode mode) {
+  if (mode != SkBlendMode::kSrcOver) {
+    DisallowGroupOpacity();
+  }
   AccumulateUnbounded();
 }
 void DisplayListBoundsCalculator::drawLine(const SkPoint& p0,
@@ -374,11 +428,11 @@ void DisplayListBoundsCalculator::drawArc(const SkRect& bounds,
 void DisplayListBoundsCalculator::drawPoints(SkCanvas::PointMode mode,
                                              uint32_t count,
                                              const SkPoint pts[]) {
+  // The points and lines of a single op can overlap each other.
+  DisallowGroupOpacity();
   if (count > 0) {
     BoundsAccumulator ptBounds;
-    for (size_t i = 0; i < count; i++) {
-      ptBounds.accumulate(pts[i]);
-    }
+    ptBounds.accumulate(pts, static_cast<int>(count));
     int flags = kIsStrokedGeometry;
     if (mode != SkCanvas::kPoints_PointMode) {
       flags |= kGeometryMayHaveDiagonalEndCaps;
@@ -389,6 +443,9 @@ void DisplayListBoundsCalculator::drawPoints(SkCanvas::PointMode mode,
 }
 void DisplayListBoundsCalculator::drawVertices(const sk_sp<SkVertices> vertices,
                                                SkBlendMode mode) {
+  // The colors of the vertices are blended with the paint before its alpha
+  // is applied.
+  DisallowGroupOpacity();
   AccumulateRect(vertices->bounds(), kIsNonGeometric);
 }
 void DisplayListBoundsCalculator::drawImage(const sk_sp<SkImage> image,
@@ -438,15 +495,11 @@ void DisplayListBoundsCalculator::drawAtlas(const sk_sp<SkImage> atlas,
                                             const SkSamplingOptions& sampling,
                                             const SkRect* cullRect,
                                             bool render_with_attributes) {
-  SkPoint quad[4];
+  // The sprites of a single op can overlap each other, and their colors
+  // are blended with the sprites before the paint alpha is applied.
+  DisallowGroupOpacity();
   BoundsAccumulator atlasBounds;
-  for (int i = 0; i < count; i++) {
-    const SkRect& src = tex[i];
-    xform[i].toQuad(src.width(), src.height(), quad);
-    for (int j = 0; j < 4; j++) {
-      atlasBounds.accumulate(quad[j]);
-    }
-  }
+  atlasBounds.accumulate(xform, tex, count);
   if (atlasBounds.is_not_empty()) {
     int flags = render_with_attributes ? kIsNonGeometric : kIsUnfiltered;
     AccumulateRect(atlasBounds.bounds(), flags);
@@ -458,6 +511,7 @@ void DisplayListBoundsCalculator::drawPicture(const sk_sp<SkPicture> picture,
   // TODO(flar) cull rect really cannot be trusted in general, but it will
   // work for SkPictures generated from our own PictureRecorder or any
   // picture captured with an SkRTreeFactory or accurate bounds estimate.
+  DisallowGroupOpacity();
   SkRect bounds = picture->cullRect();
   if (pic_matrix) {
     pic_matrix->mapRect(&bounds);
@@ -467,11 +521,16 @@ void DisplayListBoundsCalculator::drawPicture(const sk_sp<SkPicture> picture,
 }
 void DisplayListBoundsCalculator::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
+  if (!display_list->can_apply_group_opacity()) {
+    DisallowGroupOpacity();
+  }
   AccumulateRect(display_list->bounds(), kIsUnfiltered);
 }
 void DisplayListBoundsCalculator::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                                SkScalar x,
                                                SkScalar y) {
+  // The glyphs of a single blob can overlap each other.
+  DisallowGroupOpacity();
   AccumulateRect(blob->bounds().makeOffset(x, y), kIsFilledGeometry);
 }
 void DisplayListBoundsCalculator::drawShadow(const SkPath& path,
@@ -479,6 +538,8 @@ void DisplayListBoundsCalculator::drawShadow(const SkPath& path,
                                              const SkScalar elevation,
                                              bool transparent_occluder,
                                              SkScalar dpr) {
+  // The shadow colors are not a linear function of the alpha of |color|.
+  DisallowGroupOpacity();
   SkRect shadow_bounds =
       PhysicalShapeLayer::ComputeShadowBounds(path, elevation, dpr, matrix());
   AccumulateRect(shadow_bounds, kIsUnfiltered);
@@ -571,21 +632,50 @@ bool DisplayListBoundsCalculator::AdjustBoundsForPaint(SkRect& bounds,
 
 void DisplayListBoundsCalculator::AccumulateUnbounded() {
   if (has_clip()) {
-    accumulator_->accumulate(clip_bounds());
+    AccumulateOpBounds(clip_bounds());
   } else {
     layer_infos_.back()->set_unbounded();
+    DisallowGroupOpacity();
   }
 }
 void DisplayListBoundsCalculator::AccumulateRect(SkRect& rect, int flags) {
+  if ((flags & kIsUnfiltered) == 0 && !paint_supports_opacity()) {
+    DisallowGroupOpacity();
+  }
   if (AdjustBoundsForPaint(rect, flags)) {
     matrix().mapRect(&rect);
     if (!has_clip() || rect.intersect(clip_bounds())) {
-      accumulator_->accumulate(rect);
+      AccumulateOpBounds(rect);
     }
   } else {
     AccumulateUnbounded();
   }
 }
+void DisplayListBoundsCalculator::AccumulateOpBounds(const SkRect& bounds) {
+  accumulator_->accumulate(bounds);
+  if (can_apply_group_opacity_ && is_outside_of_layers()) {
+    // Anti-aliased operations that share an edge also share the pixels
+    // along it. The transform the display list will be drawn with is not
+    // known here, so the bounds are rounded out in the local coordinates of
+    // the display list. This catches shared edges when the display list is
+    // drawn at its own scale, but not operations that only come to share a
+    // pixel when it is scaled down.
+    SkRect pixel_bounds = SkRect::Make(bounds.roundOut());
+    if (SkRect::Intersects(group_opacity_bounds_, pixel_bounds)) {
+      can_apply_group_opacity_ = false;
+    } else {
+      group_opacity_bounds_.join(pixel_bounds);
+    }
+  }
+}
+
+bool DisplayListBoundsCalculator::paint_supports_opacity() const {
+  // The alpha of the paint is applied before the color filter and image
+  // filter, and an opacity is only distributed over the operations when
+  // they are blended with srcOver.
+  return blend_mode_ && blend_mode_.value() == SkBlendMode::kSrcOver &&
+         !color_filter_ && !invert_colors_ && !image_filter_;
+}
 
 bool DisplayListBoundsCalculator::paint_nops_on_transparency() {
   // SkImageFilter::canComputeFastBounds tests for transparency behavior
@@ -5,8 +5,11 @@
 #ifndef FLUTTER_FLOW_DISPLAY_LIST_UTILS_H_
 #define FLUTTER_FLOW_DISPLAY_LIST_UTILS_H_
 
+#include <algorithm>
 #include <optional>
+#include <vector>
 
+#include "flutter/flow/bounds_utils.h"
 #include "flutter/flow/display_list.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
@@ -94,8 +97,22 @@ class IgnoreTransformDispatchHelper : public virtual Dispatcher {
 // A utility class that will monitor the Dispatcher methods relating
 // to the rendering attributes and accumulate them into an SkPaint
 // which can be accessed at any time via paint().
+//
+// An opacity can be supplied to apply to the color of the paint, for
+// rendering a DisplayList whose |can_apply_group_opacity| is true at
+// a group opacity without a saveLayer. The opacity does not apply
+// inside a saveLayer, where it is instead applied to the layer, so
+// subclasses must call |save_opacity| and |restore_opacity| as they
+// process save, saveLayer and restore calls.
 class SkPaintDispatchHelper : public virtual Dispatcher {
  public:
+  SkPaintDispatchHelper(SkScalar opacity = SK_Scalar1)
+      : current_color_(SK_ColorBLACK), opacity_(opacity) {
+    if (opacity < SK_Scalar1) {
+      paint_.setAlphaf(opacity);
+    }
+  }
+
   void setAntiAlias(bool aa) override;
   void setDither(bool dither) override;
   void setStyle(SkPaint::Style style) override;
@@ -116,11 +133,31 @@ class SkPaintDispatchHelper : public virtual Dispatcher {
 
   const SkPaint& paint() { return paint_; }
 
+  // The paint to use for a rendering operation that might not use the
+  // attributes, which only needs a paint if there is an opacity to apply.
+  const SkPaint* safe_paint(bool use_attributes);
+
+  // The opacity that applies to the rendering operations at the current
+  // save level.
+  SkScalar opacity() const { return opacity_; }
+
+ protected:
+  // Saves the current opacity, and sets it to SK_Scalar1 if
+  // |reset_opacity| is true, as it is for the contents of a saveLayer.
+  void save_opacity(bool reset_opacity);
+  void restore_opacity();
+
  private:
   SkPaint paint_;
   bool invert_colors_ = false;
   sk_sp<SkColorFilter> color_filter_;
 
+  SkColor current_color_;
+  SkScalar opacity_;
+  std::vector<SkScalar> save_stack_;
+  SkPaint opacity_paint_;
+
+  void set_opacity(SkScalar opacity);
   sk_sp<SkColorFilter> makeColorFilter();
 };
 
@@ -244,6 +281,14 @@ class BoundsAccumulator {
       accumulate(r.fRight, r.fBottom);
     }
   }
+  // Accumulates many points at once, see |ComputePointExtents|.
+  void accumulate(const SkPoint points[], int count) {
+    accumulateExtents(ComputePointExtents(points, count));
+  }
+  // Accumulates the quads of drawAtlas sprites, see |ComputeAtlasExtents|.
+  void accumulate(const SkRSXform xform[], const SkRect tex[], int count) {
+    accumulateExtents(ComputeAtlasExtents(xform, tex, count));
+  }
 
   bool is_empty() const { return min_x_ >= max_x_ || min_y_ >= max_y_; }
   bool is_not_empty() const { return min_x_ < max_x_ && min_y_ < max_y_; }
@@ -255,6 +300,15 @@ class BoundsAccumulator {
   }
 
  private:
+  // The extents have +infinity minimums and -infinity maximums on the axes
+  // without any coordinate, which leave this accumulator unchanged.
+  void accumulateExtents(const SkRect& extents) {
+    min_x_ = std::min(min_x_, extents.fLeft);
+    min_y_ = std::min(min_y_, extents.fTop);
+    max_x_ = std::max(max_x_, extents.fRight);
+    max_y_ = std::max(max_y_, extents.fBottom);
+  }
+
   SkScalar min_x_ = std::numeric_limits<SkScalar>::infinity();
   SkScalar min_y_ = std::numeric_limits<SkScalar>::infinity();
   SkScalar max_x_ = -std::numeric_limits<SkScalar>::infinity();
@@ -280,6 +334,7 @@ class DisplayListBoundsCalculator final
   // The flag should never be set if a cull_rect is provided.
   DisplayListBoundsCalculator(const SkRect* cull_rect = nullptr);
 
+  void setInvertColors(bool invert) override;
   void setStrokeCap(SkPaint::Cap cap) override;
   void setStrokeJoin(SkPaint::Join join) override;
   void setStyle(SkPaint::Style style) override;
@@ -379,10 +434,26 @@ class DisplayListBoundsCalculator final
     return accumulator_->bounds();
   }
 
+  // Whether rendering each of the operations with an opacity gives the
+  // same result as rendering them all into a layer composited with that
+  // opacity. This requires that the operations outside of any saveLayer
+  // do not overlap and can modulate their own alpha. The contents of a
+  // saveLayer do not matter as the opacity is applied to the layer.
+  // Should only be called after the stream is fully dispatched.
+  bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
+
  private:
   // current accumulator based on saveLayer history
   BoundsAccumulator* accumulator_;
 
+  bool can_apply_group_opacity_ = true;
+  // The union of the pixel bounds of the operations outside of any
+  // saveLayer, used to detect operations that overlap.
+  SkRect group_opacity_bounds_ = SkRect::MakeEmpty();
+  // Whether each of the saveLayers on the stack could apply an opacity
+  // to its paint.
+  std::vector<bool> layer_supports_opacity_;
+
   // A class that abstracts the information kept for a single
   // |save| or |saveLayer|, including the root information that
   // is kept as a base set of information for the DisplayList
@@ -590,6 +661,7 @@ class DisplayListBoundsCalculator final
 
   skstd::optional<SkBlendMode> blend_mode_ = SkBlendMode::kSrcOver;
   sk_sp<SkColorFilter> color_filter_;
+  bool invert_colors_ = false;
 
   SkScalar half_stroke_width_ = kMinStrokeWidth;
   SkScalar miter_limit_ = 4.0;
@@ -602,6 +674,16 @@ class DisplayListBoundsCalculator final
   SkScalar mask_sigma_pad_ = 0.0;
 
   bool paint_nops_on_transparency();
+  bool paint_supports_opacity() const;
+
+  bool is_outside_of_layers() const {
+    return accumulator_ == layer_infos_.front()->layer_accumulator();
+  }
+  void DisallowGroupOpacity() {
+    if (is_outside_of_layers()) {
+      can_apply_group_opacity_ = false;
+    }
+  }
 
   static bool ComputeFilteredBounds(SkRect& rect, SkImageFilter* filter);
   bool AdjustBoundsForPaint(SkRect& bounds, int flags);
@@ -612,6 +694,7 @@ class DisplayListBoundsCalculator final
     AccumulateRect(bounds, flags);
   }
   void AccumulateRect(SkRect& rect, int flags);
+  void AccumulateOpBounds(const SkRect& bounds);
 };
 
 }  // namespace flutter
@@ -150,6 +150,10 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
     layer_cache_bytes_ = layer_metrics.total_bytes();
     picture_cache_count_ = picture_metrics.total_count();
     picture_cache_bytes_ = picture_metrics.total_bytes();
+    if (layer_metrics.rasterized_count + picture_metrics.rasterized_count >
+        0) {
+      timing_.AddAnnotation(FrameTiming::kRasterCacheMiss);
+    }
   } else {
     layer_cache_count_ = layer_cache_bytes_ = picture_cache_count_ =
         picture_cache_bytes_ = 0;
@@ -166,6 +170,12 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   return timing_;
 }
 
+void FrameTimingsRecorder::RecordAnnotation(
+    FrameTiming::Annotation annotation) {
+  std::scoped_lock state_lock(state_mutex_);
+  timing_.AddAnnotation(annotation);
+}
+
 FrameTiming FrameTimingsRecorder::GetRecordedTime() const {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterEnd);
@@ -102,6 +102,11 @@ class FrameTimingsRecorder {
   /// the events. This summary is sent to the framework.
   FrameTiming RecordRasterEnd(const RasterCache* cache = nullptr);
 
+  /// Records work that happened while the frame was rasterized and that may
+  /// have made it slow. The annotation is added to the summary built by
+  /// `RecordRasterEnd`, even when it is recorded after the raster end event.
+  void RecordAnnotation(FrameTiming::Annotation annotation);
+
   /// Returns the frame number. Frame number is unique per frame and a frame
   /// built earlier will have a frame number less than a frame that has been
   /// built at a later point of time.
@@ -33,6 +33,9 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter has to be applied before any opacity, which an inherited
+  // opacity would be applied by the children before.
+  set_layer_can_inherit_opacity(false);
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
@@ -116,6 +116,7 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_layer_can_inherit_opacity(children_can_accept_opacity());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -132,6 +133,8 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
+  bool can_accept_opacity = true;
+  SkRect opacity_bounds = SkRect::MakeEmpty();
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
@@ -141,6 +144,17 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     layer->Preroll(context, child_matrix);
     child_paint_bounds->join(layer->paint_bounds());
 
+    if (can_accept_opacity) {
+      // Anti-aliased children that share an edge also share the pixels
+      // along it, so the bounds are mapped to device pixels and rounded out
+      // before testing them.
+      SkRect layer_bounds = SkRect::Make(
+          child_matrix.mapRect(layer->paint_bounds()).roundOut());
+      can_accept_opacity = layer->layer_can_inherit_opacity() &&
+                           !SkRect::Intersects(opacity_bounds, layer_bounds);
+      opacity_bounds.join(layer_bounds);
+    }
+
     child_has_platform_view =
         child_has_platform_view || context->has_platform_view;
     child_has_texture_layer =
@@ -150,6 +164,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   set_subtree_has_platform_view(child_has_platform_view);
+  children_can_accept_opacity_ = can_accept_opacity;
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -42,6 +42,13 @@ class ContainerLayer : public Layer {
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // Whether all of the children can inherit an opacity and none of them
+  // overlap, so that applying the opacity to each of them renders the same
+  // as applying it to all of them as a group. Set by PrerollChildren().
+  bool children_can_accept_opacity() const {
+    return children_can_accept_opacity_;
+  }
+
   // Try to prepare the raster cache for a given layer.
   //
   // The raster cache would fail if either of the followings is true:
@@ -58,6 +65,7 @@ class ContainerLayer : public Layer {
 
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
+  bool children_can_accept_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
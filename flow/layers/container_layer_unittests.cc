@@ -146,6 +146,26 @@ TEST_F(ContainerLayerTest, MultipleWithEmpty) {
                 0, MockCanvas::DrawPathData{child_path1, child_paint1}}}));
 }
 
+TEST_F(ContainerLayerTest, ChildrenSharingADevicePixelCannotAcceptOpacity) {
+  // The children are a pixel apart in local coordinates, and share the first
+  // pixel once scaled down to device pixels.
+  auto mock_layer1 = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f)));
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(6.0f, 0.0f, 5.0f, 5.0f)));
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->children_can_accept_opacity());
+
+  layer->Preroll(preroll_context(), SkMatrix::Scale(0.1f, 0.1f));
+  EXPECT_FALSE(layer->children_can_accept_opacity());
+}
+
 TEST_F(ContainerLayerTest, NeedsSystemComposite) {
   SkPath child_path1;
   child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
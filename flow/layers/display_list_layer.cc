@@ -101,6 +101,7 @@ void DisplayListLayer::Preroll(PrerollContext* context,
 
   SkRect bounds = disp_list->bounds().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
+  set_layer_can_inherit_opacity(disp_list->can_apply_group_opacity());
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
@@ -115,13 +116,23 @@ void DisplayListLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
-  if (context.raster_cache &&
-      context.raster_cache->Draw(*display_list(), *context.leaf_nodes_canvas)) {
-    TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
-    return;
+  if (context.raster_cache) {
+    // The cached image is a single draw, so it can always take the opacity.
+    SkPaint paint;
+    paint.setAlphaf(context.inherited_opacity);
+    if (context.raster_cache->Draw(
+            *display_list(), *context.leaf_nodes_canvas,
+            context.inherited_opacity < SK_Scalar1 ? &paint : nullptr)) {
+      TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+      return;
+    }
   }
 
-  display_list()->RenderTo(context.leaf_nodes_canvas);
+  RasterCacheDrawCostSampler sampler(context.raster_cache, *display_list(),
+                                     *context.leaf_nodes_canvas,
+                                     context.gr_context);
+  display_list()->RenderTo(context.leaf_nodes_canvas,
+                           context.inherited_opacity, context.raster_cache);
 }
 
 }  // namespace flutter
@@ -151,6 +151,11 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+
+    // An opacity that an ancestor has left to this layer to apply to its
+    // rendering, which is only ever less than SK_Scalar1 for layers whose
+    // layer_can_inherit_opacity() is true.
+    SkScalar inherited_opacity = SK_Scalar1;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -215,6 +220,14 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // Whether the layer can apply the inherited_opacity of the PaintContext to
+  // its own rendering, which lets an ancestor with an opacity avoid the cost
+  // of a saveLayer. Must be set by Preroll() for layers that can.
+  bool layer_can_inherit_opacity() const { return layer_can_inherit_opacity_; }
+  void set_layer_can_inherit_opacity(bool value) {
+    layer_can_inherit_opacity_ = value;
+  }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
@@ -290,6 +303,7 @@ class Layer {
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
+  bool layer_can_inherit_opacity_ = false;
 
   static uint64_t NextUniqueID();
 
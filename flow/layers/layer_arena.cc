@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+std::shared_ptr<LayerArena> LayerArena::Create(size_t chunk_size) {
+  return std::shared_ptr<LayerArena>(new LayerArena(chunk_size));
+}
+
+LayerArena::LayerArena(size_t chunk_size) : chunk_size_(chunk_size) {
+  FML_DCHECK(chunk_size_ > 0);
+}
+
+LayerArena::~LayerArena() = default;
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  // Chunks come from operator new[] and are aligned for any fundamental type,
+  // which covers every layer.
+  FML_DCHECK(alignment <= alignof(std::max_align_t));
+
+  size_t padding =
+      (alignment - reinterpret_cast<uintptr_t>(next_) % alignment) % alignment;
+  if (next_ == nullptr || padding + size > remaining_) {
+    // Allocations that do not fit in a chunk get one of their own, leaving
+    // the current chunk for the smaller allocations that follow.
+    if (size > chunk_size_) {
+      chunks_.emplace_back(new uint8_t[size]);
+      allocation_count_++;
+      bytes_used_ += size;
+      return chunks_.back().get();
+    }
+    chunks_.emplace_back(new uint8_t[chunk_size_]);
+    next_ = chunks_.back().get();
+    remaining_ = chunk_size_;
+    padding = 0;
+  }
+
+  void* result = next_ + padding;
+  next_ += padding + size;
+  remaining_ -= padding + size;
+  allocation_count_++;
+  bytes_used_ += padding + size;
+  return result;
+}
+
+}  // namespace flutter
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// Allocates the layers of a single frame from a few large chunks of memory
+// instead of making one heap allocation per layer.
+//
+// |MakeLayer| returns a std::shared_ptr that behaves like one returned by
+// std::make_shared: the layer and its control block share one allocation,
+// which is carved out of the arena. Releasing a layer runs its destructor but
+// does not return its memory. Every layer holds a reference to its arena, so
+// the chunks are freed together once the last layer allocated from the arena
+// is released, which is normally when the LayerTree of the frame is
+// destroyed.
+//
+// A layer that outlives its frame keeps the memory of the whole frame alive,
+// so layers that can be retained across frames, such as the ones wrapped by
+// an EngineLayer, should stay on the heap.
+//
+// Layers must be made from one thread at a time. They may be released on any
+// thread.
+class LayerArena : public std::enable_shared_from_this<LayerArena> {
+ public:
+  static constexpr size_t kDefaultChunkSize = 16 * 1024;
+
+  static std::shared_ptr<LayerArena> Create(
+      size_t chunk_size = kDefaultChunkSize);
+
+  ~LayerArena();
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> MakeLayer(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(shared_from_this()),
+                                   std::forward<Args>(args)...);
+  }
+
+  // The number of allocations made from the arena.
+  size_t allocation_count() const { return allocation_count_; }
+
+  // The number of chunks the arena allocated from the heap.
+  size_t chunk_count() const { return chunks_.size(); }
+
+  // The number of bytes handed out by the arena, including alignment padding.
+  size_t bytes_used() const { return bytes_used_; }
+
+ private:
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<LayerArena> arena)
+        : arena_(std::move(arena)) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // Memory is only reclaimed when the whole arena is freed.
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    std::shared_ptr<LayerArena> arena_;
+  };
+
+  explicit LayerArena(size_t chunk_size);
+
+  void* Allocate(size_t size, size_t alignment);
+
+  const size_t chunk_size_;
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+  uint8_t* next_ = nullptr;
+  size_t remaining_ = 0;
+  size_t allocation_count_ = 0;
+  size_t bytes_used_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
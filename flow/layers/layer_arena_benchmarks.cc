@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares building and releasing a layer tree the way SceneBuilder does with
+// and without a LayerArena, and reports the heap allocations made per tree.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace {
+
+std::atomic<size_t> g_heap_allocation_count(0);
+
+}  // namespace
+
+// These benchmarks are built into their own executable, so counting every
+// heap allocation of the process does not affect other benchmarks.
+void* operator new(size_t size) {
+  g_heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* result = std::malloc(size == 0 ? 1 : size)) {
+    return result;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+namespace flutter {
+
+// The number of leaf layers under each of the retainable containers.
+constexpr int kLeavesPerContainer = 8;
+
+// Makes the root and leaf layers on the heap, as SceneBuilder did before it
+// could use an arena. The leaves were made with std::make_unique, which
+// needs a second allocation for the control block of the std::shared_ptr.
+class HeapLayerFactory {
+ public:
+  std::shared_ptr<ContainerLayer> MakeRoot() {
+    return std::make_shared<ContainerLayer>();
+  }
+
+  std::shared_ptr<Layer> MakeLeaf() {
+    return std::make_unique<PlatformViewLayer>(SkPoint::Make(1, 1),
+                                               SkSize::Make(10, 10), 0);
+  }
+};
+
+// Makes the root and leaf layers from a LayerArena.
+class ArenaLayerFactory {
+ public:
+  ArenaLayerFactory() : arena_(LayerArena::Create()) {}
+
+  std::shared_ptr<ContainerLayer> MakeRoot() {
+    return arena_->MakeLayer<ContainerLayer>();
+  }
+
+  std::shared_ptr<Layer> MakeLeaf() {
+    return arena_->MakeLayer<PlatformViewLayer>(SkPoint::Make(1, 1),
+                                                SkSize::Make(10, 10), 0);
+  }
+
+ private:
+  std::shared_ptr<LayerArena> arena_;
+};
+
+// Builds a tree of |leaf_count| leaf layers grouped under transform layers.
+// The containers are made on the heap, as they can be retained by the
+// framework.
+template <typename Factory>
+static std::shared_ptr<ContainerLayer> BuildLayerTree(Factory& factory,
+                                                      int leaf_count) {
+  auto root = factory.MakeRoot();
+  std::shared_ptr<TransformLayer> container;
+  for (int i = 0; i < leaf_count; i++) {
+    if (i % kLeavesPerContainer == 0) {
+      container = std::make_shared<TransformLayer>(SkMatrix::Translate(i, i));
+      root->Add(container);
+    }
+    container->Add(factory.MakeLeaf());
+  }
+  return root;
+}
+
+template <typename Factory>
+static void BuildAndReleaseLayerTrees(benchmark::State& state) {
+  const int leaf_count = state.range(0);
+  const size_t initial_allocation_count = g_heap_allocation_count.load();
+  while (state.KeepRunning()) {
+    Factory factory;
+    BuildLayerTree(factory, leaf_count);
+  }
+  size_t allocation_count =
+      g_heap_allocation_count.load() - initial_allocation_count;
+  state.counters["HeapAllocationsPerTree"] =
+      static_cast<double>(allocation_count) / state.iterations();
+  state.SetItemsProcessed(state.iterations() * leaf_count);
+}
+
+static void BM_LayerTreeHeap(benchmark::State& state) {  // NOLINT
+  BuildAndReleaseLayerTrees<HeapLayerFactory>(state);
+}
+
+static void BM_LayerTreeArena(benchmark::State& state) {  // NOLINT
+  BuildAndReleaseLayerTrees<ArenaLayerFactory>(state);
+}
+
+BENCHMARK(BM_LayerTreeHeap)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_LayerTreeArena)->RangeMultiplier(4)->Range(16, 1024);
+
+}  // namespace flutter
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class TrackedObject {
+ public:
+  explicit TrackedObject(int* live_count) : live_count_(live_count) {
+    (*live_count_)++;
+  }
+  ~TrackedObject() { (*live_count_)--; }
+
+ private:
+  int* live_count_;
+};
+
+struct alignas(16) AlignedObject {
+  float values[4];
+};
+
+struct LargeObject {
+  uint8_t bytes[512];
+};
+
+}  // namespace
+
+TEST(LayerArenaTest, MakesObjectsFromSharedChunks) {
+  auto arena = LayerArena::Create(1024);
+  int live_count = 0;
+  std::vector<std::shared_ptr<TrackedObject>> objects;
+  for (int i = 0; i < 10; i++) {
+    objects.push_back(arena->MakeLayer<TrackedObject>(&live_count));
+  }
+
+  EXPECT_EQ(live_count, 10);
+  EXPECT_EQ(arena->allocation_count(), 10u);
+  EXPECT_EQ(arena->chunk_count(), 1u);
+
+  objects.clear();
+  EXPECT_EQ(live_count, 0);
+}
+
+TEST(LayerArenaTest, ArenaIsFreedWithItsLastObject) {
+  int live_count = 0;
+  auto arena = LayerArena::Create();
+  std::weak_ptr<LayerArena> weak_arena = arena;
+  auto first = arena->MakeLayer<TrackedObject>(&live_count);
+  auto second = arena->MakeLayer<TrackedObject>(&live_count);
+  arena.reset();
+
+  first.reset();
+  EXPECT_EQ(live_count, 1);
+  EXPECT_FALSE(weak_arena.expired());
+
+  second.reset();
+  EXPECT_EQ(live_count, 0);
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST(LayerArenaTest, AllocationsAreAligned) {
+  auto arena = LayerArena::Create(256);
+  std::vector<std::shared_ptr<void>> objects;
+  for (int i = 0; i < 20; i++) {
+    objects.push_back(arena->MakeLayer<char>('a'));
+    auto aligned = arena->MakeLayer<AlignedObject>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 16, 0u);
+    objects.push_back(aligned);
+  }
+  EXPECT_GT(arena->chunk_count(), 1u);
+}
+
+TEST(LayerArenaTest, LargeAllocationsGetTheirOwnChunk) {
+  auto arena = LayerArena::Create(128);
+  auto small = arena->MakeLayer<int>(1);
+  EXPECT_EQ(arena->chunk_count(), 1u);
+
+  auto large = arena->MakeLayer<LargeObject>();
+  EXPECT_EQ(arena->chunk_count(), 2u);
+
+  // The first chunk still has room for small allocations.
+  auto another_small = arena->MakeLayer<int>(2);
+  EXPECT_EQ(arena->chunk_count(), 2u);
+  EXPECT_EQ(*small, 1);
+  EXPECT_EQ(*another_small, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
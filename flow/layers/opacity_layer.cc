@@ -54,12 +54,22 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
 
+  // The opacity is either passed down to the children or applied with a
+  // saveLayer, so it can always be combined with an inherited opacity.
+  children_can_accept_opacity_ =
+      GetChildContainer()->layer_can_inherit_opacity();
+  set_layer_can_inherit_opacity(true);
+
   {
     set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+    // Children that apply the opacity themselves do not need a saveLayer,
+    // which is what caching them would avoid.
+    if (!children_can_accept_opacity_) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
-    child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
+      child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
 #endif
-    TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
+      TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
+    }
   }
 
   // Restore cull_rect
@@ -70,8 +80,8 @@ void OpacityLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "OpacityLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkPaint paint;
-  paint.setAlpha(alpha_);
+  SkScalar inherited_opacity = context.inherited_opacity;
+  SkScalar opacity = inherited_opacity * (alpha_ * (1.0f / SK_AlphaOPAQUE));
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
   context.internal_nodes_canvas->translate(offset_.fX, offset_.fY);
@@ -81,6 +91,16 @@ void OpacityLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
+  if (children_can_accept_opacity_) {
+    context.inherited_opacity = opacity;
+    PaintChildren(context);
+    context.inherited_opacity = inherited_opacity;
+    return;
+  }
+
+  SkPaint paint;
+  paint.setAlphaf(opacity);
+
   if (context.raster_cache &&
       context.raster_cache->Draw(GetCacheableChild(),
                                  *context.leaf_nodes_canvas, &paint)) {
@@ -102,7 +122,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, saveLayerBounds, &paint);
+  context.inherited_opacity = SK_Scalar1;
   PaintChildren(context);
+  context.inherited_opacity = inherited_opacity;
 }
 
 }  // namespace flutter
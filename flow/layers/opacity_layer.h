@@ -40,6 +40,9 @@ class OpacityLayer : public MergedContainerLayer {
  private:
   SkAlpha alpha_;
   SkPoint offset_;
+  // Whether the alpha can be applied by the children as they render,
+  // instead of with a saveLayer. Set during Preroll.
+  bool children_can_accept_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(OpacityLayer);
 };
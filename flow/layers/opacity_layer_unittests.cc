@@ -5,11 +5,15 @@
 #include "flutter/flow/layers/opacity_layer.h"
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkShader.h"
 
 namespace flutter {
 namespace testing {
@@ -396,6 +400,151 @@ TEST_F(OpacityLayerTest, Nested) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(OpacityLayerTest, NonOverlappingChildrenInheritOpacity) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(10.0f, 0.0f, 5.0f, 5.0f));
+  const SkPoint layer_offset = SkPoint::Make(0.5f, 1.5f);
+  const SkMatrix initial_transform = SkMatrix::Translate(0.5f, 0.5f);
+  const SkMatrix layer_transform =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  const SkMatrix integral_layer_transform = RasterCache::GetIntegralTransCTM(
+      SkMatrix::Concat(initial_transform, layer_transform));
+#endif
+  const SkPaint child1_paint = SkPaint(SkColors::kRed);
+  const SkPaint child2_paint = SkPaint(SkColors::kGreen);
+  const SkAlpha alpha_half = 255 / 2;
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path, child1_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path, child2_paint);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, layer_offset);
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), initial_transform);
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  SkPaint expected_paint1 = child1_paint;
+  expected_paint1.setAlphaf(alpha_half * (1.0f / SK_AlphaOPAQUE));
+  SkPaint expected_paint2 = child2_paint;
+  expected_paint2.setAlphaf(alpha_half * (1.0f / SK_AlphaOPAQUE));
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(integral_layer_transform)}},
+#endif
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child1_path, expected_paint1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child2_path, expected_paint2}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+  EXPECT_EQ(paint_context().inherited_opacity, SK_Scalar1);
+}
+
+TEST_F(OpacityLayerTest, OverlappingChildrenDoNotInheritOpacity) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(4.0f, 0.0f, 5.0f, 5.0f));
+  const SkPaint child1_paint = SkPaint(SkColors::kRed);
+  const SkPaint child2_paint = SkPaint(SkColors::kGreen);
+  const SkAlpha alpha_half = 255 / 2;
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path, child1_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path, child2_paint);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  const SkMatrix layer_transform = SkMatrix::Translate(1.0f, 1.0f);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, SkPoint::Make(1, 1));
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  const SkPaint opacity_paint =
+      SkPaint(SkColor4f::FromColor(SkColorSetA(SK_ColorBLACK, alpha_half)));
+  SkRect opacity_bounds;
+  layer->paint_bounds().makeOffset(-1.0f, -1.0f).roundOut(&opacity_bounds);
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{
+           1, MockCanvas::SaveLayerData{opacity_bounds, opacity_paint, nullptr,
+                                        2}},
+       MockCanvas::DrawCall{
+           2, MockCanvas::DrawPathData{child1_path, child1_paint}},
+       MockCanvas::DrawCall{
+           2, MockCanvas::DrawPathData{child2_path, child2_paint}},
+       MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+// Whether |canvas| drew |path| with exactly |paint|, and so without an
+// inherited opacity.
+static bool DrewPathWithPaint(const MockCanvas& canvas,
+                              const SkPath& path,
+                              const SkPaint& paint) {
+  for (const MockCanvas::DrawCall& call : canvas.draw_calls()) {
+    auto* data = std::get_if<MockCanvas::DrawPathData>(&call.data);
+    if (data && *data == MockCanvas::DrawPathData{path, paint}) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST_F(OpacityLayerTest, ColorFilterChildDoesNotInheritOpacity) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kRed);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_can_inherit_opacity(true);
+  auto filter_layer =
+      std::make_shared<ColorFilterLayer>(SkColorFilters::LinearToSRGBGamma());
+  filter_layer->Add(mock_layer);
+  auto layer = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  layer->Add(filter_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(filter_layer->layer_can_inherit_opacity());
+
+  // The opacity is applied to the filtered children in a saveLayer.
+  layer->Paint(paint_context());
+  EXPECT_TRUE(DrewPathWithPaint(mock_canvas(), child_path, child_paint));
+}
+
+TEST_F(OpacityLayerTest, ShaderMaskChildDoesNotInheritOpacity) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kRed);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_can_inherit_opacity(true);
+  auto mask_layer = std::make_shared<ShaderMaskLayer>(
+      SkShaders::Color(SK_ColorBLUE), SkRect::MakeWH(5.0f, 5.0f),
+      SkBlendMode::kSrcIn);
+  mask_layer->Add(mock_layer);
+  auto layer = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  layer->Add(mask_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(mask_layer->layer_can_inherit_opacity());
+
+  // The opacity is applied to the masked children in a saveLayer.
+  layer->Paint(paint_context());
+  EXPECT_TRUE(DrewPathWithPaint(mock_canvas(), child_path, child_paint));
+}
+
 TEST_F(OpacityLayerTest, Readback) {
   auto initial_transform = SkMatrix();
   auto layer = std::make_shared<OpacityLayer>(kOpaque_SkAlphaType, SkPoint());
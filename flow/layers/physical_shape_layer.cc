@@ -82,7 +82,8 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
 
   if (elevation_ != 0) {
     DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
-               SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
+               SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio,
+               context.raster_cache);
   }
 
   // Call drawPath without clip if possible for better performance.
@@ -145,7 +146,14 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                                     SkColor color,
                                     float elevation,
                                     bool transparentOccluder,
-                                    SkScalar dpr) {
+                                    SkScalar dpr,
+                                    const RasterCache* raster_cache) {
+  if (raster_cache &&
+      raster_cache->DrawShadow(*canvas, path, color, elevation,
+                               transparentOccluder, dpr)) {
+    return;
+  }
+
   const SkScalar kAmbientAlpha = 0.039f;
   const SkScalar kSpotAlpha = 0.25f;
 
@@ -21,12 +21,15 @@ class PhysicalShapeLayer : public ContainerLayer {
                                     float elevation,
                                     SkScalar dpr,
                                     const SkMatrix& ctm);
+  // Draws the shadow of |path|. Shadows of rounded rectangles are drawn from
+  // the shadow cache of |raster_cache| when one is given.
   static void DrawShadow(SkCanvas* canvas,
                          const SkPath& path,
                          SkColor color,
                          float elevation,
                          bool transparentOccluder,
-                         SkScalar dpr);
+                         SkScalar dpr,
+                         const RasterCache* raster_cache = nullptr);
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -143,6 +143,9 @@ void PictureLayer::Paint(PaintContext& context) const {
     TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
     return;
   }
+  RasterCacheDrawCostSampler sampler(context.raster_cache, *picture(),
+                                     *context.leaf_nodes_canvas,
+                                     context.gr_context);
   picture()->playback(context.leaf_nodes_canvas);
 }
 
@@ -35,6 +35,9 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The mask has to be applied before any opacity, which an inherited
+  // opacity would be applied by the children before.
+  set_layer_can_inherit_opacity(false);
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
@@ -65,6 +65,7 @@ void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   transform_.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_layer_can_inherit_opacity(children_can_accept_opacity());
 
   context->cull_rect = previous_cull_rect;
   context->mutators_stack.Pop();
@@ -4,16 +4,15 @@
 
 #include "flutter/flow/paint_region.h"
 
+#include "flutter/flow/bounds_utils.h"
+
 namespace flutter {
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 SkRect PaintRegion::ComputeBounds() const {
-  SkRect res = SkRect::MakeEmpty();
-  for (const auto& r : *this) {
-    res.join(r);
-  }
-  return res;
+  FML_DCHECK(is_valid());
+  return JoinRects(rects_->data() + from_, static_cast<int>(to_ - from_));
 }
 
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
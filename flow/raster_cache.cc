@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -16,6 +17,7 @@
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
 
 namespace flutter {
 
@@ -43,6 +45,7 @@ RasterCache::RasterCache(size_t access_threshold,
     : access_threshold_(access_threshold),
       picture_and_display_list_cache_limit_per_frame_(
           picture_and_display_list_cache_limit_per_frame),
+      shadow_cache_(access_threshold),
       checkerboard_images_(false) {}
 
 static bool CanRasterizeRect(const SkRect& cull_rect) {
@@ -62,7 +65,8 @@ static bool CanRasterizeRect(const SkRect& cull_rect) {
 
 static bool IsPictureWorthRasterizing(SkPicture* picture,
                                       bool will_change,
-                                      bool is_complex) {
+                                      bool is_complex,
+                                      bool measures_cost) {
   if (will_change) {
     // If the picture is going to change in the future, there is no point in
     // doing to extra work to rasterize.
@@ -81,6 +85,12 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
     return true;
   }
 
+  if (measures_cost) {
+    // The measured draw time decides whether the picture is worth
+    // rasterizing.
+    return true;
+  }
+
   // TODO(abarth): We should find a better heuristic here that lets us avoid
   // wasting memory on trivial layers that are easy to re-rasterize every frame.
   return picture->approximateOpCount(true) > 5;
@@ -88,7 +98,8 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
 
 static bool IsDisplayListWorthRasterizing(DisplayList* display_list,
                                           bool will_change,
-                                          bool is_complex) {
+                                          bool is_complex,
+                                          bool measures_cost) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -107,11 +118,29 @@ static bool IsDisplayListWorthRasterizing(DisplayList* display_list,
     return true;
   }
 
+  if (measures_cost) {
+    // The measured draw time decides whether the display list is worth
+    // rasterizing.
+    return true;
+  }
+
   // TODO(abarth): We should find a better heuristic here that lets us avoid
   // wasting memory on trivial layers that are easy to re-rasterize every frame.
   return display_list->op_count(true) > 5;
 }
 
+static void DrawAdmissionDecisionOverlay(SkCanvas& canvas,
+                                         const SkRect& rect,
+                                         SkColor color) {
+  SkPaint paint;
+  paint.setColor(SkColorSetA(color, 64));
+  canvas.drawRect(rect, paint);
+  paint.setColor(color);
+  paint.setStrokeWidth(4);
+  paint.setStyle(SkPaint::kStroke_Style);
+  canvas.drawRect(rect, paint);
+}
+
 /// @note Procedure doesn't copy all closures.
 static std::unique_ptr<RasterCacheResult> Rasterize(
     GrDirectContext* context,
@@ -179,8 +208,9 @@ void RasterCache::Prepare(PrerollContext* context,
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
   entry.used_this_frame = true;
-  if (!entry.image) {
+  if (!entry.image && !entry.evicted) {
     entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+    layer_cached_this_frame_++;
   }
 }
 
@@ -226,7 +256,8 @@ bool RasterCache::Prepare(PrerollContext* context,
     return false;
   }
 
-  if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
+  if (!IsPictureWorthRasterizing(picture, will_change, is_complex,
+                                 cost_based_admission_)) {
     // We only deal with pictures that are worthy of rasterization.
     return false;
   }
@@ -247,12 +278,24 @@ bool RasterCache::Prepare(PrerollContext* context,
 
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
-  if (entry.access_count < access_threshold_) {
-    // Frame threshold has not yet been reached.
+  const bool admit_by_cost = cost_based_admission_ && !is_complex;
+  DrawCost* draw_cost =
+      admit_by_cost
+          ? PrepareDrawCost(picture_draw_costs_, picture->uniqueID(), entry)
+          : nullptr;
+  if (entry.access_count < access_threshold_ || entry.evicted) {
+    // Frame threshold has not yet been reached, or the image was evicted.
     return false;
   }
 
   if (!entry.image) {
+    if (admit_by_cost &&
+        (!draw_cost ||
+         !IsAdmittedByDrawCost(*draw_cost, entry, picture->cullRect(),
+                               transformation_matrix))) {
+      return false;
+    }
+
     // GetIntegralTransCTM effect for matrix which only contains scale,
     // translate, so it won't affect result of matrix decomposition and cache
     // key.
@@ -277,7 +320,8 @@ bool RasterCache::Prepare(PrerollContext* context,
     return false;
   }
 
-  if (!IsDisplayListWorthRasterizing(display_list, will_change, is_complex)) {
+  if (!IsDisplayListWorthRasterizing(display_list, will_change, is_complex,
+                                     cost_based_admission_)) {
     // We only deal with display lists that are worthy of rasterization.
     return false;
   }
@@ -299,12 +343,24 @@ bool RasterCache::Prepare(PrerollContext* context,
 
   // Creates an entry, if not present prior.
   Entry& entry = display_list_cache_[cache_key];
-  if (entry.access_count < access_threshold_) {
-    // Frame threshold has not yet been reached.
+  const bool admit_by_cost = cost_based_admission_ && !is_complex;
+  DrawCost* draw_cost =
+      admit_by_cost ? PrepareDrawCost(display_list_draw_costs_,
+                                      display_list->unique_id(), entry)
+                    : nullptr;
+  if (entry.access_count < access_threshold_ || entry.evicted) {
+    // Frame threshold has not yet been reached, or the image was evicted.
     return false;
   }
 
   if (!entry.image) {
+    if (admit_by_cost &&
+        (!draw_cost ||
+         !IsAdmittedByDrawCost(*draw_cost, entry, display_list->bounds(),
+                               transformation_matrix))) {
+      return false;
+    }
+
     // GetIntegralTransCTM effect for matrix which only contains scale,
     // translate, so it won't affect result of matrix decomposition and cache
     // key.
@@ -320,6 +376,11 @@ bool RasterCache::Prepare(PrerollContext* context,
 }
 
 bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
+  auto draw_cost = picture_draw_costs_.find(picture.uniqueID());
+  if (draw_cost != picture_draw_costs_.end()) {
+    draw_cost->second.used_this_frame = true;
+  }
+
   PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
   auto it = picture_cache_.find(cache_key);
   if (it == picture_cache_.end()) {
@@ -332,6 +393,9 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
 
   if (entry.image) {
     entry.image->draw(canvas, nullptr);
+    if (show_admission_decisions_ && draw_cost != picture_draw_costs_.end()) {
+      DrawAdmissionDecisionOverlay(canvas, picture.cullRect(), SK_ColorGREEN);
+    }
     return true;
   }
 
@@ -339,7 +403,13 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
 }
 
 bool RasterCache::Draw(const DisplayList& display_list,
-                       SkCanvas& canvas) const {
+                       SkCanvas& canvas,
+                       const SkPaint* paint) const {
+  auto draw_cost = display_list_draw_costs_.find(display_list.unique_id());
+  if (draw_cost != display_list_draw_costs_.end()) {
+    draw_cost->second.used_this_frame = true;
+  }
+
   DisplayListRasterCacheKey cache_key(display_list.unique_id(),
                                       canvas.getTotalMatrix());
   auto it = display_list_cache_.find(cache_key);
@@ -352,13 +422,84 @@ bool RasterCache::Draw(const DisplayList& display_list,
   entry.used_this_frame = true;
 
   if (entry.image) {
-    entry.image->draw(canvas, nullptr);
+    entry.image->draw(canvas, paint);
+    if (show_admission_decisions_ &&
+        draw_cost != display_list_draw_costs_.end()) {
+      DrawAdmissionDecisionOverlay(canvas, display_list.bounds(),
+                                   SK_ColorGREEN);
+    }
     return true;
   }
 
   return false;
 }
 
+bool RasterCache::DrawNested(const DisplayList& display_list,
+                             SkCanvas& canvas,
+                             const SkPaint* paint) const {
+  SkMatrix transformation_matrix = canvas.getTotalMatrix();
+  if (!transformation_matrix.isScaleTranslate() ||
+      !CanRasterizeRect(display_list.bounds())) {
+    return false;
+  }
+
+  const MatrixDecomposition matrix(transformation_matrix);
+  if (!matrix.IsValid()) {
+    // The matrix was singular. No point in going further.
+    return false;
+  }
+
+  DisplayListRasterCacheKey cache_key(display_list.unique_id(),
+                                      transformation_matrix);
+
+  // Creates an entry, if not present prior.
+  Entry& entry = display_list_cache_[cache_key];
+  entry.access_count++;
+  entry.used_this_frame = true;
+
+  if (!entry.image) {
+    if (entry.access_count <= access_threshold_ || entry.evicted ||
+        !GenerateNewCacheInThisFrame()) {
+      return false;
+    }
+
+    // Nested display lists are rasterized with the context of the canvas they
+    // are drawn into. Canvases that are neither backed by a GPU context nor
+    // by pixels, such as recording canvases, cannot rasterize them.
+    GrRecordingContext* recording_context = canvas.recordingContext();
+    GrDirectContext* context =
+        recording_context ? recording_context->asDirectContext() : nullptr;
+    if (!context && canvas.imageInfo().isEmpty()) {
+      return false;
+    }
+
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+    transformation_matrix = GetIntegralTransCTM(transformation_matrix);
+#endif
+    entry.image = Rasterize(
+        context, transformation_matrix, canvas.imageInfo().colorSpace(),
+        checkerboard_images_, display_list.bounds(),
+        "RasterCacheFlow::NestedDisplayList",
+        [&display_list](SkCanvas* cache_canvas) {
+          display_list.RenderTo(cache_canvas);
+        });
+    nested_display_list_cached_this_frame_++;
+    if (!entry.image) {
+      return false;
+    }
+  }
+
+  nested_display_list_hits_this_frame_++;
+  // The image was rasterized with the integral translation, so it is drawn
+  // with it as well.
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  canvas.setMatrix(GetIntegralTransCTM(canvas.getTotalMatrix()));
+#endif
+  entry.image->draw(canvas, paint);
+  return true;
+}
+
 bool RasterCache::Draw(const Layer* layer,
                        SkCanvas& canvas,
                        SkPaint* paint) const {
@@ -380,9 +521,24 @@ bool RasterCache::Draw(const Layer* layer,
   return false;
 }
 
+bool RasterCache::DrawShadow(SkCanvas& canvas,
+                             const SkPath& path,
+                             SkColor color,
+                             float elevation,
+                             bool transparent_occluder,
+                             SkScalar dpr) const {
+  return shadow_cache_.Draw(canvas, path, color, elevation,
+                            transparent_occluder, dpr);
+}
+
 void RasterCache::PrepareNewFrame() {
   picture_cached_this_frame_ = 0;
   display_list_cached_this_frame_ = 0;
+  layer_cached_this_frame_ = 0;
+  nested_display_list_cached_this_frame_ = 0;
+  nested_display_list_hits_this_frame_ = 0;
+  draw_cost_samples_this_frame_ = 0;
+  shadow_cache_.PrepareNewFrame();
 }
 
 void RasterCache::CleanupAfterFrame() {
@@ -391,6 +547,16 @@ void RasterCache::CleanupAfterFrame() {
   SweepOneCacheAfterFrame(picture_cache_, picture_metrics_);
   SweepOneCacheAfterFrame(display_list_cache_, picture_metrics_);
   SweepOneCacheAfterFrame(layer_cache_, layer_metrics_);
+  SweepDrawCostsAfterFrame(picture_draw_costs_);
+  SweepDrawCostsAfterFrame(display_list_draw_costs_);
+  picture_metrics_.rasterized_count = picture_cached_this_frame_ +
+                                      display_list_cached_this_frame_ +
+                                      nested_display_list_cached_this_frame_;
+  picture_metrics_.nested_hit_count = nested_display_list_hits_this_frame_;
+  picture_metrics_.nested_rasterized_count =
+      nested_display_list_cached_this_frame_;
+  layer_metrics_.rasterized_count = layer_cached_this_frame_;
+  shadow_cache_.CleanupAfterFrame();
   TraceStatsToTimeline();
 }
 
@@ -398,10 +564,50 @@ void RasterCache::Clear() {
   picture_cache_.clear();
   display_list_cache_.clear();
   layer_cache_.clear();
+  picture_draw_costs_.clear();
+  display_list_draw_costs_.clear();
+  shadow_cache_.Clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
 
+size_t RasterCache::EvictImagesToByteSize(size_t max_bytes) {
+  auto image_bytes = [](const Entry* entry) {
+    return static_cast<size_t>(entry->image->image_bytes());
+  };
+  std::vector<Entry*> entries;
+  size_t total_bytes = 0;
+  auto collect = [&](auto& cache) {
+    for (auto& item : cache) {
+      if (item.second.image) {
+        entries.push_back(&item.second);
+        total_bytes += image_bytes(&item.second);
+      }
+    }
+  };
+  collect(picture_cache_);
+  collect(display_list_cache_);
+  collect(layer_cache_);
+  if (total_bytes <= max_bytes) {
+    return 0;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [&image_bytes](const Entry* a, const Entry* b) {
+              return image_bytes(a) > image_bytes(b);
+            });
+  size_t evicted_bytes = 0;
+  for (Entry* entry : entries) {
+    if (total_bytes - evicted_bytes <= max_bytes) {
+      break;
+    }
+    evicted_bytes += image_bytes(entry);
+    entry->image.reset();
+    entry->evicted = true;
+  }
+  return evicted_bytes;
+}
+
 size_t RasterCache::GetCachedEntriesCount() const {
   return layer_cache_.size() + picture_cache_.size() +
          display_list_cache_.size();
@@ -411,6 +617,10 @@ size_t RasterCache::GetLayerCachedEntriesCount() const {
   return layer_cache_.size();
 }
 
+size_t RasterCache::GetShadowCachedEntriesCount() const {
+  return shadow_cache_.GetCachedEntriesCount();
+}
+
 size_t RasterCache::GetPictureCachedEntriesCount() const {
   return picture_cache_.size() + display_list_cache_.size();
 }
@@ -427,6 +637,141 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetCostBasedAdmission(bool enabled) {
+  if (cost_based_admission_ == enabled) {
+    return;
+  }
+
+  cost_based_admission_ = enabled;
+
+  // Clear all existing entries so that the entries admitted by the previous
+  // policy do not linger.
+  Clear();
+}
+
+void RasterCache::SetShowAdmissionDecisions(bool show) {
+  show_admission_decisions_ = show;
+}
+
+RasterCache::DrawCost* RasterCache::PrepareDrawCost(DrawCostMap& costs,
+                                                   uint32_t id,
+                                                   const Entry& entry) {
+  auto it = costs.find(id);
+  if (it == costs.end()) {
+    // Sampling the draw time stalls the GPU, so only the items that were
+    // already drawn in an earlier frame and will reach the access threshold
+    // within kDrawCostSampleCount frames are measured.
+    if (entry.access_count == 0 ||
+        entry.access_count + kDrawCostSampleCount < access_threshold_) {
+      return nullptr;
+    }
+    it = costs.emplace(id, DrawCost()).first;
+  }
+  it->second.used_this_frame = true;
+  return &it->second;
+}
+
+bool RasterCache::IsAdmittedByDrawCost(DrawCost& cost,
+                                       const Entry& entry,
+                                       const SkRect& logical_rect,
+                                       const SkMatrix& matrix) {
+  if (cost.sample_count == 0) {
+    // The draw time has not been measured yet.
+    cost.rejected = false;
+    return false;
+  }
+
+  // The cached image is N32, so it takes four bytes per pixel.
+  const SkIRect bounds = GetDeviceBounds(logical_rect, matrix);
+  const double cached_megabytes = static_cast<double>(bounds.width()) *
+                                  bounds.height() * 4 / kMegaByteSizeInBytes;
+  const size_t reuse = std::min(entry.access_count, kDrawCostReuseLimit);
+  const double saved_micros = cost.average_cost().ToMicrosecondsF() * reuse;
+  cost.rejected =
+      saved_micros < cached_megabytes * kDrawCostMicrosPerCachedMegabyte;
+  return !cost.rejected;
+}
+
+bool RasterCache::NeedsDrawCostSample(const DrawCostMap& costs,
+                                      uint32_t id) const {
+  if (!cost_based_admission_ || draw_cost_samples_this_frame_ > 0) {
+    return false;
+  }
+  // Only the pictures and display lists that were prepared without a hint
+  // have a draw cost.
+  auto it = costs.find(id);
+  return it != costs.end() && it->second.sample_count < kDrawCostSampleCount;
+}
+
+bool RasterCache::NeedsDrawCostSample(const SkPicture& picture) const {
+  return NeedsDrawCostSample(picture_draw_costs_, picture.uniqueID());
+}
+
+bool RasterCache::NeedsDrawCostSample(const DisplayList& display_list) const {
+  return NeedsDrawCostSample(display_list_draw_costs_,
+                             display_list.unique_id());
+}
+
+void RasterCache::RecordDrawCost(DrawCostMap& costs,
+                                 uint32_t id,
+                                 fml::TimeDelta cost) const {
+  draw_cost_samples_this_frame_++;
+  DrawCost& draw_cost = costs[id];
+  draw_cost.used_this_frame = true;
+  draw_cost.sample_count++;
+  draw_cost.total_cost = draw_cost.total_cost + cost;
+}
+
+void RasterCache::RecordDrawCost(const SkPicture& picture,
+                                 fml::TimeDelta cost) const {
+  RecordDrawCost(picture_draw_costs_, picture.uniqueID(), cost);
+}
+
+void RasterCache::RecordDrawCost(const DisplayList& display_list,
+                                 fml::TimeDelta cost) const {
+  RecordDrawCost(display_list_draw_costs_, display_list.unique_id(), cost);
+}
+
+void RasterCache::DrawAdmissionDecision(const DrawCostMap& costs,
+                                        uint32_t id,
+                                        const SkRect& logical_rect,
+                                        SkCanvas& canvas) const {
+  if (!show_admission_decisions_) {
+    return;
+  }
+  auto it = costs.find(id);
+  if (it == costs.end()) {
+    return;
+  }
+  DrawAdmissionDecisionOverlay(
+      canvas, logical_rect,
+      it->second.rejected ? SK_ColorRED : SK_ColorYELLOW);
+}
+
+void RasterCache::DrawAdmissionDecision(const SkPicture& picture,
+                                        SkCanvas& canvas) const {
+  DrawAdmissionDecision(picture_draw_costs_, picture.uniqueID(),
+                        picture.cullRect(), canvas);
+}
+
+void RasterCache::DrawAdmissionDecision(const DisplayList& display_list,
+                                        SkCanvas& canvas) const {
+  DrawAdmissionDecision(display_list_draw_costs_, display_list.unique_id(),
+                        display_list.bounds(), canvas);
+}
+
+fml::TimeDelta RasterCache::GetDrawCost(const SkPicture& picture) const {
+  auto it = picture_draw_costs_.find(picture.uniqueID());
+  return it == picture_draw_costs_.end() ? fml::TimeDelta::Zero()
+                                         : it->second.average_cost();
+}
+
+fml::TimeDelta RasterCache::GetDrawCost(const DisplayList& display_list) const {
+  auto it = display_list_draw_costs_.find(display_list.unique_id());
+  return it == display_list_draw_costs_.end() ? fml::TimeDelta::Zero()
+                                              : it->second.average_cost();
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
@@ -435,7 +780,10 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerCount", layer_metrics_.total_count(),                          //
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
-      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes,
+      "NestedHitCount", picture_metrics_.nested_hit_count,                 //
+      "ShadowCount", shadow_cache_.metrics().in_use_count,                 //
+      "ShadowHitCount", shadow_cache_.metrics().hit_count);
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -465,4 +813,62 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
+RasterCacheDrawCostSampler::RasterCacheDrawCostSampler(
+    const RasterCache* raster_cache,
+    const SkPicture& picture,
+    SkCanvas& canvas,
+    GrDirectContext* gr_context)
+    : raster_cache_(raster_cache),
+      picture_(&picture),
+      canvas_(canvas),
+      gr_context_(gr_context) {
+  Start(raster_cache_ && raster_cache_->NeedsDrawCostSample(picture));
+}
+
+RasterCacheDrawCostSampler::RasterCacheDrawCostSampler(
+    const RasterCache* raster_cache,
+    const DisplayList& display_list,
+    SkCanvas& canvas,
+    GrDirectContext* gr_context)
+    : raster_cache_(raster_cache),
+      display_list_(&display_list),
+      canvas_(canvas),
+      gr_context_(gr_context) {
+  Start(raster_cache_ && raster_cache_->NeedsDrawCostSample(display_list));
+}
+
+void RasterCacheDrawCostSampler::Start(bool needs_sample) {
+  if (!needs_sample) {
+    return;
+  }
+  TRACE_EVENT_INSTANT0("flutter", "raster cache draw cost sample");
+  sampling_ = true;
+  if (gr_context_) {
+    // Keeps the work recorded before the draw out of the measured time.
+    gr_context_->flushAndSubmit(/*syncCpu=*/true);
+  }
+  start_ = fml::TimePoint::Now();
+}
+
+RasterCacheDrawCostSampler::~RasterCacheDrawCostSampler() {
+  if (sampling_) {
+    if (gr_context_) {
+      gr_context_->flushAndSubmit(/*syncCpu=*/true);
+    }
+    const fml::TimeDelta cost = fml::TimePoint::Now() - start_;
+    if (picture_) {
+      raster_cache_->RecordDrawCost(*picture_, cost);
+    } else {
+      raster_cache_->RecordDrawCost(*display_list_, cost);
+    }
+  }
+  if (raster_cache_) {
+    if (picture_) {
+      raster_cache_->DrawAdmissionDecision(*picture_, canvas_);
+    } else {
+      raster_cache_->DrawAdmissionDecision(*display_list_, canvas_);
+    }
+  }
+}
+
 }  // namespace flutter
@@ -10,8 +10,11 @@
 
 #include "flutter/flow/display_list.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/shadow_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -65,6 +68,25 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries that were not found and had to be rasterized
+   * in this frame.
+   */
+  size_t rasterized_count = 0;
+
+  /**
+   * The number of draws of display lists nested in other display lists that
+   * were drawn from the cache in this frame.
+   */
+  size_t nested_hit_count = 0;
+
+  /**
+   * The number of display lists nested in other display lists that were
+   * rasterized into the cache in this frame. These are also counted in
+   * rasterized_count.
+   */
+  size_t nested_rasterized_count = 0;
+
   /**
    * The total cache entries that had images during this frame whether
    * they were used in the frame or held memory during the frame and then
@@ -88,6 +110,19 @@ class RasterCache {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDispLayListCacheLimitPerFrame = 3;
 
+  // The number of times the draw time of a picture or display list is
+  // measured before the cost based admission relies on the average.
+  static constexpr size_t kDrawCostSampleCount = 2;
+
+  // The cost based admission caches a picture or display list once the time
+  // its draws took over the frames it was reused in reaches this much for
+  // every megabyte its cached image would take.
+  static constexpr int64_t kDrawCostMicrosPerCachedMegabyte = 1000;
+
+  // The reuse a picture or display list is credited with is capped, so that
+  // a cheap picture that stays on screen for long is not eventually cached.
+  static constexpr size_t kDrawCostReuseLimit = 60;
+
   explicit RasterCache(size_t access_threshold = 3,
                        size_t picture_and_display_list_cache_limit_per_frame =
                            kDefaultPictureAndDispLayListCacheLimitPerFrame);
@@ -179,6 +214,8 @@ class RasterCache {
   // 2. The picture is not worth rasterizing
   // 3. The matrix is singular
   // 4. The picture is accessed too few times
+  // 5. The cost based admission is enabled and the measured draw time of the
+  //    picture does not justify the memory of its cached image
   bool Prepare(PrerollContext* context,
                SkPicture* picture,
                bool is_complex,
@@ -202,7 +239,23 @@ class RasterCache {
   // Find the raster cache for the display list and draw it to the canvas.
   //
   // Return true if it's found and drawn.
-  bool Draw(const DisplayList& display_list, SkCanvas& canvas) const;
+  bool Draw(const DisplayList& display_list,
+            SkCanvas& canvas,
+            const SkPaint* paint = nullptr) const;
+
+  // Find the raster cache for a display list that is nested in another
+  // display list and draw it to the canvas.
+  //
+  // Unlike the display lists of layers, nested display lists are not
+  // prepared. They are rasterized when they are drawn after having been drawn
+  // more than the access threshold times, and only under transforms that
+  // scale and translate. As the key ignores the translation, a display list
+  // reused at many positions, such as an icon, is rasterized once per scale.
+  //
+  // Return true if it's found or rasterized, and drawn.
+  bool DrawNested(const DisplayList& display_list,
+                  SkCanvas& canvas,
+                  const SkPaint* paint = nullptr) const;
 
   // Find the raster cache for the layer and draw it to the canvas.
   //
@@ -214,15 +267,93 @@ class RasterCache {
             SkCanvas& canvas,
             SkPaint* paint = nullptr) const;
 
+  // Draw the shadow that |PhysicalShapeLayer::DrawShadow| draws for the path
+  // from the shadow cache. See |ShadowCache|.
+  //
+  // Return true if the shadow was drawn from the cache.
+  bool DrawShadow(SkCanvas& canvas,
+                  const SkPath& path,
+                  SkColor color,
+                  float elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) const;
+
   void PrepareNewFrame();
   void CleanupAfterFrame();
 
   void Clear();
 
+  /**
+   * @brief Evict the cached images of pictures, display lists and layers,
+   * largest first, until they take no more than |max_bytes|.
+   *
+   * The entries of evicted images are kept, and they are not rasterized again
+   * for as long as they are used every frame. Otherwise the cache would grow
+   * back over |max_bytes| within a few frames.
+   *
+   * @return the number of bytes of the evicted images.
+   */
+  size_t EvictImagesToByteSize(size_t max_bytes);
+
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Admit pictures and display lists that are not hinted as complex
+   * by their measured draw time instead of their op count.
+   *
+   * The draw time is sampled by `RasterCacheDrawCostSampler` when a picture or
+   * display list is drawn without the cache, once it was drawn in an earlier
+   * frame and is within kDrawCostSampleCount frames of the access threshold.
+   * An entry is cached once its average draw time multiplied by the number
+   * of frames it was reused in (up to kDrawCostReuseLimit) reaches
+   * kDrawCostMicrosPerCachedMegabyte for every megabyte of its cached image.
+   */
+  void SetCostBasedAdmission(bool enabled);
+
+  /**
+   * @brief Outline the pictures and display lists considered by the cost
+   * based admission: green when they are drawn from the cache, red when their
+   * draw time does not justify caching them, and yellow while it is not known
+   * yet.
+   */
+  void SetShowAdmissionDecisions(bool show);
+
+  /**
+   * @brief Whether the draw time of a picture or display list drawn without
+   * the cache should be measured in this frame. At most one draw is measured
+   * per frame, as measuring the draw time on the GPU stalls the pipeline.
+   */
+  bool NeedsDrawCostSample(const SkPicture& picture) const;
+  bool NeedsDrawCostSample(const DisplayList& display_list) const;
+
+  /**
+   * @brief Record how long drawing a picture or display list without the
+   * cache took.
+   */
+  void RecordDrawCost(const SkPicture& picture, fml::TimeDelta cost) const;
+  void RecordDrawCost(const DisplayList& display_list,
+                      fml::TimeDelta cost) const;
+
+  /**
+   * @brief Outline a picture or display list drawn without the cache, if the
+   * admission decisions are shown.
+   */
+  void DrawAdmissionDecision(const SkPicture& picture, SkCanvas& canvas) const;
+  void DrawAdmissionDecision(const DisplayList& display_list,
+                             SkCanvas& canvas) const;
+
+  /**
+   * @brief The average measured draw time of a picture or display list, or
+   * zero if it has not been measured.
+   */
+  fml::TimeDelta GetDrawCost(const SkPicture& picture) const;
+  fml::TimeDelta GetDrawCost(const DisplayList& display_list) const;
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
+  const ShadowCacheMetrics& shadow_metrics() const {
+    return shadow_cache_.metrics();
+  }
 
   size_t GetCachedEntriesCount() const;
 
@@ -239,6 +370,12 @@ class RasterCache {
    */
   size_t GetPictureCachedEntriesCount() const;
 
+  /**
+   * Return the number of map entries in the shadow cache regardless of whether
+   * the entries have been populated with an image.
+   */
+  size_t GetShadowCachedEntriesCount() const;
+
   /**
    * @brief Estimate how much memory is used by picture raster cache entries in
    * bytes, including cache entries in the SkPicture cache and the DisplayList
@@ -273,10 +410,65 @@ class RasterCache {
  private:
   struct Entry {
     bool used_this_frame = false;
+    // Whether the image was evicted to fit the cache into its budget.
+    bool evicted = false;
     size_t access_count = 0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  // The measured draw time of a picture or display list, shared by the
+  // entries of all of its matrices.
+  struct DrawCost {
+    bool used_this_frame = false;
+    // Whether the last admission decision declined to cache it.
+    bool rejected = false;
+    size_t sample_count = 0;
+    fml::TimeDelta total_cost;
+
+    fml::TimeDelta average_cost() const {
+      if (sample_count == 0) {
+        return fml::TimeDelta::Zero();
+      }
+      return total_cost / static_cast<int64_t>(sample_count);
+    }
+  };
+
+  using DrawCostMap = std::unordered_map<uint32_t, DrawCost>;
+
+  static void SweepDrawCostsAfterFrame(DrawCostMap& costs) {
+    for (auto it = costs.begin(); it != costs.end();) {
+      if (!it->second.used_this_frame) {
+        it = costs.erase(it);
+      } else {
+        it->second.used_this_frame = false;
+        ++it;
+      }
+    }
+  }
+
+  // The draw cost of the picture or display list of |entry|, which is only
+  // tracked once the entry was reused and is close to the access threshold.
+  // Returns null if the draw cost is not tracked yet.
+  DrawCost* PrepareDrawCost(DrawCostMap& costs,
+                            uint32_t id,
+                            const Entry& entry);
+
+  // Whether the cost based admission caches an entry that reached the access
+  // threshold. Updates the decision shown for the picture or display list.
+  static bool IsAdmittedByDrawCost(DrawCost& cost,
+                                   const Entry& entry,
+                                   const SkRect& logical_rect,
+                                   const SkMatrix& matrix);
+
+  bool NeedsDrawCostSample(const DrawCostMap& costs, uint32_t id) const;
+  void RecordDrawCost(DrawCostMap& costs,
+                      uint32_t id,
+                      fml::TimeDelta cost) const;
+  void DrawAdmissionDecision(const DrawCostMap& costs,
+                             uint32_t id,
+                             const SkRect& logical_rect,
+                             SkCanvas& canvas) const;
+
   template <class Cache>
   static void SweepOneCacheAfterFrame(Cache& cache,
                                       RasterCacheMetrics& metrics) {
@@ -305,7 +497,8 @@ class RasterCache {
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 &&
-           picture_cached_this_frame_ + display_list_cached_this_frame_ <
+           picture_cached_this_frame_ + display_list_cached_this_frame_ +
+                   nested_display_list_cached_this_frame_ <
                picture_and_display_list_cache_limit_per_frame_;
   }
 
@@ -313,18 +506,63 @@ class RasterCache {
   const size_t picture_and_display_list_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
   size_t display_list_cached_this_frame_ = 0;
+  size_t layer_cached_this_frame_ = 0;
+  mutable size_t nested_display_list_cached_this_frame_ = 0;
+  mutable size_t nested_display_list_hits_this_frame_ = 0;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable DisplayListRasterCacheKey::Map<Entry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
+  mutable ShadowCache shadow_cache_;
   bool checkerboard_images_;
+  bool cost_based_admission_ = false;
+  bool show_admission_decisions_ = false;
+  mutable DrawCostMap picture_draw_costs_;
+  mutable DrawCostMap display_list_draw_costs_;
+  mutable size_t draw_cost_samples_this_frame_ = 0;
 
   void TraceStatsToTimeline() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(RasterCache);
 };
 
+//------------------------------------------------------------------------------
+/// Measures a draw of a picture or display list that missed the raster cache
+/// for the cost based admission of the cache, from its construction to its
+/// destruction, and outlines the draw if the admission decisions are shown.
+///
+/// The time is measured on the CPU. With a GPU context, the work recorded
+/// before the draw and the draw itself are flushed and waited for, so that the
+/// measured time includes the time the GPU took to draw.
+///
+class RasterCacheDrawCostSampler {
+ public:
+  RasterCacheDrawCostSampler(const RasterCache* raster_cache,
+                             const SkPicture& picture,
+                             SkCanvas& canvas,
+                             GrDirectContext* gr_context);
+  RasterCacheDrawCostSampler(const RasterCache* raster_cache,
+                             const DisplayList& display_list,
+                             SkCanvas& canvas,
+                             GrDirectContext* gr_context);
+
+  ~RasterCacheDrawCostSampler();
+
+ private:
+  const RasterCache* raster_cache_;
+  const SkPicture* picture_ = nullptr;
+  const DisplayList* display_list_ = nullptr;
+  SkCanvas& canvas_;
+  GrDirectContext* gr_context_;
+  bool sampling_ = false;
+  fml::TimePoint start_;
+
+  void Start(bool needs_sample);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheDrawCostSampler);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_RASTER_CACHE_H_
@@ -11,6 +11,7 @@
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -64,6 +65,23 @@ sk_sp<DisplayList> GetSampleNestedDisplayList() {
   return outer_builder.Build();
 }
 
+// Draws the sample display list five times, translated horizontally and
+// rotated by |degrees|.
+sk_sp<DisplayList> GetSampleRepeatedDisplayList(SkScalar degrees) {
+  auto nested = GetSampleDisplayList();
+  DisplayListBuilder builder(SkRect::MakeWH(500, 100));
+  if (degrees != 0) {
+    builder.rotate(degrees);
+  }
+  for (int i = 0; i < 5; i++) {
+    builder.save();
+    builder.translate(i * 100, 0);
+    builder.drawDisplayList(nested);
+    builder.restore();
+  }
+  return builder.Build();
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -473,6 +491,402 @@ TEST(RasterCache, NestedOpCountMetricUsedForDisplayList) {
   ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
 }
 
+TEST(RasterCache, CostBasedAdmissionCachesExpensiveDisplayList) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  // A single op would not be cached by its op count.
+  auto display_list = GetSampleDisplayList();
+  ASSERT_LE(display_list->op_count(true), 5);
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  // The draw time of a display list seen for the first time is not measured.
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), false, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_FALSE(cache.NeedsDrawCostSample(*display_list));
+  cache.CleanupAfterFrame();
+
+  // It reached the access threshold, but its draw time is not known yet.
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), false, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_TRUE(cache.NeedsDrawCostSample(*display_list));
+  cache.RecordDrawCost(*display_list, fml::TimeDelta::FromMilliseconds(2));
+  ASSERT_EQ(cache.GetDrawCost(*display_list),
+            fml::TimeDelta::FromMilliseconds(2));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), false, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+}
+
+TEST(RasterCache, CostBasedAdmissionRejectsCheapDisplayList) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  // The cached image would take more than 5MB.
+  SkMatrix matrix = SkMatrix::Scale(10, 10);
+
+  // Its op count alone would get the display list cached.
+  auto display_list = GetSampleNestedDisplayList();
+
+  SkCanvas dummy_canvas;
+  dummy_canvas.setMatrix(matrix);
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  for (size_t i = 0; i < RasterCache::kDrawCostReuseLimit * 2; i++) {
+    cache.PrepareNewFrame();
+    ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                               display_list.get(), false, false, matrix));
+    ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+    if (cache.NeedsDrawCostSample(*display_list)) {
+      cache.RecordDrawCost(*display_list, fml::TimeDelta::FromMicroseconds(5));
+    }
+    cache.CleanupAfterFrame();
+  }
+  ASSERT_EQ(cache.GetDrawCost(*display_list),
+            fml::TimeDelta::FromMicroseconds(5));
+}
+
+TEST(RasterCache, CostBasedAdmissionCachesComplexHintWithoutSamples) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  // Hinted pictures are not measured.
+  ASSERT_FALSE(cache.NeedsDrawCostSample(*picture));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, DrawCostIsSampledOncePerFrame) {
+  size_t threshold = 3;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  cache.Prepare(&preroll_context_holder.preroll_context, picture.get(), false,
+                false, matrix);
+  cache.Prepare(&preroll_context_holder.preroll_context, display_list.get(),
+                false, false, matrix);
+  cache.Draw(*picture, dummy_canvas);
+  cache.Draw(*display_list, dummy_canvas);
+  cache.CleanupAfterFrame();
+
+  for (size_t i = 0; i < RasterCache::kDrawCostSampleCount; i++) {
+    cache.PrepareNewFrame();
+    cache.Prepare(&preroll_context_holder.preroll_context, picture.get(), false,
+                  false, matrix);
+    cache.Prepare(&preroll_context_holder.preroll_context, display_list.get(),
+                  false, false, matrix);
+    cache.Draw(*picture, dummy_canvas);
+    cache.Draw(*display_list, dummy_canvas);
+    ASSERT_TRUE(cache.NeedsDrawCostSample(*picture));
+    {
+      RasterCacheDrawCostSampler sampler(&cache, *picture, dummy_canvas,
+                                         nullptr);
+      picture->playback(&dummy_canvas);
+    }
+    ASSERT_FALSE(cache.NeedsDrawCostSample(*display_list));
+    cache.CleanupAfterFrame();
+  }
+
+  cache.PrepareNewFrame();
+  cache.Prepare(&preroll_context_holder.preroll_context, picture.get(), false,
+                false, matrix);
+  cache.Prepare(&preroll_context_holder.preroll_context, display_list.get(),
+                false, false, matrix);
+  ASSERT_FALSE(cache.NeedsDrawCostSample(*picture));
+  ASSERT_TRUE(cache.NeedsDrawCostSample(*display_list));
+  cache.CleanupAfterFrame();
+}
+
+TEST(RasterCache, DrawCostIsOnlySampledCloseToTheAccessThreshold) {
+  size_t threshold = RasterCache::kDrawCostSampleCount + 2;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  // Drawn in 0 and then 1 earlier frames, more than kDrawCostSampleCount
+  // frames away from the threshold.
+  for (size_t i = 0; i < 2; i++) {
+    cache.PrepareNewFrame();
+    ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                               display_list.get(), false, false, matrix));
+    ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+    ASSERT_FALSE(cache.NeedsDrawCostSample(*display_list));
+    cache.CleanupAfterFrame();
+  }
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), false, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_TRUE(cache.NeedsDrawCostSample(*display_list));
+  cache.CleanupAfterFrame();
+}
+
+TEST(RasterCache, SweepsRemoveUnusedDrawCosts) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetCostBasedAdmission(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  cache.Prepare(&preroll_context_holder.preroll_context, display_list.get(),
+                false, false, matrix);
+  cache.RecordDrawCost(*display_list, fml::TimeDelta::FromMicroseconds(5));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetDrawCost(*display_list),
+            fml::TimeDelta::FromMicroseconds(5));
+
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetDrawCost(*display_list), fml::TimeDelta::Zero());
+}
+
+TEST(RasterCache, NestedDisplayListIsCachedAfterThreshold) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  auto display_list = GetSampleRepeatedDisplayList(0);
+
+  auto expected_surface = SkSurface::MakeRasterN32Premul(500, 100);
+  display_list->RenderTo(expected_surface->getCanvas());
+
+  auto surface = SkSurface::MakeRasterN32Premul(500, 100);
+  cache.PrepareNewFrame();
+  display_list->RenderTo(surface->getCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+
+  // The first two draws miss, and the third rasterizes the nested display
+  // list.
+  ASSERT_EQ(cache.picture_metrics().nested_rasterized_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().rasterized_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().nested_hit_count, 3u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  SkBitmap expected;
+  expected.allocN32Pixels(500, 100);
+  ASSERT_TRUE(expected_surface->readPixels(expected, 0, 0));
+  SkBitmap actual;
+  actual.allocN32Pixels(500, 100);
+  ASSERT_TRUE(surface->readPixels(actual, 0, 0));
+  ASSERT_EQ(memcmp(expected.getPixels(), actual.getPixels(),
+                   expected.computeByteSize()),
+            0);
+
+  // The next frame draws every nested display list from the cache.
+  cache.PrepareNewFrame();
+  display_list->RenderTo(surface->getCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().nested_rasterized_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().nested_hit_count, 5u);
+}
+
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+TEST(RasterCache, NestedDisplayListIsDrawnAtIntegralTranslation) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  auto display_list = GetSampleRepeatedDisplayList(0);
+
+  // The nested display lists are rasterized and drawn at the translation
+  // rounded to whole pixels.
+  auto expected_surface = SkSurface::MakeRasterN32Premul(500, 100);
+  expected_surface->getCanvas()->translate(0, 1);
+  display_list->RenderTo(expected_surface->getCanvas());
+
+  auto surface = SkSurface::MakeRasterN32Premul(500, 100);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->translate(0.3, 0.6);
+  cache.PrepareNewFrame();
+  display_list->RenderTo(canvas, SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+
+  canvas->clear(SK_ColorTRANSPARENT);
+  cache.PrepareNewFrame();
+  display_list->RenderTo(canvas, SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().nested_hit_count, 5u);
+
+  SkBitmap expected;
+  expected.allocN32Pixels(500, 100);
+  ASSERT_TRUE(expected_surface->readPixels(expected, 0, 0));
+  SkBitmap actual;
+  actual.allocN32Pixels(500, 100);
+  ASSERT_TRUE(surface->readPixels(actual, 0, 0));
+  ASSERT_EQ(memcmp(expected.getPixels(), actual.getPixels(),
+                   expected.computeByteSize()),
+            0);
+}
+#endif  // SUPPORT_FRACTIONAL_TRANSLATION
+
+TEST(RasterCache, NestedDisplayListIsNotCachedUnderRotation) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  auto display_list = GetSampleRepeatedDisplayList(45);
+
+  auto surface = SkSurface::MakeRasterN32Premul(500, 100);
+  cache.PrepareNewFrame();
+  display_list->RenderTo(surface->getCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.picture_metrics().nested_rasterized_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().nested_hit_count, 0u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, NestedDisplayListIsNotRasterizedIntoRecordingCanvas) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  auto display_list = GetSampleRepeatedDisplayList(0);
+
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(500, 100));
+  cache.PrepareNewFrame();
+  display_list->RenderTo(recorder.getRecordingCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.picture_metrics().nested_rasterized_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().nested_hit_count, 0u);
+}
+
+TEST(RasterCache, ShadowsOfDisplayListAreDrawnFromShadowCache) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  DisplayListBuilder builder(SkRect::MakeWH(500, 200));
+  for (int i = 0; i < 3; i++) {
+    SkRect card = SkRect::MakeXYWH(20 + i * 160, 20, 140, 120);
+    builder.drawShadow(SkPath::RRect(SkRRect::MakeRectXY(card, 4, 4)),
+                       SK_ColorBLACK, 2, false, 1);
+  }
+  auto display_list = builder.Build();
+
+  auto surface = SkSurface::MakeRasterN32Premul(500, 200);
+  cache.PrepareNewFrame();
+  display_list->RenderTo(surface->getCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+
+  // The first two shadows miss, and the third is rasterized.
+  ASSERT_EQ(cache.shadow_metrics().miss_count, 2u);
+  ASSERT_EQ(cache.shadow_metrics().rasterized_count, 1u);
+  ASSERT_EQ(cache.shadow_metrics().hit_count, 1u);
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 1u);
+
+  cache.PrepareNewFrame();
+  display_list->RenderTo(surface->getCanvas(), SK_Scalar1, &cache);
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.shadow_metrics().hit_count, 3u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, EvictsLargestImagesToFitByteSize) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto small_display_list = GetSampleDisplayList();
+  DisplayListBuilder builder(SkRect::MakeWH(300, 200));
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeWH(300, 200));
+  auto large_display_list = builder.Build();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+  auto& preroll_context = preroll_context_holder.preroll_context;
+
+  for (int i = 0; i < 2; i++) {
+    cache.PrepareNewFrame();
+    for (const auto& display_list : {small_display_list, large_display_list}) {
+      cache.Prepare(&preroll_context, display_list.get(), true, false, matrix);
+      cache.Draw(*display_list, dummy_canvas);
+    }
+    cache.CleanupAfterFrame();
+  }
+  size_t bytes = cache.EstimatePictureCacheByteSize();
+  ASSERT_GT(bytes, 0u);
+
+  // Only the image of the large display list is evicted.
+  size_t evicted_bytes = cache.EvictImagesToByteSize(bytes - 1);
+  ASSERT_GT(evicted_bytes, bytes / 2);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), bytes - evicted_bytes);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 2u);
+
+  // The evicted display list is not rasterized again while it is in use.
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context, small_display_list.get(), true,
+                            false, matrix));
+  ASSERT_TRUE(cache.Draw(*small_display_list, dummy_canvas));
+  ASSERT_FALSE(cache.Prepare(&preroll_context, large_display_list.get(), true,
+                             false, matrix));
+  ASSERT_FALSE(cache.Draw(*large_display_list, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), bytes - evicted_bytes);
+
+  ASSERT_EQ(cache.EvictImagesToByteSize(bytes), 0u);
+}
+
 }  // namespace testing
 
 }  // namespace flutter
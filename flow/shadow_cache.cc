@@ -0,0 +1,278 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shadow_cache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
+
+namespace flutter {
+
+size_t ShadowCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.radii[0].fX, key.radii[0].fY, key.radii[1].fX,
+                          key.radii[1].fY, key.radii[2].fX, key.radii[2].fY,
+                          key.radii[3].fX, key.radii[3].fY, key.scale_x,
+                          key.scale_y, key.z, key.color,
+                          key.transparent_occluder);
+}
+
+bool ShadowCache::Key::operator==(const Key& other) const {
+  return std::equal(std::begin(radii), std::end(radii),
+                    std::begin(other.radii)) &&
+         scale_x == other.scale_x && scale_y == other.scale_y &&
+         z == other.z && color == other.color &&
+         transparent_occluder == other.transparent_occluder;
+}
+
+ShadowCache::ShadowCache(size_t access_threshold,
+                         size_t rasterize_limit_per_frame)
+    : access_threshold_(access_threshold),
+      rasterize_limit_per_frame_(rasterize_limit_per_frame) {}
+
+ShadowCache::~ShadowCache() = default;
+
+static bool GetRRect(const SkPath& path, SkRRect* rrect) {
+  if (path.isInverseFillType()) {
+    return false;
+  }
+  SkRect rect;
+  if (path.isRect(&rect)) {
+    rrect->setRect(rect);
+    return true;
+  }
+  return path.isRRect(rrect);
+}
+
+bool ShadowCache::Draw(SkCanvas& canvas,
+                       const SkPath& path,
+                       SkColor color,
+                       float elevation,
+                       bool transparent_occluder,
+                       SkScalar dpr) {
+  // Disabling caching when access_threshold is zero is historic behavior.
+  if (access_threshold_ == 0) {
+    return false;
+  }
+
+  SkMatrix matrix = canvas.getTotalMatrix();
+  SkRRect rrect;
+  SkRRect device_rrect;
+  if (!matrix.isScaleTranslate() || !(dpr * elevation > 0) ||
+      !GetRRect(path, &rrect) || !rrect.transform(matrix, &device_rrect) ||
+      device_rrect.isEmpty() || !device_rrect.rect().isFinite()) {
+    uncacheable_this_frame_++;
+    return false;
+  }
+
+  Entry& entry = GetEntry(path, device_rrect, matrix, color, elevation,
+                          transparent_occluder, dpr);
+  entry.used_this_frame = true;
+
+  const SkRect& rect = device_rrect.rect();
+  if (rect.width() < entry.min_size.width() ||
+      rect.height() < entry.min_size.height()) {
+    // The shadow would not be cheaper to draw from an image that is as large
+    // as its rectangle.
+    uncacheable_this_frame_++;
+    return false;
+  }
+
+  entry.access_count++;
+  if (!entry.image) {
+    if (entry.rasterized || entry.access_count <= access_threshold_ ||
+        rasterized_this_frame_ >= rasterize_limit_per_frame_) {
+      misses_this_frame_++;
+      return false;
+    }
+
+    // Shadows are rendered with the context of the canvas they are drawn
+    // into, like nested display lists. Canvases that are neither backed by a
+    // GPU context nor by pixels cannot render them.
+    GrRecordingContext* recording_context = canvas.recordingContext();
+    GrDirectContext* context =
+        recording_context ? recording_context->asDirectContext() : nullptr;
+    if (!context && canvas.imageInfo().colorType() == kUnknown_SkColorType) {
+      misses_this_frame_++;
+      return false;
+    }
+
+    entry.rasterized = true;
+    entry.image = Rasterize(context, canvas.imageInfo().colorSpace(), entry,
+                            device_rrect, matrix, color, elevation,
+                            transparent_occluder, dpr);
+    rasterized_this_frame_++;
+    if (!entry.image) {
+      misses_this_frame_++;
+      return false;
+    }
+  }
+
+  SkRect dst = SkRect::MakeLTRB(
+      rect.fLeft - entry.outsets.fLeft, rect.fTop - entry.outsets.fTop,
+      rect.fRight + entry.outsets.fRight, rect.fBottom + entry.outsets.fBottom);
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.resetMatrix();
+  canvas.drawImageNine(entry.image.get(), entry.center, dst,
+                       SkFilterMode::kLinear, nullptr);
+  hits_this_frame_++;
+  return true;
+}
+
+ShadowCache::Entry& ShadowCache::GetEntry(const SkPath& path,
+                                          const SkRRect& device_rrect,
+                                          const SkMatrix& matrix,
+                                          SkColor color,
+                                          float elevation,
+                                          bool transparent_occluder,
+                                          SkScalar dpr) {
+  Key key;
+  for (int i = 0; i < 4; i++) {
+    key.radii[i] = device_rrect.radii(static_cast<SkRRect::Corner>(i));
+  }
+  key.scale_x = matrix.getScaleX();
+  key.scale_y = matrix.getScaleY();
+  key.z = dpr * elevation;
+  key.color = color;
+  key.transparent_occluder = transparent_occluder;
+
+  auto [it, inserted] = cache_.try_emplace(key);
+  Entry& entry = it->second;
+  if (!inserted) {
+    return entry;
+  }
+
+  // The outsets are rounded out to whole pixels, with one more pixel for
+  // antialiasing.
+  auto outset = [](SkScalar distance) {
+    return SkScalarCeilToInt(std::max(distance, 0.0f)) + 1;
+  };
+  const SkRect& rect = device_rrect.rect();
+  SkRect shadow_bounds = matrix.mapRect(
+      PhysicalShapeLayer::ComputeShadowBounds(path, elevation, dpr, matrix));
+  entry.outsets =
+      SkIRect::MakeLTRB(outset(rect.fLeft - shadow_bounds.fLeft),
+                        outset(rect.fTop - shadow_bounds.fTop),
+                        outset(shadow_bounds.fRight - rect.fRight),
+                        outset(shadow_bounds.fBottom - rect.fBottom));
+
+  // The spot shadow is offset from the rectangle, and both shadows are
+  // blurred, by no more than the shadow extends beyond the rectangle. So the
+  // shadow is uniform along the edges of the rectangle once it is further
+  // than its corner radius and twice that extent from its corners.
+  int extent = std::max({entry.outsets.fLeft, entry.outsets.fTop,
+                         entry.outsets.fRight, entry.outsets.fBottom});
+  SkScalar radius_x = 0;
+  SkScalar radius_y = 0;
+  for (const SkVector& radii : key.radii) {
+    radius_x = std::max(radius_x, radii.fX);
+    radius_y = std::max(radius_y, radii.fY);
+  }
+  int fixed_x = SkScalarCeilToInt(radius_x) + 2 * extent;
+  int fixed_y = SkScalarCeilToInt(radius_y) + 2 * extent;
+  entry.center = SkIRect::MakeXYWH(entry.outsets.fLeft + fixed_x,
+                                   entry.outsets.fTop + fixed_y, 1, 1);
+  entry.min_size = SkISize::Make(2 * fixed_x + 1, 2 * fixed_y + 1);
+  return entry;
+}
+
+sk_sp<SkImage> ShadowCache::Rasterize(GrDirectContext* context,
+                                      SkColorSpace* dst_color_space,
+                                      const Entry& entry,
+                                      const SkRRect& device_rrect,
+                                      const SkMatrix& matrix,
+                                      SkColor color,
+                                      float elevation,
+                                      bool transparent_occluder,
+                                      SkScalar dpr) {
+  TRACE_EVENT0("flutter", "ShadowCache::Rasterize");
+  const SkIRect& outsets = entry.outsets;
+  const SkISize& size = entry.min_size;
+
+  // The rectangle of the smallest size the image can be stretched to, in the
+  // pixels of the image.
+  SkVector radii[4];
+  for (int i = 0; i < 4; i++) {
+    radii[i] = device_rrect.radii(static_cast<SkRRect::Corner>(i));
+  }
+  SkRRect image_rrect;
+  image_rrect.setRectRadii(
+      SkRect::MakeXYWH(outsets.fLeft, outsets.fTop, size.width(),
+                       size.height()),
+      radii);
+
+  // The blur of the shadow depends on the scale of the transform, but the
+  // directional light makes the shadow independent of the translation.
+  SkMatrix scale = SkMatrix::Scale(matrix.getScaleX(), matrix.getScaleY());
+  SkMatrix inverse;
+  SkRRect local_rrect;
+  if (!scale.invert(&inverse) ||
+      !image_rrect.transform(inverse, &local_rrect)) {
+    return nullptr;
+  }
+
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      outsets.fLeft + size.width() + outsets.fRight,
+      outsets.fTop + size.height() + outsets.fBottom,
+      sk_ref_sp(dst_color_space));
+
+  sk_sp<SkSurface> surface =
+      context
+          ? SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info)
+          : SkSurface::MakeRaster(image_info);
+
+  if (!surface) {
+    return nullptr;
+  }
+
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->concat(scale);
+  PhysicalShapeLayer::DrawShadow(canvas, SkPath::RRect(local_rrect), color,
+                                 elevation, transparent_occluder, dpr);
+  return surface->makeImageSnapshot();
+}
+
+void ShadowCache::PrepareNewFrame() {
+  hits_this_frame_ = 0;
+  rasterized_this_frame_ = 0;
+  misses_this_frame_ = 0;
+  uncacheable_this_frame_ = 0;
+}
+
+void ShadowCache::CleanupAfterFrame() {
+  metrics_ = {};
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    Entry& entry = it->second;
+    if (!entry.used_this_frame) {
+      if (entry.image) {
+        metrics_.eviction_count++;
+      }
+      it = cache_.erase(it);
+      continue;
+    }
+    if (entry.image) {
+      metrics_.in_use_count++;
+      metrics_.in_use_bytes += entry.image->imageInfo().computeMinByteSize();
+    }
+    entry.used_this_frame = false;
+    ++it;
+  }
+  metrics_.hit_count = hits_this_frame_;
+  metrics_.rasterized_count = rasterized_this_frame_;
+  metrics_.miss_count = misses_this_frame_;
+  metrics_.uncacheable_count = uncacheable_this_frame_;
+}
+
+void ShadowCache::Clear() {
+  cache_.clear();
+  metrics_ = {};
+}
+
+}  // namespace flutter
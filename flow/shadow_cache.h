@@ -0,0 +1,176 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_SHADOW_CACHE_H_
+#define FLUTTER_FLOW_SHADOW_CACHE_H_
+
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+struct ShadowCacheMetrics {
+  /**
+   * The number of shadows drawn from a cached image in this frame.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of shadows that were rendered into a cached image in this
+   * frame. These are also counted in hit_count.
+   */
+  size_t rasterized_count = 0;
+
+  /**
+   * The number of shadows that could have been drawn from a cached image but
+   * were drawn analytically in this frame, because they were not drawn often
+   * enough yet or their image could not be rendered.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The number of shadows that cannot be cached and were drawn analytically
+   * in this frame, such as the shadows of arbitrary paths.
+   */
+  size_t uncacheable_count = 0;
+
+  /**
+   * The number of cached images used in this frame.
+   */
+  size_t in_use_count = 0;
+
+  /**
+   * The size of all of the cached images used in this frame.
+   */
+  size_t in_use_bytes = 0;
+
+  /**
+   * The number of cached images evicted after this frame.
+   */
+  size_t eviction_count = 0;
+};
+
+//------------------------------------------------------------------------------
+/// Caches the shadows drawn by |PhysicalShapeLayer::DrawShadow| for rounded
+/// rectangles as nine-patch images.
+///
+/// The shadow of a rounded rectangle drawn with the directional light of
+/// |PhysicalShapeLayer| does not depend on where the rectangle is drawn, and
+/// along its straight edges it does not depend on how long they are. The cache
+/// renders the shadow of a rectangle that is just large enough to hold the
+/// corners and the blur of the shadow once, and stretches the center row and
+/// column of that image to the size of every rectangle drawn with the same
+/// corner radii, elevation, color and scale.
+///
+/// Only shadows drawn under transforms that scale and translate and whose
+/// rectangle is larger than the cached image are cached. All other shadows,
+/// including those of arbitrary paths, are left to be drawn analytically.
+///
+class ShadowCache {
+ public:
+  // The default max number of shadow images to be rendered per frame.
+  static constexpr size_t kDefaultRasterizeLimitPerFrame = 8;
+
+  explicit ShadowCache(
+      size_t access_threshold,
+      size_t rasterize_limit_per_frame = kDefaultRasterizeLimitPerFrame);
+
+  ~ShadowCache();
+
+  // Draw the shadow of |path| from the cache, rendering it into the cache
+  // once it was drawn more than the access threshold times.
+  //
+  // Return true if the shadow was drawn, and false if the caller has to draw
+  // it with |PhysicalShapeLayer::DrawShadow|.
+  bool Draw(SkCanvas& canvas,
+            const SkPath& path,
+            SkColor color,
+            float elevation,
+            bool transparent_occluder,
+            SkScalar dpr);
+
+  void PrepareNewFrame();
+  void CleanupAfterFrame();
+
+  void Clear();
+
+  const ShadowCacheMetrics& metrics() const { return metrics_; }
+
+  size_t GetCachedEntriesCount() const { return cache_.size(); }
+
+ private:
+  // Everything that the cached image of a shadow depends on.
+  struct Key {
+    // The corner radii of the rectangle in device pixels.
+    SkVector radii[4];
+    // The scale of the transform, which the blur of the shadow depends on.
+    SkScalar scale_x;
+    SkScalar scale_y;
+    // The elevation multiplied by the device pixel ratio.
+    SkScalar z;
+    SkColor color;
+    bool transparent_occluder;
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct Entry {
+    bool used_this_frame = false;
+    bool rasterized = false;
+    size_t access_count = 0;
+    // How far the image extends beyond the rectangle on each side, in
+    // device pixels.
+    SkIRect outsets = SkIRect::MakeEmpty();
+    // The center of the image, which is stretched to the rectangle.
+    SkIRect center = SkIRect::MakeEmpty();
+    // The smallest rectangle the image can be stretched to.
+    SkISize min_size = SkISize::MakeEmpty();
+    sk_sp<SkImage> image;
+  };
+
+  // Find the cache entry for the shadow of |device_rrect|, computing how the
+  // image of a new entry is laid out.
+  Entry& GetEntry(const SkPath& path,
+                  const SkRRect& device_rrect,
+                  const SkMatrix& matrix,
+                  SkColor color,
+                  float elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr);
+
+  static sk_sp<SkImage> Rasterize(GrDirectContext* context,
+                                  SkColorSpace* dst_color_space,
+                                  const Entry& entry,
+                                  const SkRRect& device_rrect,
+                                  const SkMatrix& matrix,
+                                  SkColor color,
+                                  float elevation,
+                                  bool transparent_occluder,
+                                  SkScalar dpr);
+
+  const size_t access_threshold_;
+  const size_t rasterize_limit_per_frame_;
+  size_t hits_this_frame_ = 0;
+  size_t rasterized_this_frame_ = 0;
+  size_t misses_this_frame_ = 0;
+  size_t uncacheable_this_frame_ = 0;
+  ShadowCacheMetrics metrics_;
+  std::unordered_map<Key, Entry, Key::Hash> cache_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShadowCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_SHADOW_CACHE_H_
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares drawing the shadows of a grid of cards with
+// PhysicalShapeLayer::DrawShadow with and without the shadow cache.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+constexpr int kCardColumns = 4;
+constexpr SkScalar kCardWidth = 180;
+constexpr SkScalar kCardHeight = 120;
+constexpr SkScalar kCardSpacing = 20;
+constexpr float kCardElevation = 4;
+constexpr SkScalar kDevicePixelRatio = 2;
+
+// Draws the shadows of |card_count| cards in rows of kCardColumns.
+static void DrawCardShadows(SkCanvas* canvas,
+                            int card_count,
+                            const RasterCache* raster_cache) {
+  for (int i = 0; i < card_count; i++) {
+    SkRect card = SkRect::MakeXYWH(
+        (i % kCardColumns) * (kCardWidth + kCardSpacing) + kCardSpacing,
+        (i / kCardColumns) * (kCardHeight + kCardSpacing) + kCardSpacing,
+        kCardWidth, kCardHeight);
+    PhysicalShapeLayer::DrawShadow(
+        canvas, SkPath::RRect(SkRRect::MakeRectXY(card, 8, 8)), SK_ColorBLACK,
+        kCardElevation, false, kDevicePixelRatio, raster_cache);
+  }
+}
+
+static sk_sp<SkSurface> MakeSurface(int card_count) {
+  int rows = (card_count + kCardColumns - 1) / kCardColumns;
+  return SkSurface::MakeRasterN32Premul(
+      static_cast<int>(kCardColumns * (kCardWidth + kCardSpacing) +
+                       kCardSpacing),
+      static_cast<int>(rows * (kCardHeight + kCardSpacing) + kCardSpacing));
+}
+
+static void BM_DrawShadowAnalytic(benchmark::State& state) {  // NOLINT
+  const int card_count = state.range(0);
+  sk_sp<SkSurface> surface = MakeSurface(card_count);
+  while (state.KeepRunning()) {
+    DrawCardShadows(surface->getCanvas(), card_count, nullptr);
+  }
+  state.SetItemsProcessed(state.iterations() * card_count);
+}
+
+static void BM_DrawShadowCached(benchmark::State& state) {  // NOLINT
+  const int card_count = state.range(0);
+  sk_sp<SkSurface> surface = MakeSurface(card_count);
+  RasterCache raster_cache;
+  while (state.KeepRunning()) {
+    raster_cache.PrepareNewFrame();
+    DrawCardShadows(surface->getCanvas(), card_count, &raster_cache);
+    raster_cache.CleanupAfterFrame();
+  }
+  state.counters["ShadowHitsPerFrame"] =
+      static_cast<double>(raster_cache.shadow_metrics().hit_count);
+  state.SetItemsProcessed(state.iterations() * card_count);
+}
+
+BENCHMARK(BM_DrawShadowAnalytic)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK(BM_DrawShadowCached)->RangeMultiplier(4)->Range(4, 64);
+
+}  // namespace flutter
@@ -0,0 +1,261 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shadow_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+constexpr float kElevation = 4;
+constexpr SkScalar kDpr = 2;
+
+SkPath GetCardPath(SkScalar x, SkScalar y) {
+  return SkPath::RRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(x, y, 160, 120),
+                                           8, 8));
+}
+
+bool DrawCardShadow(ShadowCache& cache, SkCanvas& canvas, const SkPath& path) {
+  return cache.Draw(canvas, path, SK_ColorBLACK, kElevation, false, kDpr);
+}
+
+// The largest difference of a color channel between the pixels of the
+// surfaces.
+int GetMaxDifference(SkSurface* expected_surface, SkSurface* actual_surface) {
+  SkBitmap expected;
+  expected.allocN32Pixels(expected_surface->width(),
+                          expected_surface->height());
+  EXPECT_TRUE(expected_surface->readPixels(expected, 0, 0));
+  SkBitmap actual;
+  actual.allocN32Pixels(actual_surface->width(), actual_surface->height());
+  EXPECT_TRUE(actual_surface->readPixels(actual, 0, 0));
+
+  int max_difference = 0;
+  for (int y = 0; y < expected.height(); y++) {
+    for (int x = 0; x < expected.width(); x++) {
+      SkColor expected_color = expected.getColor(x, y);
+      SkColor actual_color = actual.getColor(x, y);
+      for (int shift = 0; shift < 32; shift += 8) {
+        int difference = std::abs(
+            static_cast<int>((expected_color >> shift) & 0xff) -
+            static_cast<int>((actual_color >> shift) & 0xff));
+        max_difference = std::max(max_difference, difference);
+      }
+    }
+  }
+  return max_difference;
+}
+
+}  // namespace
+
+TEST(ShadowCache, RRectShadowIsCachedAfterThreshold) {
+  size_t threshold = 2;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(800, 200);
+  SkCanvas* canvas = surface->getCanvas();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(DrawCardShadow(cache, *canvas, GetCardPath(20, 20)));
+  ASSERT_FALSE(DrawCardShadow(cache, *canvas, GetCardPath(220, 20)));
+  ASSERT_TRUE(DrawCardShadow(cache, *canvas, GetCardPath(420, 20)));
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().miss_count, 2u);
+  ASSERT_EQ(cache.metrics().rasterized_count, 1u);
+  ASSERT_EQ(cache.metrics().hit_count, 1u);
+  ASSERT_EQ(cache.metrics().in_use_count, 1u);
+  ASSERT_GT(cache.metrics().in_use_bytes, 0u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  // The next frame draws every shadow from the cache, including the shadow
+  // of a card of another size.
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(DrawCardShadow(cache, *canvas, GetCardPath(20, 20)));
+  ASSERT_TRUE(DrawCardShadow(cache, *canvas, GetCardPath(220, 20)));
+  SkPath wide_card = SkPath::RRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(420, 20, 300, 150), 8, 8));
+  ASSERT_TRUE(DrawCardShadow(cache, *canvas, wide_card));
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().miss_count, 0u);
+  ASSERT_EQ(cache.metrics().rasterized_count, 0u);
+  ASSERT_EQ(cache.metrics().hit_count, 3u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+}
+
+TEST(ShadowCache, CachedShadowMatchesAnalyticShadow) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+  SkPath path = GetCardPath(40, 30);
+  SkPath rect_path = SkPath::Rect(SkRect::MakeXYWH(40, 230, 250, 100));
+
+  auto expected_surface = SkSurface::MakeRasterN32Premul(400, 400);
+  SkCanvas* expected_canvas = expected_surface->getCanvas();
+  expected_canvas->scale(1.25, 1);
+  PhysicalShapeLayer::DrawShadow(expected_canvas, path, SK_ColorBLACK,
+                                 kElevation, false, kDpr);
+  PhysicalShapeLayer::DrawShadow(expected_canvas, rect_path, SK_ColorBLACK,
+                                 kElevation, false, kDpr);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 400);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->scale(1.25, 1);
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 2; i++) {
+    canvas->clear(SK_ColorTRANSPARENT);
+    for (const SkPath& shadow_path : {path, rect_path}) {
+      if (!DrawCardShadow(cache, *canvas, shadow_path)) {
+        PhysicalShapeLayer::DrawShadow(canvas, shadow_path, SK_ColorBLACK,
+                                       kElevation, false, kDpr);
+      }
+    }
+  }
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.metrics().hit_count, 2u);
+
+  // The stretched image only differs by rounding.
+  ASSERT_LE(GetMaxDifference(expected_surface.get(), surface.get()), 4);
+}
+
+TEST(ShadowCache, ShadowsOfDifferentElevationsAreCachedSeparately) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 200);
+  SkCanvas* canvas = surface->getCanvas();
+  SkPath path = GetCardPath(20, 20);
+
+  cache.PrepareNewFrame();
+  for (float elevation : {1.0f, 3.0f, 1.0f, 3.0f}) {
+    cache.Draw(*canvas, path, SK_ColorBLACK, elevation, false, kDpr);
+  }
+  cache.Draw(*canvas, path, SK_ColorBLACK, 1, true, kDpr);
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().rasterized_count, 2u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 3u);
+}
+
+TEST(ShadowCache, PathShadowIsNotCached) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 200);
+  SkPath path;
+  path.moveTo(20, 20);
+  path.lineTo(220, 20);
+  path.lineTo(120, 180);
+  path.close();
+
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(DrawCardShadow(cache, *surface->getCanvas(), path));
+  }
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().uncacheable_count, 3u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(ShadowCache, ShadowIsNotCachedUnderRotation) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 400);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->rotate(30);
+
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(DrawCardShadow(cache, *canvas, GetCardPath(100, 20)));
+  }
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().uncacheable_count, 3u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(ShadowCache, ShadowOfSmallRRectIsNotCached) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(200, 200);
+  SkPath path = SkPath::RRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(20, 20, 24, 24), 12, 12));
+
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(DrawCardShadow(cache, *surface->getCanvas(), path));
+  }
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().uncacheable_count, 3u);
+  ASSERT_EQ(cache.metrics().rasterized_count, 0u);
+}
+
+TEST(ShadowCache, ShadowIsNotRasterizedIntoRecordingCanvas) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(400, 200));
+
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(DrawCardShadow(cache, *canvas, GetCardPath(20, 20)));
+  }
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.metrics().miss_count, 3u);
+  ASSERT_EQ(cache.metrics().rasterized_count, 0u);
+}
+
+TEST(ShadowCache, UnusedShadowsAreEvicted) {
+  size_t threshold = 1;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 200);
+  SkCanvas* canvas = surface->getCanvas();
+
+  cache.PrepareNewFrame();
+  DrawCardShadow(cache, *canvas, GetCardPath(20, 20));
+  ASSERT_TRUE(DrawCardShadow(cache, *canvas, GetCardPath(20, 20)));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(ShadowCache, ZeroThresholdDisablesCache) {
+  size_t threshold = 0;
+  ShadowCache cache(threshold);
+
+  auto surface = SkSurface::MakeRasterN32Premul(400, 200);
+
+  cache.PrepareNewFrame();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(
+        DrawCardShadow(cache, *surface->getCanvas(), GetCardPath(20, 20)));
+  }
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
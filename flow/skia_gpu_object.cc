@@ -4,6 +4,8 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <algorithm>
+
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/trace_event.h"
 
@@ -49,4 +51,33 @@ void SkiaUnrefQueue::Drain() {
   }
 }
 
+bool SkiaUnrefQueue::DrainUpTo(size_t max_count) {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainUpTo");
+  std::deque<SkRefCnt*> skia_objects;
+  bool has_more;
+  {
+    std::scoped_lock lock(mutex_);
+    const size_t count = std::min(max_count, objects_.size());
+    skia_objects.assign(objects_.begin(), objects_.begin() + count);
+    objects_.erase(objects_.begin(), objects_.begin() + count);
+    has_more = !objects_.empty();
+  }
+
+  for (SkRefCnt* skia_object : skia_objects) {
+    skia_object->unref();
+  }
+
+  // Purging the resources Skia deferred is not bounded by the slice, so it is
+  // only done once the last slice was drained.
+  if (context_ && skia_objects.size() > 0 && !has_more) {
+    context_->performDeferredCleanup(std::chrono::milliseconds(0));
+  }
+  return has_more;
+}
+
+bool SkiaUnrefQueue::HasPendingObjects() {
+  std::scoped_lock lock(mutex_);
+  return !objects_.empty();
+}
+
 }  // namespace flutter
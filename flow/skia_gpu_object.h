@@ -29,6 +29,15 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // after this call.
   void Drain();
 
+  // Unrefs at most |max_count| of the oldest queued objects, so that the queue
+  // can be drained in slices that fit into the slack between frames. Returns
+  // whether objects remain queued. The delayed drain stays scheduled in case
+  // no further slices are run.
+  bool DrainUpTo(size_t max_count);
+
+  // Whether any objects are waiting to be drained.
+  bool HasPendingObjects();
+
  private:
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
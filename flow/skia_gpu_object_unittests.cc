@@ -5,6 +5,7 @@
 #include "flutter/flow/skia_gpu_object.h"
 
 #include <future>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -127,5 +128,31 @@ TEST_F(SkiaGpuObjectTest, ObjectResetTwice) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, DrainUpToUnrefsOldestObjects) {
+  std::vector<std::shared_ptr<fml::AutoResetWaitableEvent>> latches;
+  for (int i = 0; i < 3; i++) {
+    latches.push_back(std::make_shared<fml::AutoResetWaitableEvent>());
+    delayed_unref_queue()->Unref(new TestSkObject(latches.back(), nullptr));
+  }
+
+  fml::AutoResetWaitableEvent drained;
+  bool has_more_after_first_slice = false;
+  bool has_more_after_second_slice = true;
+  unref_task_runner()->PostTask([&]() {
+    has_more_after_first_slice = delayed_unref_queue()->DrainUpTo(2);
+    EXPECT_TRUE(latches[0]->IsSignaledForTest());
+    EXPECT_TRUE(latches[1]->IsSignaledForTest());
+    EXPECT_FALSE(latches[2]->IsSignaledForTest());
+    has_more_after_second_slice = delayed_unref_queue()->DrainUpTo(2);
+    EXPECT_TRUE(latches[2]->IsSignaledForTest());
+    drained.Signal();
+  });
+  drained.Wait();
+
+  ASSERT_TRUE(has_more_after_first_slice);
+  ASSERT_FALSE(has_more_after_second_slice);
+  ASSERT_FALSE(delayed_unref_queue()->HasPendingObjects());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -43,6 +43,7 @@ void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   context->has_platform_view = fake_has_platform_view_;
   set_paint_bounds(fake_paint_path_.getBounds());
+  set_layer_can_inherit_opacity(fake_can_inherit_opacity_);
   if (fake_reads_surface_) {
     context->surface_needs_readback = true;
   }
@@ -51,6 +52,12 @@ void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 void MockLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
+  if (context.inherited_opacity < SK_Scalar1) {
+    SkPaint paint = fake_paint_;
+    paint.setAlphaf(paint.getAlphaf() * context.inherited_opacity);
+    context.leaf_nodes_canvas->drawPath(fake_paint_path_, paint);
+    return;
+  }
   context.leaf_nodes_canvas->drawPath(fake_paint_path_, fake_paint_);
 }
 
@@ -12,17 +12,20 @@
 namespace fml {
 
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
-    size_t worker_count) {
+    size_t worker_count,
+    const ThreadPolicy& worker_policy) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(worker_count, worker_policy)};
 }
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             const ThreadPolicy& worker_policy)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
+    workers_.emplace_back([i, this, worker_policy]() {
       fml::Thread::SetCurrentThreadName(
           std::string{"io.worker." + std::to_string(i + 1)});
+      SetCurrentThreadPolicy(worker_policy);
       WorkerMain();
     });
   }
@@ -101,6 +104,7 @@ void ConcurrentMessageLoop::WorkerMain() {
     lock.unlock();
 
     TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+    TraceCurrentThreadPlacement();
     // Execute the primary task we woke up for.
     if (task) {
       task();
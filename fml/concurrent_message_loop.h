@@ -13,6 +13,7 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread_policy.h"
 
 namespace fml {
 
@@ -22,7 +23,8 @@ class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      const ThreadPolicy& worker_policy = ThreadPolicy());
 
   ~ConcurrentMessageLoop();
 
@@ -46,7 +48,7 @@ class ConcurrentMessageLoop
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
 
-  ConcurrentMessageLoop(size_t worker_count);
+  ConcurrentMessageLoop(size_t worker_count, const ThreadPolicy& worker_policy);
 
   void WorkerMain();
 
@@ -119,14 +119,28 @@ MallocMapping::MallocMapping() : data_(nullptr), size_(0) {}
 MallocMapping::MallocMapping(uint8_t* data, size_t size)
     : data_(data), size_(size) {}
 
+MallocMapping::MallocMapping(uint8_t* data,
+                             size_t size,
+                             ReleaseProc release_proc)
+    : data_(data), size_(size), release_proc_(std::move(release_proc)) {}
+
 MallocMapping::MallocMapping(fml::MallocMapping&& mapping)
-    : data_(mapping.data_), size_(mapping.size_) {
+    : data_(mapping.data_),
+      size_(mapping.size_),
+      release_proc_(std::move(mapping.release_proc_)) {
   mapping.data_ = nullptr;
   mapping.size_ = 0;
+  mapping.release_proc_ = nullptr;
 }
 
 MallocMapping::~MallocMapping() {
-  free(data_);
+  if (release_proc_) {
+    if (data_) {
+      release_proc_(data_, size_);
+    }
+  } else {
+    free(data_);
+  }
   data_ = nullptr;
 }
 
@@ -151,6 +165,14 @@ bool MallocMapping::IsDontNeedSafe() const {
 }
 
 uint8_t* MallocMapping::Release() {
+  if (release_proc_ && data_) {
+    uint8_t* copy = Copy(data_, size_).Release();
+    release_proc_(data_, size_);
+    release_proc_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    return copy;
+  }
   uint8_t* result = data_;
   data_ = nullptr;
   size_ = 0;
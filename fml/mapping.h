@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_MAPPING_H_
 #define FLUTTER_FML_MAPPING_H_
 
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <string>
@@ -143,6 +144,8 @@ class NonOwnedMapping final : public Mapping {
 /// A Mapping like NonOwnedMapping, but uses Free as its release proc.
 class MallocMapping final : public Mapping {
  public:
+  using ReleaseProc = std::function<void(uint8_t* data, size_t size)>;
+
   MallocMapping();
 
   /// Creates a MallocMapping for a region of memory (without copying it).
@@ -151,6 +154,15 @@ class MallocMapping final : public Mapping {
   /// @param size The size of the mapping in bytes.
   MallocMapping(uint8_t* data, size_t size);
 
+  /// Adopts a region of memory that was not necessarily allocated with
+  /// `malloc` (without copying it). `release_proc` is invoked instead of
+  /// `free` when the mapping is destroyed. This lets buffers owned by an
+  /// embedder travel through APIs that take a MallocMapping without a copy.
+  /// @param data The starting address of the mapping.
+  /// @param size The size of the mapping in bytes.
+  /// @param release_proc Releases the region. May be called on any thread.
+  MallocMapping(uint8_t* data, size_t size, ReleaseProc release_proc);
+
   MallocMapping(fml::MallocMapping&& mapping);
 
   ~MallocMapping() override;
@@ -182,11 +194,15 @@ class MallocMapping final : public Mapping {
 
   /// Removes ownership of the data buffer.
   /// After this is called; the mapping will point to nullptr.
+  /// The returned buffer must be released with `free`. If the mapping was
+  /// created with a custom release proc, its data is copied into a `malloc`ed
+  /// buffer first and the original region is released.
   [[nodiscard]] uint8_t* Release();
 
  private:
   uint8_t* data_;
   size_t size_;
+  ReleaseProc release_proc_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MallocMapping);
 };
@@ -52,6 +52,37 @@ TEST(MallocMapping, Release) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(MallocMapping, CustomReleaseProc) {
+  uint8_t buffer[10] = {};
+  int release_count = 0;
+  {
+    MallocMapping mapping(buffer, sizeof(buffer),
+                          [&](uint8_t* data, size_t size) {
+                            ASSERT_EQ(buffer, data);
+                            ASSERT_EQ(sizeof(buffer), size);
+                            release_count++;
+                          });
+    MallocMapping moved = std::move(mapping);
+    ASSERT_EQ(buffer, moved.GetMapping());
+    ASSERT_EQ(0, release_count);
+  }
+  ASSERT_EQ(1, release_count);
+}
+
+TEST(MallocMapping, ReleaseWithCustomReleaseProcCopies) {
+  uint8_t buffer[10];
+  memset(buffer, 0xac, sizeof(buffer));
+  int release_count = 0;
+  MallocMapping mapping(buffer, sizeof(buffer),
+                        [&](uint8_t* data, size_t size) { release_count++; });
+  uint8_t* released = mapping.Release();
+  ASSERT_NE(buffer, released);
+  ASSERT_EQ(0, memcmp(buffer, released, sizeof(buffer)));
+  ASSERT_EQ(1, release_count);
+  ASSERT_EQ(nullptr, mapping.GetMapping());
+  free(released);
+}
+
 TEST(MallocMapping, IsDontNeedSafe) {
   size_t length = 10;
   MallocMapping mapping(reinterpret_cast<uint8_t*>(malloc(length)), length);
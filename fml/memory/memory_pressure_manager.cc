@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_pressure_manager.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+struct MemoryPressureManager::Registration::Entry {
+  std::string name;
+  fml::RefPtr<TaskRunner> task_runner;
+  TrimCallback trim;
+  std::atomic<size_t> bytes{0};
+  std::atomic<size_t> entries{0};
+  std::atomic<size_t> budget_bytes{0};
+  // Set while a trim requested because of the budget is in flight, so that a
+  // cache that keeps growing before it gets to trim is only asked once.
+  std::atomic_bool budget_trim_pending{false};
+  // Held while |trim| runs, so that unregistering waits for a trim running on
+  // another thread.
+  std::mutex trim_mutex;
+  bool registered = true;
+};
+
+MemoryPressureManager::Registration::Registration(
+    MemoryPressureManager* manager,
+    std::shared_ptr<Entry> entry)
+    : manager_(manager), entry_(std::move(entry)) {}
+
+MemoryPressureManager::Registration::~Registration() {
+  {
+    std::scoped_lock lock(entry_->trim_mutex);
+    entry_->registered = false;
+  }
+  manager_->Unregister(entry_);
+}
+
+void MemoryPressureManager::Registration::SetUsage(size_t bytes,
+                                                   size_t entries) {
+  entry_->bytes.store(bytes, std::memory_order_relaxed);
+  entry_->entries.store(entries, std::memory_order_relaxed);
+  size_t budget = entry_->budget_bytes.load(std::memory_order_relaxed);
+  if (budget > 0 && bytes > budget &&
+      !entry_->budget_trim_pending.exchange(true)) {
+    TRACE_EVENT_INSTANT1("flutter", "CacheBudgetExceeded", "cache",
+                         entry_->name.c_str());
+    RequestTrim(entry_, MemoryPressureLevel::kModerate);
+  }
+}
+
+size_t MemoryPressureManager::Registration::GetBudget() const {
+  return entry_->budget_bytes.load(std::memory_order_relaxed);
+}
+
+MemoryPressureManager& MemoryPressureManager::GetInstance() {
+  // Never destroyed, as caches may unregister during static destruction.
+  static MemoryPressureManager* instance = new MemoryPressureManager();
+  return *instance;
+}
+
+MemoryPressureManager::MemoryPressureManager() = default;
+
+MemoryPressureManager::~MemoryPressureManager() = default;
+
+std::unique_ptr<MemoryPressureManager::Registration>
+MemoryPressureManager::Register(std::string name,
+                                fml::RefPtr<TaskRunner> task_runner,
+                                TrimCallback trim) {
+  auto entry = std::make_shared<Registration::Entry>();
+  entry->name = std::move(name);
+  entry->task_runner = std::move(task_runner);
+  entry->trim = std::move(trim);
+  {
+    std::scoped_lock lock(mutex_);
+    auto budget = budgets_.find(entry->name);
+    if (budget != budgets_.end()) {
+      entry->budget_bytes = budget->second;
+    }
+    entries_.push_back(entry);
+  }
+  return std::unique_ptr<Registration>(new Registration(this, entry));
+}
+
+void MemoryPressureManager::SetBudget(const std::string& name,
+                                      size_t budget_bytes) {
+  std::scoped_lock lock(mutex_);
+  if (budget_bytes > 0) {
+    budgets_[name] = budget_bytes;
+  } else {
+    budgets_.erase(name);
+  }
+  for (const auto& entry : entries_) {
+    if (entry->name == name) {
+      entry->budget_bytes = budget_bytes;
+    }
+  }
+}
+
+void MemoryPressureManager::NotifyMemoryPressure(MemoryPressureLevel level) {
+  TRACE_EVENT1("flutter", "MemoryPressureManager::NotifyMemoryPressure",
+               "level",
+               level == MemoryPressureLevel::kCritical ? "critical"
+                                                       : "moderate");
+  std::vector<std::shared_ptr<Registration::Entry>> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    entries = entries_;
+  }
+  for (const auto& entry : entries) {
+    RequestTrim(entry, level);
+  }
+}
+
+std::vector<MemoryPressureManager::CacheUsage> MemoryPressureManager::GetUsage()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<CacheUsage> usage;
+  usage.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    CacheUsage cache;
+    cache.name = entry->name;
+    cache.bytes = entry->bytes.load(std::memory_order_relaxed);
+    cache.entries = entry->entries.load(std::memory_order_relaxed);
+    cache.budget_bytes = entry->budget_bytes.load(std::memory_order_relaxed);
+    usage.push_back(std::move(cache));
+  }
+  return usage;
+}
+
+void MemoryPressureManager::Unregister(
+    const std::shared_ptr<Registration::Entry>& entry) {
+  std::scoped_lock lock(mutex_);
+  entries_.erase(std::remove(entries_.begin(), entries_.end(), entry),
+                 entries_.end());
+}
+
+void MemoryPressureManager::RequestTrim(
+    const std::shared_ptr<Registration::Entry>& entry,
+    MemoryPressureLevel level) {
+  auto trim = [weak_entry = std::weak_ptr<Registration::Entry>(entry),
+               level]() {
+    auto entry = weak_entry.lock();
+    if (!entry) {
+      return;
+    }
+    {
+      std::scoped_lock lock(entry->trim_mutex);
+      if (entry->registered) {
+        TRACE_EVENT1("flutter", "MemoryPressureManager::Trim", "cache",
+                     entry->name.c_str());
+        entry->trim(level);
+      }
+    }
+    entry->budget_trim_pending = false;
+  };
+  if (entry->task_runner) {
+    entry->task_runner->PostTask(trim);
+  } else {
+    trim();
+  }
+}
+
+}  // namespace fml
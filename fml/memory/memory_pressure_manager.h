@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_MEMORY_PRESSURE_MANAGER_H_
+#define FLUTTER_FML_MEMORY_MEMORY_PRESSURE_MANAGER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+enum class MemoryPressureLevel {
+  // Memory is getting scarce, or a cache exceeded its budget. Caches should
+  // drop entries that are not in active use.
+  kModerate,
+  // The process is at risk of being killed. Caches should release everything
+  // that can be recreated.
+  kCritical,
+};
+
+//------------------------------------------------------------------------------
+/// The process-wide registry of the engine's memory caches.
+///
+/// Each cache registers with a name and a trim callback, and publishes its
+/// current size through its |Registration| whenever it changes. Publishing is
+/// a pair of relaxed atomic stores, so the sizes of all the caches can be
+/// reported from any thread without synchronizing with their owners.
+///
+/// Trim requests are delivered on the task runner given at registration, so
+/// caches that are only accessed on one thread do not need to be thread safe.
+/// A cache is asked to trim when the embedder signals memory pressure, and at
+/// |MemoryPressureLevel::kModerate| when its published size exceeds the
+/// budget set for its name.
+///
+class MemoryPressureManager {
+ public:
+  using TrimCallback = std::function<void(MemoryPressureLevel level)>;
+
+  struct CacheUsage {
+    std::string name;
+    size_t bytes = 0;
+    size_t entries = 0;
+    // Zero if the cache has no budget.
+    size_t budget_bytes = 0;
+  };
+
+  class Registration {
+   public:
+    //--------------------------------------------------------------------------
+    /// @brief      Unregisters the cache. Pending trim requests are dropped.
+    ///             Must be called on the task runner of the registration, if
+    ///             it has one, and not from within its trim callback.
+    ///
+    ~Registration();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Publishes the current size of the cache. Caches that cannot
+    ///             measure their size in bytes publish their entry count only.
+    ///
+    void SetUsage(size_t bytes, size_t entries = 0);
+
+    //--------------------------------------------------------------------------
+    /// @brief      The budget set for the name of the cache, or zero if it has
+    ///             none.
+    ///
+    size_t GetBudget() const;
+
+   private:
+    friend class MemoryPressureManager;
+
+    struct Entry;
+
+    MemoryPressureManager* manager_;
+    std::shared_ptr<Entry> entry_;
+
+    Registration(MemoryPressureManager* manager, std::shared_ptr<Entry> entry);
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Registration);
+  };
+
+  static MemoryPressureManager& GetInstance();
+
+  MemoryPressureManager();
+
+  ~MemoryPressureManager();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a cache.
+  ///
+  /// @param[in]  name         The name the cache is reported and budgeted
+  ///                          under. Several caches may share a name, for
+  ///                          example the raster caches of several engines.
+  /// @param[in]  task_runner  The task runner to deliver trim requests on. If
+  ///                          null, |trim| is called on the thread that
+  ///                          requests the trim and must be thread safe. A
+  ///                          trim requested because the cache exceeds its
+  ///                          budget then runs within |SetUsage|, which must
+  ///                          not be called while holding a lock that |trim|
+  ///                          acquires.
+  /// @param[in]  trim         Releases memory according to the level.
+  ///
+  /// @return     The registration, which unregisters the cache when it is
+  ///             destroyed.
+  ///
+  std::unique_ptr<Registration> Register(std::string name,
+                                         fml::RefPtr<TaskRunner> task_runner,
+                                         TrimCallback trim);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the budget of the caches registered under the name, now
+  ///             and in the future. A budget of zero removes it.
+  ///
+  void SetBudget(const std::string& name, size_t budget_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks every registered cache to trim at the given level.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The last published usage of every registered cache, in
+  ///             registration order.
+  ///
+  std::vector<CacheUsage> GetUsage() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<Registration::Entry>> entries_;
+  std::map<std::string, size_t> budgets_;
+
+  void Unregister(const std::shared_ptr<Registration::Entry>& entry);
+
+  static void RequestTrim(const std::shared_ptr<Registration::Entry>& entry,
+                          MemoryPressureLevel level);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryPressureManager);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_MEMORY_PRESSURE_MANAGER_H_
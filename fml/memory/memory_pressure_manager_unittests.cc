@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/memory/memory_pressure_manager.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(MemoryPressureManagerTest, ReportsPublishedUsage) {
+  MemoryPressureManager manager;
+  auto first = manager.Register("First", nullptr, [](auto level) {});
+  auto second = manager.Register("Second", nullptr, [](auto level) {});
+  first->SetUsage(100, 2);
+  second->SetUsage(0, 7);
+
+  auto usage = manager.GetUsage();
+  ASSERT_EQ(usage.size(), 2u);
+  ASSERT_EQ(usage[0].name, "First");
+  ASSERT_EQ(usage[0].bytes, 100u);
+  ASSERT_EQ(usage[0].entries, 2u);
+  ASSERT_EQ(usage[1].name, "Second");
+  ASSERT_EQ(usage[1].entries, 7u);
+
+  first.reset();
+  usage = manager.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  ASSERT_EQ(usage[0].name, "Second");
+}
+
+TEST(MemoryPressureManagerTest, TrimsEveryCacheAtTheGivenLevel) {
+  MemoryPressureManager manager;
+  std::vector<MemoryPressureLevel> first_levels;
+  std::vector<MemoryPressureLevel> second_levels;
+  auto first = manager.Register(
+      "First", nullptr, [&](auto level) { first_levels.push_back(level); });
+  auto second = manager.Register(
+      "Second", nullptr, [&](auto level) { second_levels.push_back(level); });
+
+  manager.NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+  manager.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+
+  ASSERT_EQ(first_levels,
+            (std::vector<MemoryPressureLevel>{MemoryPressureLevel::kModerate,
+                                              MemoryPressureLevel::kCritical}));
+  ASSERT_EQ(second_levels, first_levels);
+}
+
+TEST(MemoryPressureManagerTest, TrimsCachesThatExceedTheirBudget) {
+  MemoryPressureManager manager;
+  manager.SetBudget("Cache", 100);
+  int trims = 0;
+  std::unique_ptr<MemoryPressureManager::Registration> cache;
+  cache = manager.Register("Cache", nullptr, [&](auto level) {
+    ASSERT_EQ(level, MemoryPressureLevel::kModerate);
+    trims++;
+    cache->SetUsage(50);
+  });
+  auto other = manager.Register("Other", nullptr, [&](auto level) {
+    FAIL() << "Caches without a budget are not trimmed.";
+  });
+
+  cache->SetUsage(100);
+  ASSERT_EQ(trims, 0);
+  other->SetUsage(1000);
+  cache->SetUsage(101);
+  ASSERT_EQ(trims, 1);
+  ASSERT_EQ(manager.GetUsage()[0].bytes, 50u);
+  ASSERT_EQ(manager.GetUsage()[0].budget_bytes, 100u);
+  ASSERT_EQ(cache->GetBudget(), 100u);
+  ASSERT_EQ(other->GetBudget(), 0u);
+
+  manager.SetBudget("Cache", 0);
+  cache->SetUsage(1000);
+  ASSERT_EQ(trims, 1);
+  ASSERT_EQ(cache->GetBudget(), 0u);
+}
+
+TEST(MemoryPressureManagerTest, DeliversTrimsOnTheTaskRunner) {
+  MemoryPressureManager manager;
+  Thread thread;
+  auto task_runner = thread.GetTaskRunner();
+
+  AutoResetWaitableEvent latch;
+  std::unique_ptr<MemoryPressureManager::Registration> cache;
+  task_runner->PostTask([&]() {
+    cache = manager.Register("Cache", task_runner, [&](auto level) {
+      ASSERT_TRUE(task_runner->RunsTasksOnCurrentThread());
+      latch.Signal();
+    });
+    latch.Signal();
+  });
+  latch.Wait();
+
+  manager.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+  latch.Wait();
+
+  // Trims requested before unregistration are dropped.
+  task_runner->PostTask([&]() {
+    manager.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+    cache.reset();
+  });
+  thread.Join();
+  ASSERT_TRUE(manager.GetUsage().empty());
+}
+
+}  // namespace testing
+}  // namespace fml
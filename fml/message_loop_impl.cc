@@ -11,6 +11,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/thread_policy.h"
 #include "flutter/fml/trace_event.h"
 
 #if OS_MACOSX
@@ -119,6 +120,7 @@ void MessageLoopImpl::DoTerminate() {
 
 void MessageLoopImpl::FlushTasks(FlushType type) {
   TRACE_EVENT0("fml", "MessageLoop::FlushTasks");
+  TraceCurrentThreadPlacement();
 
   const auto now = fml::TimePoint::Now();
   fml::closure invocation;
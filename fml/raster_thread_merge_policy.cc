@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/raster_thread_merge_policy.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+RasterThreadMergePolicy::RasterThreadMergePolicy(size_t minimum_lease,
+                                                 size_t maximum_lease,
+                                                 size_t history_size)
+    : minimum_lease_(minimum_lease),
+      maximum_lease_(maximum_lease),
+      history_size_(history_size),
+      lease_term_(minimum_lease) {
+  FML_DCHECK(minimum_lease_ > 0) << "lease_term should be positive.";
+  FML_DCHECK(maximum_lease_ >= minimum_lease_);
+}
+
+RasterThreadMergePolicy::~RasterThreadMergePolicy() = default;
+
+size_t RasterThreadMergePolicy::RecordFrame(bool has_platform_views) {
+  frame_count_++;
+
+  if (has_platform_views) {
+    if (has_seen_platform_views_ && frames_without_platform_views_ > 0) {
+      recent_gaps_.push_back({frame_count_, frames_without_platform_views_});
+    }
+    has_seen_platform_views_ = true;
+    frames_without_platform_views_ = 0;
+  } else if (has_seen_platform_views_) {
+    frames_without_platform_views_++;
+  }
+
+  while (!recent_gaps_.empty() &&
+         recent_gaps_.front().end_frame + history_size_ < frame_count_) {
+    recent_gaps_.pop_front();
+  }
+
+  // The lease is decremented once per frame after the last frame with
+  // platform views, so bridging a gap of N frames takes a lease of N + 1.
+  size_t lease = minimum_lease_;
+  for (const Gap& gap : recent_gaps_) {
+    lease = std::max(lease, gap.length + 1);
+  }
+  lease_term_ = std::min(lease, maximum_lease_);
+  return lease_term_;
+}
+
+}  // namespace fml
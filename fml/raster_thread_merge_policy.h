@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_RASTER_THREAD_MERGE_POLICY_H_
+#define FLUTTER_FML_RASTER_THREAD_MERGE_POLICY_H_
+
+#include <cstddef>
+#include <deque>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// Chooses the lease term passed to |RasterThreadMerger::MergeWithLease| and
+/// |RasterThreadMerger::ExtendLeaseTo| from the recent history of frames with
+/// platform views.
+///
+/// Each merge or unmerge drops or re-submits a frame, so an app whose platform
+/// views disappear for a few frames at a time (a map scrolled briefly off
+/// screen, a video between clips) should stay merged through those gaps rather
+/// than thrash. The policy remembers the length of every gap between two
+/// frames with platform views that ended within the last |history_size|
+/// frames, and picks a lease long enough to bridge the longest of them. The
+/// lease grows as soon as such a gap is seen and only shrinks back to
+/// |minimum_lease| once the gap ages out of the history, which provides the
+/// hysteresis.
+///
+/// This class is not thread safe. It is meant to be owned by an external view
+/// embedder and used on the rasterizing thread.
+class RasterThreadMergePolicy {
+ public:
+  // Matches the fixed lease the embedders used before this policy existed.
+  static constexpr size_t kDefaultMinimumLease = 10;
+  static constexpr size_t kDefaultMaximumLease = 120;
+  static constexpr size_t kDefaultHistorySize = 600;
+
+  explicit RasterThreadMergePolicy(
+      size_t minimum_lease = kDefaultMinimumLease,
+      size_t maximum_lease = kDefaultMaximumLease,
+      size_t history_size = kDefaultHistorySize);
+
+  ~RasterThreadMergePolicy();
+
+  // Records whether the frame being prerolled has platform views. Must be
+  // called exactly once per committed frame, including frames without platform
+  // views, and not for frames that are dropped to be retried. Returns the
+  // lease term to extend with for this frame.
+  size_t RecordFrame(bool has_platform_views);
+
+  // The lease term computed by the last call to |RecordFrame|. Frames that are
+  // dropped to be retried merge with this lease, and the retried frame extends
+  // it once it is recorded.
+  size_t GetLeaseTerm() const { return lease_term_; }
+
+ private:
+  struct Gap {
+    // The frame at which platform views reappeared.
+    size_t end_frame;
+    size_t length;
+  };
+
+  const size_t minimum_lease_;
+  const size_t maximum_lease_;
+  const size_t history_size_;
+  size_t frame_count_ = 0;
+  bool has_seen_platform_views_ = false;
+  size_t frames_without_platform_views_ = 0;
+  std::deque<Gap> recent_gaps_;
+  size_t lease_term_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterThreadMergePolicy);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_RASTER_THREAD_MERGE_POLICY_H_
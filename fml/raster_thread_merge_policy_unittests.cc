@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/raster_thread_merge_policy.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(RasterThreadMergePolicy, StartsWithMinimumLease) {
+  RasterThreadMergePolicy policy(10, 100, 1000);
+  ASSERT_EQ(policy.GetLeaseTerm(), 10u);
+  ASSERT_EQ(policy.RecordFrame(false), 10u);
+  ASSERT_EQ(policy.RecordFrame(true), 10u);
+  ASSERT_EQ(policy.RecordFrame(true), 10u);
+}
+
+TEST(RasterThreadMergePolicy, ExtendsLeaseToBridgeObservedGaps) {
+  RasterThreadMergePolicy policy(10, 100, 1000);
+  policy.RecordFrame(true);
+  for (int i = 0; i < 30; i++) {
+    ASSERT_EQ(policy.RecordFrame(false), 10u);
+  }
+  // The platform view came back after 30 frames, so the next lease must keep
+  // the threads merged through a gap of the same length.
+  ASSERT_EQ(policy.RecordFrame(true), 31u);
+  ASSERT_EQ(policy.RecordFrame(false), 31u);
+}
+
+TEST(RasterThreadMergePolicy, LeaseIsCappedAtMaximum) {
+  RasterThreadMergePolicy policy(10, 20, 1000);
+  policy.RecordFrame(true);
+  for (int i = 0; i < 50; i++) {
+    policy.RecordFrame(false);
+  }
+  ASSERT_EQ(policy.RecordFrame(true), 20u);
+}
+
+TEST(RasterThreadMergePolicy, LeaseShrinksOnceGapsAgeOut) {
+  RasterThreadMergePolicy policy(10, 100, 100);
+  policy.RecordFrame(true);
+  for (int i = 0; i < 30; i++) {
+    policy.RecordFrame(false);
+  }
+  ASSERT_EQ(policy.RecordFrame(true), 31u);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(policy.RecordFrame(true), 31u);
+  }
+  ASSERT_EQ(policy.RecordFrame(true), 10u);
+}
+
+}  // namespace testing
+}  // namespace fml
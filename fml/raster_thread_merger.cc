@@ -154,6 +154,14 @@ void RasterThreadMerger::WaitUntilMerged() {
   merged_condition_.wait(lock, [&] { return IsMergedUnSafe(); });
 }
 
+void RasterThreadMerger::RecordSkippedFrame() {
+  shared_merger_->RecordSkippedFrame();
+}
+
+ThreadMergerStats RasterThreadMerger::GetStats() {
+  return shared_merger_->GetStats();
+}
+
 RasterThreadStatus RasterThreadMerger::DecrementLease() {
   if (TaskQueuesAreSame()) {
     return RasterThreadStatus::kRemainsMerged;
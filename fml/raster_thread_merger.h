@@ -106,6 +106,16 @@ class RasterThreadMerger
   // or |ExtendLeaseTo| or |DecrementLease| results in a noop.
   bool IsEnabled();
 
+  // Records that a frame was dropped and will be retried because the threads
+  // had to be merged first, i.e. the rasterizer got
+  // |RasterStatus::kSkipAndRetry|.
+  void RecordSkippedFrame();
+
+  // Returns the merge counters shared by all the mergers for this pair of
+  // task queues. The counters are also reported to the timeline as the
+  // "RasterThreadMerger" counter on every change.
+  ThreadMergerStats GetStats();
+
   // Registers a callback that can be used to clean up global state right after
   // the thread configuration has changed.
   //
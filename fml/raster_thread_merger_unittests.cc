@@ -657,5 +657,43 @@ TEST(RasterThreadMerger,
   ASSERT_FALSE(merger_from_3_to_1->IsMerged());
 }
 
+TEST(RasterThreadMerger, RecordsMergeStats) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const size_t kNumFramesMerged = 2;
+
+  ThreadMergerStats stats = raster_thread_merger->GetStats();
+  ASSERT_EQ(stats.merge_count, 0u);
+  ASSERT_EQ(stats.unmerge_count, 0u);
+  ASSERT_EQ(stats.skipped_frame_count, 0u);
+  ASSERT_EQ(stats.merged_duration, fml::TimeDelta::Zero());
+
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  raster_thread_merger->RecordSkippedFrame();
+  // Merging again while merged is not a new transition.
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  stats = raster_thread_merger->GetStats();
+  ASSERT_EQ(stats.merge_count, 1u);
+  ASSERT_EQ(stats.unmerge_count, 0u);
+  ASSERT_EQ(stats.skipped_frame_count, 1u);
+
+  for (size_t i = 0; i < kNumFramesMerged; i++) {
+    raster_thread_merger->DecrementLease();
+  }
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+  stats = raster_thread_merger->GetStats();
+  ASSERT_EQ(stats.merge_count, 1u);
+  ASSERT_EQ(stats.unmerge_count, 1u);
+  const fml::TimeDelta merged_duration = stats.merged_duration;
+  ASSERT_GE(merged_duration, fml::TimeDelta::Zero());
+
+  // Time spent unmerged is not accounted.
+  ASSERT_EQ(raster_thread_merger->GetStats().merged_duration, merged_duration);
+}
+
 }  // namespace testing
 }  // namespace fml
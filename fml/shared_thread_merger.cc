@@ -6,8 +6,11 @@
 
 #include "flutter/fml/shared_thread_merger.h"
 
+#include <optional>
 #include <set>
 
+#include "flutter/fml/trace_event.h"
+
 namespace fml {
 
 SharedThreadMerger::SharedThreadMerger(fml::TaskQueueId owner,
@@ -20,14 +23,21 @@ SharedThreadMerger::SharedThreadMerger(fml::TaskQueueId owner,
 bool SharedThreadMerger::MergeWithLease(RasterThreadMergerId caller,
                                         size_t lease_term) {
   FML_DCHECK(lease_term > 0) << "lease_term should be positive.";
-  std::scoped_lock lock(mutex_);
-  if (IsMergedUnSafe()) {
-    return true;
+  std::optional<StatsTrace> stats_trace;
+  bool success;
+  {
+    std::scoped_lock lock(mutex_);
+    if (IsMergedUnSafe()) {
+      return true;
+    }
+    success = task_queues_->Merge(owner_, subsumed_);
+    FML_CHECK(success) << "Unable to merge the raster and platform threads.";
+    RecordMergeUnSafe();
+    // Save the lease term
+    lease_term_by_caller_[caller] = lease_term;
+    stats_trace = TakeStatsTraceUnSafe();
   }
-  bool success = task_queues_->Merge(owner_, subsumed_);
-  FML_CHECK(success) << "Unable to merge the raster and platform threads.";
-  // Save the lease term
-  lease_term_by_caller_[caller] = lease_term;
+  TraceStats(stats_trace);
   return success;
 }
 
@@ -37,40 +47,54 @@ bool SharedThreadMerger::UnMergeNowUnSafe() {
          "UnMergeNowUnSafe()";
   bool success = task_queues_->Unmerge(owner_, subsumed_);
   FML_CHECK(success) << "Unable to un-merge the raster and platform threads.";
+  RecordUnmergeUnSafe();
   return success;
 }
 
 bool SharedThreadMerger::UnMergeNowIfLastOne(RasterThreadMergerId caller) {
-  std::scoped_lock lock(mutex_);
-  lease_term_by_caller_.erase(caller);
-  if (!lease_term_by_caller_.empty()) {
-    return true;
+  std::optional<StatsTrace> stats_trace;
+  bool success;
+  {
+    std::scoped_lock lock(mutex_);
+    lease_term_by_caller_.erase(caller);
+    if (!lease_term_by_caller_.empty()) {
+      return true;
+    }
+    success = UnMergeNowUnSafe();
+    stats_trace = TakeStatsTraceUnSafe();
   }
-  return UnMergeNowUnSafe();
+  TraceStats(stats_trace);
+  return success;
 }
 
 bool SharedThreadMerger::DecrementLease(RasterThreadMergerId caller) {
-  std::scoped_lock lock(mutex_);
-  auto entry = lease_term_by_caller_.find(caller);
-  bool exist = entry != lease_term_by_caller_.end();
-  if (exist) {
-    std::atomic_size_t& lease_term_ref = entry->second;
-    FML_CHECK(lease_term_ref > 0)
-        << "lease_term should always be positive when merged, lease_term="
-        << lease_term_ref;
-    lease_term_ref--;
-  } else {
-    FML_LOG(WARNING) << "The caller does not exist when calling "
-                        "DecrementLease(), ignored. This may happens after "
-                        "caller is erased in UnMergeNowIfLastOne(). caller="
-                     << caller;
-  }
-  if (IsAllLeaseTermsZeroUnSafe()) {
-    // Unmerge now because lease_term_ decreased to zero.
-    UnMergeNowUnSafe();
-    return true;
+  std::optional<StatsTrace> stats_trace;
+  bool unmerged = false;
+  {
+    std::scoped_lock lock(mutex_);
+    auto entry = lease_term_by_caller_.find(caller);
+    bool exist = entry != lease_term_by_caller_.end();
+    if (exist) {
+      std::atomic_size_t& lease_term_ref = entry->second;
+      FML_CHECK(lease_term_ref > 0)
+          << "lease_term should always be positive when merged, lease_term="
+          << lease_term_ref;
+      lease_term_ref--;
+    } else {
+      FML_LOG(WARNING) << "The caller does not exist when calling "
+                          "DecrementLease(), ignored. This may happens after "
+                          "caller is erased in UnMergeNowIfLastOne(). caller="
+                       << caller;
+    }
+    if (IsAllLeaseTermsZeroUnSafe()) {
+      // Unmerge now because lease_term_ decreased to zero.
+      UnMergeNowUnSafe();
+      stats_trace = TakeStatsTraceUnSafe();
+      unmerged = true;
+    }
   }
-  return false;
+  TraceStats(stats_trace);
+  return unmerged;
 }
 
 void SharedThreadMerger::ExtendLeaseTo(RasterThreadMergerId caller,
@@ -99,4 +123,74 @@ bool SharedThreadMerger::IsAllLeaseTermsZeroUnSafe() const {
                      [&](const auto& item) { return item.second == 0; });
 }
 
+void SharedThreadMerger::RecordSkippedFrame() {
+  std::optional<StatsTrace> stats_trace;
+  {
+    std::scoped_lock lock(mutex_);
+    stats_.skipped_frame_count++;
+    stats_trace_pending_ = true;
+    stats_trace = TakeStatsTraceUnSafe();
+  }
+  TraceStats(stats_trace);
+}
+
+ThreadMergerStats SharedThreadMerger::GetStats() {
+  std::scoped_lock lock(mutex_);
+  return GetStatsUnSafe();
+}
+
+ThreadMergerStats SharedThreadMerger::GetStatsUnSafe() const {
+  ThreadMergerStats stats = stats_;
+  if (is_merge_recorded_) {
+    stats.merged_duration = stats.merged_duration +
+                            (fml::TimePoint::Now() - merged_since_);
+  }
+  return stats;
+}
+
+void SharedThreadMerger::RecordMergeUnSafe() {
+  if (is_merge_recorded_) {
+    return;
+  }
+  is_merge_recorded_ = true;
+  merged_since_ = fml::TimePoint::Now();
+  stats_.merge_count++;
+  stats_trace_pending_ = true;
+}
+
+void SharedThreadMerger::RecordUnmergeUnSafe() {
+  if (!is_merge_recorded_) {
+    return;
+  }
+  is_merge_recorded_ = false;
+  stats_.merged_duration =
+      stats_.merged_duration + (fml::TimePoint::Now() - merged_since_);
+  stats_.unmerge_count++;
+  stats_trace_pending_ = true;
+}
+
+std::optional<SharedThreadMerger::StatsTrace>
+SharedThreadMerger::TakeStatsTraceUnSafe() {
+  if (!stats_trace_pending_) {
+    return std::nullopt;
+  }
+  stats_trace_pending_ = false;
+  return StatsTrace{GetStatsUnSafe(), is_merge_recorded_};
+}
+
+void SharedThreadMerger::TraceStats(
+    const std::optional<StatsTrace>& stats_trace) const {
+  if (!stats_trace) {
+    return;
+  }
+  const ThreadMergerStats& stats = stats_trace->stats;
+  FML_TRACE_COUNTER("flutter",                                              //
+                    "RasterThreadMerger", reinterpret_cast<int64_t>(this),  //
+                    "Merged", stats_trace->merged ? 1 : 0,                  //
+                    "Merges", stats.merge_count,                            //
+                    "Unmerges", stats.unmerge_count,                        //
+                    "SkippedFrames", stats.skipped_frame_count,             //
+                    "MergedMillis", stats.merged_duration.ToMilliseconds());
+}
+
 }  // namespace fml
@@ -7,10 +7,13 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
@@ -18,6 +21,19 @@ class RasterThreadMerger;
 
 typedef void* RasterThreadMergerId;
 
+/// Counters describing how often the threads were merged and what it cost.
+struct ThreadMergerStats {
+  // Number of times the threads went from unmerged to merged.
+  size_t merge_count = 0;
+  // Number of times the threads went from merged to unmerged.
+  size_t unmerge_count = 0;
+  // Number of frames dropped so that they could be re-rasterized after a
+  // merge.
+  size_t skipped_frame_count = 0;
+  // Total time spent merged, including the ongoing merge if any.
+  fml::TimeDelta merged_duration;
+};
+
 /// Instance of this class is shared between multiple |RasterThreadMerger|
 /// instances, Most of the callings from |RasterThreadMerger| will be redirected
 /// to this class with one more caller parameter.
@@ -54,6 +70,12 @@ class SharedThreadMerger
   // See the doc of |RasterThreadMerger::DecrementLease|.
   bool DecrementLease(RasterThreadMergerId caller);
 
+  // It's called by |RasterThreadMerger::RecordSkippedFrame|.
+  void RecordSkippedFrame();
+
+  // It's called by |RasterThreadMerger::GetStats|.
+  ThreadMergerStats GetStats();
+
  private:
   fml::TaskQueueId owner_;
   fml::TaskQueueId subsumed_;
@@ -66,8 +88,31 @@ class SharedThreadMerger
   /// method will remove the caller from this lease_term_by_caller_.
   std::map<RasterThreadMergerId, std::atomic_size_t> lease_term_by_caller_;
 
+  ThreadMergerStats stats_;
+  bool is_merge_recorded_ = false;
+  fml::TimePoint merged_since_;
+  // Whether the stats changed since they were last traced.
+  bool stats_trace_pending_ = false;
+
+  // A snapshot of the stats, taken under |mutex_| and traced after it was
+  // released.
+  struct StatsTrace {
+    ThreadMergerStats stats;
+    bool merged;
+  };
+
   bool IsAllLeaseTermsZeroUnSafe() const;
 
+  ThreadMergerStats GetStatsUnSafe() const;
+
+  void RecordMergeUnSafe();
+
+  void RecordUnmergeUnSafe();
+
+  std::optional<StatsTrace> TakeStatsTraceUnSafe();
+
+  void TraceStats(const std::optional<StatsTrace>& stats_trace) const;
+
   bool UnMergeNowUnSafe();
 
   FML_DISALLOW_COPY_AND_ASSIGN(SharedThreadMerger);
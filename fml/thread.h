@@ -11,12 +11,14 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread_policy.h"
 
 namespace fml {
 
 class Thread {
  public:
-  explicit Thread(const std::string& name = "");
+  explicit Thread(const std::string& name = "",
+                  const ThreadPolicy& policy = ThreadPolicy());
 
   ~Thread();
 
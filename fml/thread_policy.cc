@@ -0,0 +1,309 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/thread_policy.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/trace_event.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fml {
+
+namespace {
+
+// |TraceCurrentThreadPlacement| runs on every message loop flush and worker
+// wake. The placement is only sampled on one in this many calls.
+constexpr uint32_t kPlacementSampleInterval = 64;
+
+struct PlacementState {
+  std::string policy;
+  int last_traced_cpu = -1;
+  uint32_t calls_until_sample = 0;
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<PlacementState> tls_placement;
+
+const char* SchedulerName(ThreadPolicy::Scheduler scheduler) {
+  switch (scheduler) {
+    case ThreadPolicy::Scheduler::kDefault:
+      return "default";
+    case ThreadPolicy::Scheduler::kOther:
+      return "other";
+    case ThreadPolicy::Scheduler::kBatch:
+      return "batch";
+    case ThreadPolicy::Scheduler::kIdle:
+      return "idle";
+    case ThreadPolicy::Scheduler::kFifo:
+      return "fifo";
+    case ThreadPolicy::Scheduler::kRoundRobin:
+      return "rr";
+  }
+  return "default";
+}
+
+bool ParseScheduler(std::string_view name, ThreadPolicy::Scheduler* scheduler) {
+  for (auto candidate :
+       {ThreadPolicy::Scheduler::kOther, ThreadPolicy::Scheduler::kBatch,
+        ThreadPolicy::Scheduler::kIdle, ThreadPolicy::Scheduler::kFifo,
+        ThreadPolicy::Scheduler::kRoundRobin}) {
+    if (name == SchedulerName(candidate)) {
+      *scheduler = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParseInt(std::string_view string, int* value) {
+  if (string.empty()) {
+    return false;
+  }
+  bool negative = string[0] == '-';
+  if (negative) {
+    string.remove_prefix(1);
+  }
+  if (string.empty() || string.size() > 9) {
+    return false;
+  }
+  int result = 0;
+  for (char c : string) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    result = result * 10 + (c - '0');
+  }
+  *value = negative ? -result : result;
+  return true;
+}
+
+bool ParseCpuList(std::string_view list, std::vector<size_t>* cpus) {
+  std::vector<size_t> result;
+  while (!list.empty()) {
+    size_t comma = list.find(',');
+    std::string_view item = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view{}
+                                           : list.substr(comma + 1);
+
+    size_t dash = item.find('-');
+    int first = 0;
+    int last = 0;
+    if (dash == std::string_view::npos) {
+      if (!ParseInt(item, &first)) {
+        return false;
+      }
+      last = first;
+    } else if (!ParseInt(item.substr(0, dash), &first) ||
+               !ParseInt(item.substr(dash + 1), &last)) {
+      return false;
+    }
+    if (first < 0 || last < first) {
+      return false;
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      result.push_back(cpu);
+    }
+  }
+  if (result.empty()) {
+    return false;
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  *cpus = std::move(result);
+  return true;
+}
+
+}  // namespace
+
+bool ThreadPolicy::IsDefault() const {
+  return scheduler == Scheduler::kDefault && !nice.has_value() &&
+         cpu_affinity.empty();
+}
+
+std::string ThreadPolicy::ToString() const {
+  std::stringstream stream;
+  stream << "sched=" << SchedulerName(scheduler);
+  if (scheduler == Scheduler::kFifo || scheduler == Scheduler::kRoundRobin) {
+    stream << ":priority=" << realtime_priority;
+  }
+  if (nice.has_value()) {
+    stream << ":nice=" << nice.value();
+  }
+  if (!cpu_affinity.empty()) {
+    stream << ":cpus=";
+    for (size_t i = 0; i < cpu_affinity.size(); i++) {
+      stream << (i == 0 ? "" : ",") << cpu_affinity[i];
+    }
+  }
+  return stream.str();
+}
+
+bool ThreadPolicy::operator==(const ThreadPolicy& other) const {
+  return scheduler == other.scheduler &&
+         realtime_priority == other.realtime_priority && nice == other.nice &&
+         cpu_affinity == other.cpu_affinity;
+}
+
+bool ParseThreadPolicy(std::string_view spec, ThreadPolicy* policy) {
+  ThreadPolicy result;
+  while (!spec.empty()) {
+    size_t colon = spec.find(':');
+    std::string_view entry = spec.substr(0, colon);
+    spec = colon == std::string_view::npos ? std::string_view{}
+                                           : spec.substr(colon + 1);
+
+    size_t equals = entry.find('=');
+    if (equals == std::string_view::npos) {
+      return false;
+    }
+    std::string_view key = entry.substr(0, equals);
+    std::string_view value = entry.substr(equals + 1);
+    if (key == "sched") {
+      if (!ParseScheduler(value, &result.scheduler)) {
+        return false;
+      }
+    } else if (key == "priority") {
+      if (!ParseInt(value, &result.realtime_priority)) {
+        return false;
+      }
+    } else if (key == "nice") {
+      int nice = 0;
+      if (!ParseInt(value, &nice)) {
+        return false;
+      }
+      result.nice = nice;
+    } else if (key == "cpus") {
+      if (!ParseCpuList(value, &result.cpu_affinity)) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  *policy = std::move(result);
+  return true;
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+bool SetCurrentThreadPolicy(const ThreadPolicy& policy) {
+  if (policy.IsDefault()) {
+    return true;
+  }
+
+  bool applied = true;
+
+  if (policy.scheduler != ThreadPolicy::Scheduler::kDefault) {
+    int scheduler = SCHED_OTHER;
+    sched_param param = {};
+    switch (policy.scheduler) {
+      case ThreadPolicy::Scheduler::kDefault:
+      case ThreadPolicy::Scheduler::kOther:
+        scheduler = SCHED_OTHER;
+        break;
+      case ThreadPolicy::Scheduler::kBatch:
+        scheduler = SCHED_BATCH;
+        break;
+      case ThreadPolicy::Scheduler::kIdle:
+        scheduler = SCHED_IDLE;
+        break;
+      case ThreadPolicy::Scheduler::kFifo:
+        scheduler = SCHED_FIFO;
+        param.sched_priority = policy.realtime_priority;
+        break;
+      case ThreadPolicy::Scheduler::kRoundRobin:
+        scheduler = SCHED_RR;
+        param.sched_priority = policy.realtime_priority;
+        break;
+    }
+    // On Linux, a pid of zero refers to the calling thread.
+    if (sched_setscheduler(0, scheduler, &param) != 0) {
+      FML_LOG(ERROR) << "Could not set the scheduler of the current thread to "
+                     << SchedulerName(policy.scheduler) << ".";
+      applied = false;
+    }
+  }
+
+  if (policy.nice.has_value()) {
+    // Nice values are per thread on Linux and are addressed by thread ID.
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, policy.nice.value()) != 0) {
+      FML_LOG(ERROR) << "Could not set the nice value of the current thread to "
+                     << policy.nice.value() << ".";
+      applied = false;
+    }
+  }
+
+  if (!policy.cpu_affinity.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t cpu : policy.cpu_affinity) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+      FML_LOG(ERROR) << "Could not set the CPU affinity of the current thread.";
+      applied = false;
+    }
+  }
+
+  auto* state = new PlacementState();
+  state->policy = policy.ToString();
+  tls_placement.reset(state);
+
+  return applied;
+}
+
+int GetCurrentCpu() {
+  return sched_getcpu();
+}
+
+#else  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+bool SetCurrentThreadPolicy(const ThreadPolicy& policy) {
+  if (policy.IsDefault()) {
+    return true;
+  }
+  FML_DLOG(INFO) << "Thread policies are not supported on this platform.";
+  return false;
+}
+
+int GetCurrentCpu() {
+  return -1;
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+void TraceCurrentThreadPlacement() {
+  PlacementState* state = tls_placement.get();
+  if (state == nullptr) {
+    return;
+  }
+  if (state->calls_until_sample > 0) {
+    state->calls_until_sample--;
+    return;
+  }
+  state->calls_until_sample = kPlacementSampleInterval - 1;
+  int cpu = GetCurrentCpu();
+  if (cpu == state->last_traced_cpu) {
+    return;
+  }
+  state->last_traced_cpu = cpu;
+  std::string cpu_string = std::to_string(cpu);
+  TRACE_EVENT_INSTANT2("fml", "ThreadPlacement", "cpu", cpu_string.c_str(),
+                       "policy", state->policy.c_str());
+}
+
+}  // namespace fml
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_THREAD_POLICY_H_
+#define FLUTTER_FML_THREAD_POLICY_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// The scheduling parameters of a thread. A default constructed policy leaves
+/// the scheduling the thread inherited from its creator untouched.
+///
+/// Policies are currently only applied on Linux and Android, where they are
+/// used to keep latency sensitive threads off the little cores of
+/// heterogeneous (big.LITTLE) CPUs.
+///
+struct ThreadPolicy {
+  enum class Scheduler {
+    // Keep the scheduling policy the thread inherited.
+    kDefault,
+    // SCHED_OTHER, the default time-sharing policy.
+    kOther,
+    // SCHED_BATCH, for CPU-bound work that should not preempt others.
+    kBatch,
+    // SCHED_IDLE, for work that only runs when nothing else is runnable.
+    kIdle,
+    // SCHED_FIFO, a real-time policy. Requires |realtime_priority|.
+    kFifo,
+    // SCHED_RR, a real-time policy. Requires |realtime_priority|.
+    kRoundRobin,
+  };
+
+  Scheduler scheduler = Scheduler::kDefault;
+
+  // The static priority used by the real-time schedulers, between 1 and 99 on
+  // Linux. Ignored by the other schedulers.
+  int realtime_priority = 0;
+
+  // The nice value of the thread, between -20 (highest priority) and 19.
+  // Lowering the nice value of a thread usually requires CAP_SYS_NICE.
+  std::optional<int> nice;
+
+  // The CPUs the thread may run on. Empty leaves the affinity untouched.
+  std::vector<size_t> cpu_affinity;
+
+  bool IsDefault() const;
+
+  std::string ToString() const;
+
+  bool operator==(const ThreadPolicy& other) const;
+
+  bool operator!=(const ThreadPolicy& other) const {
+    return !(*this == other);
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Parses a policy from a colon separated list of `key=value`
+///             pairs, for example `nice=-10:cpus=4-7` or
+///             `sched=fifo:priority=2:cpus=4,6`. The recognized keys are:
+///
+///             - `sched`: one of `other`, `batch`, `idle`, `fifo` or `rr`.
+///             - `priority`: the real-time priority.
+///             - `nice`: the nice value.
+///             - `cpus`: a comma separated list of CPU indices and ranges.
+///
+/// @return     Whether the specification was valid. |policy| is only
+///             modified if it was.
+///
+bool ParseThreadPolicy(std::string_view spec, ThreadPolicy* policy);
+
+//------------------------------------------------------------------------------
+/// @brief      Applies the policy to the calling thread. Every parameter is
+///             applied independently, so a failure to apply one (usually for
+///             lack of privileges) does not prevent the others from being
+///             applied.
+///
+/// @return     Whether all the parameters of the policy were applied.
+///
+bool SetCurrentThreadPolicy(const ThreadPolicy& policy);
+
+//------------------------------------------------------------------------------
+/// @brief      The index of the CPU the calling thread is running on, or -1
+///             if it cannot be determined on this platform.
+///
+int GetCurrentCpu();
+
+//------------------------------------------------------------------------------
+/// @brief      Adds a timeline annotation recording the CPU the calling
+///             thread runs on, if a policy was applied to the thread with
+///             |SetCurrentThreadPolicy| and the thread migrated since the
+///             last annotation. Threads without a policy are not annotated.
+///
+///             This is called on hot paths, so the placement is only sampled
+///             periodically: the first call on a thread always samples it,
+///             later calls only every so often.
+///
+void TraceCurrentThreadPlacement();
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_THREAD_POLICY_H_
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/thread_policy.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fml {
+namespace testing {
+
+TEST(ThreadPolicyTest, DefaultPolicyIsDefault) {
+  ThreadPolicy policy;
+  ASSERT_TRUE(policy.IsDefault());
+  ASSERT_TRUE(SetCurrentThreadPolicy(policy));
+}
+
+TEST(ThreadPolicyTest, ParsesSpecifications) {
+  ThreadPolicy policy;
+  ASSERT_TRUE(ParseThreadPolicy("nice=-10:cpus=4-6,1,5", &policy));
+  ASSERT_EQ(policy.scheduler, ThreadPolicy::Scheduler::kDefault);
+  ASSERT_EQ(policy.nice, -10);
+  ASSERT_EQ(policy.cpu_affinity, (std::vector<size_t>{1, 4, 5, 6}));
+
+  ASSERT_TRUE(ParseThreadPolicy("sched=fifo:priority=2", &policy));
+  ASSERT_EQ(policy.scheduler, ThreadPolicy::Scheduler::kFifo);
+  ASSERT_EQ(policy.realtime_priority, 2);
+  ASSERT_FALSE(policy.nice.has_value());
+  ASSERT_TRUE(policy.cpu_affinity.empty());
+
+  ThreadPolicy round_trip;
+  ASSERT_TRUE(ParseThreadPolicy(policy.ToString(), &round_trip));
+  ASSERT_EQ(round_trip, policy);
+
+  ASSERT_TRUE(ParseThreadPolicy("", &policy));
+  ASSERT_TRUE(policy.IsDefault());
+}
+
+TEST(ThreadPolicyTest, RejectsInvalidSpecifications) {
+  ThreadPolicy policy;
+  policy.nice = 3;
+  ASSERT_FALSE(ParseThreadPolicy("nice", &policy));
+  ASSERT_FALSE(ParseThreadPolicy("nice=high", &policy));
+  ASSERT_FALSE(ParseThreadPolicy("sched=fast", &policy));
+  ASSERT_FALSE(ParseThreadPolicy("cpus=3-1", &policy));
+  ASSERT_FALSE(ParseThreadPolicy("cpus=", &policy));
+  ASSERT_FALSE(ParseThreadPolicy("color=red", &policy));
+  // The policy is only modified by valid specifications.
+  ASSERT_EQ(policy.nice, 3);
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+TEST(ThreadPolicyTest, AppliesAffinityAndNiceValueToThread) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  size_t cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    cpu++;
+  }
+
+  ThreadPolicy policy;
+  policy.cpu_affinity = {cpu};
+  // Raising the nice value does not require privileges.
+  policy.nice = 5;
+
+  Thread thread("policy_thread", policy);
+  AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&]() {
+    cpu_set_t set;
+    EXPECT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+    EXPECT_EQ(CPU_COUNT(&set), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &set));
+    EXPECT_EQ(GetCurrentCpu(), static_cast<int>(cpu));
+
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    errno = 0;
+    EXPECT_EQ(getpriority(PRIO_PROCESS, tid), 5);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(ThreadPolicyTest, AppliesPolicyToConcurrentWorkers) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  size_t cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    cpu++;
+  }
+
+  ThreadPolicy policy;
+  policy.cpu_affinity = {cpu};
+  auto loop = ConcurrentMessageLoop::Create(2, policy);
+  AutoResetWaitableEvent latch;
+  loop->GetTaskRunner()->PostTask([&]() {
+    cpu_set_t set;
+    EXPECT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+    EXPECT_EQ(CPU_COUNT(&set), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &set));
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(ThreadPolicyTest, ReportsPoliciesThatCannotBeApplied) {
+  Thread thread;
+  AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&]() {
+    ThreadPolicy policy;
+    policy.cpu_affinity = {CPU_SETSIZE};
+    EXPECT_FALSE(SetCurrentThreadPolicy(policy));
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,317 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_buffer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// Generations are unique across buffers, so that a thread cannot mistake the
+// buffer it recorded into for a buffer at the same address that was destroyed.
+std::atomic_uint32_t gLastGeneration = 0;
+
+// The name index and event type of a record share a word, so that a record is
+// three words in total.
+uint64_t PackRecord(uint32_t name_index, TraceBufferEventType type) {
+  return static_cast<uint64_t>(name_index) |
+         (static_cast<uint64_t>(type) << 32);
+}
+
+const char* GetPhase(TraceBufferEventType type) {
+  switch (type) {
+    case TraceBufferEventType::kBegin:
+      return "B";
+    case TraceBufferEventType::kEnd:
+      return "E";
+    case TraceBufferEventType::kInstant:
+      return "i";
+    case TraceBufferEventType::kAsyncBegin:
+      return "b";
+    case TraceBufferEventType::kAsyncEnd:
+      return "e";
+    case TraceBufferEventType::kFlowBegin:
+      return "s";
+    case TraceBufferEventType::kFlowStep:
+      return "t";
+    case TraceBufferEventType::kFlowEnd:
+      return "f";
+    case TraceBufferEventType::kCounter:
+      return "C";
+  }
+  return "i";
+}
+
+void AppendJsonString(std::string& json, const std::string& string) {
+  json += '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          json += escaped;
+        } else {
+          json += c;
+        }
+        break;
+    }
+  }
+  json += '"';
+}
+
+}  // namespace
+
+struct TraceBuffer::ThreadBuffer {
+  struct Record {
+    std::atomic_int64_t timestamp_micros = 0;
+    std::atomic_int64_t id = 0;
+    std::atomic_uint64_t name_and_type = 0;
+  };
+
+  const uint32_t generation;
+  const uint32_t thread_index;
+  const size_t capacity;
+  std::unique_ptr<Record[]> records;
+
+  // The writer claims a record before writing it and publishes it after, so
+  // that a concurrent dump can tell which of the records it copied may have
+  // been overwritten in the meantime.
+  std::atomic_uint64_t claimed_count = 0;
+  std::atomic_uint64_t published_count = 0;
+
+  // Only accessed by the thread that owns the buffer. The cached names are
+  // compared on every lookup, as a name may be stored at an address that was
+  // used by another name before.
+  std::unordered_map<const char*, std::pair<const std::string*, uint32_t>>
+      name_cache;
+
+  ThreadBuffer(uint32_t p_generation,
+               uint32_t p_thread_index,
+               size_t p_capacity)
+      : generation(p_generation),
+        thread_index(p_thread_index),
+        capacity(p_capacity),
+        records(new Record[p_capacity]) {}
+};
+
+// Keeps the buffer of a thread alive until both the thread has exited and the
+// buffer has been unregistered.
+struct ThreadBufferHolder {
+  std::shared_ptr<TraceBuffer::ThreadBuffer> buffer;
+};
+
+namespace {
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadBufferHolder> tls_trace_buffer;
+
+}  // namespace
+
+TraceBuffer& TraceBuffer::GetInstance() {
+  static TraceBuffer* instance = new TraceBuffer();
+  return *instance;
+}
+
+TraceBuffer::TraceBuffer() {
+  // Index zero is the name of events that were recorded without one.
+  names_.push_back(std::make_unique<std::string>());
+}
+
+TraceBuffer::~TraceBuffer() = default;
+
+void TraceBuffer::Enable(size_t capacity) {
+  std::scoped_lock lock(buffers_mutex_);
+  buffers_.clear();
+  capacity_.store(std::max<size_t>(capacity, 1), std::memory_order_relaxed);
+  generation_.store(++gLastGeneration, std::memory_order_release);
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceBuffer::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+TraceBuffer::ThreadBuffer* TraceBuffer::GetThreadBuffer() {
+  ThreadBufferHolder* holder = tls_trace_buffer.get();
+  const uint32_t generation = generation_.load(std::memory_order_acquire);
+  if (holder != nullptr && holder->buffer->generation == generation) {
+    return holder->buffer.get();
+  }
+
+  std::scoped_lock lock(buffers_mutex_);
+  auto buffer = std::make_shared<ThreadBuffer>(
+      generation_.load(std::memory_order_relaxed), buffers_.size(),
+      capacity_.load(std::memory_order_relaxed));
+  buffers_.push_back(buffer);
+  tls_trace_buffer.reset(new ThreadBufferHolder{buffer});
+  return buffer.get();
+}
+
+const std::string* TraceBuffer::InternName(const char* name, uint32_t* index) {
+  std::scoped_lock lock(names_mutex_);
+  auto found = name_indices_.find(name);
+  if (found != name_indices_.end()) {
+    *index = found->second;
+    return names_[found->second].get();
+  }
+  *index = names_.size();
+  names_.push_back(std::make_unique<std::string>(name));
+  name_indices_[*names_.back()] = *index;
+  return names_.back().get();
+}
+
+void TraceBuffer::Record(TraceBufferEventType type,
+                         const char* name,
+                         int64_t timestamp_micros,
+                         int64_t id) {
+  if (!IsEnabled()) {
+    return;
+  }
+  ThreadBuffer* buffer = GetThreadBuffer();
+
+  uint32_t name_index = 0;
+  if (name != nullptr) {
+    auto found = buffer->name_cache.find(name);
+    if (found != buffer->name_cache.end() &&
+        strcmp(found->second.first->c_str(), name) == 0) {
+      name_index = found->second.second;
+    } else {
+      const std::string* interned = InternName(name, &name_index);
+      buffer->name_cache[name] = {interned, name_index};
+    }
+  }
+
+  const uint64_t index =
+      buffer->published_count.load(std::memory_order_relaxed);
+  buffer->claimed_count.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  auto& record = buffer->records[index % buffer->capacity];
+  record.timestamp_micros.store(timestamp_micros, std::memory_order_relaxed);
+  record.id.store(id, std::memory_order_relaxed);
+  record.name_and_type.store(PackRecord(name_index, type),
+                             std::memory_order_relaxed);
+  buffer->published_count.store(index + 1, std::memory_order_release);
+}
+
+std::vector<TraceBuffer::Event> TraceBuffer::Dump() const {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffers = buffers_;
+  }
+
+  struct RawEvent {
+    int64_t timestamp_micros;
+    int64_t id;
+    uint64_t name_and_type;
+    uint32_t thread_index;
+  };
+  std::vector<RawEvent> raw_events;
+  for (const auto& buffer : buffers) {
+    const uint64_t end =
+        buffer->published_count.load(std::memory_order_acquire);
+    const uint64_t begin = end > buffer->capacity ? end - buffer->capacity : 0;
+    const size_t first_event = raw_events.size();
+    for (uint64_t i = begin; i < end; i++) {
+      const auto& record = buffer->records[i % buffer->capacity];
+      raw_events.push_back(
+          {record.timestamp_micros.load(std::memory_order_relaxed),
+           record.id.load(std::memory_order_relaxed),
+           record.name_and_type.load(std::memory_order_relaxed),
+           buffer->thread_index});
+    }
+
+    // Drops the oldest records if they were overwritten while being copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed =
+        buffer->claimed_count.load(std::memory_order_relaxed);
+    const uint64_t valid_begin =
+        claimed > buffer->capacity ? claimed - buffer->capacity : 0;
+    if (valid_begin > begin) {
+      const size_t overwritten = std::min(valid_begin - begin, end - begin);
+      raw_events.erase(raw_events.begin() + first_event,
+                       raw_events.begin() + first_event + overwritten);
+    }
+  }
+
+  std::vector<Event> events;
+  events.reserve(raw_events.size());
+  {
+    std::scoped_lock lock(names_mutex_);
+    for (const auto& raw_event : raw_events) {
+      Event event;
+      event.timestamp_micros = raw_event.timestamp_micros;
+      event.id = raw_event.id;
+      event.thread_index = raw_event.thread_index;
+      event.type = static_cast<TraceBufferEventType>(raw_event.name_and_type >>
+                                                     32);
+      const uint32_t name_index =
+          static_cast<uint32_t>(raw_event.name_and_type & 0xFFFFFFFF);
+      if (name_index < names_.size()) {
+        event.name = *names_[name_index];
+      }
+      events.push_back(std::move(event));
+    }
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event& a, const Event& b) {
+                     return a.timestamp_micros < b.timestamp_micros;
+                   });
+  return events;
+}
+
+std::string TraceBuffer::ToChromeTraceJson(const std::vector<Event>& events) {
+  std::string json = "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); i++) {
+    const Event& event = events[i];
+    if (i > 0) {
+      json += ',';
+    }
+    // The Dart timeline reports the events of the engine under the same
+    // category.
+    json += "{\"name\":";
+    AppendJsonString(json, event.name);
+    json += ",\"cat\":\"Embedder\",\"ph\":\"";
+    json += GetPhase(event.type);
+    json += "\",\"ts\":" + std::to_string(event.timestamp_micros) +
+            ",\"pid\":0,\"tid\":" + std::to_string(event.thread_index);
+    switch (event.type) {
+      case TraceBufferEventType::kInstant:
+        json += ",\"s\":\"t\"";
+        break;
+      case TraceBufferEventType::kAsyncBegin:
+      case TraceBufferEventType::kAsyncEnd:
+      case TraceBufferEventType::kFlowBegin:
+      case TraceBufferEventType::kFlowStep:
+      case TraceBufferEventType::kFlowEnd:
+        json += ",\"id\":\"" + std::to_string(event.id) + "\"";
+        break;
+      case TraceBufferEventType::kCounter:
+        json += ",\"args\":{\"value\":" + std::to_string(event.id) + "}";
+        break;
+      case TraceBufferEventType::kBegin:
+      case TraceBufferEventType::kEnd:
+        break;
+    }
+    json += '}';
+  }
+  json += "],\"displayTimeUnit\":\"ms\"}";
+  return json;
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_BUFFER_H_
+#define FLUTTER_FML_TRACE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+namespace tracing {
+
+enum class TraceBufferEventType : uint8_t {
+  kBegin,
+  kEnd,
+  kInstant,
+  kAsyncBegin,
+  kAsyncEnd,
+  kFlowBegin,
+  kFlowStep,
+  kFlowEnd,
+  kCounter,
+};
+
+//------------------------------------------------------------------------------
+/// A flight recorder for the trace events of the engine.
+///
+/// Unlike the Dart timeline, the buffer is cheap enough to stay enabled in
+/// release builds. Each thread writes fixed size binary records into a ring
+/// buffer of its own, so recording takes no locks once a thread has recorded
+/// its first event. Names are interned and stored as indices, and the
+/// arguments of events are not recorded.
+///
+/// The buffers keep the most recent events of every thread, and can be dumped
+/// at any time, for example when a frame is janky or when the process is low
+/// on memory, and converted to the Chrome trace event format.
+///
+class TraceBuffer {
+ public:
+  struct Event {
+    int64_t timestamp_micros = 0;
+    // The identifier of async and flow events, or the value of counters.
+    int64_t id = 0;
+    // Identifies the thread that recorded the event, in the order threads
+    // first recorded events after the buffer was enabled.
+    uint32_t thread_index = 0;
+    TraceBufferEventType type = TraceBufferEventType::kInstant;
+    std::string name;
+  };
+
+  static TraceBuffer& GetInstance();
+
+  TraceBuffer();
+
+  ~TraceBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts recording, discarding the events recorded before.
+  ///
+  /// @param[in]  capacity  The number of events kept for each thread.
+  ///
+  void Enable(size_t capacity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording. The events recorded so far can still be
+  ///             dumped.
+  ///
+  void Disable();
+
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an event on the current thread, if the buffer is
+  ///             enabled.
+  ///
+  /// @param[in]  type              The type of the event.
+  /// @param[in]  name              The name of the event. It does not need to
+  ///                               outlive the call.
+  /// @param[in]  timestamp_micros  The time of the event on the timeline
+  ///                               clock.
+  /// @param[in]  id                The identifier of async and flow events,
+  ///                               or the value of counters.
+  ///
+  void Record(TraceBufferEventType type,
+              const char* name,
+              int64_t timestamp_micros,
+              int64_t id = 0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The events currently in the buffers of all threads, ordered
+  ///             by time. This may be called from any thread while events are
+  ///             being recorded.
+  ///
+  std::vector<Event> Dump() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts events to the JSON object format of the Chrome
+  ///             trace viewer, which can be loaded in chrome://tracing and
+  ///             Perfetto.
+  ///
+  static std::string ToChromeTraceJson(const std::vector<Event>& events);
+
+ private:
+  friend struct ThreadBufferHolder;
+
+  struct ThreadBuffer;
+
+  std::atomic_bool enabled_ = false;
+  // Changed every time the buffer is enabled, so that threads replace the
+  // buffers that were registered before.
+  std::atomic_uint32_t generation_ = 0;
+  std::atomic_size_t capacity_ = 0;
+
+  mutable std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+  // Interned names are never released, so that the names can be resolved by
+  // their index without locking when they are recorded.
+  mutable std::mutex names_mutex_;
+  std::vector<std::unique_ptr<std::string>> names_;
+  std::unordered_map<std::string, uint32_t> name_indices_;
+
+  ThreadBuffer* GetThreadBuffer();
+
+  const std::string* InternName(const char* name, uint32_t* index);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceBuffer);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_BUFFER_H_
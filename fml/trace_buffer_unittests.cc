@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_buffer.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+TEST(TraceBufferTest, RecordsNothingUntilEnabled) {
+  TraceBuffer buffer;
+  buffer.Record(TraceBufferEventType::kInstant, "Ignored", 1);
+  ASSERT_TRUE(buffer.Dump().empty());
+
+  buffer.Enable(16);
+  ASSERT_TRUE(buffer.IsEnabled());
+  buffer.Record(TraceBufferEventType::kBegin, "Frame", 2);
+  buffer.Record(TraceBufferEventType::kEnd, "Frame", 3);
+  buffer.Disable();
+  buffer.Record(TraceBufferEventType::kInstant, "Ignored", 4);
+
+  auto events = buffer.Dump();
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].type, TraceBufferEventType::kBegin);
+  ASSERT_EQ(events[0].name, "Frame");
+  ASSERT_EQ(events[0].timestamp_micros, 2);
+  ASSERT_EQ(events[1].type, TraceBufferEventType::kEnd);
+  ASSERT_EQ(events[1].timestamp_micros, 3);
+}
+
+TEST(TraceBufferTest, KeepsTheMostRecentEvents) {
+  TraceBuffer buffer;
+  buffer.Enable(4);
+  for (int64_t i = 0; i < 10; i++) {
+    buffer.Record(TraceBufferEventType::kCounter, "Count", i, i * 10);
+  }
+
+  auto events = buffer.Dump();
+  ASSERT_EQ(events.size(), 4u);
+  for (size_t i = 0; i < events.size(); i++) {
+    ASSERT_EQ(events[i].timestamp_micros, static_cast<int64_t>(6 + i));
+    ASSERT_EQ(events[i].id, static_cast<int64_t>(60 + i * 10));
+  }
+
+  // Enabling the buffer again discards the recorded events.
+  buffer.Enable(4);
+  ASSERT_TRUE(buffer.Dump().empty());
+}
+
+TEST(TraceBufferTest, ResolvesNamesByContents) {
+  TraceBuffer buffer;
+  buffer.Enable(16);
+  char name[] = "First";
+  buffer.Record(TraceBufferEventType::kInstant, name, 1);
+  // The same address now holds another name.
+  name[0] = 'T';
+  buffer.Record(TraceBufferEventType::kInstant, name, 2);
+  buffer.Record(TraceBufferEventType::kInstant, nullptr, 3);
+
+  auto events = buffer.Dump();
+  ASSERT_EQ(events.size(), 3u);
+  ASSERT_EQ(events[0].name, "First");
+  ASSERT_EQ(events[1].name, "Tirst");
+  ASSERT_EQ(events[2].name, "");
+}
+
+TEST(TraceBufferTest, MergesTheEventsOfAllThreads) {
+  TraceBuffer buffer;
+  buffer.Enable(16);
+  buffer.Record(TraceBufferEventType::kBegin, "Main", 1);
+  std::thread thread([&buffer]() {
+    buffer.Record(TraceBufferEventType::kAsyncBegin, "Worker", 2, 7);
+    buffer.Record(TraceBufferEventType::kAsyncEnd, "Worker", 4, 7);
+  });
+  thread.join();
+  buffer.Record(TraceBufferEventType::kEnd, "Main", 3);
+
+  // The events of threads that have exited are kept.
+  auto events = buffer.Dump();
+  ASSERT_EQ(events.size(), 4u);
+  ASSERT_EQ(events[0].name, "Main");
+  ASSERT_EQ(events[1].name, "Worker");
+  ASSERT_EQ(events[2].name, "Main");
+  ASSERT_EQ(events[3].name, "Worker");
+  ASSERT_EQ(events[0].thread_index, events[2].thread_index);
+  ASSERT_EQ(events[1].thread_index, events[3].thread_index);
+  ASSERT_NE(events[0].thread_index, events[1].thread_index);
+  ASSERT_EQ(events[3].id, 7);
+}
+
+TEST(TraceBufferTest, CanDumpWhileRecording) {
+  TraceBuffer buffer;
+  buffer.Enable(64);
+  std::atomic_bool done = false;
+  std::thread thread([&]() {
+    for (int64_t i = 0; i < 100000; i++) {
+      buffer.Record(TraceBufferEventType::kCounter, "Count", i, i);
+    }
+    done = true;
+  });
+  while (!done) {
+    for (const auto& event : buffer.Dump()) {
+      ASSERT_EQ(event.name, "Count");
+      ASSERT_EQ(event.id, event.timestamp_micros);
+    }
+  }
+  thread.join();
+  ASSERT_EQ(buffer.Dump().size(), 64u);
+}
+
+TEST(TraceBufferTest, ConvertsToChromeTraceJson) {
+  std::vector<TraceBuffer::Event> events(4);
+  events[0].type = TraceBufferEventType::kBegin;
+  events[0].name = "Frame \"1\"";
+  events[0].timestamp_micros = 10;
+  events[1].type = TraceBufferEventType::kFlowStep;
+  events[1].name = "Flow";
+  events[1].timestamp_micros = 11;
+  events[1].id = 3;
+  events[2].type = TraceBufferEventType::kCounter;
+  events[2].name = "Count";
+  events[2].timestamp_micros = 12;
+  events[2].id = 42;
+  events[3].type = TraceBufferEventType::kEnd;
+  events[3].timestamp_micros = 13;
+  events[3].thread_index = 1;
+
+  ASSERT_EQ(
+      TraceBuffer::ToChromeTraceJson(events),
+      "{\"traceEvents\":["
+      "{\"name\":\"Frame \\\"1\\\"\",\"cat\":\"Embedder\",\"ph\":\"B\","
+      "\"ts\":10,\"pid\":0,\"tid\":0},"
+      "{\"name\":\"Flow\",\"cat\":\"Embedder\",\"ph\":\"t\",\"ts\":11,"
+      "\"pid\":0,\"tid\":0,\"id\":\"3\"},"
+      "{\"name\":\"Count\",\"cat\":\"Embedder\",\"ph\":\"C\",\"ts\":12,"
+      "\"pid\":0,\"tid\":0,\"args\":{\"value\":42}},"
+      "{\"name\":\"\",\"cat\":\"Embedder\",\"ph\":\"E\",\"ts\":13,\"pid\":0,"
+      "\"tid\":1}"
+      "],\"displayTimeUnit\":\"ms\"}");
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
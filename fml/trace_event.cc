@@ -6,21 +6,98 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_buffer.h"
 
 namespace fml {
 namespace tracing {
 
+namespace {
+// The trace buffer records events in all build modes, including release builds
+// where the timeline is not available.
+inline void RecordInTraceBuffer(TraceBufferEventType type,
+                                const char* label,
+                                int64_t timestamp_micros,
+                                int64_t id) {
+  TraceBuffer& buffer = TraceBuffer::GetInstance();
+  if (buffer.IsEnabled()) {
+    buffer.Record(type, label, timestamp_micros, id);
+  }
+}
+
+inline void RecordInTraceBuffer(TraceBufferEventType type,
+                                const char* label,
+                                int64_t id = 0) {
+  TraceBuffer& buffer = TraceBuffer::GetInstance();
+  if (buffer.IsEnabled()) {
+    buffer.Record(type, label, Dart_TimelineGetMicros(), id);
+  }
+}
+}  // namespace
+
+size_t TraceNonce() {
+  static std::atomic_size_t gLastItem;
+  return ++gLastItem;
+}
+
 #if FLUTTER_TIMELINE_ENABLED
 
 namespace {
 AsciiTrie gAllowlist;
 TimelineEventHandler gTimelineEventHandler;
 
+inline void RecordInTraceBuffer(const char* label,
+                                int64_t timestamp0,
+                                int64_t timestamp1_or_async_id,
+                                Dart_Timeline_Event_Type type,
+                                intptr_t argument_count,
+                                const char** argument_values) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      RecordInTraceBuffer(TraceBufferEventType::kBegin, label, timestamp0, 0);
+      break;
+    case Dart_Timeline_Event_End:
+      RecordInTraceBuffer(TraceBufferEventType::kEnd, label, timestamp0, 0);
+      break;
+    case Dart_Timeline_Event_Instant:
+      RecordInTraceBuffer(TraceBufferEventType::kInstant, label, timestamp0, 0);
+      break;
+    case Dart_Timeline_Event_Async_Begin:
+      RecordInTraceBuffer(TraceBufferEventType::kAsyncBegin, label, timestamp0,
+                          timestamp1_or_async_id);
+      break;
+    case Dart_Timeline_Event_Async_End:
+      RecordInTraceBuffer(TraceBufferEventType::kAsyncEnd, label, timestamp0,
+                          timestamp1_or_async_id);
+      break;
+    case Dart_Timeline_Event_Flow_Begin:
+      RecordInTraceBuffer(TraceBufferEventType::kFlowBegin, label, timestamp0,
+                          timestamp1_or_async_id);
+      break;
+    case Dart_Timeline_Event_Flow_Step:
+      RecordInTraceBuffer(TraceBufferEventType::kFlowStep, label, timestamp0,
+                          timestamp1_or_async_id);
+      break;
+    case Dart_Timeline_Event_Flow_End:
+      RecordInTraceBuffer(TraceBufferEventType::kFlowEnd, label, timestamp0,
+                          timestamp1_or_async_id);
+      break;
+    case Dart_Timeline_Event_Counter:
+      // Only the first value of a counter is recorded.
+      RecordInTraceBuffer(
+          TraceBufferEventType::kCounter, label, timestamp0,
+          argument_count > 0 ? strtoll(argument_values[0], nullptr, 10) : 0);
+      break;
+    default:
+      break;
+  }
+}
+
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
@@ -28,6 +105,8 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  RecordInTraceBuffer(label, timestamp0, timestamp1_or_async_id, type,
+                      argument_count, argument_values);
   if (gTimelineEventHandler && gAllowlist.Query(label)) {
     gTimelineEventHandler(label, timestamp0, timestamp1_or_async_id, type,
                           argument_count, argument_names, argument_values);
@@ -43,11 +122,6 @@ void TraceSetTimelineEventHandler(TimelineEventHandler handler) {
   gTimelineEventHandler = handler;
 }
 
-size_t TraceNonce() {
-  static std::atomic_size_t gLastItem;
-  return ++gLastItem;
-}
-
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -295,10 +369,6 @@ void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
 
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
 
-size_t TraceNonce() {
-  return 0;
-}
-
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -314,21 +384,29 @@ void TraceTimelineEvent(TraceArg category_group,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {}
 
-void TraceEvent0(TraceArg category_group, TraceArg name) {}
+void TraceEvent0(TraceArg category_group, TraceArg name) {
+  RecordInTraceBuffer(TraceBufferEventType::kBegin, name);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kBegin, name);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kBegin, name);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  RecordInTraceBuffer(TraceBufferEventType::kEnd, name);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
@@ -337,47 +415,66 @@ void TraceEventAsyncComplete(TraceArg category_group,
 
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
-                           TraceIDArg id) {}
+                           TraceIDArg id) {
+  RecordInTraceBuffer(TraceBufferEventType::kAsyncBegin, name, id);
+}
 
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  RecordInTraceBuffer(TraceBufferEventType::kAsyncEnd, name, id);
+}
 
 void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id,
                            TraceArg arg1_name,
-                           TraceArg arg1_val) {}
+                           TraceArg arg1_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kAsyncBegin, name, id);
+}
 
 void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id,
                          TraceArg arg1_name,
-                         TraceArg arg1_val) {}
+                         TraceArg arg1_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kAsyncEnd, name, id);
+}
 
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
+void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  RecordInTraceBuffer(TraceBufferEventType::kInstant, name);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kInstant, name);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  RecordInTraceBuffer(TraceBufferEventType::kInstant, name);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
-                          TraceIDArg id) {}
+                          TraceIDArg id) {
+  RecordInTraceBuffer(TraceBufferEventType::kFlowBegin, name, id);
+}
 
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  RecordInTraceBuffer(TraceBufferEventType::kFlowStep, name, id);
+}
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  RecordInTraceBuffer(TraceBufferEventType::kFlowEnd, name, id);
 }
 
 #endif  // FLUTTER_TIMELINE_ENABLED
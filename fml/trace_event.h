@@ -239,17 +239,20 @@ void TraceCounterNopHACK(TraceArg category,
                          TraceIDArg identifier,
                          Args... args) {}
 
+void TraceEvent0(TraceArg category_group, TraceArg name);
+
 template <typename... Args>
 void TraceEvent(TraceArg category, TraceArg name, Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
                      split.second);
+#else  // FLUTTER_TIMELINE_ENABLED
+  // The end of the event is always traced, see |ScopedInstantEnd|.
+  TraceEvent0(category, name);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
-void TraceEvent0(TraceArg category_group, TraceArg name);
-
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
@@ -72,9 +72,16 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 }
 
 SceneBuilder::SceneBuilder() {
+  // The containers pushed by the framework can be retained through their
+  // EngineLayers and stay on the heap. The arena holds the root and the
+  // leaf layers, which only live as long as the layer tree of this frame.
+  if (UIDartState::Current()->enable_layer_arena()) {
+    layer_arena_ = LayerArena::Create();
+  }
+
   // Add a ContainerLayer as the root layer, so that AddLayer operations are
   // always valid.
-  PushLayer(std::make_shared<flutter::ContainerLayer>());
+  PushLayer(MakeFrameLayer<flutter::ContainerLayer>());
 }
 
 SceneBuilder::~SceneBuilder() = default;
@@ -267,12 +274,12 @@ void SceneBuilder::addPicture(double dx,
                               Picture* picture,
                               int hints) {
   if (picture->picture()) {
-    auto layer = std::make_unique<flutter::PictureLayer>(
+    auto layer = MakeFrameLayer<flutter::PictureLayer>(
         SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(picture->picture()),
         !!(hints & 1), !!(hints & 2));
     AddLayer(std::move(layer));
   } else {
-    auto layer = std::make_unique<flutter::DisplayListLayer>(
+    auto layer = MakeFrameLayer<flutter::DisplayListLayer>(
         SkPoint::Make(dx, dy),
         UIDartState::CreateGPUObject(picture->display_list()), !!(hints & 1),
         !!(hints & 2));
@@ -288,7 +295,7 @@ void SceneBuilder::addTexture(double dx,
                               bool freeze,
                               int filterQualityIndex) {
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
-  auto layer = std::make_unique<flutter::TextureLayer>(
+  auto layer = MakeFrameLayer<flutter::TextureLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
       sampling);
   AddLayer(std::move(layer));
@@ -299,7 +306,7 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
-  auto layer = std::make_unique<flutter::PlatformViewLayer>(
+  auto layer = MakeFrameLayer<flutter::PlatformViewLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
 }
@@ -311,7 +318,7 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
   auto layer =
-      std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
+      MakeFrameLayer<flutter::PerformanceOverlayLayer>(enabledOptions);
   layer->set_paint_bounds(rect);
   AddLayer(std::move(layer));
 }
@@ -335,6 +342,7 @@ void SceneBuilder::build(Dart_Handle scene_handle) {
       scene_handle, std::move(layer_stack_[0]), rasterizer_tracing_threshold_,
       checkerboard_raster_cache_images_, checkerboard_offscreen_layers_);
   layer_stack_.clear();
+  layer_arena_.reset();
   ClearDartWrapper();  // may delete this object.
 }
 
@@ -196,6 +196,22 @@ void createPath() {
 }
 void _validatePath(Path path) native 'ValidatePath';
 
+@pragma('vm:entry-point')
+void createShaderFromInvalidSkSL() {
+  final FragmentProgram program = _createFragmentProgramWithInvalidSkSL();
+  _compileRuntimeEffects();
+  try {
+    program.shader();
+  } catch (error) {
+    _reportShaderError(error.toString());
+    return;
+  }
+  _reportShaderError('');
+}
+FragmentProgram _createFragmentProgramWithInvalidSkSL() native 'CreateFragmentProgramWithInvalidSkSL';
+void _compileRuntimeEffects() native 'CompileRuntimeEffects';
+void _reportShaderError(String error) native 'ReportShaderError';
+
 @pragma('vm:entry-point')
 void frameCallback(_Image, int) {
   print('called back');
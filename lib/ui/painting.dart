@@ -3791,6 +3791,7 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
 
   void _constructor() native 'FragmentProgram_constructor';
   void _init(String sksl, bool debugPrint) native 'FragmentProgram_init';
+  void _validate() native 'FragmentProgram_validate';
 
   // TODO(chriscraws): Add `List<ImageShader>? children` as a parameter to [build].
   // https://github.com/flutter/flutter/issues/85240
@@ -3834,6 +3835,9 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
   Shader shader({
     Float32List? floatUniforms,
   }) {
+    // Invalid SkSL that is compiled in the background is reported here, before
+    // the uniforms are passed to the engine.
+    _validate();
     if (floatUniforms == null) {
       floatUniforms = Float32List(_uniformFloatCount);
     }
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <chrono>
+#include <future>
 #include <iostream>
 
 #include "flutter/lib/ui/painting/fragment_program.h"
@@ -25,8 +27,9 @@ static void FragmentProgram_constructor(Dart_NativeArguments args) {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, FragmentProgram);
 
-#define FOR_EACH_BINDING(V) \
-  V(FragmentProgram, init)  \
+#define FOR_EACH_BINDING(V)    \
+  V(FragmentProgram, init)     \
+  V(FragmentProgram, validate) \
   V(FragmentProgram, shader)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
@@ -37,25 +40,62 @@ void FragmentProgram::RegisterNatives(tonic::DartLibraryNatives* natives) {
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+static void ThrowInvalidSkSL(const std::string& sksl,
+                             const std::string& error) {
+  Dart_Handle message = tonic::ToDart(std::string("Invalid SkSL:\n") + sksl +
+                                      std::string("\nSkSL Error:\n") + error);
+  Dart_ThrowException(message);
+}
+
 void FragmentProgram::init(std::string sksl, bool debugPrintSksl) {
-  SkRuntimeEffect::Result result =
-      SkRuntimeEffect::MakeForShader(SkString(sksl));
-  runtime_effect_ = result.effect;
+  if (debugPrintSksl) {
+    FML_DLOG(INFO) << std::string("debugPrintSksl:\n") + sksl.c_str();
+  }
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  if (!UIDartState::Current()->compile_runtime_effects_in_background()) {
+    RuntimeEffectCache::Result result = cache->Get(sksl);
+    runtime_effect_ = std::move(result.effect);
+    if (runtime_effect_ == nullptr) {
+      ThrowInvalidSkSL(sksl, result.error);
+    }
+    return;
+  }
+  pending_runtime_effect_ = cache->GetAsync(sksl);
+  sksl_ = std::move(sksl);
+  // An effect that is already compiled is reported now. Otherwise invalid SkSL
+  // is reported by |validate| before the first shader is created.
+  if (pending_runtime_effect_.wait_for(std::chrono::seconds(0)) ==
+      std::future_status::ready) {
+    validate();
+  }
+}
 
-  if (runtime_effect_ == nullptr) {
-    Dart_ThrowException(tonic::ToDart(
-        std::string("Invalid SkSL:\n") + sksl.c_str() +
-        std::string("\nSkSL Error:\n") + result.errorText.c_str()));
+void FragmentProgram::validate() {
+  if (!pending_runtime_effect_.valid()) {
     return;
   }
-  if (debugPrintSksl) {
-    FML_DLOG(INFO) << std::string("debugPrintSksl:\n") + sksl.c_str();
+  RuntimeEffectCache::Result result = pending_runtime_effect_.get();
+  if (result.cancelled) {
+    // The worker dropped the compilation, so compile on this thread instead.
+    result = RuntimeEffectCache::GetCacheForProcess()->Get(sksl_);
   }
+  if (result.effect == nullptr) {
+    // The pending result is kept so that every later call throws as well.
+    ThrowInvalidSkSL(sksl_, result.error);
+    return;
+  }
+  runtime_effect_ = std::move(result.effect);
+  pending_runtime_effect_ = {};
+  sksl_.clear();
 }
 
 fml::RefPtr<FragmentShader> FragmentProgram::shader(
     Dart_Handle shader,
     const tonic::Float32List& uniforms) {
+  // Invalid SkSL has already been reported by |init| or |validate|.
+  if (runtime_effect_ == nullptr) {
+    return nullptr;
+  }
   auto sk_shader = runtime_effect_->makeShader(
       SkData::MakeWithCopy(uniforms.data(),
                            uniforms.num_elements() * sizeof(float)),
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_FRAGMENT_PROGRAM_H_
 #define FLUTTER_LIB_UI_PAINTING_FRAGMENT_PROGRAM_H_
 
+#include "flutter/common/graphics/runtime_effect_cache.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/fragment_shader.h"
 #include "third_party/skia/include/effects/SkRuntimeEffect.h"
@@ -30,6 +31,12 @@ class FragmentProgram : public RefCountedDartWrappable<FragmentProgram> {
 
   void init(std::string sksl, bool debugPrintSksl);
 
+  // Waits for the runtime effect if it is being compiled in the background,
+  // and throws a Dart exception if the SkSL is invalid. It is called before
+  // the first shader is created, as |shader| cannot throw once the uniforms
+  // have been acquired.
+  void validate();
+
   fml::RefPtr<FragmentShader> shader(Dart_Handle shader,
                                      const tonic::Float32List& uniforms);
 
@@ -37,6 +44,9 @@ class FragmentProgram : public RefCountedDartWrappable<FragmentProgram> {
 
  private:
   FragmentProgram();
+
+  std::string sksl_;
+  RuntimeEffectCache::Future pending_runtime_effect_;
   sk_sp<SkRuntimeEffect> runtime_effect_;
 };
 
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/fragment_program.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/common/graphics/runtime_effect_cache.h"
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A worker that holds the compilations until the test runs them.
+class HeldTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override {
+    std::scoped_lock lock(mutex_);
+    tasks_.push_back(task);
+  }
+
+  void RunTasks() {
+    std::vector<fml::closure> tasks;
+    {
+      std::scoped_lock lock(mutex_);
+      tasks.swap(tasks_);
+    }
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
+TEST_F(ShellTest, InvalidSkSLCompiledInTheBackgroundThrowsBeforeShader) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  auto worker = std::make_shared<HeldTaskRunner>();
+  std::string shader_error;
+
+  auto native_create_program = [](Dart_NativeArguments args) {
+    auto program = FragmentProgram::Create();
+    // The compilation is pending on the held worker, so |init| cannot report
+    // the invalid SkSL.
+    program->init("not sksl", false);
+    Dart_SetReturnValue(args, tonic::ToDart(program));
+  };
+  auto native_compile = [worker](Dart_NativeArguments args) {
+    worker->RunTasks();
+  };
+  auto native_report_error = [message_latch,
+                              &shader_error](Dart_NativeArguments args) {
+    shader_error = tonic::DartConverter<std::string>::FromDart(
+        Dart_GetNativeArgument(args, 0));
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  settings.compile_runtime_effects_in_background = true;
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("CreateFragmentProgramWithInvalidSkSL",
+                    CREATE_NATIVE_ENTRY(native_create_program));
+  AddNativeCallback("CompileRuntimeEffects",
+                    CREATE_NATIVE_ENTRY(native_compile));
+  AddNativeCallback("ReportShaderError",
+                    CREATE_NATIVE_ENTRY(native_report_error));
+
+  RuntimeEffectCache::ResetCacheForProcess();
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+  ASSERT_TRUE(shell->IsSetup());
+  RuntimeEffectCache::GetCacheForProcess()->SetWorkerTaskRunner(worker);
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("createShaderFromInvalidSkSL");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  EXPECT_EQ(shader_error.find("Invalid SkSL:\nnot sksl"), 0u);
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+  RuntimeEffectCache::ResetCacheForProcess();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -24,6 +24,10 @@ bool SemanticsNode::HasFlag(SemanticsFlags flag) const {
   return (flags & static_cast<int32_t>(flag)) != 0;
 }
 
+bool SemanticsNode::HasChange(SemanticsNodeChange change) const {
+  return (changes & static_cast<int32_t>(change)) != 0;
+}
+
 bool SemanticsNode::IsPlatformViewNode() const {
   return platformViewId > kMinPlatformViewId;
 }
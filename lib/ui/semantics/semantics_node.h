@@ -93,6 +93,30 @@ enum class SemanticsFlags : int32_t {
 const int kScrollableSemanticsFlags =
     static_cast<int32_t>(SemanticsFlags::kHasImplicitScrolling);
 
+/// The groups of `SemanticsNode` fields that can change between two updates of
+/// the same node.
+///
+///\warning This must match the `FlutterSemanticsNodeChange` enum in
+///         `shell/platform/embedder/embedder.h`.
+enum class SemanticsNodeChange : int32_t {
+  kFlags = 1 << 0,
+  kActions = 1 << 1,
+  kRect = 1 << 2,
+  kTransform = 1 << 3,
+  kLabel = 1 << 4,
+  kValue = 1 << 5,
+  kHint = 1 << 6,
+  kTooltip = 1 << 7,
+  kTextSelection = 1 << 8,
+  kScroll = 1 << 9,
+  kChildren = 1 << 10,
+  kCustomActions = 1 << 11,
+  // Value lengths, platform view ID, elevation, thickness and text direction.
+  kOther = 1 << 12,
+};
+
+const int32_t kAllSemanticsNodeChanges = (1 << 13) - 1;
+
 struct SemanticsNode {
   SemanticsNode();
 
@@ -102,6 +126,7 @@ struct SemanticsNode {
 
   bool HasAction(SemanticsAction action) const;
   bool HasFlag(SemanticsFlags flag) const;
+  bool HasChange(SemanticsNodeChange change) const;
 
   // Whether this node is for embedded platform views.
   bool IsPlatformViewNode() const;
@@ -139,6 +164,11 @@ struct SemanticsNode {
   std::vector<int32_t> childrenInTraversalOrder;
   std::vector<int32_t> childrenInHitTestOrder;
   std::vector<int32_t> customAccessibilityActions;
+
+  // The set of `SemanticsNodeChange` bits that differ from the last update
+  // delivered for this node. Nodes that were never delivered before, or that
+  // did not go through a `SemanticsTreeDiffer`, report every bit.
+  int32_t changes = kAllSemanticsNodeChanges;
 };
 
 // Contains semantic nodes that need to be updated.
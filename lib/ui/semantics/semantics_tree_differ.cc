@@ -0,0 +1,189 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
+
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Scroll positions and extents default to NaN, which must compare equal to
+// itself here.
+bool SameDouble(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool SameAttribute(const StringAttribute& a, const StringAttribute& b) {
+  if (a.start != b.start || a.end != b.end || a.type != b.type) {
+    return false;
+  }
+  if (a.type == StringAttributeType::kLocale) {
+    return static_cast<const LocaleStringAttribute&>(a).locale ==
+           static_cast<const LocaleStringAttribute&>(b).locale;
+  }
+  return true;
+}
+
+bool SameAttributes(const StringAttributes& a, const StringAttributes& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i] == b[i]) {
+      continue;
+    }
+    if (!a[i] || !b[i] || !SameAttribute(*a[i], *b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr int32_t Bit(SemanticsNodeChange change) {
+  return static_cast<int32_t>(change);
+}
+
+}  // namespace
+
+SemanticsTreeDiffer::SemanticsTreeDiffer() = default;
+
+SemanticsTreeDiffer::~SemanticsTreeDiffer() = default;
+
+int32_t SemanticsTreeDiffer::ComputeChanges(const SemanticsNode& previous,
+                                            const SemanticsNode& current) {
+  int32_t changes = 0;
+  if (previous.flags != current.flags) {
+    changes |= Bit(SemanticsNodeChange::kFlags);
+  }
+  if (previous.actions != current.actions) {
+    changes |= Bit(SemanticsNodeChange::kActions);
+  }
+  if (previous.rect != current.rect) {
+    changes |= Bit(SemanticsNodeChange::kRect);
+  }
+  if (previous.transform != current.transform) {
+    changes |= Bit(SemanticsNodeChange::kTransform);
+  }
+  if (previous.label != current.label ||
+      !SameAttributes(previous.labelAttributes, current.labelAttributes)) {
+    changes |= Bit(SemanticsNodeChange::kLabel);
+  }
+  if (previous.value != current.value ||
+      previous.increasedValue != current.increasedValue ||
+      previous.decreasedValue != current.decreasedValue ||
+      !SameAttributes(previous.valueAttributes, current.valueAttributes) ||
+      !SameAttributes(previous.increasedValueAttributes,
+                      current.increasedValueAttributes) ||
+      !SameAttributes(previous.decreasedValueAttributes,
+                      current.decreasedValueAttributes)) {
+    changes |= Bit(SemanticsNodeChange::kValue);
+  }
+  if (previous.hint != current.hint ||
+      !SameAttributes(previous.hintAttributes, current.hintAttributes)) {
+    changes |= Bit(SemanticsNodeChange::kHint);
+  }
+  if (previous.tooltip != current.tooltip) {
+    changes |= Bit(SemanticsNodeChange::kTooltip);
+  }
+  if (previous.textSelectionBase != current.textSelectionBase ||
+      previous.textSelectionExtent != current.textSelectionExtent) {
+    changes |= Bit(SemanticsNodeChange::kTextSelection);
+  }
+  if (previous.scrollChildren != current.scrollChildren ||
+      previous.scrollIndex != current.scrollIndex ||
+      !SameDouble(previous.scrollPosition, current.scrollPosition) ||
+      !SameDouble(previous.scrollExtentMax, current.scrollExtentMax) ||
+      !SameDouble(previous.scrollExtentMin, current.scrollExtentMin)) {
+    changes |= Bit(SemanticsNodeChange::kScroll);
+  }
+  if (previous.childrenInTraversalOrder != current.childrenInTraversalOrder ||
+      previous.childrenInHitTestOrder != current.childrenInHitTestOrder) {
+    changes |= Bit(SemanticsNodeChange::kChildren);
+  }
+  if (previous.customAccessibilityActions !=
+      current.customAccessibilityActions) {
+    changes |= Bit(SemanticsNodeChange::kCustomActions);
+  }
+  if (previous.maxValueLength != current.maxValueLength ||
+      previous.currentValueLength != current.currentValueLength ||
+      previous.platformViewId != current.platformViewId ||
+      !SameDouble(previous.elevation, current.elevation) ||
+      !SameDouble(previous.thickness, current.thickness) ||
+      previous.textDirection != current.textDirection) {
+    changes |= Bit(SemanticsNodeChange::kOther);
+  }
+  return changes;
+}
+
+size_t SemanticsTreeDiffer::Diff(SemanticsNodeUpdates& updates) {
+  TRACE_EVENT0("flutter", "SemanticsTreeDiffer::Diff");
+
+  // Compute the change masks against the state delivered before this update,
+  // and collect the children that were detached from a parent.
+  std::vector<int32_t> detached;
+  for (auto& [id, node] : updates) {
+    auto found = committed_.find(id);
+    if (found == committed_.end()) {
+      node.changes = kAllSemanticsNodeChanges;
+      continue;
+    }
+    const SemanticsNode& previous = found->second;
+    node.changes = ComputeChanges(previous, node);
+    if (!node.HasChange(SemanticsNodeChange::kChildren)) {
+      continue;
+    }
+    std::unordered_set<int32_t> current_children(
+        node.childrenInTraversalOrder.begin(),
+        node.childrenInTraversalOrder.end());
+    for (int32_t child : previous.childrenInTraversalOrder) {
+      if (current_children.count(child) == 0) {
+        detached.push_back(child);
+      }
+    }
+  }
+
+  for (int32_t id : detached) {
+    ForgetSubtree(id);
+  }
+
+  size_t dropped = 0;
+  for (auto it = updates.begin(); it != updates.end();) {
+    if (it->second.changes == 0) {
+      it = updates.erase(it);
+      dropped++;
+    } else {
+      committed_[it->first] = it->second;
+      ++it;
+    }
+  }
+  return dropped;
+}
+
+void SemanticsTreeDiffer::Reset() {
+  committed_.clear();
+}
+
+void SemanticsTreeDiffer::ForgetSubtree(int32_t id) {
+  std::vector<int32_t> pending = {id};
+  while (!pending.empty()) {
+    int32_t current = pending.back();
+    pending.pop_back();
+    auto found = committed_.find(current);
+    if (found == committed_.end()) {
+      continue;
+    }
+    pending.insert(pending.end(),
+                   found->second.childrenInTraversalOrder.begin(),
+                   found->second.childrenInTraversalOrder.end());
+    committed_.erase(found);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
+#define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Remembers the last semantics state delivered to the platform for
+///             every node and filters out updates that would not change it.
+///
+///             The framework sends every node that was marked dirty during
+///             `PipelineOwner.flushSemantics`, even if none of its fields ended
+///             up changing. Platform accessibility bridges then rebuild their
+///             native nodes for each of them. The differ drops those no-op
+///             updates before they leave the UI thread and annotates the
+///             remaining nodes with a `SemanticsNodeChange` mask.
+///
+///             Nodes removed from their parent's child list are forgotten
+///             along with their subtree, so that a node re-added later is
+///             always delivered in full. This mirrors the way the platform
+///             bridges discard unreachable nodes.
+///
+///             This class is not thread safe and is meant to be used on the UI
+///             thread only.
+///
+class SemanticsTreeDiffer {
+ public:
+  SemanticsTreeDiffer();
+
+  ~SemanticsTreeDiffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the nodes in `updates` that are identical to their
+  ///             last delivered state, fills in `SemanticsNode::changes` for
+  ///             the others and commits them as the new delivered state.
+  ///
+  /// @param      updates  The updates produced by the framework.
+  ///
+  /// @return     The number of nodes removed from `updates`.
+  ///
+  size_t Diff(SemanticsNodeUpdates& updates);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all committed state. The next update for each node
+  ///             will be delivered in full. Must be called whenever the
+  ///             platform side may have discarded its tree, for instance when
+  ///             semantics are toggled or the isolate is restarted.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of nodes whose delivered state is remembered.
+  ///
+  size_t GetCommittedNodeCount() const { return committed_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the `SemanticsNodeChange` mask between two states of
+  ///             the same node.
+  ///
+  static int32_t ComputeChanges(const SemanticsNode& previous,
+                                const SemanticsNode& current);
+
+ private:
+  SemanticsNodeUpdates committed_;
+
+  void ForgetSubtree(int32_t id);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsTreeDiffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_DIFFER_H_
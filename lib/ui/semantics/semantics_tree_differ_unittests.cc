@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+SemanticsNode MakeNode(int32_t id, std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = "node " + std::to_string(id);
+  node.rect = SkRect::MakeLTRB(0, 0, 100, 100);
+  node.childrenInTraversalOrder = children;
+  node.childrenInHitTestOrder = children;
+  return node;
+}
+
+}  // namespace
+
+TEST(SemanticsTreeDifferTest, NewNodesAreDeliveredInFull) {
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates updates;
+  updates[0] = MakeNode(0, {1});
+  updates[1] = MakeNode(1);
+
+  ASSERT_EQ(differ.Diff(updates), 0u);
+  ASSERT_EQ(updates.size(), 2u);
+  ASSERT_EQ(updates[0].changes, kAllSemanticsNodeChanges);
+  ASSERT_EQ(updates[1].changes, kAllSemanticsNodeChanges);
+  ASSERT_EQ(differ.GetCommittedNodeCount(), 2u);
+}
+
+TEST(SemanticsTreeDifferTest, DropsUnchangedNodes) {
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates first;
+  first[0] = MakeNode(0, {1});
+  first[1] = MakeNode(1);
+  differ.Diff(first);
+
+  SemanticsNodeUpdates second;
+  second[0] = MakeNode(0, {1});
+  second[1] = MakeNode(1);
+  second[1].rect = SkRect::MakeLTRB(0, 10, 100, 110);
+
+  ASSERT_EQ(differ.Diff(second), 1u);
+  ASSERT_EQ(second.size(), 1u);
+  ASSERT_EQ(second[1].changes,
+            static_cast<int32_t>(SemanticsNodeChange::kRect));
+}
+
+TEST(SemanticsTreeDifferTest, NaNScrollPositionsCompareEqual) {
+  SemanticsNode node = MakeNode(0);
+  ASSERT_TRUE(std::isnan(node.scrollPosition));
+  ASSERT_EQ(SemanticsTreeDiffer::ComputeChanges(node, node), 0);
+
+  SemanticsNode scrolled = node;
+  scrolled.scrollPosition = 10.0;
+  ASSERT_EQ(SemanticsTreeDiffer::ComputeChanges(node, scrolled),
+            static_cast<int32_t>(SemanticsNodeChange::kScroll));
+}
+
+TEST(SemanticsTreeDifferTest, ComparesStringAttributesByValue) {
+  SemanticsNode node = MakeNode(0);
+  auto attribute = std::make_shared<LocaleStringAttribute>();
+  attribute->start = 0;
+  attribute->end = 1;
+  attribute->type = StringAttributeType::kLocale;
+  attribute->locale = "en-US";
+  node.labelAttributes.push_back(attribute);
+
+  SemanticsNode same = node;
+  auto copy = std::make_shared<LocaleStringAttribute>(*attribute);
+  same.labelAttributes = {copy};
+  ASSERT_EQ(SemanticsTreeDiffer::ComputeChanges(node, same), 0);
+
+  copy->locale = "fr-FR";
+  ASSERT_EQ(SemanticsTreeDiffer::ComputeChanges(node, same),
+            static_cast<int32_t>(SemanticsNodeChange::kLabel));
+}
+
+TEST(SemanticsTreeDifferTest, DetachedSubtreesAreRedeliveredWhenReattached) {
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates first;
+  first[0] = MakeNode(0, {1});
+  first[1] = MakeNode(1, {2});
+  first[2] = MakeNode(2);
+  differ.Diff(first);
+
+  SemanticsNodeUpdates detach;
+  detach[0] = MakeNode(0);
+  ASSERT_EQ(differ.Diff(detach), 0u);
+  ASSERT_EQ(detach[0].changes,
+            static_cast<int32_t>(SemanticsNodeChange::kChildren));
+  ASSERT_EQ(differ.GetCommittedNodeCount(), 1u);
+
+  SemanticsNodeUpdates reattach;
+  reattach[0] = MakeNode(0, {1});
+  reattach[1] = MakeNode(1, {2});
+  reattach[2] = MakeNode(2);
+  ASSERT_EQ(differ.Diff(reattach), 0u);
+  ASSERT_EQ(reattach.size(), 3u);
+  ASSERT_EQ(reattach[2].changes, kAllSemanticsNodeChanges);
+}
+
+TEST(SemanticsTreeDifferTest, ResetForgetsCommittedState) {
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates first;
+  first[0] = MakeNode(0);
+  differ.Diff(first);
+  differ.Reset();
+  ASSERT_EQ(differ.GetCommittedNodeCount(), 0u);
+
+  SemanticsNodeUpdates second;
+  second[0] = MakeNode(0);
+  ASSERT_EQ(differ.Diff(second), 0u);
+  ASSERT_EQ(second.size(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
@@ -112,9 +113,56 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Simulates a scrolling list where the framework resends every visible item
+// each frame but only |state.range(1)| of them actually moved.
+static void BM_SemanticsTreeDiffer(benchmark::State& state) {
+  const int32_t node_count = state.range(0);
+  const int32_t changed_count = state.range(1);
+
+  SemanticsNodeUpdates tree;
+  SemanticsNode& root = tree[0];
+  for (int32_t id = 1; id <= node_count; id++) {
+    root.childrenInTraversalOrder.push_back(id);
+    root.childrenInHitTestOrder.push_back(id);
+    SemanticsNode& node = tree[id];
+    node.id = id;
+    node.label = "Item " + std::to_string(id);
+    node.actions = static_cast<int32_t>(SemanticsAction::kTap);
+    node.rect = SkRect::MakeXYWH(0, id * 48, 400, 48);
+  }
+
+  SemanticsTreeDiffer differ;
+  SemanticsNodeUpdates initial = tree;
+  differ.Diff(initial);
+
+  size_t delivered = 0;
+  int32_t frame = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    SemanticsNodeUpdates update = tree;
+    frame++;
+    for (int32_t id = 1; id <= changed_count; id++) {
+      update[id].rect.offset(0, frame);
+    }
+    state.ResumeTiming();
+
+    differ.Diff(update);
+    delivered += update.size();
+  }
+  state.counters["DeliveredNodesPerFrame"] =
+      benchmark::Counter(delivered, benchmark::Counter::kAvgIterations);
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_SemanticsTreeDiffer)
+    ->Args({100, 0})
+    ->Args({100, 10})
+    ->Args({1000, 0})
+    ->Args({1000, 100})
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
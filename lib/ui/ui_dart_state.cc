@@ -57,6 +57,9 @@ UIDartState::UIDartState(
     bool is_root_isolate,
     bool enable_skparagraph,
     bool enable_display_list,
+    bool optimize_display_lists,
+    bool enable_layer_arena,
+    bool compile_runtime_effects_in_background,
     const UIDartState::Context& context)
     : add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -67,6 +70,10 @@ UIDartState::UIDartState(
       isolate_name_server_(std::move(isolate_name_server)),
       enable_skparagraph_(enable_skparagraph),
       enable_display_list_(enable_display_list),
+      optimize_display_lists_(optimize_display_lists),
+      enable_layer_arena_(enable_layer_arena),
+      compile_runtime_effects_in_background_(
+          compile_runtime_effects_in_background),
       context_(std::move(context)) {
   AddOrRemoveTaskObserver(true /* add */);
 }
@@ -244,4 +251,16 @@ bool UIDartState::enable_display_list() const {
   return enable_display_list_;
 }
 
+bool UIDartState::optimize_display_lists() const {
+  return optimize_display_lists_;
+}
+
+bool UIDartState::enable_layer_arena() const {
+  return enable_layer_arena_;
+}
+
+bool UIDartState::compile_runtime_effects_in_background() const {
+  return compile_runtime_effects_in_background_;
+}
+
 }  // namespace flutter
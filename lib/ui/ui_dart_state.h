@@ -145,6 +145,12 @@ class UIDartState : public tonic::DartState {
 
   bool enable_display_list() const;
 
+  bool optimize_display_lists() const;
+
+  bool enable_layer_arena() const;
+
+  bool compile_runtime_effects_in_background() const;
+
   template <class T>
   static flutter::SkiaGPUObject<T> CreateGPUObject(sk_sp<T> object) {
     if (!object) {
@@ -166,6 +172,9 @@ class UIDartState : public tonic::DartState {
               bool is_root_isolate_,
               bool enable_skparagraph,
               bool enable_display_list,
+              bool optimize_display_lists,
+              bool enable_layer_arena,
+              bool compile_runtime_effects_in_background,
               const UIDartState::Context& context);
 
   ~UIDartState() override;
@@ -193,6 +202,9 @@ class UIDartState : public tonic::DartState {
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   const bool enable_skparagraph_;
   const bool enable_display_list_;
+  const bool optimize_display_lists_;
+  const bool enable_layer_arena_;
+  const bool compile_runtime_effects_in_background_;
   UIDartState::Context context_;
 
   void AddOrRemoveTaskObserver(bool add);
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/input_event_batch.h"
+
+namespace flutter {
+
+InputEventBatch::InputEventBatch() = default;
+
+InputEventBatch::~InputEventBatch() = default;
+
+InputEventBatch::InputEventBatch(InputEventBatch&& other) = default;
+
+InputEventBatch& InputEventBatch::operator=(InputEventBatch&& other) = default;
+
+void InputEventBatch::AddPointerData(const PointerData& data) {
+  if (!pointer_entry_open_) {
+    Entry entry;
+    entry.pointer_data_start = pointer_data_.size();
+    entries_.push_back(std::move(entry));
+    pointer_entry_open_ = true;
+  }
+  pointer_data_.push_back(data);
+  entries_.back().pointer_data_count++;
+}
+
+void InputEventBatch::AddKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
+                                       KeyDataResponse callback) {
+  Entry entry;
+  entry.key_packet = std::move(packet);
+  entry.key_callback = std::move(callback);
+  entries_.push_back(std::move(entry));
+  pointer_entry_open_ = false;
+}
+
+bool InputEventBatch::IsEmpty() const {
+  return entries_.empty();
+}
+
+std::vector<InputEventBatch::Entry>& InputEventBatch::GetEntries() {
+  for (auto& entry : entries_) {
+    if (entry.pointer_data_count == 0 || entry.pointer_packet) {
+      continue;
+    }
+    entry.pointer_packet =
+        std::make_unique<PointerDataPacket>(entry.pointer_data_count);
+    for (size_t i = 0; i < entry.pointer_data_count; i++) {
+      entry.pointer_packet->SetPointerData(
+          i, pointer_data_[entry.pointer_data_start + i]);
+    }
+  }
+  // Entries are not packed twice, and later pointer events start a new entry.
+  pointer_entry_open_ = false;
+  return entries_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_INPUT_EVENT_BATCH_H_
+#define FLUTTER_LIB_UI_WINDOW_INPUT_EVENT_BATCH_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/key_data_packet.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An ordered sequence of pointer and key events that is delivered to the
+/// framework with a single hop to the UI thread.
+///
+/// Consecutive pointer events are gathered into one `PointerDataPacket`, so a
+/// batch holding only pointer events dispatches exactly like a single call to
+/// `PlatformView::DispatchPointerDataPacket`. Each key event keeps its own
+/// `KeyDataPacket` and response callback, since the framework answers key
+/// events one at a time.
+///
+class InputEventBatch {
+ public:
+  using KeyDataResponse = std::function<void(bool /* handled */)>;
+
+  struct Entry {
+    // Exactly one of |pointer_packet| and |key_packet| is set once the entries
+    // are returned by |GetEntries|.
+    std::unique_ptr<PointerDataPacket> pointer_packet;
+    std::unique_ptr<KeyDataPacket> key_packet;
+    KeyDataResponse key_callback;
+    // The range of the pointer events of the batch that |pointer_packet| is
+    // made from.
+    size_t pointer_data_start = 0;
+    size_t pointer_data_count = 0;
+  };
+
+  InputEventBatch();
+
+  ~InputEventBatch();
+
+  InputEventBatch(InputEventBatch&& other);
+
+  InputEventBatch& operator=(InputEventBatch&& other);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends a pointer event. It joins the packet of the pointer
+  ///             events directly before it.
+  ///
+  void AddPointerData(const PointerData& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends a key event.
+  ///
+  /// @param[in]  packet    The key data packet containing one key event.
+  /// @param[in]  callback  Called when the framework has decided whether to
+  ///                       handle this key data.
+  ///
+  void AddKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
+                        KeyDataResponse callback);
+
+  bool IsEmpty() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The packets of the batch, in the order the events were
+  ///             added. Pointer events that were not converted by a
+  ///             `PointerDataPacketConverter` are packed as they were added.
+  ///
+  std::vector<Entry>& GetEntries();
+
+ private:
+  friend class PointerDataPacketConverter;
+
+  std::vector<Entry> entries_;
+  // The pointer events of all of the entries, in the order they were added.
+  // They are kept unpacked so that they can be converted in one pass.
+  std::vector<PointerData> pointer_data_;
+  // Whether the last entry is a pointer entry that later pointer events join.
+  bool pointer_entry_open_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(InputEventBatch);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_INPUT_EVENT_BATCH_H_
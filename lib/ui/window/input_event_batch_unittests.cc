@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/input_event_batch.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreateMove(double x) {
+  PointerData data;
+  data.Clear();
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.physical_x = x;
+  return data;
+}
+
+std::unique_ptr<KeyDataPacket> CreateKeyDataPacket(uint64_t logical) {
+  KeyData key_data;
+  key_data.Clear();
+  key_data.type = KeyEventType::kDown;
+  key_data.logical = logical;
+  return std::make_unique<KeyDataPacket>(key_data, nullptr);
+}
+
+size_t PointerCount(const PointerDataPacket& packet) {
+  return packet.data().size() / sizeof(PointerData);
+}
+
+}  // namespace
+
+TEST(InputEventBatchTest, EmptyBatchHasNoEntries) {
+  InputEventBatch batch;
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_TRUE(batch.GetEntries().empty());
+}
+
+TEST(InputEventBatchTest, ConsecutivePointerEventsShareAPacket) {
+  InputEventBatch batch;
+  batch.AddPointerData(CreateMove(1));
+  batch.AddPointerData(CreateMove(2));
+  batch.AddPointerData(CreateMove(3));
+  ASSERT_FALSE(batch.IsEmpty());
+
+  auto& entries = batch.GetEntries();
+  ASSERT_EQ(entries.size(), 1u);
+  ASSERT_NE(entries[0].pointer_packet, nullptr);
+  ASSERT_EQ(entries[0].key_packet, nullptr);
+  ASSERT_EQ(PointerCount(*entries[0].pointer_packet), 3u);
+
+  PointerData last;
+  memcpy(&last, &entries[0].pointer_packet->data()[2 * sizeof(PointerData)],
+         sizeof(PointerData));
+  ASSERT_EQ(last.physical_x, 3);
+}
+
+TEST(InputEventBatchTest, KeyEventsSplitPointerPackets) {
+  InputEventBatch batch;
+  bool handled = false;
+  batch.AddPointerData(CreateMove(1));
+  batch.AddKeyDataPacket(CreateKeyDataPacket(42),
+                         [&handled](bool result) { handled = result; });
+  batch.AddPointerData(CreateMove(2));
+  batch.AddPointerData(CreateMove(3));
+  batch.AddKeyDataPacket(CreateKeyDataPacket(43), nullptr);
+
+  auto& entries = batch.GetEntries();
+  ASSERT_EQ(entries.size(), 4u);
+  ASSERT_EQ(PointerCount(*entries[0].pointer_packet), 1u);
+  ASSERT_NE(entries[1].key_packet, nullptr);
+  ASSERT_EQ(PointerCount(*entries[2].pointer_packet), 2u);
+  ASSERT_NE(entries[3].key_packet, nullptr);
+
+  entries[1].key_callback(true);
+  ASSERT_TRUE(handled);
+  ASSERT_FALSE(entries[3].key_callback);
+}
+
+}  // namespace testing
+}  // namespace flutter
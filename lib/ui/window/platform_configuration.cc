@@ -190,8 +190,32 @@ void _RespondToKeyData(Dart_NativeArguments args) {
   tonic::DartCallStatic(&RespondToKeyData, args);
 }
 
-Dart_Handle ToByteData(const fml::Mapping& buffer) {
-  return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
+// Payloads smaller than this are copied into the Dart heap, which is cheaper
+// than tracking an external allocation. Matches the threshold used by
+// |tonic::DartByteData::Create|.
+constexpr size_t kExternalByteDataThreshold = 1000;
+
+void FinalizeMallocMapping(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<fml::MallocMapping*>(peer);
+}
+
+// Hands the buffer to Dart. Large buffers are adopted by an external ByteData
+// instead of being copied; the mapping is released when the ByteData is
+// collected.
+Dart_Handle ToByteData(fml::MallocMapping buffer) {
+  if (buffer.GetSize() < kExternalByteDataThreshold) {
+    return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
+  }
+  void* bytes = const_cast<uint8_t*>(buffer.GetMapping());
+  const intptr_t length = buffer.GetSize();
+  auto* peer = new fml::MallocMapping(std::move(buffer));
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, bytes, length, peer, length,
+      FinalizeMallocMapping);
+  if (Dart_IsError(handle)) {
+    delete peer;
+  }
+  return handle;
 }
 
 }  // namespace
@@ -317,7 +341,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -348,7 +372,7 @@ void PlatformConfiguration::DispatchSemanticsAction(int32_t id,
   tonic::DartState::Scope scope(dart_state);
 
   Dart_Handle args_handle =
-      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(args);
+      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(std::move(args));
 
   if (Dart_IsError(args_handle)) {
     return;
@@ -17,27 +17,46 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
   size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
-  auto buffer = packet->data();
+  const auto& buffer = packet->data();
   size_t buffer_length = buffer.size();
 
-  std::vector<PointerData> converted_pointers;
+  converted_pointers_.clear();
   // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
+  // converted_pointers_.
   for (size_t i = 0; i < buffer_length / kBytesPerPointerData; i++) {
     PointerData pointer_data;
     memcpy(&pointer_data, &buffer[i * kBytesPerPointerData],
            sizeof(PointerData));
-    ConvertPointerData(pointer_data, converted_pointers);
+    ConvertPointerData(pointer_data, converted_pointers_);
   }
 
-  // Writes converted_pointers into converted_packet.
+  return PackConvertedPointers();
+}
+
+void PointerDataPacketConverter::Convert(InputEventBatch& batch) {
+  for (auto& entry : batch.entries_) {
+    if (entry.pointer_data_count == 0 || entry.pointer_packet) {
+      continue;
+    }
+    converted_pointers_.clear();
+    const PointerData* pointer_data =
+        batch.pointer_data_.data() + entry.pointer_data_start;
+    for (size_t i = 0; i < entry.pointer_data_count; i++) {
+      ConvertPointerData(pointer_data[i], converted_pointers_);
+    }
+    entry.pointer_packet = PackConvertedPointers();
+  }
+  batch.pointer_entry_open_ = false;
+}
+
+std::unique_ptr<PointerDataPacket>
+PointerDataPacketConverter::PackConvertedPointers() {
   auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
+      std::make_unique<flutter::PointerDataPacket>(converted_pointers_.size());
   size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
+  for (auto& converted_pointer : converted_pointers_) {
     converted_packet->SetPointerData(count++, converted_pointer);
   }
-
   return converted_packet;
 }
 
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/input_event_batch.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 
 namespace flutter {
@@ -91,11 +92,31 @@ class PointerDataPacketConverter {
   std::unique_ptr<PointerDataPacket> Convert(
       std::unique_ptr<PointerDataPacket> packet);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Converts the pointer events of a batch in one pass, in the
+  ///             order they were added, and packs each run of pointer events
+  ///             into the packet of its entry. Key events are left as they
+  ///             are.
+  ///
+  ///             The events are converted straight from the batch, so they
+  ///             are copied into a packet once instead of being packed by the
+  ///             batch and unpacked again here.
+  ///
+  /// @param[in]  batch  The batch whose pointer events are converted.
+  ///
+  void Convert(InputEventBatch& batch);
+
  private:
   std::map<int64_t, PointerState> states_;
 
   int64_t pointer_;
 
+  // The converted events of the packet or entry being converted. It is kept
+  // between calls so that its storage is reused.
+  std::vector<PointerData> converted_pointers_;
+
+  std::unique_ptr<PointerDataPacket> PackConvertedPointers();
+
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
@@ -599,5 +599,44 @@ TEST(PointerDataPacketConverterTest, CanConvetScroll) {
   ASSERT_EQ(result[6].scroll_delta_y, 0.0);
 }
 
+TEST(PointerDataPacketConverterTest, CanConvertInputEventBatch) {
+  PointerDataPacketConverter converter;
+  InputEventBatch batch;
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 330.0, 450.0,
+                             1);
+  batch.AddPointerData(data);
+  KeyData key_data;
+  key_data.Clear();
+  key_data.type = KeyEventType::kDown;
+  batch.AddKeyDataPacket(std::make_unique<KeyDataPacket>(key_data, nullptr),
+                         nullptr);
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 0.0, 0.0, 0);
+  batch.AddPointerData(data);
+  converter.Convert(batch);
+
+  auto& entries = batch.GetEntries();
+  ASSERT_EQ(entries.size(), (size_t)3);
+  ASSERT_NE(entries[1].key_packet, nullptr);
+  ASSERT_EQ(entries[1].pointer_packet, nullptr);
+
+  // The pointer state is carried from one run of pointer events to the next,
+  // as if they had been converted from one packet.
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(entries[0].pointer_packet));
+  ASSERT_EQ(result.size(), (size_t)2);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[0].synthesized, 1);
+  ASSERT_EQ(result[1].change, PointerData::Change::kDown);
+
+  result.clear();
+  UnpackPointerPacket(result, std::move(entries[2].pointer_packet));
+  ASSERT_EQ(result.size(), (size_t)2);
+  ASSERT_EQ(result[0].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[0].physical_delta_x, -330.0);
+  ASSERT_EQ(result[0].synthesized, 1);
+  ASSERT_EQ(result[1].change, PointerData::Change::kUp);
+}
+
 }  // namespace testing
 }  // namespace flutter
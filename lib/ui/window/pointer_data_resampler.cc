@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+bool IsMoveOrHover(const PointerData& data) {
+  return (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+size_t DeviceKindIndex(PointerData::DeviceKind kind) {
+  size_t index = static_cast<size_t>(kind);
+  return index < kPointerDeviceKindCount ? index : kPointerDeviceKindCount;
+}
+
+}  // namespace
+
+PointerResamplingMode PointerDataResampler::Config::GetMode(
+    PointerData::DeviceKind kind) const {
+  size_t index = DeviceKindIndex(kind);
+  return index < kPointerDeviceKindCount ? modes[index]
+                                         : PointerResamplingMode::kNone;
+}
+
+void PointerDataResampler::Config::SetMode(PointerData::DeviceKind kind,
+                                            PointerResamplingMode mode) {
+  size_t index = DeviceKindIndex(kind);
+  FML_DCHECK(index < kPointerDeviceKindCount);
+  if (index < kPointerDeviceKindCount) {
+    modes[index] = mode;
+  }
+}
+
+bool PointerDataResampler::Config::IsEnabled() const {
+  return std::any_of(std::begin(modes), std::end(modes),
+                     [](PointerResamplingMode mode) {
+                       return mode != PointerResamplingMode::kNone;
+                     });
+}
+
+PointerDataResampler::PointerDataResampler(Config config)
+    : config_(std::move(config)) {}
+
+PointerDataResampler::~PointerDataResampler() = default;
+
+bool PointerDataResampler::ShouldBuffer(const PointerDataPacket& packet) const {
+  const auto& buffer = packet.data();
+  size_t count = buffer.size() / sizeof(PointerData);
+  for (size_t i = 0; i < count; i++) {
+    PointerData data;
+    memcpy(&data, &buffer[i * sizeof(PointerData)], sizeof(PointerData));
+    if (config_.GetMode(data.kind) != PointerResamplingMode::kNone) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PointerDataResampler::AddPacket(const PointerDataPacket& packet) {
+  const auto& buffer = packet.data();
+  size_t count = buffer.size() / sizeof(PointerData);
+  size_t offset = pending_.size();
+  pending_.resize(offset + count);
+  memcpy(pending_.data() + offset, buffer.data(), count * sizeof(PointerData));
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataResampler::Flush(
+    fml::TimePoint vsync_target_time) {
+  const int64_t sample_time = (vsync_target_time - config_.sampling_offset)
+                                  .ToEpochDelta()
+                                  .ToMicroseconds();
+
+  std::vector<PointerData> events;
+  events.reserve(pending_.size());
+  std::vector<PointerData> held_back;
+  // The index in |events| of the merged move or hover of each pointer. A
+  // pointer's slot is closed by any other kind of event for that pointer.
+  std::map<int64_t, size_t> move_slots;
+  // The index in |held_back| of the first held back event of each pointer.
+  // Once an event of a pointer is held back, so are all its later events.
+  std::map<int64_t, size_t> first_held_back;
+
+  for (size_t i = 0; i < pending_.size(); i++) {
+    const PointerData& data = pending_[i];
+    PointerResamplingMode mode = config_.GetMode(data.kind);
+    if (mode == PointerResamplingMode::kNone) {
+      events.push_back(data);
+      continue;
+    }
+
+    if (mode == PointerResamplingMode::kResample && i >= carried_over_ &&
+        (first_held_back.count(data.device) > 0 ||
+         (IsMoveOrHover(data) && data.time_stamp > sample_time))) {
+      first_held_back.emplace(data.device, held_back.size());
+      held_back.push_back(data);
+      continue;
+    }
+
+    RecordSample(data);
+
+    if (IsMoveOrHover(data)) {
+      auto slot = move_slots.find(data.device);
+      if (slot != move_slots.end()) {
+        events[slot->second] = data;
+      } else {
+        move_slots[data.device] = events.size();
+        events.push_back(data);
+      }
+      continue;
+    }
+
+    move_slots.erase(data.device);
+    events.push_back(data);
+  }
+
+  // Move the merged event of each resampled pointer to the sample time.
+  for (const auto& [device, index] : move_slots) {
+    PointerData& data = events[index];
+    if (config_.GetMode(data.kind) != PointerResamplingMode::kResample) {
+      continue;
+    }
+    auto held = first_held_back.find(device);
+    const PointerData* next =
+        held == first_held_back.end() ? nullptr : &held_back[held->second];
+    Sample sample = Resample(devices_[device], next, sample_time);
+    data.time_stamp = sample.time;
+    data.physical_x = sample.x;
+    data.physical_y = sample.y;
+  }
+
+  // Pointers whose samples are all newer than the sample time still move
+  // towards their next sample, so that the pointer does not stall for a
+  // frame.
+  for (const auto& [device, index] : first_held_back) {
+    if (move_slots.count(device) > 0) {
+      continue;
+    }
+    auto state = devices_.find(device);
+    if (state == devices_.end() || !state->second.has_last ||
+        state->second.last.time >= sample_time) {
+      continue;
+    }
+    const PointerData& next = held_back[index];
+    FML_DCHECK(IsMoveOrHover(next));
+    Sample sample = Resample(state->second, &next, sample_time);
+    PointerData data = next;
+    data.time_stamp = sample.time;
+    data.physical_x = sample.x;
+    data.physical_y = sample.y;
+    events.push_back(data);
+  }
+
+  pending_ = std::move(held_back);
+  carried_over_ = pending_.size();
+
+  if (events.empty()) {
+    return nullptr;
+  }
+
+  UpdateDeltas(events);
+
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+void PointerDataResampler::RecordSample(const PointerData& data) {
+  DeviceState& state = devices_[data.device];
+  switch (data.change) {
+    case PointerData::Change::kUp:
+    case PointerData::Change::kCancel:
+    case PointerData::Change::kRemove:
+      state.has_last = false;
+      state.has_previous = false;
+      return;
+    case PointerData::Change::kDown:
+    case PointerData::Change::kAdd:
+      // A new stroke. Do not extrapolate across it.
+      state.has_previous = false;
+      state.last = {data.time_stamp, data.physical_x, data.physical_y};
+      state.has_last = true;
+      return;
+    case PointerData::Change::kMove:
+    case PointerData::Change::kHover:
+      if (data.signal_kind != PointerData::SignalKind::kNone) {
+        return;
+      }
+      state.has_previous =
+          state.has_last && data.time_stamp > state.last.time;
+      if (state.has_previous) {
+        state.previous = state.last;
+      }
+      state.last = {data.time_stamp, data.physical_x, data.physical_y};
+      state.has_last = true;
+      return;
+  }
+}
+
+PointerDataResampler::Sample PointerDataResampler::Resample(
+    const DeviceState& state,
+    const PointerData* next,
+    int64_t sample_time) const {
+  const Sample& last = state.last;
+  if (!state.has_last || sample_time <= last.time) {
+    return last;
+  }
+
+  // Interpolate between the newest dispatched sample and the next one.
+  if (next != nullptr && next->time_stamp > last.time) {
+    double t = static_cast<double>(sample_time - last.time) /
+               static_cast<double>(next->time_stamp - last.time);
+    t = std::min(t, 1.0);
+    return {sample_time, last.x + (next->physical_x - last.x) * t,
+            last.y + (next->physical_y - last.y) * t};
+  }
+
+  // Extrapolate along the velocity of the two newest samples.
+  const int64_t horizon = config_.prediction_horizon.ToMicroseconds();
+  if (horizon > 0 && state.has_previous && last.time > state.previous.time) {
+    const Sample& previous = state.previous;
+    int64_t dt = std::min(sample_time - last.time, horizon);
+    double scale = static_cast<double>(dt) /
+                   static_cast<double>(last.time - previous.time);
+    return {last.time + dt, last.x + (last.x - previous.x) * scale,
+            last.y + (last.y - previous.y) * scale};
+  }
+
+  return last;
+}
+
+void PointerDataResampler::UpdateDeltas(std::vector<PointerData>& events) {
+  for (PointerData& data : events) {
+    if (config_.GetMode(data.kind) == PointerResamplingMode::kNone) {
+      continue;
+    }
+    DeviceState& state = devices_[data.device];
+    if (IsMoveOrHover(data) && state.has_dispatched) {
+      data.physical_delta_x = data.physical_x - state.dispatched_x;
+      data.physical_delta_y = data.physical_y - state.dispatched_y;
+    }
+    state.dispatched_x = data.physical_x;
+    state.dispatched_y = data.physical_y;
+    state.has_dispatched = data.change != PointerData::Change::kRemove;
+  }
+}
+
+}  // namespace flutter
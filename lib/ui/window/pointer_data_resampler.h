@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
+#define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+// The number of values in |PointerData::DeviceKind|.
+static constexpr size_t kPointerDeviceKindCount = 4;
+
+//------------------------------------------------------------------------------
+/// How the pointer events of one |PointerData::DeviceKind| are delivered to
+/// the framework.
+///
+enum class PointerResamplingMode {
+  // Events are dispatched as soon as they are received.
+  kNone,
+  // Events are buffered until the next vsync. Consecutive move or hover
+  // events of a pointer are merged into the latest one.
+  kCoalesce,
+  // Like |kCoalesce|, and the position of a moving pointer is additionally
+  // resampled at the sample time of the frame. Samples newer than the sample
+  // time are held back for a later frame.
+  kResample,
+};
+
+//------------------------------------------------------------------------------
+/// Buffers pointer events between vsyncs and produces a single packet per
+/// frame. Depending on the |PointerResamplingMode| configured for each device
+/// kind, high-rate move events are coalesced and their positions are
+/// resampled at `vsync_target_time - sampling_offset`, by interpolating
+/// between the samples on either side of that time or, if enabled, by
+/// extrapolating over a short prediction horizon.
+///
+/// Down, up, cancel, add, remove and signal events are never merged or moved
+/// and keep their order relative to the other events of the same pointer.
+/// Events of device kinds configured as |PointerResamplingMode::kNone| are
+/// passed through unmodified.
+///
+/// This class is not thread safe. It is used by
+/// |ResamplingPointerDataDispatcher| on the UI thread.
+///
+class PointerDataResampler {
+ public:
+  struct Config {
+    // Indexed by |PointerData::DeviceKind|.
+    PointerResamplingMode modes[kPointerDeviceKindCount] = {};
+
+    // How far behind the vsync target time positions are resampled. Trailing
+    // the target time makes it likely that a real sample exists on either
+    // side of the sample time, so positions are interpolated rather than
+    // extrapolated.
+    fml::TimeDelta sampling_offset;
+
+    // The maximum duration past the newest sample for which a position is
+    // extrapolated. Zero disables prediction, in which case the pointer is
+    // held at its newest position.
+    fml::TimeDelta prediction_horizon;
+
+    PointerResamplingMode GetMode(PointerData::DeviceKind kind) const;
+
+    void SetMode(PointerData::DeviceKind kind, PointerResamplingMode mode);
+
+    // Whether any device kind is buffered.
+    bool IsEnabled() const;
+  };
+
+  explicit PointerDataResampler(Config config);
+
+  ~PointerDataResampler();
+
+  const Config& GetConfig() const { return config_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the packet contains events that must wait for the
+  ///             next vsync. Packets that do not may be dispatched right away
+  ///             as long as no events are pending.
+  ///
+  bool ShouldBuffer(const PointerDataPacket& packet) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the events of the packet to the pending events.
+  ///
+  void AddPacket(const PointerDataPacket& packet);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether events are waiting for a call to |Flush|.
+  ///
+  bool HasPendingEvents() const { return !pending_.empty(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Produces the packet to dispatch for the frame targeting
+  ///             `vsync_target_time`. Events that are held back for a later
+  ///             frame stay pending, but never for more than one additional
+  ///             frame so that a mismatched event clock cannot starve input.
+  ///
+  /// @return     The packet to dispatch, or nullptr if there is none.
+  ///
+  std::unique_ptr<PointerDataPacket> Flush(fml::TimePoint vsync_target_time);
+
+ private:
+  struct Sample {
+    int64_t time = 0;
+    double x = 0.0;
+    double y = 0.0;
+  };
+
+  struct DeviceState {
+    // The two newest raw samples of a pointer that is being tracked.
+    Sample last;
+    Sample previous;
+    bool has_last = false;
+    bool has_previous = false;
+    // The last position dispatched to the framework, used to recompute the
+    // deltas of merged and resampled events.
+    double dispatched_x = 0.0;
+    double dispatched_y = 0.0;
+    bool has_dispatched = false;
+  };
+
+  const Config config_;
+  std::vector<PointerData> pending_;
+  // The number of events at the front of |pending_| that were already held
+  // back by the previous |Flush|.
+  size_t carried_over_ = 0;
+  std::map<int64_t, DeviceState> devices_;
+
+  void RecordSample(const PointerData& data);
+
+  Sample Resample(const DeviceState& state,
+                  const PointerData* next,
+                  int64_t sample_time) const;
+
+  void UpdateDeltas(std::vector<PointerData>& events);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataResampler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreatePointerData(PointerData::Change change,
+                              PointerData::DeviceKind kind,
+                              int64_t device,
+                              int64_t time_stamp,
+                              double x,
+                              double y) {
+  PointerData data;
+  memset(&data, 0, sizeof(PointerData));
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = kind;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  return data;
+}
+
+PointerData CreateTouch(PointerData::Change change,
+                        int64_t device,
+                        int64_t time_stamp,
+                        double x,
+                        double y = 0.0) {
+  return CreatePointerData(change, PointerData::DeviceKind::kTouch, device,
+                           time_stamp, x, y);
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+std::vector<PointerData> UnpackPacket(const PointerDataPacket* packet) {
+  std::vector<PointerData> events;
+  if (packet == nullptr) {
+    return events;
+  }
+  events.resize(packet->data().size() / sizeof(PointerData));
+  memcpy(events.data(), packet->data().data(), packet->data().size());
+  return events;
+}
+
+fml::TimePoint FromMicroseconds(int64_t micros) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMicroseconds(micros));
+}
+
+PointerDataResampler::Config TouchConfig(PointerResamplingMode mode) {
+  PointerDataResampler::Config config;
+  config.SetMode(PointerData::DeviceKind::kTouch, mode);
+  return config;
+}
+
+}  // namespace
+
+TEST(PointerDataResamplerTest, DoesNotBufferDisabledDeviceKinds) {
+  PointerDataResampler resampler(TouchConfig(PointerResamplingMode::kCoalesce));
+  ASSERT_TRUE(resampler.GetConfig().IsEnabled());
+
+  auto mouse = CreatePacket({CreatePointerData(PointerData::Change::kHover,
+                                               PointerData::DeviceKind::kMouse,
+                                               0, 0, 1, 1)});
+  ASSERT_FALSE(resampler.ShouldBuffer(*mouse));
+
+  auto touch = CreatePacket({CreateTouch(PointerData::Change::kDown, 0, 0, 1)});
+  ASSERT_TRUE(resampler.ShouldBuffer(*touch));
+
+  ASSERT_FALSE(PointerDataResampler::Config().IsEnabled());
+}
+
+TEST(PointerDataResamplerTest, CoalescesMovesPerPointer) {
+  PointerDataResampler resampler(TouchConfig(PointerResamplingMode::kCoalesce));
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 0, 0),
+      CreateTouch(PointerData::Change::kMove, 0, 1000, 1),
+      CreateTouch(PointerData::Change::kDown, 1, 1500, 100),
+      CreateTouch(PointerData::Change::kMove, 0, 2000, 3),
+  }));
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kMove, 1, 2500, 104),
+      CreateTouch(PointerData::Change::kMove, 0, 3000, 6),
+  }));
+
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(0)).get());
+  ASSERT_EQ(events.size(), 4u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[1].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[1].device, 0);
+  ASSERT_EQ(events[1].physical_x, 6);
+  ASSERT_EQ(events[1].physical_delta_x, 6);
+  ASSERT_EQ(events[1].time_stamp, 3000);
+  ASSERT_EQ(events[2].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[3].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[3].device, 1);
+  ASSERT_EQ(events[3].physical_delta_x, 4);
+  ASSERT_FALSE(resampler.HasPendingEvents());
+  ASSERT_EQ(resampler.Flush(FromMicroseconds(0)), nullptr);
+}
+
+TEST(PointerDataResamplerTest, DoesNotMergeMovesAcrossOtherEvents) {
+  PointerDataResampler resampler(TouchConfig(PointerResamplingMode::kCoalesce));
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 0, 0),
+      CreateTouch(PointerData::Change::kMove, 0, 1000, 1),
+      CreateTouch(PointerData::Change::kMove, 0, 2000, 2),
+      CreateTouch(PointerData::Change::kUp, 0, 2000, 2),
+      CreateTouch(PointerData::Change::kDown, 0, 3000, 10),
+      CreateTouch(PointerData::Change::kMove, 0, 4000, 11),
+  }));
+
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(0)).get());
+  ASSERT_EQ(events.size(), 5u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[1].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[1].physical_x, 2);
+  ASSERT_EQ(events[2].change, PointerData::Change::kUp);
+  ASSERT_EQ(events[3].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[4].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[4].physical_x, 11);
+  ASSERT_EQ(events[4].physical_delta_x, 1);
+}
+
+TEST(PointerDataResamplerTest, ResamplesAtTheSampleTime) {
+  auto config = TouchConfig(PointerResamplingMode::kResample);
+  config.sampling_offset = fml::TimeDelta::FromMicroseconds(2000);
+  PointerDataResampler resampler(config);
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 0, 0),
+      CreateTouch(PointerData::Change::kMove, 0, 4000, 4),
+      CreateTouch(PointerData::Change::kMove, 0, 8000, 8),
+      CreateTouch(PointerData::Change::kMove, 0, 12000, 12),
+  }));
+
+  // Samples at 10ms, between the moves at 8ms and 12ms.
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(12000)).get());
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[1].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[1].time_stamp, 10000);
+  ASSERT_DOUBLE_EQ(events[1].physical_x, 10);
+  ASSERT_DOUBLE_EQ(events[1].physical_delta_x, 10);
+  ASSERT_TRUE(resampler.HasPendingEvents());
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kMove, 0, 16000, 16),
+      CreateTouch(PointerData::Change::kUp, 0, 16000, 16),
+  }));
+
+  // Samples at 14ms. The move at 12ms was held back once and is dispatched,
+  // resampled towards the next move. The up follows a held back move and is
+  // held back with it.
+  events = UnpackPacket(resampler.Flush(FromMicroseconds(16000)).get());
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[0].time_stamp, 14000);
+  ASSERT_DOUBLE_EQ(events[0].physical_x, 14);
+  ASSERT_DOUBLE_EQ(events[0].physical_delta_x, 4);
+
+  events = UnpackPacket(resampler.Flush(FromMicroseconds(20000)).get());
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kMove);
+  ASSERT_DOUBLE_EQ(events[0].physical_x, 16);
+  ASSERT_DOUBLE_EQ(events[0].physical_delta_x, 2);
+  ASSERT_EQ(events[1].change, PointerData::Change::kUp);
+  ASSERT_FALSE(resampler.HasPendingEvents());
+}
+
+TEST(PointerDataResamplerTest, PredictsWithinTheHorizon) {
+  auto config = TouchConfig(PointerResamplingMode::kResample);
+  config.prediction_horizon = fml::TimeDelta::FromMicroseconds(2000);
+  PointerDataResampler resampler(config);
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 0, 0),
+      CreateTouch(PointerData::Change::kMove, 0, 4000, 4, 8),
+      CreateTouch(PointerData::Change::kMove, 0, 8000, 8, 16),
+  }));
+
+  // 1ms past the newest sample.
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(9000)).get());
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[1].time_stamp, 9000);
+  ASSERT_DOUBLE_EQ(events[1].physical_x, 9);
+  ASSERT_DOUBLE_EQ(events[1].physical_y, 18);
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kMove, 0, 12000, 12, 24),
+  }));
+
+  // 8ms past the newest sample, clamped to the 2ms horizon.
+  events = UnpackPacket(resampler.Flush(FromMicroseconds(20000)).get());
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].time_stamp, 14000);
+  ASSERT_DOUBLE_EQ(events[0].physical_x, 14);
+  ASSERT_DOUBLE_EQ(events[0].physical_delta_x, 5);
+}
+
+TEST(PointerDataResamplerTest, HoldsBackEventsForAtMostOneFrame) {
+  PointerDataResampler resampler(TouchConfig(PointerResamplingMode::kResample));
+
+  // Timestamps far ahead of the vsync clock.
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 1000000, 0),
+      CreateTouch(PointerData::Change::kMove, 0, 1001000, 1),
+  }));
+
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(0)).get());
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kDown);
+  ASSERT_TRUE(resampler.HasPendingEvents());
+
+  events = UnpackPacket(resampler.Flush(FromMicroseconds(0)).get());
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[0].physical_x, 1);
+  ASSERT_FALSE(resampler.HasPendingEvents());
+}
+
+TEST(PointerDataResamplerTest, PassesThroughOtherDeviceKindsInOrder) {
+  PointerDataResampler resampler(TouchConfig(PointerResamplingMode::kCoalesce));
+
+  resampler.AddPacket(*CreatePacket({
+      CreateTouch(PointerData::Change::kDown, 0, 0, 0),
+      CreatePointerData(PointerData::Change::kHover,
+                        PointerData::DeviceKind::kMouse, 1, 0, 5, 5),
+      CreatePointerData(PointerData::Change::kHover,
+                        PointerData::DeviceKind::kMouse, 1, 1000, 6, 6),
+  }));
+
+  auto events = UnpackPacket(resampler.Flush(FromMicroseconds(0)).get());
+  ASSERT_EQ(events.size(), 3u);
+  ASSERT_EQ(events[1].kind, PointerData::DeviceKind::kMouse);
+  ASSERT_EQ(events[1].physical_x, 5);
+  ASSERT_EQ(events[2].physical_x, 6);
+}
+
+}  // namespace testing
+}  // namespace flutter
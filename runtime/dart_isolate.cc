@@ -323,6 +323,9 @@ DartIsolate::DartIsolate(const Settings& settings,
                   is_root_isolate,
                   settings.enable_skparagraph,
                   settings.enable_display_list,
+                  settings.optimize_display_lists,
+                  settings.enable_layer_arena,
+                  settings.compile_runtime_effects_in_background,
                   std::move(context)),
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
@@ -282,7 +282,9 @@ size_t DartVM::GetVMLaunchCount() {
 DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                std::shared_ptr<IsolateNameServer> isolate_name_server)
     : settings_(vm_data->GetSettings()),
-      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
+      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create(
+          std::thread::hardware_concurrency(),
+          settings_.worker_thread_policy)),
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
               fml::closure work) { runner->PostTask(work); }),
@@ -24,6 +24,8 @@ const std::string_view ServiceProtocol::kScreenshotExtensionName =
     "_flutter.screenshot";
 const std::string_view ServiceProtocol::kScreenshotSkpExtensionName =
     "_flutter.screenshotSkp";
+const std::string_view ServiceProtocol::kScreenshotDisplayListExtensionName =
+    "_flutter.screenshotDisplayList";
 const std::string_view ServiceProtocol::kRunInViewExtensionName =
     "_flutter.runInView";
 const std::string_view ServiceProtocol::kFlushUIThreadTasksExtensionName =
@@ -37,6 +39,13 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetCacheMemoryUsageExtensionName =
+    "_flutter.getCacheMemoryUsage";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingStatisticsExtensionName =
+        "_flutter.getFrameTimingStatistics";
+const std::string_view ServiceProtocol::kDumpTraceBufferExtensionName =
+    "_flutter.dumpTraceBuffer";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -50,12 +59,16 @@ ServiceProtocol::ServiceProtocol()
           // Public
           kScreenshotExtensionName,
           kScreenshotSkpExtensionName,
+          kScreenshotDisplayListExtensionName,
           kRunInViewExtensionName,
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetCacheMemoryUsageExtensionName,
+          kGetFrameTimingStatisticsExtensionName,
+          kDumpTraceBufferExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
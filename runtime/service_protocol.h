@@ -23,12 +23,16 @@ class ServiceProtocol {
  public:
   static const std::string_view kScreenshotExtensionName;
   static const std::string_view kScreenshotSkpExtensionName;
+  static const std::string_view kScreenshotDisplayListExtensionName;
   static const std::string_view kRunInViewExtensionName;
   static const std::string_view kFlushUIThreadTasksExtensionName;
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetCacheMemoryUsageExtensionName;
+  static const std::string_view kGetFrameTimingStatisticsExtensionName;
+  static const std::string_view kDumpTraceBufferExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+AdaptivePipelineDepth::AdaptivePipelineDepth(uint32_t max_depth)
+    : max_depth_(std::max(max_depth, 1u)) {}
+
+AdaptivePipelineDepth::~AdaptivePipelineDepth() = default;
+
+void AdaptivePipelineDepth::RecordFrame(fml::TimeDelta build_duration,
+                                        fml::TimeDelta raster_duration) {
+  build_durations_.push_back(build_duration);
+  raster_durations_.push_back(raster_duration);
+  if (build_durations_.size() > kFrameCount) {
+    build_durations_.pop_front();
+    raster_durations_.pop_front();
+  }
+}
+
+uint32_t AdaptivePipelineDepth::GetDepth(fml::TimeDelta frame_budget) const {
+  if (build_durations_.size() < kFrameCount) {
+    return std::min(kDefaultDepth, max_depth_);
+  }
+
+  const fml::TimeDelta build =
+      *std::max_element(build_durations_.begin(), build_durations_.end());
+  const fml::TimeDelta raster =
+      *std::max_element(raster_durations_.begin(), raster_durations_.end());
+
+  uint32_t depth;
+  if (build + raster <= frame_budget) {
+    depth = 1;
+  } else if (raster <= frame_budget) {
+    depth = 2;
+  } else {
+    depth = max_depth_;
+  }
+  return std::min(depth, max_depth_);
+}
+
+}  // namespace flutter
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
+#define FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
+
+#include <cstdint>
+#include <deque>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Chooses how many frames may be in flight in the layer tree
+///             pipeline from the build and raster durations of recent frames.
+///
+///             A single frame in flight gives the lowest input latency, and is
+///             chosen while the UI and raster threads together fit in the
+///             frame budget. When they do not, a second frame lets the two
+///             threads work in parallel. When rasterization alone takes longer
+///             than the frame budget, the raster thread is the bottleneck and
+///             the deepest pipeline is used so that the UI thread does not
+///             stall on it.
+///
+///             The slowest of the recent frames is used, so the depth goes up
+///             as soon as one frame is slow and only goes down once all of the
+///             recent frames are fast.
+///
+class AdaptivePipelineDepth {
+ public:
+  /// The number of recent frames the depth is chosen from.
+  static constexpr size_t kFrameCount = 10;
+
+  /// The depth used before enough frames were recorded.
+  static constexpr uint32_t kDefaultDepth = 2;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  max_depth  The depth of the pipeline, which is the largest
+  ///                        depth that is ever chosen.
+  ///
+  explicit AdaptivePipelineDepth(uint32_t max_depth);
+
+  ~AdaptivePipelineDepth();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the durations of a frame that was rasterized.
+  ///
+  void RecordFrame(fml::TimeDelta build_duration,
+                   fml::TimeDelta raster_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Chooses the depth of the pipeline for the next frame.
+  ///
+  /// @param[in]  frame_budget  The time between two vsyncs.
+  ///
+  /// @return     The depth, between one and the maximum depth.
+  ///
+  uint32_t GetDepth(fml::TimeDelta frame_budget) const;
+
+ private:
+  const uint32_t max_depth_;
+  std::deque<fml::TimeDelta> build_durations_;
+  std::deque<fml::TimeDelta> raster_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AdaptivePipelineDepth);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static const fml::TimeDelta kFrameBudget =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+static void RecordFrames(AdaptivePipelineDepth& depth,
+                         size_t count,
+                         int64_t build_ms,
+                         int64_t raster_ms) {
+  for (size_t i = 0; i < count; i++) {
+    depth.RecordFrame(fml::TimeDelta::FromMilliseconds(build_ms),
+                      fml::TimeDelta::FromMilliseconds(raster_ms));
+  }
+}
+
+TEST(AdaptivePipelineDepthTest, UsesDefaultDepthUntilEnoughFramesAreRecorded) {
+  AdaptivePipelineDepth depth(3);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), AdaptivePipelineDepth::kDefaultDepth);
+  RecordFrames(depth, AdaptivePipelineDepth::kFrameCount - 1, 1, 1);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), AdaptivePipelineDepth::kDefaultDepth);
+  RecordFrames(depth, 1, 1, 1);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, ChoosesDepthFromTheSlowestRecentFrame) {
+  AdaptivePipelineDepth depth(3);
+  RecordFrames(depth, AdaptivePipelineDepth::kFrameCount, 6, 6);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 1u);
+
+  // The threads only fit in the budget when they run in parallel.
+  RecordFrames(depth, 1, 10, 10);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 2u);
+
+  // Rasterization is the bottleneck.
+  RecordFrames(depth, 1, 2, 20);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 3u);
+
+  // The depth only goes back down once the slow frames are no longer recent.
+  RecordFrames(depth, AdaptivePipelineDepth::kFrameCount - 1, 6, 6);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 3u);
+  RecordFrames(depth, 1, 6, 6);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, DoesNotExceedMaxDepth) {
+  AdaptivePipelineDepth depth(1);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 1u);
+  RecordFrames(depth, AdaptivePipelineDepth::kFrameCount, 2, 20);
+  ASSERT_EQ(depth.GetDepth(kFrameBudget), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -19,28 +19,42 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The depth of the pipeline when it adapts to the durations of recent frames.
+// This is the number of frames the raster thread may fall behind the UI thread
+// when it is the bottleneck.
+constexpr uint32_t kAdaptivePipelineMaxDepth = 3;
+
+uint32_t GetLayerTreePipelineDepth(const TaskRunners& task_runners,
+                                   bool adaptive_pipeline_depth) {
+#if !SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  if (task_runners.GetPlatformTaskRunner() ==
+      task_runners.GetRasterTaskRunner()) {
+    return 1;
+  }
+#endif  // !SHELL_ENABLE_METAL
+  return adaptive_pipeline_depth ? kAdaptivePipelineMaxDepth : 2;
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    TaskRunners task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool adaptive_pipeline_depth)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
       layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+          GetLayerTreePipelineDepth(task_runners_, adaptive_pipeline_depth))),
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  if (adaptive_pipeline_depth) {
+    adaptive_pipeline_depth_ = std::make_unique<AdaptivePipelineDepth>(
+        GetLayerTreePipelineDepth(task_runners_, adaptive_pipeline_depth));
+  }
 }
 
 Animator::~Animator() = default;
@@ -118,6 +132,9 @@ void Animator::BeginFrame(
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animation::Render. Simply reuse that
     // instead of asking the pipeline for a fresh continuation.
+    if (adaptive_pipeline_depth_) {
+      UpdatePipelineDepth();
+    }
     producer_continuation_ = layer_tree_pipeline_->Produce();
 
     if (!producer_continuation_) {
@@ -206,6 +223,29 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
                            std::move(frame_timings_recorder_));
 }
 
+void Animator::RecordFrameTiming(const FrameTiming& timing) {
+  if (!adaptive_pipeline_depth_) {
+    return;
+  }
+  adaptive_pipeline_depth_->RecordFrame(
+      timing.Get(FrameTiming::kBuildFinish) -
+          timing.Get(FrameTiming::kBuildStart),
+      timing.Get(FrameTiming::kRasterFinish) -
+          timing.Get(FrameTiming::kRasterStart));
+}
+
+void Animator::UpdatePipelineDepth() {
+  const fml::TimeDelta frame_budget =
+      frame_timings_recorder_->GetVsyncTargetTime() -
+      frame_timings_recorder_->GetVsyncStartTime();
+  const uint32_t depth = adaptive_pipeline_depth_->GetDepth(frame_budget);
+  layer_tree_pipeline_->SetActiveDepth(depth);
+  FML_TRACE_COUNTER("flutter", "AdaptivePipelineDepth",
+                    reinterpret_cast<int64_t>(this),  //
+                    "depth", depth                     //
+  );
+}
+
 bool Animator::CanReuseLastLayerTree() {
   return !regenerate_layer_tree_;
 }
@@ -280,6 +320,10 @@ void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+fml::TimePoint Animator::GetLastVsyncTargetTime() {
+  return waiter_->GetLastFrameTargetTime();
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
@@ -7,12 +7,14 @@
 
 #include <deque>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -46,7 +48,8 @@ class Animator final {
 
   Animator(Delegate& delegate,
            TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool adaptive_pipeline_depth = false);
 
   ~Animator();
 
@@ -72,6 +75,13 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    The target time of the most recent vsync. Used to resample
+  ///           pointer events from within secondary vsync callbacks.
+  ///
+  /// @see      `PointerDataDispatcher::Delegate::GetLastVsyncTargetTime`.
+  fml::TimePoint GetLastVsyncTargetTime();
+
   void Start();
 
   void Stop();
@@ -83,6 +93,14 @@ class Animator final {
   // active rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Records the timings of a frame that was rasterized. When the
+  ///           animator was created with an adaptive pipeline depth, these
+  ///           choose the number of frames that may be in flight.
+  ///
+  /// @see      `AdaptivePipelineDepth`
+  void RecordFrameTiming(const FrameTiming& timing);
+
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
@@ -90,6 +108,8 @@ class Animator final {
 
   bool CanReuseLastLayerTree();
 
+  void UpdatePipelineDepth();
+
   void DrawLastLayerTree(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
@@ -108,6 +128,7 @@ class Animator final {
   uint64_t frame_request_number_ = 1;
   fml::TimePoint dart_frame_deadline_;
   std::shared_ptr<LayerTreePipeline> layer_tree_pipeline_;
+  std::unique_ptr<AdaptivePipelineDepth> adaptive_pipeline_depth_;
   fml::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   bool paused_ = true;
@@ -106,6 +106,10 @@ Engine::Engine(Delegate& delegate,
           settings_.advisory_script_entrypoint,    // advisory script entrypoint
           std::move(volatile_path_tracker),        // volatile path tracker
       });
+
+  font_cache_registration_ = fml::MemoryPressureManager::GetInstance().Register(
+      "FontCollection", task_runners_.GetUITaskRunner(),
+      [this](fml::MemoryPressureLevel level) { TrimFontCache(level); });
 }
 
 std::unique_ptr<Engine> Engine::Spawn(
@@ -149,6 +153,12 @@ void Engine::SetupDefaultFontManager() {
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
+void Engine::SetupDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  font_collection_->GetFontCollection()->SetDefaultFontManager(
+      std::move(font_manager));
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -186,6 +196,7 @@ bool Engine::Restart(RunConfiguration configuration) {
     return false;
   }
   delegate_.OnPreEngineRestart();
+  semantics_tree_differ_.Reset();
   runtime_controller_ = runtime_controller_->Clone();
   UpdateAssetManager(nullptr);
   return Run(std::move(configuration)) == Engine::RunStatus::Success;
@@ -239,6 +250,33 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
   TRACE_EVENT0("flutter", "Engine::BeginFrame");
   runtime_controller_->BeginFrame(frame_time, frame_number);
+  if (font_cache_registration_) {
+    PublishFontCacheUsage();
+  }
+}
+
+void Engine::TrimFontCache(fml::MemoryPressureLevel level) {
+  const auto& font_collection = font_collection_->GetFontCollection();
+  if (level == fml::MemoryPressureLevel::kCritical) {
+    font_collection->ClearFontFamilyCache();
+    PublishFontCacheUsage();
+    return;
+  }
+
+  // The least recently used collections are evicted until the cache fits its
+  // budget. Moderate pressure signaled by the embedder while the cache is
+  // within its budget, or without one, halves it.
+  const size_t bytes = font_collection->GetCacheByteSize();
+  const size_t budget = font_cache_registration_->GetBudget();
+  font_collection->TrimFontFamilyCache(
+      budget > 0 && bytes > budget ? budget : bytes / 2);
+  PublishFontCacheUsage();
+}
+
+void Engine::PublishFontCacheUsage() {
+  const auto& font_collection = font_collection_->GetFontCollection();
+  font_cache_registration_->SetUsage(font_collection->GetCacheByteSize(),
+                                     font_collection->GetCacheEntryCount());
 }
 
 void Engine::ReportTimings(std::vector<int64_t> timings) {
@@ -246,6 +284,10 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::RecordFrameTiming(const FrameTiming& timing) {
+  animator_->RecordFrameTiming(timing);
+}
+
 void Engine::NotifyIdle(int64_t deadline) {
   auto trace_event = std::to_string(deadline - Dart_TimelineGetMicros());
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
@@ -449,6 +491,9 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The platform rebuilds its accessibility tree from scratch when semantics
+  // are toggled, so every node must be delivered in full again.
+  semantics_tree_differ_.Reset();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
@@ -494,6 +539,12 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  if (settings_.diff_semantics_updates) {
+    semantics_tree_differ_.Diff(update);
+  }
+  if (update.empty() && actions.empty()) {
+    return;
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
@@ -540,6 +591,10 @@ void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
 }
 
+fml::TimePoint Engine::GetLastVsyncTargetTime() {
+  return animator_->GetLastVsyncTargetTime();
+}
+
 void Engine::HandleAssetPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
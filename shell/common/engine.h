@@ -12,11 +12,13 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/memory_pressure_manager.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/semantics_tree_differ.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
@@ -32,6 +34,7 @@
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
 namespace flutter {
@@ -439,6 +442,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Setup default font manager with one that was already loaded,
+  ///             for example on a background thread.
+  ///
+  /// @param[in]  font_manager  The default font manager for the platform.
+  ///
+  void SetupDefaultFontManager(sk_sp<SkFontMgr> font_manager);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -583,6 +594,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a frame that was rasterized so that
+  ///             the animator can adapt the depth of the layer tree pipeline
+  ///             to them. This is only called when
+  ///             `Settings::adaptive_pipeline_depth` is enabled.
+  ///
+  /// @param[in]  timing  The timings of the frame.
+  ///
+  void RecordFrameTiming(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -822,6 +843,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
@@ -930,7 +954,12 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::shared_ptr<FontCollection> font_collection_;
   ImageDecoder image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
+  SemanticsTreeDiffer semantics_tree_differ_;
   TaskRunners task_runners_;
+  // Only set on engines that own their font collection, that is, engines that
+  // were not spawned.
+  std::unique_ptr<fml::MemoryPressureManager::Registration>
+      font_cache_registration_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
@@ -966,6 +995,12 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void StartAnimatorIfPossible();
 
+  // Releases font cache entries according to the memory pressure level.
+  void TrimFontCache(fml::MemoryPressureLevel level);
+
+  // Publishes the size of the font cache through |font_cache_registration_|.
+  void PublishFontCacheUsage();
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(
@@ -328,4 +328,55 @@ TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   });
 }
 
+TEST_F(EngineTest, DropsUnchangedSemanticsNodes) {
+  PostUITaskSync([this] {
+    EXPECT_CALL(delegate_, OnEngineUpdateSemantics(::testing::_, ::testing::_))
+        .Times(1);
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(runtime_controller_));
+
+    SemanticsNode node;
+    node.id = 0;
+    node.label = "label";
+    RuntimeDelegate& runtime_delegate = *engine;
+    for (int i = 0; i < 2; i++) {
+      runtime_delegate.UpdateSemantics({{node.id, node}}, {});
+    }
+  });
+}
+
+TEST_F(EngineTest, SendsUnchangedSemanticsNodesWithoutDiffing) {
+  settings_.diff_semantics_updates = false;
+  PostUITaskSync([this] {
+    EXPECT_CALL(delegate_, OnEngineUpdateSemantics(::testing::_, ::testing::_))
+        .Times(2);
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(runtime_controller_));
+
+    SemanticsNode node;
+    node.id = 0;
+    node.label = "label";
+    RuntimeDelegate& runtime_delegate = *engine;
+    for (int i = 0; i < 2; i++) {
+      runtime_delegate.UpdateSemantics({{node.id, node}}, {});
+    }
+  });
+}
+
 }  // namespace flutter
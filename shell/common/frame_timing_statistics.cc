@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+// Uses the nearest-rank method on the durations, which are reordered.
+static FrameTimingStatistics::Percentiles ComputePercentiles(
+    std::vector<fml::TimeDelta>& durations) {
+  FrameTimingStatistics::Percentiles percentiles;
+  if (durations.empty()) {
+    return percentiles;
+  }
+  auto percentile = [&durations](size_t percent) {
+    size_t rank = (durations.size() * percent + 99) / 100;
+    auto nth = durations.begin() + (std::max<size_t>(rank, 1) - 1);
+    std::nth_element(durations.begin(), nth, durations.end());
+    return *nth;
+  };
+  percentiles.p50 = percentile(50);
+  percentiles.p90 = percentile(90);
+  percentiles.p99 = percentile(99);
+  return percentiles;
+}
+
+FrameTimingStatistics::FrameTimingStatistics(size_t frame_count)
+    : max_frame_count_(std::max<size_t>(frame_count, 1)) {}
+
+FrameTimingStatistics::~FrameTimingStatistics() = default;
+
+void FrameTimingStatistics::AddFrame(const FrameTiming& timing) {
+  Frame frame;
+  frame.frame_number = timing.GetFrameNumber();
+  frame.vsync_latency = timing.Get(FrameTiming::kBuildStart) -
+                        timing.Get(FrameTiming::kVsyncStart);
+  frame.build = timing.Get(FrameTiming::kBuildFinish) -
+                timing.Get(FrameTiming::kBuildStart);
+  frame.raster = timing.Get(FrameTiming::kRasterFinish) -
+                 timing.Get(FrameTiming::kRasterStart);
+  frame.annotations = timing.GetAnnotations();
+
+  std::scoped_lock lock(frames_mutex_);
+  frames_.push_back(frame);
+  if (frames_.size() > max_frame_count_) {
+    frames_.pop_front();
+  }
+}
+
+FrameTimingStatistics::Summary FrameTimingStatistics::Summarize(
+    fml::TimeDelta frame_budget) const {
+  std::deque<Frame> frames;
+  {
+    std::scoped_lock lock(frames_mutex_);
+    frames = frames_;
+  }
+
+  Summary summary;
+  summary.frame_count = frames.size();
+  summary.annotated_frame_counts.resize(std::size(FrameTiming::kAnnotations));
+
+  std::vector<fml::TimeDelta> vsync_latencies, builds, rasters;
+  vsync_latencies.reserve(frames.size());
+  builds.reserve(frames.size());
+  rasters.reserve(frames.size());
+  for (const auto& frame : frames) {
+    vsync_latencies.push_back(frame.vsync_latency);
+    builds.push_back(frame.build);
+    rasters.push_back(frame.raster);
+    for (size_t i = 0; i < std::size(FrameTiming::kAnnotations); i++) {
+      if (frame.annotations & FrameTiming::kAnnotations[i]) {
+        summary.annotated_frame_counts[i]++;
+      }
+    }
+    if (frame.build > frame_budget || frame.raster > frame_budget) {
+      summary.slow_frames.push_back(frame);
+    }
+  }
+  summary.vsync_latency = ComputePercentiles(vsync_latencies);
+  summary.build = ComputePercentiles(builds);
+  summary.raster = ComputePercentiles(rasters);
+  return summary;
+}
+
+}  // namespace flutter
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the timings of the most recently rasterized frames, and
+///             summarizes them into percentiles along with the frames that
+///             missed their budget and the work that was annotated on them.
+///
+///             Frames are added on the raster thread and the statistics may be
+///             read from any thread.
+///
+class FrameTimingStatistics {
+ public:
+  /// The number of frames kept by default, which is five seconds at 60Hz.
+  static constexpr size_t kDefaultFrameCount = 300;
+
+  struct Percentiles {
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+  };
+
+  struct Frame {
+    uint64_t frame_number = 0;
+    /// The time from the vsync to the start of the build.
+    fml::TimeDelta vsync_latency;
+    fml::TimeDelta build;
+    fml::TimeDelta raster;
+    /// A combination of `FrameTiming::Annotation` values.
+    uint32_t annotations = FrameTiming::kNoAnnotation;
+  };
+
+  struct Summary {
+    size_t frame_count = 0;
+    Percentiles vsync_latency;
+    Percentiles build;
+    Percentiles raster;
+    /// The number of frames with each of `FrameTiming::kAnnotations`, in the
+    /// same order.
+    std::vector<size_t> annotated_frame_counts;
+    /// The frames whose build or raster took longer than the frame budget,
+    /// oldest first.
+    std::vector<Frame> slow_frames;
+  };
+
+  explicit FrameTimingStatistics(size_t frame_count = kDefaultFrameCount);
+
+  ~FrameTimingStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a rasterized frame, replacing the oldest frame once the
+  ///             maximum number of frames is kept.
+  ///
+  void AddFrame(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Summarizes the frames that are kept.
+  ///
+  /// @param[in]  frame_budget  The time between two vsyncs. Frames whose build
+  ///                           or raster took longer are reported as slow.
+  ///
+  Summary Summarize(fml::TimeDelta frame_budget) const;
+
+ private:
+  const size_t max_frame_count_;
+  mutable std::mutex frames_mutex_;
+  std::deque<Frame> frames_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static FrameTiming MakeTiming(
+    uint64_t frame_number,
+    int64_t build_ms,
+    int64_t raster_ms,
+    uint32_t annotations = FrameTiming::kNoAnnotation) {
+  const auto start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(frame_number * 100));
+  const auto build_start = start + fml::TimeDelta::FromMilliseconds(1);
+  const auto build_finish =
+      build_start + fml::TimeDelta::FromMilliseconds(build_ms);
+  const auto raster_finish =
+      build_finish + fml::TimeDelta::FromMilliseconds(raster_ms);
+  FrameTiming timing;
+  timing.SetFrameNumber(frame_number);
+  timing.Set(FrameTiming::kVsyncStart, start);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, build_finish);
+  timing.Set(FrameTiming::kRasterStart, build_finish);
+  timing.Set(FrameTiming::kRasterFinish, raster_finish);
+  for (auto annotation : FrameTiming::kAnnotations) {
+    if (annotations & annotation) {
+      timing.AddAnnotation(annotation);
+    }
+  }
+  return timing;
+}
+
+static const fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(16);
+
+TEST(FrameTimingStatisticsTest, SummarizesNoFrames) {
+  FrameTimingStatistics statistics;
+  auto summary = statistics.Summarize(kFrameBudget);
+  ASSERT_EQ(summary.frame_count, 0u);
+  ASSERT_EQ(summary.build.p99, fml::TimeDelta::Zero());
+  ASSERT_TRUE(summary.slow_frames.empty());
+}
+
+TEST(FrameTimingStatisticsTest, ComputesPercentiles) {
+  FrameTimingStatistics statistics;
+  for (uint64_t i = 1; i <= 100; i++) {
+    statistics.AddFrame(MakeTiming(i, i, 101 - i));
+  }
+  auto summary = statistics.Summarize(fml::TimeDelta::FromMilliseconds(1000));
+  ASSERT_EQ(summary.frame_count, 100u);
+  ASSERT_EQ(summary.build.p50, fml::TimeDelta::FromMilliseconds(50));
+  ASSERT_EQ(summary.build.p90, fml::TimeDelta::FromMilliseconds(90));
+  ASSERT_EQ(summary.build.p99, fml::TimeDelta::FromMilliseconds(99));
+  ASSERT_EQ(summary.raster.p50, fml::TimeDelta::FromMilliseconds(50));
+  ASSERT_EQ(summary.raster.p99, fml::TimeDelta::FromMilliseconds(99));
+  ASSERT_EQ(summary.vsync_latency.p90, fml::TimeDelta::FromMilliseconds(1));
+}
+
+TEST(FrameTimingStatisticsTest, KeepsTheMostRecentFrames) {
+  FrameTimingStatistics statistics(2);
+  statistics.AddFrame(MakeTiming(1, 30, 1));
+  statistics.AddFrame(MakeTiming(2, 1, 1));
+  statistics.AddFrame(MakeTiming(3, 1, 1));
+  auto summary = statistics.Summarize(kFrameBudget);
+  ASSERT_EQ(summary.frame_count, 2u);
+  ASSERT_EQ(summary.build.p99, fml::TimeDelta::FromMilliseconds(1));
+  ASSERT_TRUE(summary.slow_frames.empty());
+}
+
+TEST(FrameTimingStatisticsTest, AttributesSlowFrames) {
+  FrameTimingStatistics statistics;
+  statistics.AddFrame(MakeTiming(1, 2, 40, FrameTiming::kShaderCompilation));
+  statistics.AddFrame(MakeTiming(2, 2, 2, FrameTiming::kRasterCacheMiss));
+  statistics.AddFrame(
+      MakeTiming(3, 20, 2,
+                 FrameTiming::kRasterCacheMiss | FrameTiming::kImageUpload));
+
+  auto summary = statistics.Summarize(kFrameBudget);
+  ASSERT_EQ(summary.annotated_frame_counts,
+            (std::vector<size_t>{1u, 2u, 0u, 1u}));
+  ASSERT_EQ(summary.slow_frames.size(), 2u);
+  ASSERT_EQ(summary.slow_frames[0].frame_number, 1u);
+  ASSERT_EQ(summary.slow_frames[0].raster,
+            fml::TimeDelta::FromMilliseconds(40));
+  ASSERT_EQ(summary.slow_frames[0].annotations,
+            static_cast<uint32_t>(FrameTiming::kShaderCompilation));
+  ASSERT_EQ(summary.slow_frames[1].frame_number, 3u);
+  ASSERT_TRUE(summary.slow_frames[1].annotations & FrameTiming::kImageUpload);
+}
+
+}  // namespace testing
+}  // namespace flutter
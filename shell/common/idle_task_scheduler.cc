@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskScheduler::IdleTaskScheduler() = default;
+
+IdleTaskScheduler::~IdleTaskScheduler() {
+  std::scoped_lock lock(entries_mutex_);
+  for (const auto& entry : entries_) {
+    entry->removed = true;
+  }
+}
+
+IdleTaskScheduler::TaskId IdleTaskScheduler::AddTask(
+    std::string name,
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    IdleTask task) {
+  FML_DCHECK(task_runner);
+  FML_DCHECK(task);
+  auto entry = std::make_shared<Entry>();
+  entry->name = std::move(name);
+  entry->task_runner = std::move(task_runner);
+  entry->task = std::move(task);
+
+  std::scoped_lock lock(entries_mutex_);
+  entry->id = next_id_++;
+  entries_.push_back(entry);
+  return entry->id;
+}
+
+void IdleTaskScheduler::RemoveTask(TaskId id) {
+  std::scoped_lock lock(entries_mutex_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if ((*it)->id == id) {
+      (*it)->removed = true;
+      entries_.erase(it);
+      return;
+    }
+  }
+}
+
+size_t IdleTaskScheduler::RunIdleTasks(fml::TimePoint deadline) {
+  if (!HasSlack(deadline)) {
+    return 0;
+  }
+
+  std::vector<std::shared_ptr<Entry>> entries;
+  size_t start;
+  {
+    std::scoped_lock lock(entries_mutex_);
+    if (entries_.empty()) {
+      return 0;
+    }
+    entries = entries_;
+    // Rotate the starting point so that tasks late in the list are not starved
+    // by tasks that always have more work.
+    start = next_index_++ % entries.size();
+  }
+
+  TRACE_EVENT0("flutter", "IdleTaskScheduler::RunIdleTasks");
+
+  size_t invocations = 0;
+  std::vector<bool> has_more_work(entries.size(), true);
+  bool any_work = true;
+  while (any_work && HasSlack(deadline)) {
+    any_work = false;
+    for (size_t i = 0; i < entries.size() && HasSlack(deadline); i++) {
+      const size_t index = (start + i) % entries.size();
+      if (!has_more_work[index]) {
+        continue;
+      }
+      const auto& entry = entries[index];
+      if (entry->removed) {
+        has_more_work[index] = false;
+        continue;
+      }
+
+      if (entry->task_runner->RunsTasksOnCurrentThread()) {
+        invocations++;
+        has_more_work[index] = RunEntry(entry, deadline);
+        any_work = any_work || has_more_work[index];
+        continue;
+      }
+
+      // Remote tasks are posted once per idle period, and not at all if a
+      // previous invocation is still waiting to run. They re-post themselves
+      // on their task runner while they have more work and slack remains.
+      has_more_work[index] = false;
+      if (entry->posted.exchange(true)) {
+        continue;
+      }
+      invocations++;
+      PostEntry(entry, deadline);
+    }
+  }
+  return invocations;
+}
+
+bool IdleTaskScheduler::HasSlack(fml::TimePoint deadline) {
+  return fml::TimePoint::Now() + kMinimumSlack < deadline;
+}
+
+void IdleTaskScheduler::PostEntry(const std::shared_ptr<Entry>& entry,
+                                  fml::TimePoint deadline) {
+  entry->task_runner->PostTask([entry, deadline]() {
+    if (!entry->removed && HasSlack(deadline) && RunEntry(entry, deadline) &&
+        HasSlack(deadline)) {
+      // Posting the next invocation instead of looping lets other tasks on
+      // the task runner run in between.
+      PostEntry(entry, deadline);
+      return;
+    }
+    entry->posted = false;
+  });
+}
+
+bool IdleTaskScheduler::RunEntry(const std::shared_ptr<Entry>& entry,
+                                 fml::TimePoint deadline) {
+  TRACE_EVENT1("flutter", "IdleTask", "name", entry->name.c_str());
+  return entry->task(deadline);
+}
+
+}  // namespace flutter
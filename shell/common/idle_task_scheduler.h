@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs deferrable engine housekeeping in the slack left between
+///             the end of a frame and the next frame deadline.
+///
+///             The `Animator` tells the shell when the UI thread is idle and
+///             until when. Besides forwarding that deadline to the Dart VM,
+///             the shell hands it to this scheduler, which runs the registered
+///             idle tasks round-robin until the deadline is about to expire.
+///             Tasks registered for another task runner are posted there along
+///             with the deadline and skipped if they start too late. They are
+///             posted again for as long as they report more work and the
+///             deadline has not passed.
+///
+///             Idle tasks must do a bounded amount of work per invocation and
+///             check the deadline they are given. No threads are created by
+///             the scheduler.
+///
+///             Tasks may be added and removed from any thread. `RunIdleTasks`
+///             must only be called on the UI task runner.
+///
+class IdleTaskScheduler {
+ public:
+  //----------------------------------------------------------------------------
+  /// An idle task. It is given the time by which it must have returned and
+  /// returns whether it has more work it could do if it were called again.
+  ///
+  using IdleTask = std::function<bool(fml::TimePoint deadline)>;
+
+  using TaskId = uint64_t;
+
+  //----------------------------------------------------------------------------
+  /// The minimum amount of slack that must remain before the deadline for
+  /// another idle task to be started.
+  ///
+  static constexpr fml::TimeDelta kMinimumSlack =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  IdleTaskScheduler();
+
+  ~IdleTaskScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a task to be run whenever the engine is idle.
+  ///
+  /// @param[in]  name         The name of the task, used for tracing.
+  /// @param[in]  task_runner  The task runner on which the task must run.
+  /// @param[in]  task         The task.
+  ///
+  /// @return     An identifier that can be passed to `RemoveTask`.
+  ///
+  TaskId AddTask(std::string name,
+                 fml::RefPtr<fml::TaskRunner> task_runner,
+                 IdleTask task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unregisters a task. Invocations of the task that were already
+  ///             posted to its task runner are dropped.
+  ///
+  void RemoveTask(TaskId id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs idle tasks until `deadline` (minus `kMinimumSlack`) or
+  ///             until none of them has work left.
+  ///
+  /// @return     The number of task invocations that were run or posted.
+  ///
+  size_t RunIdleTasks(fml::TimePoint deadline);
+
+ private:
+  struct Entry {
+    TaskId id;
+    std::string name;
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    IdleTask task;
+    std::atomic_bool removed = false;
+    // Whether an invocation is posted to a remote task runner and has not run
+    // yet.
+    std::atomic_bool posted = false;
+  };
+
+  std::mutex entries_mutex_;
+  std::vector<std::shared_ptr<Entry>> entries_;
+  TaskId next_id_ = 1;
+  size_t next_index_ = 0;
+
+  static bool HasSlack(fml::TimePoint deadline);
+
+  // Posts an invocation of a remote task, which posts the next one while the
+  // task has more work and there is slack.
+  static void PostEntry(const std::shared_ptr<Entry>& entry,
+                        fml::TimePoint deadline);
+
+  static bool RunEntry(const std::shared_ptr<Entry>& entry,
+                       fml::TimePoint deadline);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
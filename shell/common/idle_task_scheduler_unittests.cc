@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::RefPtr<fml::TaskRunner> CurrentTaskRunner() {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  return fml::MessageLoop::GetCurrent().GetTaskRunner();
+}
+
+fml::TimePoint DeadlineIn(int64_t milliseconds) {
+  return fml::TimePoint::Now() + fml::TimeDelta::FromMilliseconds(milliseconds);
+}
+
+}  // namespace
+
+TEST(IdleTaskSchedulerTest, RunsLocalTasksUntilTheyRunOutOfWork) {
+  IdleTaskScheduler scheduler;
+  int remaining_chunks = 3;
+  int invocations = 0;
+  scheduler.AddTask("chunks", CurrentTaskRunner(),
+                    [&](fml::TimePoint deadline) {
+                      invocations++;
+                      remaining_chunks--;
+                      return remaining_chunks > 0;
+                    });
+
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(1000)), 3u);
+  ASSERT_EQ(invocations, 3);
+  ASSERT_EQ(remaining_chunks, 0);
+}
+
+TEST(IdleTaskSchedulerTest, DoesNotRunWithoutSlack) {
+  IdleTaskScheduler scheduler;
+  int invocations = 0;
+  scheduler.AddTask("task", CurrentTaskRunner(), [&](fml::TimePoint deadline) {
+    invocations++;
+    return false;
+  });
+
+  ASSERT_EQ(scheduler.RunIdleTasks(fml::TimePoint::Now()), 0u);
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(-10)), 0u);
+  ASSERT_EQ(invocations, 0);
+}
+
+TEST(IdleTaskSchedulerTest, StopsAtTheDeadline) {
+  IdleTaskScheduler scheduler;
+  int invocations = 0;
+  scheduler.AddTask("busy", CurrentTaskRunner(), [&](fml::TimePoint deadline) {
+    invocations++;
+    while (fml::TimePoint::Now() < deadline) {
+    }
+    return true;
+  });
+
+  const auto deadline = DeadlineIn(5);
+  scheduler.RunIdleTasks(deadline);
+  ASSERT_GE(fml::TimePoint::Now(), deadline);
+  ASSERT_EQ(invocations, 1);
+}
+
+TEST(IdleTaskSchedulerTest, RemovedTasksDoNotRun) {
+  IdleTaskScheduler scheduler;
+  int invocations = 0;
+  auto id = scheduler.AddTask("task", CurrentTaskRunner(),
+                              [&](fml::TimePoint deadline) {
+                                invocations++;
+                                return false;
+                              });
+  scheduler.RemoveTask(id);
+
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(1000)), 0u);
+  ASSERT_EQ(invocations, 0);
+}
+
+TEST(IdleTaskSchedulerTest, PostsTasksToTheirTaskRunner) {
+  IdleTaskScheduler scheduler;
+  fml::Thread thread("idle_task_scheduler_test");
+  auto runner = thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  bool ran_on_runner = false;
+  scheduler.AddTask("remote", runner, [&](fml::TimePoint deadline) {
+    ran_on_runner = runner->RunsTasksOnCurrentThread();
+    latch.Signal();
+    return true;
+  });
+
+  // Remote tasks are posted once per idle period even if they report more
+  // work.
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(1000)), 1u);
+  latch.Wait();
+  ASSERT_TRUE(ran_on_runner);
+}
+
+TEST(IdleTaskSchedulerTest, RepostsRemoteTasksWhileTheyHaveMoreWork) {
+  IdleTaskScheduler scheduler;
+  fml::Thread thread("idle_task_scheduler_test");
+  fml::AutoResetWaitableEvent latch;
+  int remaining_chunks = 3;
+  int invocations = 0;
+  scheduler.AddTask("remote", thread.GetTaskRunner(),
+                    [&](fml::TimePoint deadline) {
+                      invocations++;
+                      remaining_chunks--;
+                      if (remaining_chunks == 0) {
+                        latch.Signal();
+                      }
+                      return remaining_chunks > 0;
+                    });
+
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(1000)), 1u);
+  latch.Wait();
+  ASSERT_EQ(invocations, 3);
+}
+
+TEST(IdleTaskSchedulerTest, StopsRepostingRemoteTasksAtTheDeadline) {
+  IdleTaskScheduler scheduler;
+  fml::Thread thread("idle_task_scheduler_test");
+  auto runner = thread.GetTaskRunner();
+  int invocations = 0;
+  scheduler.AddTask("busy", runner, [&](fml::TimePoint deadline) {
+    invocations++;
+    while (fml::TimePoint::Now() < deadline) {
+    }
+    return true;
+  });
+
+  ASSERT_EQ(scheduler.RunIdleTasks(DeadlineIn(50)), 1u);
+
+  // A re-posted invocation would run before the second task posted here.
+  for (int i = 0; i < 2; i++) {
+    fml::AutoResetWaitableEvent latch;
+    runner->PostTask([&latch]() { latch.Signal(); });
+    latch.Wait();
+  }
+  ASSERT_EQ(invocations, 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_archive.h"
+
+#include <cstring>
+
+#include "flutter/assets/packed_asset_archive_builder.h"
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::shared_ptr<fml::Mapping> MakeAsset(const std::string& contents) {
+  return std::make_shared<fml::DataMapping>(contents);
+}
+
+static std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+static std::unique_ptr<PackedAssetArchive> MakeArchive(
+    const PackedAssetArchiveBuilder& builder) {
+  return std::make_unique<PackedAssetArchive>(builder.Build(), false, false);
+}
+
+TEST(PackedAssetArchiveTest, ResolvesAssetsByName) {
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("fonts/Roboto.ttf", MakeAsset("roboto"));
+  builder.AddAsset("AssetManifest.json", MakeAsset("{}"));
+  builder.AddAsset("images/empty.png", MakeAsset(""));
+  auto archive = MakeArchive(builder);
+
+  ASSERT_TRUE(archive->IsValid());
+  ASSERT_EQ(archive->GetAssetCount(), 3u);
+  ASSERT_EQ(archive->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetArchive);
+  ASSERT_EQ(ToString(archive->GetAsMapping("fonts/Roboto.ttf")), "roboto");
+  ASSERT_EQ(ToString(archive->GetAsMapping("AssetManifest.json")), "{}");
+  ASSERT_EQ(archive->GetAsMapping("images/empty.png")->GetSize(), 0u);
+  ASSERT_EQ(archive->GetAsMapping("fonts"), nullptr);
+  ASSERT_EQ(archive->GetAsMapping("fonts/Roboto.ttf2"), nullptr);
+  ASSERT_EQ(archive->GetAsMapping(""), nullptr);
+}
+
+TEST(PackedAssetArchiveTest, AlignsAssetContents) {
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("a", MakeAsset("a"));
+  builder.AddAsset("b", MakeAsset(std::string(5000, 'b')));
+  builder.AddAsset("c", MakeAsset("c"), true);
+  std::shared_ptr<fml::Mapping> data = builder.Build();
+  PackedAssetArchive archive(data, false, false);
+  ASSERT_TRUE(archive.IsValid());
+
+  for (const char* name : {"a", "b", "c"}) {
+    auto mapping = archive.GetAsMapping(name);
+    ASSERT_NE(mapping, nullptr);
+    ASSERT_EQ((mapping->GetMapping() - data->GetMapping()) %
+                  kPackedAssetArchiveAlignment,
+              0u);
+  }
+
+  // The startup-critical asset is stored first.
+  PackedAssetArchiveHeader header;
+  memcpy(&header, data->GetMapping(), sizeof(header));
+  ASSERT_EQ(header.prefetch_size, kPackedAssetArchiveAlignment);
+  ASSERT_EQ(archive.GetAsMapping("c")->GetMapping(),
+            data->GetMapping() + header.prefetch_offset);
+}
+
+TEST(PackedAssetArchiveTest, MappingsOutliveTheArchive) {
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("asset", MakeAsset("contents"));
+  auto archive = MakeArchive(builder);
+  auto mapping = archive->GetAsMapping("asset");
+  archive.reset();
+  ASSERT_EQ(ToString(mapping), "contents");
+}
+
+TEST(PackedAssetArchiveTest, MatchesPatternsLikeADirectory) {
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("shaders/a.sksl", MakeAsset("a"));
+  builder.AddAsset("shaders/b.sksl", MakeAsset("b"));
+  builder.AddAsset("shaders/nested/c.sksl", MakeAsset("c"));
+  builder.AddAsset("shadersx/d.sksl", MakeAsset("d"));
+  builder.AddAsset("e.sksl", MakeAsset("e"));
+  builder.AddAsset("f.json", MakeAsset("f"));
+  auto archive = MakeArchive(builder);
+
+  auto mappings = archive->GetAsMappings(".*\\.sksl", std::nullopt);
+  ASSERT_EQ(mappings.size(), 5u);
+
+  mappings = archive->GetAsMappings(".*\\.sksl", "shaders");
+  ASSERT_EQ(mappings.size(), 2u);
+  ASSERT_EQ(ToString(mappings[0]), "a");
+  ASSERT_EQ(ToString(mappings[1]), "b");
+
+  mappings = archive->GetAsMappings("c\\.sksl", "shaders/nested");
+  ASSERT_EQ(mappings.size(), 1u);
+
+  ASSERT_TRUE(archive->GetAsMappings(".*", "missing").empty());
+}
+
+TEST(PackedAssetArchiveTest, RejectsInvalidArchives) {
+  ASSERT_FALSE(PackedAssetArchive(nullptr, false, false).IsValid());
+  ASSERT_FALSE(
+      PackedAssetArchive(MakeAsset("not an archive"), false, false).IsValid());
+
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("asset", MakeAsset("contents"));
+  std::shared_ptr<fml::Mapping> data = builder.Build();
+  ASSERT_TRUE(PackedAssetArchive(data, false, false).IsValid());
+
+  // Points the contents of the asset past the end of the archive.
+  std::vector<uint8_t> corrupt(data->GetMapping(),
+                               data->GetMapping() + data->GetSize());
+  PackedAssetArchiveEntry entry;
+  memcpy(&entry, corrupt.data() + sizeof(PackedAssetArchiveHeader),
+         sizeof(entry));
+  entry.data_size = corrupt.size();
+  memcpy(corrupt.data() + sizeof(PackedAssetArchiveHeader), &entry,
+         sizeof(entry));
+  auto archive = PackedAssetArchive(
+      std::make_shared<fml::DataMapping>(std::move(corrupt)), false, false);
+  ASSERT_FALSE(archive.IsValid());
+  ASSERT_EQ(archive.GetAssetCount(), 0u);
+  ASSERT_EQ(archive.GetAsMapping("asset"), nullptr);
+}
+
+TEST(PackedAssetArchiveTest, ReadsArchiveFromFile) {
+  PackedAssetArchiveBuilder builder;
+  builder.AddAsset("asset", MakeAsset("contents"), true);
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), kPackedAssetArchiveFileName,
+                                   *builder.Build()));
+
+  fml::UniqueFD file =
+      fml::OpenFile(directory.fd(), kPackedAssetArchiveFileName, false,
+                    fml::FilePermission::kRead);
+  PackedAssetArchive archive(file, true);
+  ASSERT_TRUE(archive.IsValid());
+  ASSERT_TRUE(archive.IsValidAfterAssetManagerChange());
+  auto mapping = archive.GetAsMapping("asset");
+  ASSERT_EQ(ToString(mapping), "contents");
+  ASSERT_TRUE(mapping->IsDontNeedSafe());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -283,6 +283,52 @@ TEST_F(PersistentCacheTest,
   fml::UnlinkFile(asset_dir.fd(), PersistentCache::kAssetFileName);
 }
 
+TEST_F(PersistentCacheTest,
+#if defined(WINUWP)
+       // TODO(cbracken): https://github.com/flutter/flutter/issues/90481
+       DISABLED_SerializedSkSLBundleCanBeLoaded
+#else
+       SerializedSkSLBundleCanBeLoaded
+#endif  // defined(WINUWP)
+) {
+  fml::LogSettings warning_only = {fml::LOG_WARNING};
+  fml::ScopedSetLogSettings scoped_set_log_settings(warning_only);
+
+  std::vector<PersistentCache::SkSLCache> sksls = {
+      {SkData::MakeWithCString("A"), SkData::MakeWithCString("x")},
+      {SkData::MakeWithCString("B"), SkData::MakeWithCString("y")},
+  };
+  std::string bundle = PersistentCache::SerializeSkSLBundle(sksls, "android");
+  ASSERT_NE(bundle.find("\"platform\": \"android\""), std::string::npos);
+
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::DataMapping data(bundle);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(),
+                                   PersistentCache::kAssetFileName, data));
+
+  ResetAssetManager();
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(asset_dir.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+  PersistentCache::SetAssetManager(asset_manager);
+
+  auto shaders = PersistentCache::GetCacheForProcess()->LoadSkSLs();
+  ASSERT_EQ(shaders.size(), 2u);
+  if (shaders[0].key->bytes()[0] == 'B') {
+    std::swap(shaders[0], shaders[1]);
+  }
+  ASSERT_TRUE(shaders[0].key->equals(sksls[0].key.get()));
+  ASSERT_TRUE(shaders[0].value->equals(sksls[0].value.get()));
+  ASSERT_TRUE(shaders[1].key->equals(sksls[1].key.get()));
+  ASSERT_TRUE(shaders[1].value->equals(sksls[1].value.get()));
+
+  // Cleanup.
+  ResetAssetManager();
+  fml::UnlinkFile(asset_dir.fd(), PersistentCache::kAssetFileName);
+}
+
 TEST_F(PersistentCacheTest,
 #if defined(WINUWP)
        // TODO(cbracken): https://github.com/flutter/flutter/issues/90481
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -91,14 +93,27 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        active_depth_(depth),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// Limits the number of resources in flight to fewer than the depth the
+  /// pipeline was created with. The limit is clamped between one and that
+  /// depth. Resources that are already in flight are not affected.
+  void SetActiveDepth(uint32_t depth) {
+    active_depth_ = std::clamp(depth, 1u, depth_);
+  }
+
+  uint32_t GetActiveDepth() const { return active_depth_; }
+
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!HasActiveSlot() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -118,7 +133,7 @@ class Pipeline {
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!HasActiveSlot() || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -173,12 +188,17 @@ class Pipeline {
 
  private:
   const uint32_t depth_;
+  std::atomic<uint32_t> active_depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  bool HasActiveSlot() const {
+    return inflight_.load() < static_cast<int>(active_depth_.load());
+  }
+
   bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
     {
       std::scoped_lock lock(queue_mutex_);
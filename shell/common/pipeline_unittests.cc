@@ -131,5 +131,37 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ActiveDepthLimitsResourcesInFlight) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  pipeline->SetActiveDepth(1);
+  ASSERT_EQ(pipeline->GetActiveDepth(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  // Raising the active depth frees up a slot while the first resource is
+  // still in flight.
+  pipeline->SetActiveDepth(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); }),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, ActiveDepthIsClampedToDepth) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+  pipeline->SetActiveDepth(0);
+  ASSERT_EQ(pipeline->GetActiveDepth(), 1u);
+  pipeline->SetActiveDepth(5);
+  ASSERT_EQ(pipeline->GetActiveDepth(), 2u);
+}
+
 }  // namespace testing
 }  // namespace flutter
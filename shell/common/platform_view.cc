@@ -45,6 +45,11 @@ void PlatformView::DispatchKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
                                                 std::move(callback));
 }
 
+void PlatformView::DispatchInputEventBatch(InputEventBatch batch) {
+  pointer_data_packet_converter_.Convert(batch);
+  delegate_.OnPlatformViewDispatchInputEventBatch(std::move(batch));
+}
+
 void PlatformView::DispatchSemanticsAction(int32_t id,
                                            SemanticsAction action,
                                            fml::MallocMapping args) {
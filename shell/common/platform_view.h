@@ -17,6 +17,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/window/input_event_batch.h"
 #include "flutter/lib/ui/window/key_data_packet.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
@@ -141,6 +142,18 @@ class PlatformView {
         std::unique_ptr<KeyDataPacket> packet,
         std::function<void(bool /* handled */)> callback) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the platform view has encountered
+    ///             a batch of pointer and key events. The events need to be
+    ///             forwarded, in order, to the running root isolate hosted by
+    ///             the engine on the UI thread, using a single task.
+    ///
+    /// @param[in]  batch  The batch of events. Its pointer data packets have
+    ///                    already been converted.
+    ///
+    virtual void OnPlatformViewDispatchInputEventBatch(
+        InputEventBatch batch) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the platform view has encountered
     ///             an accessibility related action on the specified node. This
@@ -602,6 +615,17 @@ class PlatformView {
   void DispatchKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
                              Delegate::KeyDataResponse callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatches a batch of pointer and key events from the
+  ///             embedder to the framework, preserving their order. Unlike
+  ///             calling `DispatchPointerDataPacket` and
+  ///             `DispatchKeyDataPacket` for each event, the whole batch
+  ///             wakes up the UI thread only once.
+  ///
+  /// @param[in]  batch  The events to dispatch to the framework.
+  ///
+  void DispatchInputEventBatch(InputEventBatch batch);
+
   //--------------------------------------------------------------------------
   /// @brief      Used by the embedder to specify a texture that it wants the
   ///             rasterizer to composite within the Flutter layer tree. All
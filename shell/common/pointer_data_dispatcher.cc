@@ -15,6 +15,14 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate,
+    PointerDataResampler::Config config)
+    : DefaultPointerDataDispatcher(delegate),
+      resampler_(std::move(config)),
+      weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +76,64 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (!resampler_.HasPendingEvents() && !resampler_.ShouldBuffer(*packet)) {
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+    return;
+  }
+
+  resampler_.AddPacket(*packet);
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->DispatchResampledPacket();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchResampledPacket() {
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchResampledPacket");
+  fml::TimePoint target_time = delegate_.GetLastVsyncTargetTime();
+  if (target_time == fml::TimePoint()) {
+    target_time = fml::TimePoint::Now();
+  }
+
+  std::unique_ptr<PointerDataPacket> packet = resampler_.Flush(target_time);
+  if (packet) {
+    // Packets merged into this one end their flows here. The flow of the
+    // newest packet continues into the frame. Events held back from an
+    // earlier frame get a flow of their own.
+    uint64_t trace_flow_id;
+    if (pending_trace_flow_ids_.empty()) {
+      trace_flow_id = fml::tracing::TraceNonce();
+      TRACE_FLOW_BEGIN("flutter", "PointerEvent", trace_flow_id);
+    } else {
+      trace_flow_id = pending_trace_flow_ids_.back();
+      pending_trace_flow_ids_.pop_back();
+    }
+    for (uint64_t merged_flow_id : pending_trace_flow_ids_) {
+      TRACE_FLOW_END("flutter", "PointerEvent", merged_flow_id);
+    }
+    pending_trace_flow_ids_.clear();
+    delegate_.DoDispatchPacket(std::move(packet), trace_flow_id);
+  }
+
+  if (resampler_.HasPendingEvents()) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
 }  // namespace flutter
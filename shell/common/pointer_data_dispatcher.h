@@ -5,6 +5,7 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -64,6 +65,15 @@ class PointerDataDispatcher {
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
         const fml::closure& callback) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief    The target time of the most recent vsync. When called from a
+    ///           secondary vsync callback, this is the target time of the
+    ///           frame that callback runs for.
+    ///
+    ///           This is used by `ResamplingPointerDataDispatcher` to
+    ///           resample pointer positions for the frame being produced.
+    virtual fml::TimePoint GetLastVsyncTargetTime() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -164,6 +174,48 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that buffers pointer events until the next vsync, and then
+/// dispatches a single packet produced by a `PointerDataResampler`. Depending
+/// on the mode configured for each `PointerData::DeviceKind`, move events of
+/// a pointer are coalesced into one per frame, and their positions are
+/// resampled at the frame's vsync target time minus a sampling offset.
+///
+/// This is meant for input devices that sample faster than the display
+/// refreshes (e.g. 240Hz touch panels). Without it, every sample is delivered
+/// to the framework as its own packet, and positions are whatever the latest
+/// sample happened to be when the frame started, which makes drags uneven.
+///
+/// Packets containing only events of device kinds that are not buffered are
+/// dispatched right away, unless earlier events are still pending.
+///
+/// Enabled with the `--pointer-coalescing` and `--pointer-resampling`
+/// switches. See `Settings::pointer_coalescing_device_kinds`.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  ResamplingPointerDataDispatcher(Delegate& delegate,
+                                  PointerDataResampler::Config config);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  PointerDataResampler resampler_;
+  // The trace flows of the packets whose events are pending in |resampler_|.
+  std::vector<uint64_t> pending_trace_flow_ids_;
+
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+
+  void DispatchResampledPacket();
+
+  void ScheduleSecondaryVsyncCallback();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  explicit FakeDispatcherDelegate(fml::TimePoint vsync_target_time)
+      : vsync_target_time_(vsync_target_time) {}
+
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets_.push_back(std::move(packet));
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback_ = callback;
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override {
+    return vsync_target_time_;
+  }
+
+  void FireVsync() {
+    ASSERT_TRUE(vsync_callback_);
+    fml::closure callback = std::move(vsync_callback_);
+    vsync_callback_ = nullptr;
+    callback();
+  }
+
+  const std::vector<std::unique_ptr<PointerDataPacket>>& packets() const {
+    return packets_;
+  }
+
+ private:
+  const fml::TimePoint vsync_target_time_;
+  fml::closure vsync_callback_;
+  std::vector<std::unique_ptr<PointerDataPacket>> packets_;
+};
+
+PointerData CreateTouch(PointerData::Change change,
+                        int64_t time_stamp,
+                        double x) {
+  PointerData data;
+  memset(&data, 0, sizeof(PointerData));
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.physical_x = x;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+std::vector<PointerData> UnpackPacket(const PointerDataPacket& packet) {
+  std::vector<PointerData> events(packet.data().size() / sizeof(PointerData));
+  memcpy(events.data(), packet.data().data(), packet.data().size());
+  return events;
+}
+
+}  // namespace
+
+TEST(PointerDataDispatcherTest, ResamplesAtDelegateVsyncTargetTime) {
+  // A target time far from |fml::TimePoint::Now()| so that falling back to the
+  // current time would resample at a different position.
+  FakeDispatcherDelegate delegate(fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMicroseconds(12000)));
+
+  PointerDataResampler::Config config;
+  config.SetMode(PointerData::DeviceKind::kTouch,
+                 PointerResamplingMode::kResample);
+  config.sampling_offset = fml::TimeDelta::FromMicroseconds(2000);
+  ResamplingPointerDataDispatcher dispatcher(delegate, config);
+
+  dispatcher.DispatchPacket(
+      CreatePacket({
+          CreateTouch(PointerData::Change::kDown, 0, 0),
+          CreateTouch(PointerData::Change::kMove, 4000, 4),
+          CreateTouch(PointerData::Change::kMove, 8000, 8),
+          CreateTouch(PointerData::Change::kMove, 12000, 12),
+      }),
+      0);
+  ASSERT_TRUE(delegate.packets().empty());
+
+  delegate.FireVsync();
+
+  // Sampled at 10ms, between the moves at 8ms and 12ms.
+  ASSERT_EQ(delegate.packets().size(), 1u);
+  auto events = UnpackPacket(*delegate.packets()[0]);
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].change, PointerData::Change::kDown);
+  ASSERT_EQ(events[1].change, PointerData::Change::kMove);
+  ASSERT_EQ(events[1].time_stamp, 10000);
+  ASSERT_DOUBLE_EQ(events[1].physical_x, 10);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -10,6 +10,8 @@
 
 #include "flow/frame_timings.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/flow/display_list_serialization.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -61,6 +63,15 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+  auto raster_task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner();
+  auto& memory_pressure_manager = fml::MemoryPressureManager::GetInstance();
+  raster_cache_registration_ = memory_pressure_manager.Register(
+      "RasterCache", raster_task_runner,
+      [this](fml::MemoryPressureLevel level) { TrimRasterCache(level); });
+  resource_cache_registration_ = memory_pressure_manager.Register(
+      "GPUResourceCache", raster_task_runner,
+      [this](fml::MemoryPressureLevel level) { TrimResourceCache(level); });
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -77,11 +88,15 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
       if (surface_) {
         surface_->ClearRenderContext();
       }
+      thread_merge_changed_ = true;
     });
   }
 }
 
 void Rasterizer::Teardown() {
+  raster_cache_registration_.reset();
+  resource_cache_registration_.reset();
+
   auto context_switch =
       surface_ ? surface_->MakeRenderContextCurrent() : nullptr;
   if (context_switch && context_switch->GetResult()) {
@@ -134,6 +149,64 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
+void Rasterizer::TrimRasterCache(fml::MemoryPressureLevel level) {
+  auto& raster_cache = compositor_context_->raster_cache();
+  if (level == fml::MemoryPressureLevel::kCritical) {
+    raster_cache.Clear();
+    PublishCacheUsage();
+    return;
+  }
+
+  // Every entry left between frames was used in the last frame, so the
+  // largest images are evicted until the cache fits its budget. Moderate
+  // pressure signaled by the embedder while the cache is within its budget,
+  // or without one, halves it.
+  const size_t bytes = raster_cache.EstimateLayerCacheByteSize() +
+                       raster_cache.EstimatePictureCacheByteSize();
+  const size_t budget =
+      raster_cache_registration_ ? raster_cache_registration_->GetBudget() : 0;
+  raster_cache.EvictImagesToByteSize(budget > 0 && bytes > budget ? budget
+                                                                  : bytes / 2);
+  PublishCacheUsage();
+}
+
+void Rasterizer::TrimResourceCache(fml::MemoryPressureLevel level) {
+  if (!surface_) {
+    return;
+  }
+  auto context = surface_->GetContext();
+  if (!context) {
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  if (level == fml::MemoryPressureLevel::kCritical) {
+    context->performDeferredCleanup(std::chrono::milliseconds(0));
+  } else {
+    context->purgeUnlockedResources(/*scratchResourcesOnly=*/true);
+  }
+  PublishCacheUsage();
+}
+
+void Rasterizer::PublishCacheUsage() {
+  const auto& raster_cache = compositor_context_->raster_cache();
+  if (raster_cache_registration_) {
+    raster_cache_registration_->SetUsage(
+        raster_cache.EstimateLayerCacheByteSize() +
+            raster_cache.EstimatePictureCacheByteSize(),
+        raster_cache.GetCachedEntriesCount());
+  }
+  auto context = surface_ ? surface_->GetContext() : nullptr;
+  if (resource_cache_registration_ && context) {
+    int resource_count = 0;
+    size_t resource_bytes = 0;
+    context->getResourceCacheUsage(&resource_count, &resource_bytes);
+    resource_cache_registration_->SetUsage(resource_bytes, resource_count);
+  }
+}
+
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
   return &compositor_context_->texture_registry();
 }
@@ -388,12 +461,22 @@ RasterStatus Rasterizer::DoDraw(
     last_layer_tree_ = std::move(layer_tree);
   } else if (raster_status == RasterStatus::kResubmit ||
              raster_status == RasterStatus::kSkipAndRetry) {
+    if (raster_status == RasterStatus::kSkipAndRetry && raster_thread_merger_) {
+      raster_thread_merger_->RecordSkippedFrame();
+    }
     resubmitted_layer_tree_ = std::move(layer_tree);
     return raster_status;
   } else if (raster_status == RasterStatus::kDiscarded) {
     return raster_status;
   }
 
+  if (persistent_cache->StoredNewShaders()) {
+    frame_timings_recorder->RecordAnnotation(FrameTiming::kShaderCompilation);
+  }
+  if (thread_merge_changed_.exchange(false)) {
+    frame_timings_recorder->RecordAnnotation(FrameTiming::kThreadMerge);
+  }
+
   if (persistent_cache->IsDumpingSkp() &&
       persistent_cache->StoredNewShaders()) {
     auto screenshot =
@@ -539,6 +622,10 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     compositor_context_->raster_cache().PrepareNewFrame();
     frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+    // Skia adds a resource to its cache when it uploads an image to the GPU.
+    // The raster cache also adds one for each entry it rasterizes.
+    const int gpu_resource_count = GetGpuResourceCount();
+
     RasterStatus raster_status = compositor_frame->Raster(layer_tree, false);
     if (raster_status == RasterStatus::kFailed ||
         raster_status == RasterStatus::kSkipAndRetry) {
@@ -556,12 +643,22 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     compositor_context_->raster_cache().CleanupAfterFrame();
     frame_timings_recorder.RecordRasterEnd(
         &compositor_context_->raster_cache());
+
+    const auto& raster_cache = compositor_context_->raster_cache();
+    const int raster_cache_resource_count =
+        raster_cache.picture_metrics().rasterized_count +
+        raster_cache.layer_metrics().rasterized_count;
+    if (GetGpuResourceCount() - gpu_resource_count >
+        raster_cache_resource_count) {
+      frame_timings_recorder.RecordAnnotation(FrameTiming::kImageUpload);
+    }
     FireNextFrameCallbackIfPresent();
 
     if (surface_->GetContext()) {
       TRACE_EVENT0("flutter", "PerformDeferredSkiaCleanup");
       surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
     }
+    PublishCacheUsage();
 
     return raster_status;
   }
@@ -569,6 +666,17 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   return RasterStatus::kFailed;
 }
 
+int Rasterizer::GetGpuResourceCount() const {
+  GrDirectContext* context = surface_->GetContext();
+  if (!context) {
+    return 0;
+  }
+  int resource_count = 0;
+  size_t resource_bytes = 0;
+  context->getResourceCacheUsage(&resource_count, &resource_bytes);
+  return resource_count;
+}
+
 static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context) {
@@ -599,6 +707,33 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   return recorder.finishRecordingAsPicture()->serialize(&procs);
 }
 
+static sk_sp<SkData> ScreenshotLayerTreeAsDisplayList(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context) {
+  FML_DCHECK(tree != nullptr);
+  DisplayListCanvasRecorder recorder(
+      SkRect::MakeWH(tree->frame_size().width(), tree->frame_size().height()));
+
+  SkMatrix root_surface_transformation;
+  root_surface_transformation.reset();
+
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, &recorder, nullptr, root_surface_transformation, false, true,
+      nullptr);
+  frame->Raster(*tree, true);
+
+#if defined(OS_FUCHSIA)
+  SkSerialProcs procs = {0};
+  procs.fImageProc = SerializeImageWithoutData;
+  procs.fTypefaceProc = SerializeTypefaceWithoutData;
+#else
+  SkSerialProcs procs = {0};
+  procs.fTypefaceProc = SerializeTypefaceWithData;
+#endif
+
+  return SerializeDisplayList(recorder.Build(), procs);
+}
+
 static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
                                               const SkISize& size) {
   const auto image_info = SkImageInfo::MakeN32Premul(
@@ -711,6 +846,9 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
       data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
                                         surface_context, true);
       break;
+    case ScreenshotType::SerializedDisplayList:
+      data = ScreenshotLayerTreeAsDisplayList(layer_tree, *compositor_context_);
+      break;
   }
 
   if (data == nullptr) {
@@ -742,6 +880,13 @@ void Rasterizer::SetSnapshotSurfaceProducer(
   snapshot_surface_producer_ = std::move(producer);
 }
 
+void Rasterizer::SetRasterCacheAdmission(bool cost_based_admission,
+                                         bool show_decisions) {
+  auto& raster_cache = compositor_context_->raster_cache();
+  raster_cache.SetCostBasedAdmission(cost_based_admission);
+  raster_cache.SetShowAdmissionDecisions(show_decisions);
+}
+
 fml::RefPtr<fml::RasterThreadMerger> Rasterizer::GetRasterThreadMerger() {
   return raster_thread_merger_;
 }
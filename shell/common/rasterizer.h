@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 
@@ -16,6 +17,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/memory/memory_pressure_manager.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -266,6 +268,15 @@ class Rasterizer final : public SnapshotDelegate {
     /// container is used.
     ///
     CompressedImage,
+
+    //--------------------------------------------------------------------------
+    /// A format used to denote a Flutter display list, serialized with
+    /// `SerializeDisplayList` along with the images and other objects it
+    /// references. Unlike a Skia picture, the display list records the
+    /// frame op for op as the engine renders it, so it can be replayed and
+    /// benchmarked with `display_list_replay_benchmarks`.
+    ///
+    SerializedDisplayList,
   };
 
   //----------------------------------------------------------------------------
@@ -366,6 +377,20 @@ class Rasterizer final : public SnapshotDelegate {
   void SetSnapshotSurfaceProducer(
       std::unique_ptr<SnapshotSurfaceProducer> producer);
 
+  //----------------------------------------------------------------------------
+  /// @brief Configure how the raster cache admits pictures and display lists.
+  ///        This is done on shell initialization.
+  ///
+  /// @param[in]  cost_based_admission  Whether entries are admitted by their
+  ///                                   measured draw time instead of their
+  ///                                   op count.
+  /// @param[in]  show_decisions        Whether the admission decisions are
+  ///                                   outlined on screen.
+  ///
+  /// @see        `RasterCache::SetCostBasedAdmission`
+  ///
+  void SetRasterCacheAdmission(bool cost_based_admission, bool show_decisions);
+
   //----------------------------------------------------------------------------
   /// @brief      Returns a pointer to the compositor context used by this
   ///             rasterizer. This pointer will never be `nullptr`.
@@ -462,8 +487,17 @@ class Rasterizer final : public SnapshotDelegate {
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+  // Set when the threads are merged or unmerged, and cleared by the next frame
+  // that is rasterized, which is annotated with the change.
+  std::atomic<bool> thread_merge_changed_ = false;
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  // Registered with the |fml::MemoryPressureManager| between |Setup| and
+  // |Teardown|.
+  std::unique_ptr<fml::MemoryPressureManager::Registration>
+      raster_cache_registration_;
+  std::unique_ptr<fml::MemoryPressureManager::Registration>
+      resource_cache_registration_;
   // |SnapshotDelegate|
   sk_sp<SkImage> MakeRasterSnapshot(
       std::function<void(SkCanvas*)> draw_callback,
@@ -498,6 +532,14 @@ class Rasterizer final : public SnapshotDelegate {
 
   void FireNextFrameCallbackIfPresent();
 
+  void TrimRasterCache(fml::MemoryPressureLevel level);
+
+  void TrimResourceCache(fml::MemoryPressureLevel level);
+
+  void PublishCacheUsage();
+
+  int GetGpuResourceCount() const;
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
 
   FML_DISALLOW_COPY_AND_ASSIGN(Rasterizer);
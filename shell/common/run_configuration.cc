@@ -7,8 +7,10 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_archive.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 
@@ -24,10 +26,30 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  fml::UniqueFD assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+
+  // A packed archive holds all of the assets of the directory it is in, and
+  // is read with a single mapping instead of a file per asset.
+  fml::UniqueFD archive_file =
+      fml::OpenFile(assets_directory, kPackedAssetArchiveFileName, false,
+                    fml::FilePermission::kRead);
+  if (archive_file.is_valid()) {
+    auto archive = std::make_unique<PackedAssetArchive>(archive_file, true);
+    if (archive->IsValid()) {
+      asset_manager->PushBack(std::move(archive));
+    } else {
+      FML_LOG(ERROR) << "Could not read " << kPackedAssetArchiveFileName
+                     << " from " << settings.assets_path
+                     << ", reading the assets from the directory instead.";
+      archive_file.reset();
+    }
+  }
+
+  if (!archive_file.is_valid()) {
+    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+        std::move(assets_directory), true));
+  }
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/runtime_effect_cache.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr char kRedSkSL[] =
+    "half4 main(float2 coord) { return half4(1.0, 0.0, 0.0, 1.0); }";
+constexpr char kGreenSkSL[] =
+    "half4 main(float2 coord) { return half4(0.0, 1.0, 0.0, 1.0); }";
+
+// A task runner that holds its tasks until they are run or dropped, as a
+// message loop that shuts down drops its queued tasks.
+class HeldTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunTasks() {
+    std::vector<fml::closure> tasks;
+    tasks.swap(tasks_);
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+  void DropTasks() { tasks_.clear(); }
+
+  size_t size() const { return tasks_.size(); }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+class RuntimeEffectCacheTest : public ::testing::Test {
+ public:
+  RuntimeEffectCacheTest() {
+    PersistentCache::SetCacheDirectoryPath(cache_directory_.path());
+    PersistentCache::ResetCacheForProcess();
+    RuntimeEffectCache::ResetCacheForProcess();
+  }
+
+  ~RuntimeEffectCacheTest() override {
+    RuntimeEffectCache::ResetCacheForProcess();
+    PersistentCache::SetCacheDirectoryPath("");
+    PersistentCache::ResetCacheForProcess();
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory cache_directory_;
+};
+
+}  // namespace
+
+TEST_F(RuntimeEffectCacheTest, SharesEffectsCompiledFromTheSameSource) {
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  RuntimeEffectCache::Result red = cache->Get(kRedSkSL);
+  ASSERT_NE(red.effect, nullptr);
+  EXPECT_EQ(cache->Get(kRedSkSL).effect, red.effect);
+  EXPECT_EQ(cache->size(), 1u);
+
+  RuntimeEffectCache::Result green = cache->Get(kGreenSkSL);
+  ASSERT_NE(green.effect, nullptr);
+  EXPECT_NE(green.effect, red.effect);
+  EXPECT_EQ(cache->size(), 2u);
+}
+
+TEST_F(RuntimeEffectCacheTest, CachesCompilationErrors) {
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  RuntimeEffectCache::Result result = cache->Get("not sksl");
+  EXPECT_EQ(result.effect, nullptr);
+  EXPECT_FALSE(result.error.empty());
+  EXPECT_EQ(cache->Get("not sksl").error, result.error);
+  EXPECT_EQ(cache->size(), 1u);
+}
+
+TEST_F(RuntimeEffectCacheTest, CompilesOnTheWorkerTaskRunner) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  cache->SetWorkerTaskRunner(loop->GetTaskRunner());
+
+  RuntimeEffectCache::Future future = cache->GetAsync(kRedSkSL);
+  sk_sp<SkRuntimeEffect> effect = future.get().effect;
+  ASSERT_NE(effect, nullptr);
+  EXPECT_EQ(cache->Get(kRedSkSL).effect, effect);
+  EXPECT_EQ(cache->GetAsync(kRedSkSL).get().effect, effect);
+}
+
+TEST_F(RuntimeEffectCacheTest, PrecompilesTheEffectsOfPreviousRuns) {
+  RuntimeEffectCache::GetCacheForProcess()->Get(kRedSkSL);
+  RuntimeEffectCache::GetCacheForProcess()->Get("not sksl");
+
+  // Only valid effects are recorded for the next run.
+  PersistentCache::ResetCacheForProcess();
+  RuntimeEffectCache::ResetCacheForProcess();
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  EXPECT_EQ(cache->PrecompileKnownEffects(), 1u);
+  EXPECT_EQ(cache->size(), 1u);
+  EXPECT_NE(cache->Get(kRedSkSL).effect, nullptr);
+
+  EXPECT_EQ(cache->PrecompileKnownEffects(), 0u);
+}
+
+TEST_F(RuntimeEffectCacheTest, CompilesAgainAfterTheWorkerDropsTheTask) {
+  auto worker = std::make_shared<HeldTaskRunner>();
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  cache->SetWorkerTaskRunner(worker);
+
+  RuntimeEffectCache::Future future = cache->GetAsync(kRedSkSL);
+  ASSERT_EQ(worker->size(), 1u);
+  worker->DropTasks();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(0)),
+            std::future_status::ready);
+  EXPECT_TRUE(future.get().cancelled);
+  EXPECT_EQ(future.get().effect, nullptr);
+
+  RuntimeEffectCache::Result result = cache->Get(kRedSkSL);
+  EXPECT_FALSE(result.cancelled);
+  EXPECT_NE(result.effect, nullptr);
+  EXPECT_EQ(cache->size(), 1u);
+  EXPECT_EQ(worker->size(), 0u);
+}
+
+TEST_F(RuntimeEffectCacheTest, SchedulesThePrecompilationOnce) {
+  RuntimeEffectCache::GetCacheForProcess()->Get(kRedSkSL);
+  PersistentCache::ResetCacheForProcess();
+  RuntimeEffectCache::ResetCacheForProcess();
+
+  auto worker = std::make_shared<HeldTaskRunner>();
+  RuntimeEffectCache* cache = RuntimeEffectCache::GetCacheForProcess();
+  cache->SetWorkerTaskRunner(worker);
+  cache->SchedulePrecompileKnownEffects();
+  cache->SchedulePrecompileKnownEffects();
+  ASSERT_EQ(worker->size(), 1u);
+
+  // The precompilation reads the persistent cache on the worker, then posts
+  // the compilation of each effect.
+  worker->RunTasks();
+  EXPECT_EQ(cache->size(), 1u);
+  EXPECT_EQ(worker->size(), 1u);
+  worker->RunTasks();
+  EXPECT_NE(cache->GetAsync(kRedSkSL).get().effect, nullptr);
+  EXPECT_EQ(worker->size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -11,6 +11,7 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/common/graphics/runtime_effect_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
@@ -19,6 +20,8 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_buffer.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
@@ -32,6 +35,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -40,8 +44,33 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+// The number of GPU objects released per idle invocation of the Skia unref
+// queue task.
+constexpr size_t kSkiaUnrefQueueIdleSliceSize = 32;
+
 namespace {
 
+// Reports the duration of a phase of the startup or teardown of a shell to
+// Settings::shell_phase_callback when it goes out of scope.
+class ScopedShellPhase {
+ public:
+  ScopedShellPhase(const ShellPhaseCallback& callback, const char* phase)
+      : callback_(callback), phase_(phase), start_(fml::TimePoint::Now()) {}
+
+  ~ScopedShellPhase() {
+    if (callback_) {
+      callback_(phase_, fml::TimePoint::Now() - start_);
+    }
+  }
+
+ private:
+  const ShellPhaseCallback& callback_;
+  const char* phase_;
+  const fml::TimePoint start_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedShellPhase);
+};
+
 std::unique_ptr<Engine> CreateEngine(
     Engine::Delegate& delegate,
     const PointerDataDispatcherMaker& dispatcher_maker,
@@ -101,6 +130,11 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_buffer_capacity > 0) {
+      fml::tracing::TraceBuffer::GetInstance().Enable(
+          settings.trace_buffer_capacity);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -121,6 +155,44 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+bool ParsePointerDeviceKind(const std::string& name,
+                            PointerData::DeviceKind* kind) {
+  if (name == "touch") {
+    *kind = PointerData::DeviceKind::kTouch;
+  } else if (name == "mouse") {
+    *kind = PointerData::DeviceKind::kMouse;
+  } else if (name == "stylus") {
+    *kind = PointerData::DeviceKind::kStylus;
+  } else if (name == "inverted-stylus") {
+    *kind = PointerData::DeviceKind::kInvertedStylus;
+  } else {
+    FML_LOG(ERROR) << "Unknown pointer device kind: " << name;
+    return false;
+  }
+  return true;
+}
+
+PointerDataResampler::Config CreatePointerResamplingConfig(
+    const Settings& settings) {
+  PointerDataResampler::Config config;
+  PointerData::DeviceKind kind;
+  for (const auto& name : settings.pointer_coalescing_device_kinds) {
+    if (ParsePointerDeviceKind(name, &kind)) {
+      config.SetMode(kind, PointerResamplingMode::kCoalesce);
+    }
+  }
+  for (const auto& name : settings.pointer_resampling_device_kinds) {
+    if (ParsePointerDeviceKind(name, &kind)) {
+      config.SetMode(kind, PointerResamplingMode::kResample);
+    }
+  }
+  config.sampling_offset =
+      fml::TimeDelta::FromMicroseconds(settings.pointer_resampling_offset_us);
+  config.prediction_horizon =
+      fml::TimeDelta::FromMicroseconds(settings.pointer_prediction_horizon_us);
+  return config;
+}
+
 }  // namespace
 
 std::unique_ptr<Shell> Shell::Create(
@@ -181,6 +253,41 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     task_runners.GetUITaskRunner(),
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
+  const ShellPhaseCallback& phase_callback =
+      shell->GetSettings().shell_phase_callback;
+
+  // Loading the default font manager can take a long time and depends on none
+  // of the other subsystems, so it is loaded on a concurrent worker while they
+  // are set up. The engine picks it up once it has been created.
+  if (!shell->GetSettings().prefetched_default_font_manager) {
+    auto font_manager_promise =
+        std::make_shared<std::promise<sk_sp<SkFontMgr>>>();
+    shell->default_font_manager_ = font_manager_promise->get_future().share();
+    shell->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_manager_promise,
+         font_initialization_data =
+             shell->GetSettings().font_initialization_data,
+         phase_callback]() {
+          sk_sp<SkFontMgr> font_manager;
+          {
+            TRACE_EVENT0("flutter", "ShellSetupDefaultFontManager");
+            ScopedShellPhase phase(phase_callback,
+                                   "ShellSetupDefaultFontManager");
+            font_manager = txt::GetDefaultFontManager(font_initialization_data);
+          }
+          font_manager_promise->set_value(std::move(font_manager));
+        });
+  }
+
+  // Fragment programs compile their runtime effects on the concurrent workers
+  // when asked to compile in the background. The effects used by previous
+  // runs of the application are compiled there before they are needed, once
+  // per process.
+  RuntimeEffectCache* runtime_effect_cache =
+      RuntimeEffectCache::GetCacheForProcess();
+  runtime_effect_cache->SetWorkerTaskRunner(
+      shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+  runtime_effect_cache->SchedulePrecompileKnownEffects();
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -191,25 +298,33 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       task_runners.GetRasterTaskRunner(), [&rasterizer_promise,  //
                                            &snapshot_delegate_promise,
                                            on_create_rasterizer,  //
-                                           shell = shell.get()    //
+                                           shell = shell.get(),   //
+                                           phase_callback         //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        ScopedShellPhase phase(phase_callback, "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
-  if (!platform_view || !platform_view->GetWeakPtr()) {
-    return nullptr;
-  }
+  std::unique_ptr<PlatformView> platform_view;
+  std::unique_ptr<VsyncWaiter> vsync_waiter;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformView");
+    ScopedShellPhase phase(phase_callback, "ShellSetupPlatformView");
+    platform_view = on_create_platform_view(*shell.get());
+    if (!platform_view || !platform_view->GetWeakPtr()) {
+      return nullptr;
+    }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
+    // Ask the platform view for the vsync waiter. This will be used by the
+    // engine to create the animator.
+    vsync_waiter = platform_view->CreateVSyncWaiter();
+    if (!vsync_waiter) {
+      return nullptr;
+    }
   }
 
   // Create the IO manager on the IO thread. The IO manager must be initialized
@@ -232,14 +347,16 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // https://github.com/flutter/flutter/issues/42948
   fml::TaskRunner::RunNowOrPostTask(
       io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
-       platform_view = platform_view->GetWeakPtr(),                       //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+      [&io_manager_promise,                                                //
+       &weak_io_manager_promise,                                           //
+       &unref_queue_promise,                                               //
+       platform_view = platform_view->GetWeakPtr(),                        //
+       io_task_runner,                                                     //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),  //
+       phase_callback                                                      //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        ScopedShellPhase phase(phase_callback, "ShellSetupIOSubsystem");
         auto io_manager = std::make_unique<ShellIOManager>(
             platform_view.getUnsafe()->CreateResourceContext(),
             is_backgrounded_sync_switch, io_task_runner);
@@ -252,6 +369,17 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
 
+  // Pointer coalescing and resampling, when configured, take precedence over
+  // the dispatcher preferred by the platform.
+  auto resampling_config = CreatePointerResamplingConfig(settings);
+  if (resampling_config.IsEnabled()) {
+    dispatcher_maker = [resampling_config](
+                           PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(
+          delegate, resampling_config);
+    };
+  }
+
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
   auto engine_future = engine_promise.get_future();
@@ -266,14 +394,17 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
-                         &on_create_engine]() mutable {
+                         &on_create_engine,                               //
+                         phase_callback]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        ScopedShellPhase phase(phase_callback, "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().adaptive_pipeline_depth);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -375,6 +506,12 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  idle_task_scheduler_ = std::make_unique<IdleTaskScheduler>();
+
+  for (const auto& budget : settings_.cache_memory_budgets) {
+    fml::MemoryPressureManager::GetInstance().SetBudget(budget.first,
+                                                        budget.second);
+  }
 
   // Generate a WeakPtrFactory for use with the raster thread. This does not
   // need to wait on a latch because it can only ever be used from the raster
@@ -395,6 +532,11 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetRasterTaskRunner(),
       std::bind(&Shell::OnServiceProtocolScreenshotSKP, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kScreenshotDisplayListExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolScreenshotDisplayList, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kRunInViewExtensionName] = {
       task_runners_.GetUITaskRunner(),
       std::bind(&Shell::OnServiceProtocolRunInView, this, std::placeholders::_1,
@@ -423,6 +565,20 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetCacheMemoryUsageExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetCacheMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kDumpTraceBufferExtensionName] =
+      {task_runners_.GetIOTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolDumpTraceBuffer, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -431,34 +587,54 @@ Shell::~Shell() {
 
   vm_->GetServiceProtocol()->RemoveHandler(this);
 
-  fml::AutoResetWaitableEvent ui_latch, gpu_latch, platform_latch, io_latch;
+  const ShellPhaseCallback& phase_callback = settings_.shell_phase_callback;
+
+  // The engine and the rasterizer do not depend on each other and are torn
+  // down concurrently. |rasterizer_| is moved out below while the UI thread
+  // may still be running tasks of the engine, so the paths that run on the
+  // UI thread must only use |weak_rasterizer_|. The IO manager must outlive
+  // both of them, as they may still queue GPU objects for collection on the
+  // IO thread.
+  fml::CountDownLatch ui_and_gpu_latch(2);
+  fml::AutoResetWaitableEvent platform_latch, io_latch;
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
-      fml::MakeCopyable([this, &ui_latch]() mutable {
-        engine_.reset();
-        ui_latch.Signal();
+      fml::MakeCopyable([this, &ui_and_gpu_latch, &phase_callback]() mutable {
+        {
+          TRACE_EVENT0("flutter", "ShellTeardownUISubsystem");
+          ScopedShellPhase phase(phase_callback, "ShellTeardownUISubsystem");
+          engine_.reset();
+        }
+        ui_and_gpu_latch.CountDown();
       }));
-  ui_latch.Wait();
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetRasterTaskRunner(),
-      fml::MakeCopyable(
-          [this, rasterizer = std::move(rasterizer_), &gpu_latch]() mutable {
-            rasterizer.reset();
-            this->weak_factory_gpu_.reset();
-            gpu_latch.Signal();
-          }));
-  gpu_latch.Wait();
+      fml::MakeCopyable([this, rasterizer = std::move(rasterizer_),
+                         &ui_and_gpu_latch, &phase_callback]() mutable {
+        {
+          TRACE_EVENT0("flutter", "ShellTeardownGPUSubsystem");
+          ScopedShellPhase phase(phase_callback, "ShellTeardownGPUSubsystem");
+          rasterizer.reset();
+          this->weak_factory_gpu_.reset();
+        }
+        ui_and_gpu_latch.CountDown();
+      }));
+  ui_and_gpu_latch.Wait();
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetIOTaskRunner(),
       fml::MakeCopyable([io_manager = std::move(io_manager_),
-                         platform_view = platform_view_.get(),
-                         &io_latch]() mutable {
-        io_manager.reset();
-        if (platform_view) {
-          platform_view->ReleaseResourceContext();
+                         platform_view = platform_view_.get(), &io_latch,
+                         &phase_callback]() mutable {
+        {
+          TRACE_EVENT0("flutter", "ShellTeardownIOSubsystem");
+          ScopedShellPhase phase(phase_callback, "ShellTeardownIOSubsystem");
+          io_manager.reset();
+          if (platform_view) {
+            platform_view->ReleaseResourceContext();
+          }
         }
         io_latch.Signal();
       }));
@@ -471,8 +647,12 @@ Shell::~Shell() {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetPlatformTaskRunner(),
       fml::MakeCopyable([platform_view = std::move(platform_view_),
-                         &platform_latch]() mutable {
-        platform_view.reset();
+                         &platform_latch, &phase_callback]() mutable {
+        {
+          TRACE_EVENT0("flutter", "ShellTeardownPlatformView");
+          ScopedShellPhase phase(phase_callback, "ShellTeardownPlatformView");
+          platform_view.reset();
+        }
         platform_latch.Signal();
       }));
   platform_latch.Wait();
@@ -518,6 +698,23 @@ std::unique_ptr<Shell> Shell::Spawn(
   return result;
 }
 
+static void WriteTraceBuffer(
+    const std::string& path,
+    const std::vector<fml::tracing::TraceBuffer::Event>& events) {
+  TRACE_EVENT0("flutter", "Shell::WriteTraceBuffer");
+  std::string absolute_path = fml::paths::AbsolutePath(path);
+  std::string directory_path = fml::paths::GetDirectoryName(absolute_path);
+  std::string file_name = absolute_path.substr(directory_path.size() + 1);
+  fml::UniqueFD directory = fml::OpenDirectory(
+      directory_path.c_str(), false, fml::FilePermission::kReadWrite);
+  fml::DataMapping mapping(
+      fml::tracing::TraceBuffer::ToChromeTraceJson(events));
+  if (!directory.is_valid() ||
+      !fml::WriteAtomically(directory, file_name.c_str(), mapping)) {
+    FML_LOG(ERROR) << "Could not write the trace buffer to " << path;
+  }
+}
+
 void Shell::NotifyLowMemoryWarning() const {
   auto trace_id = fml::tracing::TraceNonce();
   TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
@@ -528,6 +725,18 @@ void Shell::NotifyLowMemoryWarning() const {
   // running.
   ::Dart_NotifyLowMemory();
 
+  // The process may be killed soon, so this is the last chance to save the
+  // events that led up to it.
+  auto& trace_buffer = fml::tracing::TraceBuffer::GetInstance();
+  if (!settings_.trace_buffer_dump_path.empty() && trace_buffer.IsEnabled()) {
+    task_runners_.GetIOTaskRunner()->PostTask(
+        [path = settings_.trace_buffer_dump_path,
+         events = trace_buffer.Dump()]() { WriteTraceBuffer(path, events); });
+  }
+
+  fml::MemoryPressureManager::GetInstance().NotifyMemoryPressure(
+      fml::MemoryPressureLevel::kCritical);
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
         if (rasterizer) {
@@ -540,6 +749,14 @@ void Shell::NotifyLowMemoryWarning() const {
   // to purge them.
 }
 
+void Shell::NotifyMemoryPressure(fml::MemoryPressureLevel level) const {
+  if (level == fml::MemoryPressureLevel::kCritical) {
+    NotifyLowMemoryWarning();
+    return;
+  }
+  fml::MemoryPressureManager::GetInstance().NotifyMemoryPressure(level);
+}
+
 void Shell::RunEngine(RunConfiguration run_configuration) {
   RunEngine(std::move(run_configuration), nullptr);
 }
@@ -635,6 +852,8 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetExternalViewEmbedder(view_embedder);
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
+  rasterizer_->SetRasterCacheAdmission(settings_.raster_cache_cost_admission,
+                                       settings_.show_raster_cache_admission);
 
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
@@ -643,13 +862,15 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
   // Setup the time-consuming default font manager right after engine created.
-  if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
-                                        }
-                                      });
+  // It has been loading on a concurrent worker since the shell was created.
+  if (default_font_manager_.valid()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, font_manager = default_font_manager_] {
+          if (engine) {
+            engine->SetupDefaultFontManager(font_manager.get());
+          }
+        });
   }
 
   is_setup_ = true;
@@ -657,6 +878,19 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
+  // Release GPU objects collected on the UI thread while there is frame slack
+  // instead of waiting for the unref queue's timer to fire mid-frame. Each
+  // invocation releases one slice, and the scheduler posts the next one while
+  // the deadline allows. Whatever is left is released by the timer.
+  if (auto unref_queue = io_manager_->GetSkiaUnrefQueue()) {
+    idle_task_scheduler_->AddTask(
+        "SkiaUnrefQueue", task_runners_.GetIOTaskRunner(),
+        [unref_queue](fml::TimePoint) {
+          return unref_queue->HasPendingObjects() &&
+                 unref_queue->DrainUpTo(kSkiaUnrefQueueIdleSliceSize);
+        });
+  }
+
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
 
@@ -961,6 +1195,40 @@ void Shell::OnPlatformViewDispatchKeyDataPacket(
       }));
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewDispatchInputEventBatch(InputEventBatch batch) {
+  TRACE_EVENT0("flutter", "Shell::OnPlatformViewDispatchInputEventBatch");
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  // Every pointer packet of the batch gets its own flow, like packets
+  // dispatched through |OnPlatformViewDispatchPointerDataPacket|.
+  uint64_t first_flow_id = next_pointer_flow_id_;
+  for (const auto& entry : batch.GetEntries()) {
+    if (entry.pointer_packet) {
+      TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
+      next_pointer_flow_id_++;
+    }
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      fml::MakeCopyable([engine = weak_engine_, batch = std::move(batch),
+                         flow_id = first_flow_id]() mutable {
+        if (!engine) {
+          return;
+        }
+        for (auto& entry : batch.GetEntries()) {
+          if (entry.pointer_packet) {
+            engine->DispatchPointerDataPacket(std::move(entry.pointer_packet),
+                                              flow_id++);
+          } else {
+            engine->DispatchKeyDataPacket(std::move(entry.key_packet),
+                                          std::move(entry.key_callback));
+          }
+        }
+      }));
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchSemanticsAction(int32_t id,
                                                   SemanticsAction action,
@@ -1103,6 +1371,13 @@ void Shell::OnAnimatorNotifyIdle(int64_t deadline) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
   }
+
+  // The deadline is expressed on the Dart timeline clock. The Dart VM had the
+  // first chance at the slack above, so whatever is left goes to the engine's
+  // own idle tasks.
+  const fml::TimeDelta slack =
+      fml::TimeDelta::FromMicroseconds(deadline - Dart_TimelineGetMicros());
+  idle_task_scheduler_->RunIdleTasks(fml::TimePoint::Now() + slack);
 }
 
 // |Animator::Delegate|
@@ -1132,7 +1407,7 @@ void Shell::OnAnimatorDraw(
   task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
       [&waiting_for_first_frame = waiting_for_first_frame_,
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
-       rasterizer = rasterizer_->GetWeakPtr(),
+       rasterizer = weak_rasterizer_,
        weak_pipeline = std::weak_ptr<Pipeline<LayerTree>>(pipeline),
        discard_callback = std::move(discard_callback),
        frame_timings_recorder = std::move(frame_timings_recorder)]() mutable {
@@ -1157,7 +1432,7 @@ void Shell::OnAnimatorDrawLastLayerTree(
   FML_DCHECK(is_setup_);
 
   auto task = fml::MakeCopyable(
-      [rasterizer = rasterizer_->GetWeakPtr(),
+      [rasterizer = weak_rasterizer_,
        frame_timings_recorder = std::move(frame_timings_recorder)]() mutable {
         if (rasterizer) {
           rasterizer->DrawLastLayerTree(std::move(frame_timings_recorder));
@@ -1223,7 +1498,7 @@ void Shell::HandleEngineSkiaMessage(std::unique_ptr<PlatformMessage> message) {
     return;
 
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), max_bytes = args->value.GetInt(),
+      [rasterizer = weak_rasterizer_, max_bytes = args->value.GetInt(),
        response = std::move(message->response())] {
         if (rasterizer) {
           rasterizer->SetResourceCacheMaxBytes(static_cast<size_t>(max_bytes),
@@ -1361,6 +1636,18 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  frame_timing_statistics_.AddFrame(timing);
+
+  // The animator chooses the depth of the pipeline on the UI thread.
+  if (settings_.adaptive_pipeline_depth) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->RecordFrameTiming(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1537,6 +1824,28 @@ bool Shell::OnServiceProtocolScreenshotSKP(
   return false;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolScreenshotDisplayList(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto screenshot = rasterizer_->ScreenshotLastLayerTree(
+      Rasterizer::ScreenshotType::SerializedDisplayList, true);
+  if (screenshot.data) {
+    response->SetObject();
+    auto& allocator = response->GetAllocator();
+    response->AddMember("type", "ScreenshotDisplayList", allocator);
+    rapidjson::Value display_list;
+    display_list.SetString(static_cast<const char*>(screenshot.data->data()),
+                           screenshot.data->size(), allocator);
+    response->AddMember("displayList", display_list, allocator);
+    return true;
+  }
+  ServiceProtocolFailureError(response,
+                              "Could not capture DisplayList screenshot.");
+  return false;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolRunInView(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1702,6 +2011,140 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetCacheMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  response->AddMember("type", "CacheMemoryUsage", response->GetAllocator());
+  rapidjson::Value caches_json(rapidjson::kArrayType);
+  for (const auto& cache :
+       fml::MemoryPressureManager::GetInstance().GetUsage()) {
+    rapidjson::Value cache_json(rapidjson::kObjectType);
+    cache_json.AddMember(
+        "name",
+        rapidjson::Value(cache.name.c_str(), response->GetAllocator()).Move(),
+        response->GetAllocator());
+    cache_json.AddMember<uint64_t>("bytes", cache.bytes,
+                                   response->GetAllocator());
+    cache_json.AddMember<uint64_t>("entries", cache.entries,
+                                   response->GetAllocator());
+    cache_json.AddMember<uint64_t>("budgetBytes", cache.budget_bytes,
+                                   response->GetAllocator());
+    caches_json.PushBack(cache_json, response->GetAllocator());
+  }
+  response->AddMember("caches", caches_json, response->GetAllocator());
+  return true;
+}
+
+FrameTimingStatistics::Summary Shell::SummarizeFrameTimings() {
+  return frame_timing_statistics_.Summarize(
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()));
+}
+
+static const char* GetAnnotationName(FrameTiming::Annotation annotation) {
+  switch (annotation) {
+    case FrameTiming::kShaderCompilation:
+      return "shaderCompilation";
+    case FrameTiming::kRasterCacheMiss:
+      return "rasterCacheMiss";
+    case FrameTiming::kThreadMerge:
+      return "threadMerge";
+    case FrameTiming::kImageUpload:
+      return "imageUpload";
+    case FrameTiming::kNoAnnotation:
+      break;
+  }
+  return "";
+}
+
+static rapidjson::Value PercentilesToJson(
+    const FrameTimingStatistics::Percentiles& percentiles,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value json(rapidjson::kObjectType);
+  json.AddMember<int64_t>("p50", percentiles.p50.ToMicroseconds(), allocator);
+  json.AddMember<int64_t>("p90", percentiles.p90.ToMicroseconds(), allocator);
+  json.AddMember<int64_t>("p99", percentiles.p99.ToMicroseconds(), allocator);
+  return json;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameTimingStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto summary = SummarizeFrameTimings();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", summary.frame_count, allocator);
+  // All of the durations are in microseconds.
+  response->AddMember("vsyncLatency",
+                      PercentilesToJson(summary.vsync_latency, allocator),
+                      allocator);
+  response->AddMember("build", PercentilesToJson(summary.build, allocator),
+                      allocator);
+  response->AddMember("raster", PercentilesToJson(summary.raster, allocator),
+                      allocator);
+
+  rapidjson::Value annotated_frames(rapidjson::kObjectType);
+  for (size_t i = 0; i < std::size(FrameTiming::kAnnotations); i++) {
+    annotated_frames.AddMember(
+        rapidjson::StringRef(GetAnnotationName(FrameTiming::kAnnotations[i])),
+        static_cast<uint64_t>(summary.annotated_frame_counts[i]), allocator);
+  }
+  response->AddMember("annotatedFrameCounts", annotated_frames, allocator);
+
+  rapidjson::Value slow_frames(rapidjson::kArrayType);
+  for (const auto& frame : summary.slow_frames) {
+    rapidjson::Value frame_json(rapidjson::kObjectType);
+    frame_json.AddMember<uint64_t>("frameNumber", frame.frame_number,
+                                   allocator);
+    frame_json.AddMember<int64_t>(
+        "vsyncLatency", frame.vsync_latency.ToMicroseconds(), allocator);
+    frame_json.AddMember<int64_t>("build", frame.build.ToMicroseconds(),
+                                  allocator);
+    frame_json.AddMember<int64_t>("raster", frame.raster.ToMicroseconds(),
+                                  allocator);
+    rapidjson::Value annotations(rapidjson::kArrayType);
+    for (auto annotation : FrameTiming::kAnnotations) {
+      if (frame.annotations & annotation) {
+        annotations.PushBack(
+            rapidjson::StringRef(GetAnnotationName(annotation)), allocator);
+      }
+    }
+    frame_json.AddMember("annotations", annotations, allocator);
+    slow_frames.PushBack(frame_json, allocator);
+  }
+  response->AddMember("slowFrames", slow_frames, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolDumpTraceBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& trace_buffer = fml::tracing::TraceBuffer::GetInstance();
+  if (!trace_buffer.IsEnabled()) {
+    ServiceProtocolFailureError(response,
+                                "The trace buffer is not enabled. See "
+                                "--trace-buffer-capacity.");
+    return false;
+  }
+
+  rapidjson::Document trace;
+  trace.Parse(
+      fml::tracing::TraceBuffer::ToChromeTraceJson(trace_buffer.Dump()));
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceBuffer", allocator);
+  response->AddMember("traceEvents",
+                      rapidjson::Value(trace["traceEvents"], allocator),
+                      allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
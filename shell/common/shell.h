@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <future>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -17,6 +18,7 @@
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_pressure_manager.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/thread_checker.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -36,9 +38,12 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_timing_statistics.h"
+#include "flutter/shell/common/idle_task_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 
 namespace flutter {
 
@@ -279,10 +284,24 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell will attempt to purge caches.
+  ///
+  ///             The warning is about the memory of the process, so every
+  ///             cache registered with the `fml::MemoryPressureManager` is
+  ///             cleared at `fml::MemoryPressureLevel::kCritical`, including
+  ///             those of other shells in the process. The GPU resources of
+  ///             this shell's rasterizer are purged as well.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify that memory is getting scarce.
+  ///             Every cache registered with the `fml::MemoryPressureManager`
+  ///             is asked to trim, including those of other shells in the
+  ///             process. At `fml::MemoryPressureLevel::kCritical`, this is
+  ///             equivalent to `NotifyLowMemoryWarning`.
+  ///
+  void NotifyMemoryPressure(fml::MemoryPressureLevel level) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -395,6 +414,23 @@ class Shell final : public PlatformView::Delegate,
   /// @see        `CreateCompatibleGenerator`
   void RegisterImageDecoder(ImageGeneratorFactory factory, int32_t priority);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Summarizes the timings of the most recently rasterized frames
+  ///             into percentiles, along with the frames that took longer
+  ///             than the frame budget of the main display and the work they
+  ///             were annotated with. This may be called from any thread.
+  ///
+  /// @see        `FrameTimingStatistics`
+  ///
+  FrameTimingStatistics::Summary SummarizeFrameTimings();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scheduler for deferrable engine work that runs while the
+  ///             UI thread is idle between frames. Tasks may be registered
+  ///             from any thread.
+  ///
+  IdleTaskScheduler& GetIdleTaskScheduler() { return *idle_task_scheduler_; }
+
   //----------------------------------------------------------------------------
   /// @brief Returns the delegate object that handles PlatformMessage's from
   ///        Flutter to the host platform (and its responses).
@@ -419,6 +455,8 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
+  // Loaded on a concurrent worker while the other subsystems are set up.
+  std::shared_future<sk_sp<SkFontMgr>> default_font_manager_;
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
@@ -453,11 +491,16 @@ class Shell final : public PlatformView::Delegate,
   // have not been reported yet. Vector of ints instead of FrameTiming is stored
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
+  FrameTimingStatistics frame_timing_statistics_;
 
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
 
+  /// Runs deferrable housekeeping within the slack reported by the animator.
+  /// This class is thread safe, can be accessed from any of the threads.
+  std::unique_ptr<IdleTaskScheduler> idle_task_scheduler_;
+
   // protects expected_frame_size_ which is set on platform thread and read on
   // raster thread
   std::mutex resize_mutex_;
@@ -530,6 +573,9 @@ class Shell final : public PlatformView::Delegate,
       std::unique_ptr<KeyDataPacket> packet,
       std::function<void(bool /* handled */)> callback) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewDispatchInputEventBatch(InputEventBatch batch) override;
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(int32_t id,
                                              SemanticsAction action,
@@ -652,6 +698,11 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  bool OnServiceProtocolScreenshotDisplayList(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   bool OnServiceProtocolRunInView(
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -684,6 +735,29 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports the last published usage of every cache registered with the
+  // `fml::MemoryPressureManager` in the process.
+  bool OnServiceProtocolGetCacheMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the percentiles of the recent frame timings and the slow frames
+  // among them, with the work each one was annotated with.
+  bool OnServiceProtocolGetFrameTimingStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the events in the trace buffer in the Chrome trace format.
+  bool OnServiceProtocolDumpTraceBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
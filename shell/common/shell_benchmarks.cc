@@ -4,6 +4,10 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <map>
+#include <mutex>
+#include <string>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
@@ -13,9 +17,41 @@
 
 namespace flutter {
 
+constexpr char kStartupPhasePrefix[] = "ShellSetup";
+constexpr char kShutdownPhasePrefix[] = "ShellTeardown";
+
+// Collects the durations of the phases of the shell startup and shutdown,
+// which are reported from the threads that run them.
+class ShellPhaseTimings {
+ public:
+  ShellPhaseCallback GetCallback() {
+    return [this](const char* phase, fml::TimeDelta duration) {
+      std::scoped_lock lock(mutex_);
+      milliseconds_[phase] += duration.ToMillisecondsF();
+    };
+  }
+
+  // Reports the average duration of the phases with the prefix as counters
+  // of the benchmark.
+  void ReportCounters(benchmark::State& state, const std::string& prefix) {
+    std::scoped_lock lock(mutex_);
+    for (const auto& [phase, milliseconds] : milliseconds_) {
+      if (phase.compare(0, prefix.size(), prefix) == 0) {
+        state.counters[phase + "Ms"] = benchmark::Counter(
+            milliseconds, benchmark::Counter::kAvgIterations);
+      }
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::string, double> milliseconds_;
+};
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
-                                    bool measure_shutdown) {
+                                    bool measure_shutdown,
+                                    ShellPhaseTimings& timings) {
   auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
                                        fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
@@ -27,6 +63,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
     Settings settings = {};
     settings.task_observer_add = [](intptr_t, fml::closure) {};
     settings.task_observer_remove = [](intptr_t) {};
+    settings.shell_phase_callback = timings.GetCallback();
 
     if (DartVM::IsRunningPrecompiledCode()) {
       aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
@@ -97,25 +134,32 @@ static void StartupAndShutdownShell(benchmark::State& state,
 }
 
 static void BM_ShellInitialization(benchmark::State& state) {
+  ShellPhaseTimings timings;
   while (state.KeepRunning()) {
-    StartupAndShutdownShell(state, true, false);
+    StartupAndShutdownShell(state, true, false, timings);
   }
+  timings.ReportCounters(state, kStartupPhasePrefix);
 }
 
 BENCHMARK(BM_ShellInitialization);
 
 static void BM_ShellShutdown(benchmark::State& state) {
+  ShellPhaseTimings timings;
   while (state.KeepRunning()) {
-    StartupAndShutdownShell(state, false, true);
+    StartupAndShutdownShell(state, false, true, timings);
   }
+  timings.ReportCounters(state, kShutdownPhasePrefix);
 }
 
 BENCHMARK(BM_ShellShutdown);
 
 static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
+  ShellPhaseTimings timings;
   while (state.KeepRunning()) {
-    StartupAndShutdownShell(state, true, true);
+    StartupAndShutdownShell(state, true, true, timings);
   }
+  timings.ReportCounters(state, kStartupPhasePrefix);
+  timings.ReportCounters(state, kShutdownPhasePrefix);
 }
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
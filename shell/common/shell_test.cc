@@ -268,6 +268,15 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetCacheMemoryUsage:
+            shell->OnServiceProtocolGetCacheMemoryUsage(params, response);
+            break;
+          case ServiceProtocolEnum::kGetFrameTimingStatistics:
+            shell->OnServiceProtocolGetFrameTimingStatistics(params, response);
+            break;
+          case ServiceProtocolEnum::kDumpTraceBuffer:
+            shell->OnServiceProtocolDumpTraceBuffer(params, response);
+            break;
         }
         finished.set_value(true);
       });
@@ -9,11 +9,14 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 
 #include "assets/directory_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/display_list_serialization.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -23,6 +26,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -70,6 +74,8 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
   MOCK_METHOD2(OnPlatformViewDispatchKeyDataPacket,
                void(std::unique_ptr<KeyDataPacket> packet,
                     KeyDataResponse callback));
+  MOCK_METHOD1(OnPlatformViewDispatchInputEventBatch,
+               void(InputEventBatch batch));
 
   MOCK_METHOD3(OnPlatformViewDispatchSemanticsAction,
                void(int32_t id,
@@ -1873,6 +1879,60 @@ TEST_F(ShellTest, Screenshot) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ScreenshotDisplayList) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent firstFrameLatch;
+  settings.frame_rasterized_callback =
+      [&firstFrameLatch](const FrameTiming& t) { firstFrameLatch.Signal(); };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](std::shared_ptr<ContainerLayer> root) {
+    SkPictureRecorder recorder;
+    SkCanvas* recording_canvas =
+        recorder.beginRecording(SkRect::MakeXYWH(0, 0, 80, 80));
+    recording_canvas->drawRect(SkRect::MakeXYWH(0, 0, 80, 80),
+                               SkPaint(SkColor4f::FromColor(SK_ColorRED)));
+    auto sk_picture = recorder.finishRecordingAsPicture();
+    fml::RefPtr<SkiaUnrefQueue> queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        this->GetCurrentTaskRunner(), fml::TimeDelta::Zero());
+    auto picture_layer = std::make_shared<PictureLayer>(
+        SkPoint::Make(10, 10),
+        flutter::SkiaGPUObject<SkPicture>({sk_picture, queue}), false, false);
+    root->Add(picture_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  firstFrameLatch.Wait();
+
+  std::promise<Rasterizer::Screenshot> screenshot_promise;
+  auto screenshot_future = screenshot_promise.get_future();
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(),
+      [&screenshot_promise, &shell]() {
+        auto rasterizer = shell->GetRasterizer();
+        screenshot_promise.set_value(rasterizer->ScreenshotLastLayerTree(
+            Rasterizer::ScreenshotType::SerializedDisplayList, false));
+      });
+
+  Rasterizer::Screenshot screenshot = screenshot_future.get();
+  ASSERT_NE(screenshot.data, nullptr);
+  ASSERT_EQ(screenshot.frame_size, SkISize::Make(100, 100));
+  sk_sp<DisplayList> display_list = DeserializeDisplayList(
+      screenshot.data->data(), screenshot.data->size());
+  ASSERT_NE(display_list, nullptr);
+  ASSERT_GT(display_list->op_count(true), 0);
+  // The frame is cleared before it is painted, so the list covers all of it.
+  ASSERT_EQ(display_list->bounds(), SkRect::MakeWH(100, 100));
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanConvertToAndFromMappings) {
   const size_t buffer_size = 2 << 20;
 
@@ -2273,6 +2333,92 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetCacheMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  settings.cache_memory_budgets["ShellTestCache"] = 1000;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto registration = fml::MemoryPressureManager::GetInstance().Register(
+      "ShellTestCache", nullptr, [](fml::MemoryPressureLevel level) {});
+  registration->SetUsage(100, 3);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetCacheMemoryUsage,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json.find("{\"type\":\"CacheMemoryUsage\",\"caches\":["),
+            0u);
+  ASSERT_NE(actual_json.find("{\"name\":\"ShellTestCache\",\"bytes\":100,"
+                             "\"entries\":3,\"budgetBytes\":1000}"),
+            std::string::npos);
+
+  registration.reset();
+  fml::MemoryPressureManager::GetInstance().SetBudget("ShellTestCache", 0);
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingStatisticsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameTimingStatistics,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"FrameTimingStatistics\",\"frameCount\":0,"
+      "\"vsyncLatency\":{\"p50\":0,\"p90\":0,\"p99\":0},"
+      "\"build\":{\"p50\":0,\"p90\":0,\"p99\":0},"
+      "\"raster\":{\"p50\":0,\"p90\":0,\"p99\":0},"
+      "\"annotatedFrameCounts\":{\"shaderCompilation\":0,\"rasterCacheMiss\":0,"
+      "\"threadMerge\":0,\"imageUpload\":0},\"slowFrames\":[]}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolDumpTraceBufferWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kDumpTraceBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  ASSERT_TRUE(document.HasMember("code"));
+
+  auto& trace_buffer = fml::tracing::TraceBuffer::GetInstance();
+  trace_buffer.Enable(1024);
+  trace_buffer.Record(fml::tracing::TraceBufferEventType::kInstant,
+                      "ShellTestEvent", 1);
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kDumpTraceBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  trace_buffer.Disable();
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json.find("{\"type\":\"TraceBuffer\",\"traceEvents\":["),
+            0u);
+  ASSERT_NE(actual_json.find("{\"name\":\"ShellTestEvent\",\"cat\":"
+                             "\"Embedder\",\"ph\":\"i\",\"ts\":1,"),
+            std::string::npos);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, DiscardLayerTreeOnResize) {
   auto settings = CreateSettingsForFixture();
 
@@ -3131,6 +3277,35 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ReportsStartupAndTeardownPhases) {
+  auto settings = CreateSettingsForFixture();
+  std::mutex phases_mutex;
+  std::set<std::string> phases;
+  settings.shell_phase_callback = [&](const char* phase,
+                                      fml::TimeDelta duration) {
+    std::scoped_lock lock(phases_mutex);
+    ASSERT_GE(duration, fml::TimeDelta::Zero());
+    phases.insert(phase);
+  };
+
+  auto shell = CreateShell(std::move(settings));
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  DestroyShell(std::move(shell));
+
+  std::scoped_lock lock(phases_mutex);
+  EXPECT_EQ(phases, std::set<std::string>({
+                        "ShellSetupDefaultFontManager",
+                        "ShellSetupGPUSubsystem",
+                        "ShellSetupIOSubsystem",
+                        "ShellSetupPlatformView",
+                        "ShellSetupUISubsystem",
+                        "ShellTeardownGPUSubsystem",
+                        "ShellTeardownIOSubsystem",
+                        "ShellTeardownPlatformView",
+                        "ShellTeardownUISubsystem",
+                    }));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
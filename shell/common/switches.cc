@@ -198,6 +198,24 @@ static bool GetSwitchValue(const fml::CommandLine& command_line,
   return false;
 }
 
+static bool GetThreadPolicy(const fml::CommandLine& command_line,
+                            Switch sw,
+                            fml::ThreadPolicy* result) {
+  std::string switch_string;
+
+  if (!command_line.GetOptionValue(FlagForSwitch(sw), &switch_string)) {
+    return false;
+  }
+
+  if (!fml::ParseThreadPolicy(switch_string, result)) {
+    FML_LOG(ERROR) << "Thread policy '" << switch_string << "' given to --"
+                   << FlagForSwitch(sw) << " was malformed and is ignored.";
+    return false;
+  }
+
+  return true;
+}
+
 std::unique_ptr<fml::Mapping> GetSymbolMapping(std::string symbol_prefix,
                                                std::string native_lib_path) {
   const uint8_t* mapping;
@@ -322,6 +340,11 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  GetSwitchValue(command_line, Switch::TraceBufferCapacity,
+                 &settings.trace_buffer_capacity);
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceBufferDumpPath),
+                              &settings.trace_buffer_dump_path);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -406,6 +429,18 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_skparagraph =
       command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
 
+  settings.diff_semantics_updates = !command_line.HasOption(
+      FlagForSwitch(Switch::DisableSemanticsUpdateDiffing));
+
+  settings.optimize_display_lists =
+      command_line.HasOption(FlagForSwitch(Switch::OptimizeDisplayLists));
+
+  settings.enable_layer_arena =
+      command_line.HasOption(FlagForSwitch(Switch::EnableLayerArena));
+
+  settings.compile_runtime_effects_in_background = command_line.HasOption(
+      FlagForSwitch(Switch::CompileRuntimeEffectsInBackground));
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
@@ -445,12 +480,66 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  settings.adaptive_pipeline_depth =
+      command_line.HasOption(FlagForSwitch(Switch::AdaptivePipelineDepth));
+
+  settings.raster_cache_cost_admission =
+      command_line.HasOption(FlagForSwitch(Switch::RasterCacheCostAdmission));
+  settings.show_raster_cache_admission =
+      command_line.HasOption(FlagForSwitch(Switch::ShowRasterCacheAdmission));
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  std::string pointer_coalescing;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::PointerCoalescing),
+                                  &pointer_coalescing)) {
+    settings.pointer_coalescing_device_kinds =
+        ParseCommaDelimited(pointer_coalescing);
+  }
+
+  std::string pointer_resampling;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::PointerResampling),
+                                  &pointer_resampling)) {
+    settings.pointer_resampling_device_kinds =
+        ParseCommaDelimited(pointer_resampling);
+  }
+
+  GetSwitchValue(command_line, Switch::PointerResamplingOffset,
+                 &settings.pointer_resampling_offset_us);
+  GetSwitchValue(command_line, Switch::PointerPredictionHorizon,
+                 &settings.pointer_prediction_horizon_us);
+
+  GetThreadPolicy(command_line, Switch::UIThreadPolicy,
+                  &settings.ui_thread_policy);
+  GetThreadPolicy(command_line, Switch::RasterThreadPolicy,
+                  &settings.raster_thread_policy);
+  GetThreadPolicy(command_line, Switch::IOThreadPolicy,
+                  &settings.io_thread_policy);
+  GetThreadPolicy(command_line, Switch::WorkerThreadPolicy,
+                  &settings.worker_thread_policy);
+
+  std::string cache_memory_budgets;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::CacheMemoryBudgets),
+                                  &cache_memory_budgets)) {
+    for (const auto& budget : ParseCommaDelimited(cache_memory_budgets)) {
+      size_t separator = budget.find('=');
+      size_t budget_bytes = 0;
+      if (separator == std::string::npos ||
+          !(std::stringstream(budget.substr(separator + 1)) >> budget_bytes)) {
+        FML_LOG(ERROR) << "Cache memory budget '" << budget
+                       << "' was malformed and is ignored.";
+        continue;
+      }
+      settings.cache_memory_budgets[budget.substr(0, separator)] =
+          budget_bytes;
+    }
+  }
+
   return settings;
 }
 
@@ -160,6 +160,33 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(AdaptivePipelineDepth,
+           "adaptive-pipeline-depth",
+           "Adapt the number of frames that may be in flight between the UI "
+           "and raster threads to the durations of recent frames. This lowers "
+           "input latency when frames are fast, and keeps the UI thread from "
+           "stalling when rasterization is slow.")
+DEF_SWITCH(RasterCacheCostAdmission,
+           "raster-cache-cost-admission",
+           "Cache pictures in the raster cache when their measured draw time, "
+           "over the frames they are reused in, justifies the memory of their "
+           "cached images, instead of by their number of operations.")
+DEF_SWITCH(ShowRasterCacheAdmission,
+           "show-raster-cache-admission",
+           "Outline the pictures considered by the cost based admission of "
+           "the raster cache in green when they are cached, in red when their "
+           "draw time does not justify caching them, and in yellow while it "
+           "is being measured.")
+DEF_SWITCH(TraceBufferCapacity,
+           "trace-buffer-capacity",
+           "Record the most recent trace events of each thread, up to the "
+           "given number, into a buffer that stays enabled in all build "
+           "modes. The buffer is returned in the Chrome trace format by the "
+           "_flutter.dumpTraceBuffer service extension.")
+DEF_SWITCH(TraceBufferDumpPath,
+           "trace-buffer-dump-path",
+           "The file the trace buffer is written to when the engine receives a "
+           "low memory warning.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
@@ -214,6 +241,70 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
+DEF_SWITCH(DisableSemanticsUpdateDiffing,
+           "disable-semantics-update-diffing",
+           "Sends every semantics node updated by the framework to the "
+           "platform, including the nodes that did not change since they were "
+           "last sent. Meant for embedders that rebuild their accessibility "
+           "tree from each update.")
+DEF_SWITCH(OptimizeDisplayLists,
+           "optimize-display-lists",
+           "Removes redundant records from the display lists recorded by the "
+           "framework before they are rasterized.")
+DEF_SWITCH(EnableLayerArena,
+           "enable-layer-arena",
+           "Allocates the layers of each frame that the framework cannot "
+           "retain from a per-frame arena instead of individually.")
+DEF_SWITCH(CompileRuntimeEffectsInBackground,
+           "compile-runtime-effects-in-background",
+           "Compiles the SkSL of fragment programs on a worker thread instead "
+           "of blocking the UI thread when the program is created.")
+DEF_SWITCH(PointerCoalescing,
+           "pointer-coalescing",
+           "Comma-separated list of pointer device kinds (touch, mouse, "
+           "stylus, inverted-stylus) whose move events are coalesced into one "
+           "per pointer per frame.")
+DEF_SWITCH(PointerResampling,
+           "pointer-resampling",
+           "Comma-separated list of pointer device kinds whose move events are "
+           "coalesced and whose positions are resampled at the vsync target "
+           "time.")
+DEF_SWITCH(PointerResamplingOffset,
+           "pointer-resampling-offset",
+           "How far behind the vsync target time pointer positions are "
+           "resampled, in microseconds. Only used with --pointer-resampling.")
+DEF_SWITCH(PointerPredictionHorizon,
+           "pointer-prediction-horizon",
+           "The maximum duration, in microseconds, that resampled pointer "
+           "positions are extrapolated past the newest sample. Only used with "
+           "--pointer-resampling.")
+DEF_SWITCH(UIThreadPolicy,
+           "ui-thread-policy",
+           "The scheduling policy of the UI thread, as a colon separated list "
+           "of key=value pairs. The keys are 'sched' (other, batch, idle, fifo "
+           "or rr), 'priority' (the real-time priority), 'nice' and 'cpus' (a "
+           "comma separated list of CPUs and CPU ranges). For example: "
+           "--ui-thread-policy=nice=-4:cpus=4-7")
+DEF_SWITCH(RasterThreadPolicy,
+           "raster-thread-policy",
+           "The scheduling policy of the raster thread. See "
+           "--ui-thread-policy for the format.")
+DEF_SWITCH(IOThreadPolicy,
+           "io-thread-policy",
+           "The scheduling policy of the IO thread. See --ui-thread-policy for "
+           "the format.")
+DEF_SWITCH(WorkerThreadPolicy,
+           "worker-thread-policy",
+           "The scheduling policy of the worker threads used for image "
+           "decoding and other background work. See --ui-thread-policy for "
+           "the format.")
+DEF_SWITCH(CacheMemoryBudgets,
+           "cache-memory-budgets",
+           "A comma separated list of memory budgets, in bytes, for the "
+           "engine's caches. A cache that grows past its budget is asked to "
+           "trim. The cache names are reported by the "
+           "_flutter.getCacheMemoryUsage service extension. For example: "
+           "--cache-memory-budgets=RasterCache=67108864,TextLayoutCache=4194304")
 
 DEF_SWITCHES_END
 
@@ -46,5 +46,73 @@ TEST(SwitchesTest, SkiaTraceAllowlistFlag) {
 #endif
 }
 
+TEST(SwitchesTest, ThreadPolicyFlags) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--raster-thread-policy=nice=-4:cpus=4-7",
+       "--worker-thread-policy=cpus=0,1", "--io-thread-policy=nice"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.ui_thread_policy.IsDefault());
+  EXPECT_EQ(settings.raster_thread_policy.nice, -4);
+  EXPECT_EQ(settings.raster_thread_policy.cpu_affinity,
+            (std::vector<size_t>{4, 5, 6, 7}));
+  EXPECT_EQ(settings.worker_thread_policy.cpu_affinity,
+            (std::vector<size_t>{0, 1}));
+  // Malformed policies are ignored.
+  EXPECT_TRUE(settings.io_thread_policy.IsDefault());
+}
+
+TEST(SwitchesTest, CacheMemoryBudgetsFlag) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--cache-memory-budgets=RasterCache=1024,Bad,Other=x,"
+                  "TextLayoutCache=64"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.cache_memory_budgets,
+            (std::map<std::string, size_t>{{"RasterCache", 1024},
+                                           {"TextLayoutCache", 64}}));
+}
+
+TEST(SwitchesTest, TraceBufferFlags) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--trace-buffer-capacity=4096",
+       "--trace-buffer-dump-path=/tmp/trace.json"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.trace_buffer_capacity, 4096u);
+  EXPECT_EQ(settings.trace_buffer_dump_path, "/tmp/trace.json");
+}
+
+TEST(SwitchesTest, RasterCacheAdmissionFlags) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.raster_cache_cost_admission);
+  EXPECT_FALSE(settings.show_raster_cache_admission);
+
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--raster-cache-cost-admission",
+       "--show-raster-cache-admission"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.raster_cache_cost_admission);
+  EXPECT_TRUE(settings.show_raster_cache_admission);
+}
+
+TEST(SwitchesTest, EnableLayerArenaFlag) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.enable_layer_arena);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--enable-layer-arena"}));
+  EXPECT_TRUE(settings.enable_layer_arena);
+}
+
+TEST(SwitchesTest, CompileRuntimeEffectsInBackgroundFlag) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.compile_runtime_effects_in_background);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--compile-runtime-effects-in-background"}));
+  EXPECT_TRUE(settings.compile_runtime_effects_in_background);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -10,26 +10,43 @@ ThreadHost::ThreadHost() = default;
 
 ThreadHost::ThreadHost(ThreadHost&&) = default;
 
+ThreadHost::ThreadPolicies ThreadHost::ThreadPolicies::FromSettings(
+    const Settings& settings) {
+  ThreadPolicies policies;
+  policies.ui = settings.ui_thread_policy;
+  policies.raster = settings.raster_thread_policy;
+  policies.io = settings.io_thread_policy;
+  return policies;
+}
+
 ThreadHost::ThreadHost(std::string name_prefix_arg, uint64_t mask)
+    : ThreadHost(std::move(name_prefix_arg), mask, ThreadPolicies{}) {}
+
+ThreadHost::ThreadHost(std::string name_prefix_arg,
+                       uint64_t mask,
+                       const ThreadPolicies& policies)
     : name_prefix(name_prefix_arg) {
   if (mask & ThreadHost::Type::Platform) {
-    platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
+    platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform",
+                                                    policies.platform);
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui", policies.ui);
   }
 
   if (mask & ThreadHost::Type::RASTER) {
-    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster");
+    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster",
+                                                  policies.raster);
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io", policies.io);
   }
 
   if (mask & ThreadHost::Type::Profiler) {
-    profiler_thread = std::make_unique<fml::Thread>(name_prefix + ".profiler");
+    profiler_thread = std::make_unique<fml::Thread>(name_prefix + ".profiler",
+                                                    policies.profiler);
   }
 }
 
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
 
@@ -22,6 +23,18 @@ struct ThreadHost {
     Profiler = 1 << 4,
   };
 
+  /// The scheduling policies of the threads created by the host.
+  struct ThreadPolicies {
+    fml::ThreadPolicy platform;
+    fml::ThreadPolicy ui;
+    fml::ThreadPolicy raster;
+    fml::ThreadPolicy io;
+    fml::ThreadPolicy profiler;
+
+    /// The UI, raster and IO thread policies configured in the settings.
+    static ThreadPolicies FromSettings(const Settings& settings);
+  };
+
   std::string name_prefix;
   std::unique_ptr<fml::Thread> platform_thread;
   std::unique_ptr<fml::Thread> ui_thread;
@@ -37,6 +50,10 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  ThreadHost(std::string name_prefix,
+             uint64_t type_mask,
+             const ThreadPolicies& policies);
+
   ~ThreadHost();
 };
 
@@ -45,9 +45,10 @@ AndroidShellHolder::AndroidShellHolder(
   auto thread_label = std::to_string(thread_host_count++);
 
   thread_host_ = std::make_shared<ThreadHost>();
-  *thread_host_ = {thread_label, ThreadHost::Type::UI |
-                                     ThreadHost::Type::RASTER |
-                                     ThreadHost::Type::IO};
+  *thread_host_ = {thread_label,
+                   ThreadHost::Type::UI | ThreadHost::Type::RASTER |
+                       ThreadHost::Type::IO,
+                   ThreadHost::ThreadPolicies::FromSettings(settings_)};
 
   fml::WeakPtr<PlatformViewAndroid> weak_platform_view;
   Shell::CreateCallback<PlatformView> on_create_platform_view =
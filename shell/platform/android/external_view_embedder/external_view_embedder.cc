@@ -213,6 +213,7 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
 PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   if (!FrameHasPlatformLayers()) {
+    merge_policy_.RecordFrame(false);
     return PostPrerollResult::kSuccess;
   }
   if (!raster_thread_merger->IsMerged()) {
@@ -225,15 +226,16 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
     // Eventually, the frame is submitted once this method returns `kSuccess`.
     // At that point, the raster tasks are handled on the platform thread.
     CancelFrame();
-    raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
+    raster_thread_merger->MergeWithLease(merge_policy_.GetLeaseTerm());
     return PostPrerollResult::kSkipAndRetryFrame;
   }
-  raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
   // Surface switch requires to resubmit the frame.
   // TODO(egarciad): https://github.com/flutter/flutter/issues/65652
   if (previous_frame_view_count_ == 0) {
+    raster_thread_merger->ExtendLeaseTo(merge_policy_.GetLeaseTerm());
     return PostPrerollResult::kResubmitFrame;
   }
+  raster_thread_merger->ExtendLeaseTo(merge_policy_.RecordFrame(true));
   return PostPrerollResult::kSuccess;
 }
 
@@ -9,6 +9,7 @@
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
+#include "flutter/fml/raster_thread_merge_policy.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -80,12 +81,10 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   SkRect GetViewRect(int view_id) const;
 
  private:
-  // The number of frames the rasterizer task runner will continue
-  // to run on the platform thread after no platform view is rendered.
-  //
-  // Note: this is an arbitrary number that attempts to account for cases
-  // where the platform view might be momentarily off the screen.
-  static const int kDefaultMergedLeaseDuration = 10;
+  // Decides the number of frames the rasterizer task runner will continue
+  // to run on the platform thread after no platform view is rendered, based on
+  // how long platform views were recently off the screen.
+  fml::RasterThreadMergePolicy merge_policy_;
 
   // Provides metadata to the Android surfaces.
   const AndroidContext& android_context_;
@@ -197,7 +197,7 @@ TEST(AndroidExternalViewEmbedder, RasterizerRunsOnPlatformThread) {
     raster_thread_merger->DecrementLease();
     pending_frames++;
   }
-  ASSERT_EQ(10, pending_frames);  // kDefaultMergedLeaseDuration
+  ASSERT_EQ(10, pending_frames);  // kDefaultMinimumLease
 }
 
 TEST(AndroidExternalViewEmbedder, RasterizerRunsOnRasterizerThread) {
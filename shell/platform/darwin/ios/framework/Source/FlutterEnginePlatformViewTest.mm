@@ -28,6 +28,7 @@ class FakeDelegate : public PlatformView::Delegate {
   }
   void OnPlatformViewDispatchKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
                                            std::function<void(bool)> callback) override {}
+  void OnPlatformViewDispatchInputEventBatch(InputEventBatch batch) override {}
   void OnPlatformViewDispatchSemanticsAction(int32_t id,
                                              SemanticsAction action,
                                              fml::MallocMapping args) override {}
@@ -258,13 +258,12 @@ bool FlutterPlatformViewsController::HasPlatformViewThisOrNextFrame() {
   return composition_order_.size() > 0 || active_composition_order_.size() > 0;
 }
 
-const int FlutterPlatformViewsController::kDefaultMergedLeaseDuration;
-
 PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   // TODO(cyanglaz): https://github.com/flutter/flutter/issues/56474
   // Rename `has_platform_view` to `view_mutated` when the above issue is resolved.
   if (!HasPlatformViewThisOrNextFrame()) {
+    merge_policy_.RecordFrame(false);
     return PostPrerollResult::kSuccess;
   }
   if (!raster_thread_merger->IsMerged()) {
@@ -277,7 +276,7 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
     // Eventually, the frame is submitted once this method returns `kSuccess`.
     // At that point, the raster tasks are handled on the platform thread.
     CancelFrame();
-    raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
+    raster_thread_merger->MergeWithLease(merge_policy_.GetLeaseTerm());
     return PostPrerollResult::kSkipAndRetryFrame;
   }
   // If the post preroll action is successful, we will display platform views in the current frame.
@@ -285,7 +284,7 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
   // We need to begin an explicit CATransaction. This transaction needs to be submitted
   // after the current frame is submitted.
   BeginCATransaction();
-  raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
+  raster_thread_merger->ExtendLeaseTo(merge_policy_.RecordFrame(true));
   return PostPrerollResult::kSuccess;
 }
 
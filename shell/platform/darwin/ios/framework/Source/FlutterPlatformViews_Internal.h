@@ -8,6 +8,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
+#include "flutter/fml/raster_thread_merge_policy.h"
 #include "flutter/shell/common/shell.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterBinaryMessenger.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
@@ -214,12 +215,10 @@ class FlutterPlatformViewsController {
   std::map<int64_t, int64_t> clip_count_;
   SkISize frame_size_;
 
-  // The number of frames the rasterizer task runner will continue
-  // to run on the platform thread after no platform view is rendered.
-  //
-  // Note: this is an arbitrary number that attempts to account for cases
-  // where the platform view might be momentarily off the screen.
-  static const int kDefaultMergedLeaseDuration = 10;
+  // Decides the number of frames the rasterizer task runner will continue
+  // to run on the platform thread after no platform view is rendered, based on
+  // how long platform views were recently off the screen.
+  fml::RasterThreadMergePolicy merge_policy_;
 
   // Method channel `OnDispose` calls adds the views to be disposed to this set to be disposed on
   // the next frame.
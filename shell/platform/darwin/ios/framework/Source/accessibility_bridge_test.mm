@@ -81,6 +81,7 @@ class MockDelegate : public PlatformView::Delegate {
   }
   void OnPlatformViewDispatchKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
                                            std::function<void(bool)> callback) override {}
+  void OnPlatformViewDispatchInputEventBatch(InputEventBatch batch) override {}
   void OnPlatformViewDispatchSemanticsAction(int32_t id,
                                              SemanticsAction action,
                                              fml::MallocMapping args) override {}
@@ -5,6 +5,7 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -144,6 +145,40 @@ static bool IsMetalRendererConfigValid(const FlutterRendererConfig* config) {
   return device && command_queue && present && get_texture;
 }
 
+static fml::ThreadPolicy ToThreadPolicy(const FlutterThreadPolicy* policy) {
+  fml::ThreadPolicy result;
+  switch (SAFE_ACCESS(policy, scheduler, kFlutterThreadSchedulerDefault)) {
+    case kFlutterThreadSchedulerDefault:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kDefault;
+      break;
+    case kFlutterThreadSchedulerOther:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kOther;
+      break;
+    case kFlutterThreadSchedulerBatch:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kBatch;
+      break;
+    case kFlutterThreadSchedulerIdle:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kIdle;
+      break;
+    case kFlutterThreadSchedulerFifo:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kFifo;
+      break;
+    case kFlutterThreadSchedulerRoundRobin:
+      result.scheduler = fml::ThreadPolicy::Scheduler::kRoundRobin;
+      break;
+  }
+  result.realtime_priority = SAFE_ACCESS(policy, realtime_priority, 0);
+  if (SAFE_ACCESS(policy, set_nice_value, false)) {
+    result.nice = SAFE_ACCESS(policy, nice_value, 0);
+  }
+  const size_t* cpus = SAFE_ACCESS(policy, cpu_affinity, nullptr);
+  size_t cpu_count = SAFE_ACCESS(policy, cpu_affinity_count, 0);
+  if (cpus != nullptr) {
+    result.cpu_affinity.assign(cpus, cpus + cpu_count);
+  }
+  return result;
+}
+
 static bool IsRendererValid(const FlutterRendererConfig* config) {
   if (config == nullptr) {
     return false;
@@ -692,6 +727,10 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  bool reuse_unchanged_backing_stores =
+      SAFE_ACCESS(compositor, reuse_unchanged_backing_stores, false);
+  size_t max_unused_backing_store_bytes =
+      SAFE_ACCESS(compositor, max_unused_backing_store_bytes, 0);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -718,7 +757,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       };
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
+              avoid_backing_store_cache, reuse_unchanged_backing_stores,
+              max_unused_backing_store_bytes, create_render_target_callback,
               present_callback),
           false};
 }
@@ -1008,6 +1048,18 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
+  if (SAFE_ACCESS(args, ui_thread_policy, nullptr) != nullptr) {
+    settings.ui_thread_policy = ToThreadPolicy(args->ui_thread_policy);
+  }
+  if (SAFE_ACCESS(args, raster_thread_policy, nullptr) != nullptr) {
+    settings.raster_thread_policy = ToThreadPolicy(args->raster_thread_policy);
+  }
+  if (SAFE_ACCESS(args, io_thread_policy, nullptr) != nullptr) {
+    settings.io_thread_policy = ToThreadPolicy(args->io_thread_policy);
+  }
+  if (SAFE_ACCESS(args, worker_thread_policy, nullptr) != nullptr) {
+    settings.worker_thread_policy = ToThreadPolicy(args->worker_thread_policy);
+  }
 
   flutter::PlatformViewEmbedder::UpdateSemanticsNodesCallback
       update_semantics_nodes_callback = nullptr;
@@ -1057,6 +1109,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
                 node.customAccessibilityActions.size(),
                 &node.customAccessibilityActions[0],
                 node.platformViewId,
+                node.changes,
             };
             ptr(&embedder_node, user_data);
           }
@@ -1261,7 +1314,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          SAFE_ACCESS(args, custom_task_runners, nullptr));
+          SAFE_ACCESS(args, custom_task_runners, nullptr),
+          flutter::ThreadHost::ThreadPolicies::FromSettings(settings));
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -1507,6 +1561,53 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
+static flutter::PointerData ToPointerData(const FlutterPointerEvent* current) {
+  flutter::PointerData pointer_data;
+  pointer_data.Clear();
+  // this is currely in use only on android embedding.
+  pointer_data.embedder_id = 0;
+  pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
+  pointer_data.change = ToPointerDataChange(
+      SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
+  pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
+  pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.physical_delta_x = 0.0;
+  pointer_data.physical_delta_y = 0.0;
+  pointer_data.device = SAFE_ACCESS(current, device, 0);
+  // Pointer identifier will be generated in
+  // pointer_data_packet_converter.cc.
+  pointer_data.pointer_identifier = 0;
+  pointer_data.signal_kind = ToPointerDataSignalKind(
+      SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
+  pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
+  pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
+  FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
+  // For backwards compatibility with embedders written before the device
+  // kind and buttons were exposed, if the device kind is not set treat it
+  // as a mouse, with a synthesized primary button state based on the phase.
+  if (device_kind == 0) {
+    pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
+    pointer_data.buttons =
+        PointerDataButtonsForLegacyEvent(pointer_data.change);
+
+  } else {
+    pointer_data.kind = ToPointerDataKind(device_kind);
+    if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
+      // For touch events, set the button internally rather than requiring
+      // it at the API level, since it's a confusing construction to expose.
+      if (pointer_data.change == flutter::PointerData::Change::kDown ||
+          pointer_data.change == flutter::PointerData::Change::kMove) {
+        pointer_data.buttons = flutter::kPointerButtonTouchContact;
+      }
+    } else {
+      // Buttons use the same mask values, so pass them through directly.
+      pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
+    }
+  }
+  return pointer_data;
+}
+
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPointerEvent* pointers,
@@ -1524,50 +1625,7 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
   const FlutterPointerEvent* current = pointers;
 
   for (size_t i = 0; i < events_count; ++i) {
-    flutter::PointerData pointer_data;
-    pointer_data.Clear();
-    // this is currely in use only on android embedding.
-    pointer_data.embedder_id = 0;
-    pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
-    pointer_data.change = ToPointerDataChange(
-        SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
-    pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
-    pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.physical_delta_x = 0.0;
-    pointer_data.physical_delta_y = 0.0;
-    pointer_data.device = SAFE_ACCESS(current, device, 0);
-    // Pointer identifier will be generated in
-    // pointer_data_packet_converter.cc.
-    pointer_data.pointer_identifier = 0;
-    pointer_data.signal_kind = ToPointerDataSignalKind(
-        SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
-    pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
-    pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
-    FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
-    // For backwards compatibility with embedders written before the device
-    // kind and buttons were exposed, if the device kind is not set treat it
-    // as a mouse, with a synthesized primary button state based on the phase.
-    if (device_kind == 0) {
-      pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
-      pointer_data.buttons =
-          PointerDataButtonsForLegacyEvent(pointer_data.change);
-
-    } else {
-      pointer_data.kind = ToPointerDataKind(device_kind);
-      if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
-        // For touch events, set the button internally rather than requiring
-        // it at the API level, since it's a confusing construction to expose.
-        if (pointer_data.change == flutter::PointerData::Change::kDown ||
-            pointer_data.change == flutter::PointerData::Change::kMove) {
-          pointer_data.buttons = flutter::kPointerButtonTouchContact;
-        }
-      } else {
-        // Buttons use the same mask values, so pass them through directly.
-        pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
-      }
-    }
-    packet->SetPointerData(i, pointer_data);
+    packet->SetPointerData(i, ToPointerData(current));
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
@@ -1593,6 +1651,22 @@ static inline flutter::KeyEventType MapKeyEventType(
   return flutter::KeyEventType::kUp;
 }
 
+static std::unique_ptr<flutter::KeyDataPacket> ToKeyDataPacket(
+    const FlutterKeyEvent* event) {
+  const char* character = SAFE_ACCESS(event, character, nullptr);
+
+  flutter::KeyData key_data;
+  key_data.Clear();
+  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
+  key_data.type = MapKeyEventType(
+      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
+  key_data.physical = SAFE_ACCESS(event, physical, 0);
+  key_data.logical = SAFE_ACCESS(event, logical, 0);
+  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
+
+  return std::make_unique<flutter::KeyDataPacket>(key_data, character);
+}
+
 FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                                   engine,
                                               const FlutterKeyEvent* event,
@@ -1606,18 +1680,7 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
   }
 
-  const char* character = SAFE_ACCESS(event, character, nullptr);
-
-  flutter::KeyData key_data;
-  key_data.Clear();
-  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
-  key_data.type = MapKeyEventType(
-      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
-  key_data.physical = SAFE_ACCESS(event, physical, 0);
-  key_data.logical = SAFE_ACCESS(event, logical, 0);
-  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
-
-  auto packet = std::make_unique<flutter::KeyDataPacket>(key_data, character);
+  auto packet = ToKeyDataPacket(event);
 
   auto response = [callback, user_data](bool handled) {
     if (callback != nullptr) {
@@ -1633,9 +1696,109 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "running Flutter application.");
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+FlutterEngineResult FlutterEngineSendInputEvents(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterInputEvent* events,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (events == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid input events.");
+  }
+
+  flutter::InputEventBatch batch;
+  const FlutterInputEvent* current = events;
+  for (size_t i = 0; i < events_count; ++i) {
+    switch (SAFE_ACCESS(current, type, kFlutterInputEventTypePointer)) {
+      case kFlutterInputEventTypePointer: {
+        const FlutterPointerEvent* pointer_event =
+            SAFE_ACCESS(current, pointer_event, nullptr);
+        if (pointer_event == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Pointer input event was missing its "
+                                    "pointer event.");
+        }
+        batch.AddPointerData(ToPointerData(pointer_event));
+        break;
+      }
+      case kFlutterInputEventTypeKey: {
+        const FlutterKeyEvent* key_event =
+            SAFE_ACCESS(current, key_event, nullptr);
+        if (key_event == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Key input event was missing its key "
+                                    "event.");
+        }
+        FlutterKeyEventCallback callback =
+            SAFE_ACCESS(current, key_callback, nullptr);
+        void* user_data = SAFE_ACCESS(current, key_callback_user_data, nullptr);
+        batch.AddKeyDataPacket(ToKeyDataPacket(key_event),
+                               [callback, user_data](bool handled) {
+                                 if (callback != nullptr) {
+                                   callback(handled, user_data);
+                                 }
+                               });
+        break;
+      }
+      default:
+        return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "Unknown input event type.");
+    }
+    current = reinterpret_cast<const FlutterInputEvent*>(
+        reinterpret_cast<const uint8_t*>(current) + current->struct_size);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->DispatchInputEventBatch(std::move(batch))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not dispatch input events to the "
+                                  "running Flutter application.");
+}
+
+// Wraps the payload of a message sent via
+// |FlutterEngineSendPlatformMessageNoCopy| so that the release callback is
+// invoked when the engine (or the Dart object adopting it) is done with it.
+static fml::MallocMapping AdoptPlatformMessageData(
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  // A non-null sentinel so the release callback runs for empty payloads too.
+  static uint8_t empty_payload;
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  if (flutter_message != nullptr) {
+    data = const_cast<uint8_t*>(SAFE_ACCESS(flutter_message, message, nullptr));
+    size = SAFE_ACCESS(flutter_message, message_size, 0);
+  }
+  if (data == nullptr) {
+    data = &empty_payload;
+    size = 0;
+  }
+  return fml::MallocMapping(
+      data, size, [release_callback, release_user_data](uint8_t*, size_t) {
+        release_callback(release_user_data);
+      });
+}
+
+// Shared implementation of |FlutterEngineSendPlatformMessage| and
+// |FlutterEngineSendPlatformMessageNoCopy|. If a release callback is given,
+// the payload is adopted instead of copied and the callback is invoked once
+// the engine is done with it, including on failure.
+static FlutterEngineResult InternalSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  // Releases the adopted payload on any of the early returns below.
+  fml::MallocMapping adopted_data =
+      release_callback != nullptr
+          ? AdoptPlatformMessageData(flutter_message, release_callback,
+                                     release_user_data)
+          : fml::MallocMapping();
+
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -1670,6 +1833,9 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   if (message_size == 0) {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel, response);
+  } else if (release_callback != nullptr) {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel, std::move(adopted_data), response);
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
@@ -1684,6 +1850,28 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return InternalSendPlatformMessage(engine, flutter_message, nullptr, nullptr);
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  if (release_callback == nullptr &&
+      (flutter_message == nullptr ||
+       SAFE_ACCESS(flutter_message, message_size, 0) != 0)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "A release callback must be specified for a message with a payload.");
+  }
+  return InternalSendPlatformMessage(engine, flutter_message, release_callback,
+                                     release_user_data);
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -2209,6 +2397,87 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    "Could not dispatch the low memory notification message.");
 }
 
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterMemoryPressureLevel level) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  switch (level) {
+    case kFlutterMemoryPressureLevelModerate:
+      engine->GetShell().NotifyMemoryPressure(
+          fml::MemoryPressureLevel::kModerate);
+      return kSuccess;
+    case kFlutterMemoryPressureLevelCritical:
+      return FlutterEngineNotifyLowMemoryWarning(raw_engine);
+  }
+
+  return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                            "Invalid memory pressure level specified.");
+}
+
+static FlutterFrameTimingPercentiles ToEmbedderPercentiles(
+    const flutter::FrameTimingStatistics::Percentiles& percentiles) {
+  FlutterFrameTimingPercentiles embedder_percentiles = {};
+  embedder_percentiles.p50_nanos = percentiles.p50.ToNanoseconds();
+  embedder_percentiles.p90_nanos = percentiles.p90.ToNanoseconds();
+  embedder_percentiles.p99_nanos = percentiles.p99.ToNanoseconds();
+  return embedder_percentiles;
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterFrameTimingStatistics* statistics) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (statistics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Frame timing statistics were null.");
+  }
+
+  const auto summary = engine->GetShell().SummarizeFrameTimings();
+  auto annotated_frame_count =
+      [&summary](flutter::FrameTiming::Annotation annotation) {
+        for (size_t i = 0; i < std::size(flutter::FrameTiming::kAnnotations);
+             i++) {
+          if (flutter::FrameTiming::kAnnotations[i] == annotation) {
+            return summary.annotated_frame_counts[i];
+          }
+        }
+        return static_cast<size_t>(0);
+      };
+
+  FlutterFrameTimingStatistics embedder_statistics = {};
+  embedder_statistics.struct_size = sizeof(FlutterFrameTimingStatistics);
+  embedder_statistics.frame_count = summary.frame_count;
+  embedder_statistics.vsync_latency =
+      ToEmbedderPercentiles(summary.vsync_latency);
+  embedder_statistics.build = ToEmbedderPercentiles(summary.build);
+  embedder_statistics.raster = ToEmbedderPercentiles(summary.raster);
+  embedder_statistics.shader_compilation_frame_count =
+      annotated_frame_count(flutter::FrameTiming::kShaderCompilation);
+  embedder_statistics.raster_cache_miss_frame_count =
+      annotated_frame_count(flutter::FrameTiming::kRasterCacheMiss);
+  embedder_statistics.thread_merge_frame_count =
+      annotated_frame_count(flutter::FrameTiming::kThreadMerge);
+  embedder_statistics.image_upload_frame_count =
+      annotated_frame_count(flutter::FrameTiming::kImageUpload);
+  embedder_statistics.slow_frame_count = summary.slow_frames.size();
+
+  // Only the members known to the embedder are copied, so that embedders built
+  // against older versions of this struct keep working.
+  const size_t struct_size =
+      std::min(statistics->struct_size, sizeof(embedder_statistics));
+  memcpy(statistics, &embedder_statistics, struct_size);
+  statistics->struct_size = struct_size;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -2338,6 +2607,10 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(SendPlatformMessageNoCopy, FlutterEngineSendPlatformMessageNoCopy);
+  SET_PROC(SendInputEvents, FlutterEngineSendInputEvents);
+  SET_PROC(NotifyMemoryPressure, FlutterEngineNotifyMemoryPressure);
+  SET_PROC(GetFrameTimingStatistics, FlutterEngineGetFrameTimingStatistics);
 #undef SET_PROC
 
   return kSuccess;
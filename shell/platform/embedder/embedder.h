@@ -748,6 +748,27 @@ typedef struct {
 typedef void (*FlutterKeyEventCallback)(bool /* handled */,
                                         void* /* user_data */);
 
+typedef enum {
+  kFlutterInputEventTypePointer = 1,
+  kFlutterInputEventTypeKey,
+} FlutterInputEventType;
+
+/// One event of a batch sent with `FlutterEngineSendInputEvents`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterInputEvent).
+  size_t struct_size;
+  FlutterInputEventType type;
+  /// The pointer event. Used if `type` is `kFlutterInputEventTypePointer`.
+  const FlutterPointerEvent* pointer_event;
+  /// The key event. Used if `type` is `kFlutterInputEventTypeKey`.
+  const FlutterKeyEvent* key_event;
+  /// Invoked once the Flutter application has decided whether it handles
+  /// the key event. Accepts nullptr. Only used for key events.
+  FlutterKeyEventCallback key_callback;
+  /// The context passed to `key_callback`.
+  void* key_callback_user_data;
+} FlutterInputEvent;
+
 struct _FlutterPlatformMessageResponseHandle;
 typedef struct _FlutterPlatformMessageResponseHandle
     FlutterPlatformMessageResponseHandle;
@@ -780,6 +801,29 @@ typedef void (*FlutterDataCallback)(const uint8_t* /* data */,
 /// `SceneBuilder.addPlatformView` call.
 typedef int64_t FlutterPlatformViewIdentifier;
 
+/// The groups of `FlutterSemanticsNode` fields that changed since the node was
+/// last delivered through `FlutterUpdateSemanticsNodeCallback`.
+typedef enum {
+  kFlutterSemanticsNodeChangeFlags = 1 << 0,
+  kFlutterSemanticsNodeChangeActions = 1 << 1,
+  kFlutterSemanticsNodeChangeRect = 1 << 2,
+  kFlutterSemanticsNodeChangeTransform = 1 << 3,
+  kFlutterSemanticsNodeChangeLabel = 1 << 4,
+  /// The value, increased value or decreased value changed.
+  kFlutterSemanticsNodeChangeValue = 1 << 5,
+  kFlutterSemanticsNodeChangeHint = 1 << 6,
+  kFlutterSemanticsNodeChangeTooltip = 1 << 7,
+  kFlutterSemanticsNodeChangeTextSelection = 1 << 8,
+  /// The scroll child count, scroll index, position or extents changed.
+  kFlutterSemanticsNodeChangeScroll = 1 << 9,
+  /// The children in traversal or hit test order changed.
+  kFlutterSemanticsNodeChangeChildren = 1 << 10,
+  kFlutterSemanticsNodeChangeCustomActions = 1 << 11,
+  /// Any other field, such as the elevation, the thickness, the text direction
+  /// or the platform view identifier, changed.
+  kFlutterSemanticsNodeChangeOther = 1 << 12,
+} FlutterSemanticsNodeChange;
+
 /// `FlutterSemanticsNode` ID used as a sentinel to signal the end of a batch of
 /// semantics node updates.
 FLUTTER_EXPORT
@@ -854,6 +898,13 @@ typedef struct {
   /// Identifier of the platform view associated with this semantics node, or
   /// -1 if none.
   FlutterPlatformViewIdentifier platform_view_id;
+  /// The set of `FlutterSemanticsNodeChange` bits describing which fields
+  /// differ from the last time this node was delivered. The engine does not
+  /// deliver nodes that did not change at all. Nodes that are delivered for
+  /// the first time (or for the first time after semantics were re-enabled)
+  /// have every bit set, as do all nodes when the engine runs with
+  /// `--disable-semantics-update-diffing`.
+  int32_t changes;
 } FlutterSemanticsNode;
 
 /// `FlutterSemanticsCustomAction` ID used as a sentinel to signal the end of a
@@ -1060,7 +1111,10 @@ typedef struct {
   /// Specifies the type of backing store.
   FlutterBackingStoreType type;
   /// Indicates if this backing store was updated since the last time it was
-  /// associated with a presented layer.
+  /// associated with a presented layer. When
+  /// `FlutterCompositor.reuse_unchanged_backing_stores` is set, the engine does
+  /// not render into a cached backing store whose contents did not change, and
+  /// the embedder may skip compositing it again as well.
   bool did_update;
   union {
     /// The description of the OpenGL backing store.
@@ -1145,6 +1199,19 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// Keep the backing stores provided by this compositor across frames, and
+  /// present the backing stores of layers whose contents did not change
+  /// without rendering into them again, with `FlutterBackingStore.did_update`
+  /// set to false. The embedder must preserve the contents of such backing
+  /// stores between frames. Ignored if `avoid_backing_store_cache` is set.
+  bool reuse_unchanged_backing_stores;
+  /// The maximum size in bytes of the backing stores that are kept for reuse
+  /// while no layer of the current frame uses them. Zero selects a default
+  /// that holds a few full screen backing stores. Only used if
+  /// `reuse_unchanged_backing_stores` is set. These backing stores are
+  /// collected at the start of the next frame after a memory pressure
+  /// notification.
+  size_t max_unused_backing_store_bytes;
 } FlutterCompositor;
 
 typedef struct {
@@ -1345,6 +1412,44 @@ typedef void (*FlutterLogMessageCallback)(const char* /* tag */,
 /// FlutterEngine instance in AOT mode.
 typedef struct _FlutterEngineAOTData* FlutterEngineAOTData;
 
+typedef enum {
+  /// Keep the scheduling policy the thread was created with.
+  kFlutterThreadSchedulerDefault,
+  /// SCHED_OTHER, the default time-sharing policy.
+  kFlutterThreadSchedulerOther,
+  /// SCHED_BATCH, for CPU-bound work.
+  kFlutterThreadSchedulerBatch,
+  /// SCHED_IDLE, for work that only runs when the CPU is otherwise idle.
+  kFlutterThreadSchedulerIdle,
+  /// SCHED_FIFO, a real-time policy.
+  kFlutterThreadSchedulerFifo,
+  /// SCHED_RR, a real-time policy.
+  kFlutterThreadSchedulerRoundRobin,
+} FlutterThreadScheduler;
+
+/// The scheduling parameters of an engine managed thread. Thread policies are
+/// currently only applied on Linux and Android. Parameters that cannot be
+/// applied, usually for lack of privileges, are logged and skipped.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterThreadPolicy).
+  size_t struct_size;
+  /// The scheduling policy of the thread.
+  FlutterThreadScheduler scheduler;
+  /// The static priority used by the real-time schedulers. Ignored by the
+  /// other schedulers.
+  int32_t realtime_priority;
+  /// Whether `nice_value` is applied to the thread.
+  bool set_nice_value;
+  /// The nice value of the thread, between -20 and 19.
+  int32_t nice_value;
+  /// The indices of the CPUs the thread may run on. May be null if
+  /// `cpu_affinity_count` is zero, in which case the affinity of the thread is
+  /// left untouched.
+  const size_t* cpu_affinity;
+  /// The number of entries in `cpu_affinity`.
+  size_t cpu_affinity_count;
+} FlutterThreadPolicy;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterProjectArgs).
   size_t struct_size;
@@ -1589,6 +1694,19 @@ typedef struct {
   //
   // The first argument is the `user_data` from `FlutterEngineInitialize`.
   OnPreEngineRestartCallback on_pre_engine_restart_callback;
+
+  /// The scheduling policies of the engine managed UI, raster and IO threads.
+  /// Threads backed by custom task runners are managed by the embedder and
+  /// are not affected. May be null, in which case the policies given on the
+  /// command line (for example `--raster-thread-policy=nice=-4:cpus=4-7`) or
+  /// the default scheduling are used.
+  const FlutterThreadPolicy* ui_thread_policy;
+  const FlutterThreadPolicy* raster_thread_policy;
+  const FlutterThreadPolicy* io_thread_policy;
+  /// The scheduling policy of the worker threads used for image decoding and
+  /// other background work. These threads are shared by all the engines of a
+  /// process and only the policy given to the first engine to start is used.
+  const FlutterThreadPolicy* worker_thread_policy;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -1771,11 +1889,65 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                               FlutterKeyEventCallback callback,
                                               void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of pointer and key events to the engine. The
+///             events are delivered to the Flutter application in order, and
+///             the whole batch is handed to the UI thread at once. This is
+///             cheaper than calling `FlutterEngineSendPointerEvent` and
+///             `FlutterEngineSendKeyEvent` for each event, e.g. when an
+///             embedder drains several queued input events at a time.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The events to send. This function will no longer
+///                           access `events`, or the events they point to,
+///                           after returning.
+/// @param[in]  events_count  The number of events in `events`.
+///
+/// @return     The result of the call. If the call fails, no event of the
+///             batch is sent and no key callback is invoked.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendInputEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterInputEvent* events,
+    size_t events_count);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the running Flutter application
+///             without copying its payload. Ownership of the message buffer
+///             is transferred to the engine, which hands it to the Dart
+///             application as external typed data. This avoids copying large
+///             payloads (camera frames, tensors, etc.) on their way into Dart.
+///
+/// @attention  The buffer must stay valid and must not be modified by the
+///             embedder until `release_callback` is invoked. Since the Dart
+///             application receives a mutable `ByteData` view of the buffer,
+///             it must be backed by writable memory.
+///
+/// @param[in]  engine             A running engine instance.
+/// @param[in]  message            The message to send. The `message` field
+///                                points to the buffer being transferred.
+/// @param[in]  release_callback   Called exactly once, on an unspecified
+///                                thread, when the engine no longer needs the
+///                                buffer. This also happens if the call fails.
+///                                May be nullptr only if the message has no
+///                                payload.
+/// @param[in]  release_user_data  The baton passed to `release_callback`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* release_user_data);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -2195,6 +2367,84 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+typedef enum {
+  /// Memory is getting scarce. The engine trims its caches of entries that are
+  /// not in active use.
+  kFlutterMemoryPressureLevelModerate,
+  /// The process is at risk of being killed. Equivalent to
+  /// `FlutterEngineNotifyLowMemoryWarning`.
+  kFlutterMemoryPressureLevelCritical,
+} FlutterMemoryPressureLevel;
+
+//------------------------------------------------------------------------------
+/// @brief      Posts a graded memory pressure notification to a running engine
+///             instance. The caches of every engine instance in the process
+///             are trimmed according to the level, on the threads that own
+///             them. Only critical notifications are forwarded to the Flutter
+///             application, as by `FlutterEngineNotifyLowMemoryWarning`.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  level      The severity of the memory pressure.
+///
+/// @return     If the memory pressure notification was sent to the running
+///             engine instance.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+
+typedef struct {
+  /// The median duration, in nanoseconds.
+  uint64_t p50_nanos;
+  /// The 90th percentile duration, in nanoseconds.
+  uint64_t p90_nanos;
+  /// The 99th percentile duration, in nanoseconds.
+  uint64_t p99_nanos;
+} FlutterFrameTimingPercentiles;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStatistics).
+  size_t struct_size;
+  /// The number of recently rasterized frames that were summarized.
+  size_t frame_count;
+  /// The time from the vsync signal to the start of the frame build.
+  FlutterFrameTimingPercentiles vsync_latency;
+  /// The time taken to build the frames on the UI thread.
+  FlutterFrameTimingPercentiles build;
+  /// The time taken to rasterize the frames on the raster thread.
+  FlutterFrameTimingPercentiles raster;
+  /// The number of frames whose rasterization compiled new shaders.
+  size_t shader_compilation_frame_count;
+  /// The number of frames that had to rasterize entries into the raster cache.
+  size_t raster_cache_miss_frame_count;
+  /// The number of frames rasterized while the platform and raster threads
+  /// were being merged or unmerged.
+  size_t thread_merge_frame_count;
+  /// The number of frames that uploaded images to the GPU.
+  size_t image_upload_frame_count;
+  /// The number of frames whose build or raster time exceeded the frame budget
+  /// of the main display.
+  size_t slow_frame_count;
+} FlutterFrameTimingStatistics;
+
+//------------------------------------------------------------------------------
+/// @brief      Summarizes the timings of the frames most recently rasterized
+///             by a running engine instance. The same summary, along with the
+///             individual slow frames, is available to tools through the
+///             `_flutter.getFrameTimingStatistics` service protocol extension.
+///             This may be called from any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The summary to fill. Its struct_size must be set.
+///
+/// @return     The result of the call to get the statistics.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -2367,6 +2617,21 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* release_user_data);
+typedef FlutterEngineResult (*FlutterEngineSendInputEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterInputEvent* events,
+    size_t events_count);
+typedef FlutterEngineResult (*FlutterEngineNotifyMemoryPressureFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2411,6 +2676,10 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineSendPlatformMessageNoCopyFnPtr SendPlatformMessageNoCopy;
+  FlutterEngineSendInputEventsFnPtr SendInputEvents;
+  FlutterEngineNotifyMemoryPressureFnPtr NotifyMemoryPressure;
+  FlutterEngineGetFrameTimingStatisticsFnPtr GetFrameTimingStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -143,6 +143,20 @@ bool EmbedderEngine::DispatchKeyDataPacket(
   return true;
 }
 
+bool EmbedderEngine::DispatchInputEventBatch(flutter::InputEventBatch batch) {
+  if (!IsValid() || batch.IsEmpty()) {
+    return false;
+  }
+
+  auto platform_view = shell_->GetPlatformView();
+  if (!platform_view) {
+    return false;
+  }
+
+  platform_view->DispatchInputEventBatch(std::move(batch));
+  return true;
+}
+
 bool EmbedderEngine::SendPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   if (!IsValid() || !message) {
@@ -68,6 +68,8 @@ class EmbedderEngine {
   bool DispatchKeyDataPacket(std::unique_ptr<flutter::KeyDataPacket> packet,
                              KeyDataResponse callback);
 
+  bool DispatchInputEventBatch(flutter::InputEventBatch batch);
+
   bool SendPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
   bool RegisterTexture(int64_t texture);
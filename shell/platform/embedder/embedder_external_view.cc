@@ -3,8 +3,12 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
+
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/canvas_spy.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkTypeface.h"
 
 namespace flutter {
 
@@ -71,6 +75,71 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
+sk_sp<SkPicture> EmbedderExternalView::FinishRecording() {
+  if (recorder_->getRecordingCanvas()) {
+    picture_ = recorder_->finishRecordingAsPicture();
+  }
+  return picture_;
+}
+
+EmbedderExternalView::Contents::Contents(sk_sp<SkPicture> picture,
+                                         const SkMatrix& transformation)
+    : picture_(std::move(picture)),
+      transformation_(transformation),
+      cull_rect_(picture_->cullRect()),
+      approximate_op_count_(picture_->approximateOpCount()),
+      approximate_bytes_used_(picture_->approximateBytesUsed()) {}
+
+EmbedderExternalView::Contents::~Contents() = default;
+
+bool EmbedderExternalView::Contents::Equals(const Contents& other) const {
+  if (transformation_ != other.transformation_ ||
+      cull_rect_ != other.cull_rect_ ||
+      approximate_op_count_ != other.approximate_op_count_ ||
+      approximate_bytes_used_ != other.approximate_bytes_used_) {
+    return false;
+  }
+  if (picture_ == other.picture_) {
+    return true;
+  }
+  const auto& serialized_picture = GetSerializedPicture();
+  const auto& other_serialized_picture = other.GetSerializedPicture();
+  return serialized_picture && other_serialized_picture &&
+         serialized_picture->equals(other_serialized_picture.get());
+}
+
+static sk_sp<SkData> SerializeUniqueID(uint32_t unique_id) {
+  return SkData::MakeWithCopy(&unique_id, sizeof(unique_id));
+}
+
+const sk_sp<SkData>& EmbedderExternalView::Contents::GetSerializedPicture()
+    const {
+  if (!serialized_picture_) {
+    TRACE_EVENT0("flutter", "EmbedderExternalView::Contents::Serialize");
+    // Images and typefaces are immutable, so their IDs stand in for their
+    // contents. Encoding them would cost more than rendering the view.
+    SkSerialProcs procs;
+    procs.fImageProc = [](SkImage* image, void* ctx) {
+      return SerializeUniqueID(image->uniqueID());
+    };
+    procs.fTypefaceProc = [](SkTypeface* typeface, void* ctx) {
+      return SerializeUniqueID(typeface->uniqueID());
+    };
+    serialized_picture_ = picture_->serialize(&procs);
+  }
+  return serialized_picture_;
+}
+
+std::unique_ptr<EmbedderExternalView::Contents>
+EmbedderExternalView::GetContents() {
+  auto picture = FinishRecording();
+  if (!picture) {
+    return nullptr;
+  }
+  return std::make_unique<Contents>(std::move(picture),
+                                    surface_transformation_);
+}
+
 bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
 
@@ -78,7 +147,7 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
+  auto picture = FinishRecording();
   if (!picture) {
     return false;
   }
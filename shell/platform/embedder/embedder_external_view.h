@@ -14,6 +14,8 @@
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/canvas_spy.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
@@ -108,6 +110,49 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The contents recorded into a view along with the
+  ///             transformation they are rendered with. A render target that
+  ///             holds the contents of one view does not need to be rendered
+  ///             into again for another view with equal contents.
+  ///
+  class Contents {
+   public:
+    Contents(sk_sp<SkPicture> picture, const SkMatrix& transformation);
+
+    ~Contents();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Whether the contents render the same pixels. The
+    ///             transformations and the bounds, op counts and sizes of the
+    ///             recordings are compared first. Only contents that match in
+    ///             all of these, which are most likely unchanged, have their
+    ///             recordings serialized and compared. The serialization is
+    ///             kept for later comparisons. Images and typefaces are
+    ///             identified by their unique IDs rather than encoded.
+    ///
+    bool Equals(const Contents& other) const;
+
+   private:
+    const sk_sp<SkPicture> picture_;
+    const SkMatrix transformation_;
+    const SkRect cull_rect_;
+    const int approximate_op_count_;
+    const size_t approximate_bytes_used_;
+    mutable sk_sp<SkData> serialized_picture_;
+
+    const sk_sp<SkData>& GetSerializedPicture() const;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Contents);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finishes the recording of this view and returns its contents.
+  ///
+  /// @return     The contents, or null if nothing could be recorded.
+  ///
+  std::unique_ptr<Contents> GetContents();
+
   bool Render(const EmbedderRenderTarget& render_target);
 
  private:
@@ -117,6 +162,9 @@ class EmbedderExternalView {
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
   std::unique_ptr<SkPictureRecorder> recorder_;
   std::unique_ptr<CanvasSpy> canvas_spy_;
+  sk_sp<SkPicture> picture_;
+
+  sk_sp<SkPicture> FinishRecording();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
@@ -12,15 +12,43 @@
 
 namespace flutter {
 
+// Without reuse, render targets are only kept for the views of the next
+// frame, and no render target is kept while unused.
+static size_t GetMaxUnusedRenderTargetBytes(
+    bool reuse_unchanged_backing_stores,
+    size_t max_unused_backing_store_bytes) {
+  if (!reuse_unchanged_backing_stores) {
+    return 0;
+  }
+  return max_unused_backing_store_bytes > 0
+             ? max_unused_backing_store_bytes
+             : EmbedderRenderTargetCache::kDefaultMaxUnusedBytes;
+}
+
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    bool reuse_unchanged_backing_stores,
+    size_t max_unused_backing_store_bytes,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      reuse_unchanged_backing_stores_(reuse_unchanged_backing_stores &&
+                                      !avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(
+          GetMaxUnusedRenderTargetBytes(reuse_unchanged_backing_stores_,
+                                        max_unused_backing_store_bytes)) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
+  if (reuse_unchanged_backing_stores_) {
+    render_target_cache_registration_ =
+        fml::MemoryPressureManager::GetInstance().Register(
+            "EmbedderRenderTargetCache", nullptr,
+            [this](fml::MemoryPressureLevel level) {
+              unused_render_targets_trim_requested_ = true;
+            });
+  }
 }
 
 EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() = default;
@@ -136,14 +164,29 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
 void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame) {
-  auto [matched_render_targets, pending_keys] =
-      render_target_cache_.GetExistingTargetsInCache(pending_views_);
+  // The contents of the views are compared with the contents of the render
+  // targets they were presented with before, so that unchanged views are not
+  // rendered again.
+  EmbedderRenderTargetCache::ViewContents view_contents;
+  if (reuse_unchanged_backing_stores_) {
+    for (const auto& view : pending_views_) {
+      if (view.second->HasEngineRenderedContents()) {
+        view_contents[view.first] = view.second->GetContents();
+      }
+    }
+  }
+
+  auto existing_targets =
+      render_target_cache_.GetExistingTargetsInCache(pending_views_,
+                                                     view_contents);
+  auto& matched_render_targets = existing_targets.render_targets;
+  const auto& pending_keys = existing_targets.pending_views;
 
   // This is where unused render targets will be collected. Control may flow to
   // the embedder. Here, the embedder has the opportunity to trample on the
   // OpenGL context.
   //
-  // For optimum performance, we should tell the render target cache to clear
+  // For optimum performance, we should tell the render target cache to evict
   // its unused entries before allocating new ones. This collection step before
   // allocating new render targets ameliorates peak memory usage within the
   // frame. But, this causes an issue in a known internal embedder. To work
@@ -152,7 +195,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      unused_render_targets_trim_requested_.exchange(false)
+          ? render_target_cache_.EvictUnusedRenderTargets()
+          : render_target_cache_.EvictRenderTargetsOverBudget();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -202,6 +247,13 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // Scribble embedder provide render targets. The order in which we scribble
   // into the buffers is irrelevant to the presentation order.
   for (const auto& render_target : matched_render_targets) {
+    // The render target still holds the contents of an unchanged view. The
+    // embedder is told so that it may skip compositing it as well.
+    if (existing_targets.unchanged_views.count(render_target.first) != 0) {
+      render_target.second->SetDidUpdate(false);
+      continue;
+    }
+    render_target.second->SetDidUpdate(true);
     if (!pending_views_.at(render_target.first)
              ->Render(*render_target.second)) {
       FML_LOG(ERROR)
@@ -261,14 +313,20 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
+  // Hold all rendered layers in the render target cache along with their
+  // contents to see if they may be reused in later frames.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
-      render_target_cache_.CacheRenderTarget(render_target.first,
-                                             std::move(render_target.second));
+      render_target_cache_.CacheRenderTarget(
+          render_target.first, std::move(view_contents[render_target.first]),
+          std::move(render_target.second));
     }
   }
+  if (render_target_cache_registration_) {
+    render_target_cache_registration_->SetUsage(
+        render_target_cache_.GetCachedTargetsBytes(),
+        render_target_cache_.GetCachedTargetsCount());
+  }
 
   frame->Submit();
 }
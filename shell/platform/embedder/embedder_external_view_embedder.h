@@ -5,12 +5,14 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 
+#include <atomic>
 #include <map>
 #include <unordered_map>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_pressure_manager.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
@@ -44,6 +46,18 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
+  /// @param[in]  reuse_unchanged_backing_stores
+  ///                                     If set, render targets are kept
+  ///                                     across frames, and the render targets
+  ///                                     of views whose contents did not
+  ///                                     change are presented without
+  ///                                     rendering into them again. Ignored if
+  ///                                     avoid_backing_store_cache is set.
+  /// @param[in]  max_unused_backing_store_bytes
+  ///                                     The budget for render targets kept
+  ///                                     for reuse that no view of the
+  ///                                     current frame uses, or zero for the
+  ///                                     default budget.
   ///
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
@@ -55,6 +69,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      bool reuse_unchanged_backing_stores,
+      size_t max_unused_backing_store_bytes,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -105,6 +121,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
  private:
   const bool avoid_backing_store_cache_;
+  const bool reuse_unchanged_backing_stores_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -114,6 +131,12 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  // Set on any thread by memory pressure notifications. The unused render
+  // targets are released on the raster thread when the next frame is
+  // submitted, where the embedder expects to collect render targets.
+  std::atomic_bool unused_render_targets_trim_requested_ = false;
+  std::unique_ptr<fml::MemoryPressureManager::Registration>
+      render_target_cache_registration_;
 
   void Reset();
 
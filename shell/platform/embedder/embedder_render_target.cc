@@ -14,8 +14,6 @@ EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
     : backing_store_(backing_store),
       render_surface_(std::move(render_surface)),
       on_release_(on_release) {
-  // TODO(38468): The optimization to elide backing store updates between frames
-  // has not been implemented yet.
   backing_store_.did_update = true;
   FML_DCHECK(render_surface_);
 }
@@ -30,6 +28,10 @@ const FlutterBackingStore* EmbedderRenderTarget::GetBackingStore() const {
   return &backing_store_;
 }
 
+void EmbedderRenderTarget::SetDidUpdate(bool did_update) {
+  backing_store_.did_update = did_update;
+}
+
 sk_sp<SkSurface> EmbedderRenderTarget::GetRenderSurface() const {
   return render_surface_;
 }
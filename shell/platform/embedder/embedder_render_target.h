@@ -65,6 +65,15 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the contents of the backing store were updated
+  ///             since it was last presented. The embedder may skip
+  ///             compositing a backing store that was not updated.
+  ///
+  /// @param[in]  did_update  Whether the backing store was rendered into.
+  ///
+  void SetDidUpdate(bool did_update);
+
  private:
   FlutterBackingStore backing_store_;
   sk_sp<SkSurface> render_surface_;
@@ -4,70 +4,124 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+static SkISize GetRenderTargetSize(const EmbedderRenderTarget& target) {
+  auto surface = target.GetRenderSurface();
+  return SkISize::Make(surface->width(), surface->height());
+}
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_unused_bytes)
+    : max_unused_bytes_(max_unused_bytes) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
-std::pair<EmbedderRenderTargetCache::RenderTargets,
-          EmbedderExternalView::ViewIdentifierSet>
+EmbedderRenderTargetCache::ExistingTargets
 EmbedderRenderTargetCache::GetExistingTargetsInCache(
-    const EmbedderExternalView::PendingViews& pending_views) {
-  RenderTargets resolved_render_targets;
-  EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
+    const EmbedderExternalView::PendingViews& pending_views,
+    const ViewContents& view_contents) {
+  ExistingTargets existing_targets;
 
+  // The views are first matched with the render targets they were last
+  // rendered into, so that one view does not take the render target holding
+  // the unchanged contents of another.
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.size() == 0) {
-      unmatched_identifiers.insert(view.first);
-    } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+    const auto surface_size = external_view->GetRenderSurfaceSize();
+    auto found = std::find_if(
+        cached_render_targets_.begin(), cached_render_targets_.end(),
+        [&](const CachedRenderTarget& cached) {
+          return EmbedderExternalView::ViewIdentifier::Equal{}(
+                     cached.view_identifier, view.first) &&
+                 GetRenderTargetSize(*cached.target) == surface_size;
+        });
+    if (found == cached_render_targets_.end()) {
+      existing_targets.pending_views.insert(view.first);
+      continue;
+    }
+    auto contents = view_contents.find(view.first);
+    if (found->contents && contents != view_contents.end() &&
+        contents->second && found->contents->Equals(*contents->second)) {
+      existing_targets.unchanged_views.insert(view.first);
     }
+    existing_targets.render_targets[view.first] = std::move(found->target);
+    cached_render_targets_.erase(found);
   }
-  return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
+
+  // The remaining views take any render target of the right size, starting
+  // with the most recently used.
+  for (auto it = existing_targets.pending_views.begin();
+       it != existing_targets.pending_views.end();) {
+    const auto surface_size = pending_views.at(*it)->GetRenderSurfaceSize();
+    auto found = std::find_if(cached_render_targets_.begin(),
+                              cached_render_targets_.end(),
+                              [&](const CachedRenderTarget& cached) {
+                                return GetRenderTargetSize(*cached.target) ==
+                                       surface_size;
+                              });
+    if (found == cached_render_targets_.end()) {
+      ++it;
+      continue;
+    }
+    existing_targets.render_targets[*it] = std::move(found->target);
+    cached_render_targets_.erase(found);
+    it = existing_targets.pending_views.erase(it);
+  }
+
+  return existing_targets;
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
-EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
-  std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
-    }
+EmbedderRenderTargetCache::EvictRenderTargetsOverBudget() {
+  return EvictRenderTargetsToByteSize(max_unused_bytes_);
+}
+
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::EvictUnusedRenderTargets() {
+  return EvictRenderTargetsToByteSize(0);
+}
+
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::EvictRenderTargetsToByteSize(size_t max_bytes) {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> evicted_targets;
+  size_t cached_bytes = GetCachedTargetsBytes();
+  while (cached_bytes > max_bytes) {
+    auto& least_recently_used = cached_render_targets_.back();
+    cached_bytes -= least_recently_used.bytes;
+    evicted_targets.emplace(std::move(least_recently_used.target));
+    cached_render_targets_.pop_back();
   }
-  cached_render_targets_.clear();
-  return cleared_targets;
+  return evicted_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
     EmbedderExternalView::ViewIdentifier view_identifier,
+    std::unique_ptr<EmbedderExternalView::Contents> contents,
     std::unique_ptr<EmbedderRenderTarget> target) {
   if (target == nullptr) {
     return;
   }
-  auto surface = target->GetRenderSurface();
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+  const size_t bytes =
+      target->GetRenderSurface()->imageInfo().computeMinByteSize();
+  cached_render_targets_.push_front(
+      {view_identifier, std::move(contents), bytes, std::move(target)});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
-  size_t count = 0;
-  for (const auto& targets : cached_render_targets_) {
-    count += targets.second.size();
+  return cached_render_targets_.size();
+}
+
+size_t EmbedderRenderTargetCache::GetCachedTargetsBytes() const {
+  size_t bytes = 0;
+  for (const auto& cached : cached_render_targets_) {
+    bytes += cached.bytes;
   }
-  return count;
+  return bytes;
 }
 
 }  // namespace flutter
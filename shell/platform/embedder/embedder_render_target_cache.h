@@ -5,9 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <list>
 #include <set>
-#include <stack>
-#include <tuple>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -19,9 +18,23 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are kept across frames. A view is given back the
+///             render target it was last rendered into if there is one of the
+///             right size, as it may still hold the contents of the view, and
+///             any other cached render target of the right size otherwise.
+///             Render targets that are not used by a frame stay in the cache,
+///             least recently used first out, while they fit in its budget.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// The default budget for render targets that are cached but not used by
+  /// the current frame when they are reused across frames. This holds a few
+  /// full screen render targets. A budget of zero keeps render targets for the
+  /// next frame only.
+  static constexpr size_t kDefaultMaxUnusedBytes = 64 * 1024 * 1024;
+
+  explicit EmbedderRenderTargetCache(
+      size_t max_unused_bytes = kDefaultMaxUnusedBytes);
 
   ~EmbedderRenderTargetCache();
 
@@ -31,26 +44,90 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::ViewIdentifier::Hash,
                          EmbedderExternalView::ViewIdentifier::Equal>;
 
-  std::pair<RenderTargets, EmbedderExternalView::ViewIdentifierSet>
-  GetExistingTargetsInCache(
-      const EmbedderExternalView::PendingViews& pending_views);
+  using ViewContents =
+      std::unordered_map<EmbedderExternalView::ViewIdentifier,
+                         std::unique_ptr<EmbedderExternalView::Contents>,
+                         EmbedderExternalView::ViewIdentifier::Hash,
+                         EmbedderExternalView::ViewIdentifier::Equal>;
 
+  struct ExistingTargets {
+    /// The render targets found in the cache.
+    RenderTargets render_targets;
+    /// The views whose render targets already hold their contents. These do
+    /// not need to be rendered again.
+    EmbedderExternalView::ViewIdentifierSet unchanged_views;
+    /// The views for which no render target was found.
+    EmbedderExternalView::ViewIdentifierSet pending_views;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the render targets for the views of a frame out of the
+  ///             cache.
+  ///
+  /// @param[in]  pending_views  The views of the frame.
+  /// @param[in]  view_contents  The contents of the views, as returned by
+  ///                            `EmbedderExternalView::GetContents`. A view
+  ///                            without contents is never unchanged.
+  ///
+  ExistingTargets GetExistingTargetsInCache(
+      const EmbedderExternalView::PendingViews& pending_views,
+      const ViewContents& view_contents);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the least recently used render targets from the cache
+  ///             until the ones that remain fit in its budget. This is meant to
+  ///             be called after the render targets of a frame were taken out
+  ///             of the cache, so that only unused targets are counted.
+  ///
+  /// @return     The render targets that were removed. They are released to
+  ///             the embedder when they are destroyed.
+  ///
   std::set<std::unique_ptr<EmbedderRenderTarget>>
-  ClearAllRenderTargetsInCache();
-
-  void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
-                         std::unique_ptr<EmbedderRenderTarget> target);
+  EvictRenderTargetsOverBudget();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes all the render targets from the cache. Like
+  ///             `EvictRenderTargetsOverBudget`, this is meant to be called
+  ///             after the render targets of a frame were taken out of the
+  ///             cache, when memory is scarce.
+  ///
+  /// @return     The render targets that were removed.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> EvictUnusedRenderTargets();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a render target to the cache after a frame was
+  ///             presented with it.
+  ///
+  /// @param[in]  view_identifier  The view that was presented with the render
+  ///                              target.
+  /// @param[in]  contents         The contents of the view that the render
+  ///                              target holds, if known.
+  /// @param[in]  target           The render target.
+  ///
+  void CacheRenderTarget(
+      EmbedderExternalView::ViewIdentifier view_identifier,
+      std::unique_ptr<EmbedderExternalView::Contents> contents,
+      std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
- private:
-  using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+  size_t GetCachedTargetsBytes() const;
 
-  CachedRenderTargets cached_render_targets_;
+ private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderExternalView::Contents> contents;
+    size_t bytes;
+    std::unique_ptr<EmbedderRenderTarget> target;
+  };
+
+  const size_t max_unused_bytes_;
+  // The most recently used render targets are at the front.
+  std::list<CachedRenderTarget> cached_render_targets_;
+
+  std::set<std::unique_ptr<EmbedderRenderTarget>> EvictRenderTargetsToByteSize(
+      size_t max_bytes);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
@@ -81,9 +81,10 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const ThreadHost::ThreadPolicies& policies) {
   {
-    auto host = CreateEmbedderManagedThreadHost(custom_task_runners);
+    auto host = CreateEmbedderManagedThreadHost(custom_task_runners, policies);
     if (host && host->IsValid()) {
       return host;
     }
@@ -94,7 +95,7 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   // configuration if the embedder attempted to specify a configuration but
   // messed up with an incorrect configuration.
   if (custom_task_runners == nullptr) {
-    auto host = CreateEngineManagedThreadHost();
+    auto host = CreateEngineManagedThreadHost(policies);
     if (host && host->IsValid()) {
       return host;
     }
@@ -113,7 +114,8 @@ constexpr const char* kFlutterThreadName = "io.flutter";
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const ThreadHost::ThreadPolicies& policies) {
   if (custom_task_runners == nullptr) {
     return nullptr;
   }
@@ -154,7 +156,7 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // Create a thread host with just the threads that need to be managed by the
   // engine. The embedder has provided the rest.
-  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask);
+  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask, policies);
 
   // If the embedder has supplied a platform task runner, use that. If not, use
   // the current thread task runner.
@@ -205,12 +207,14 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
 // static
 std::unique_ptr<EmbedderThreadHost>
-EmbedderThreadHost::CreateEngineManagedThreadHost() {
+EmbedderThreadHost::CreateEngineManagedThreadHost(
+    const ThreadHost::ThreadPolicies& policies) {
   // Create a thread host with the current thread as the platform thread and all
   // other threads managed.
-  ThreadHost thread_host(kFlutterThreadName, ThreadHost::Type::RASTER |
-                                                 ThreadHost::Type::IO |
-                                                 ThreadHost::Type::UI);
+  ThreadHost thread_host(
+      kFlutterThreadName,
+      ThreadHost::Type::RASTER | ThreadHost::Type::IO | ThreadHost::Type::UI,
+      policies);
 
   // For embedder platforms that don't have native message loop interop, this
   // will reference a task runner that points to a null message loop
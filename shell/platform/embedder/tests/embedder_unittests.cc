@@ -13,6 +13,7 @@
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/memory_pressure_manager.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
@@ -409,6 +410,89 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that a platform message payload handed over without a copy reaches
+/// Dart intact and is released once the engine no longer references it.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  // Large enough for the payload to be adopted as external typed data.
+  const std::string message_data(4096, 'x');
+  auto* buffer = reinterpret_cast<uint8_t*>(malloc(message_data.size()));
+  memcpy(buffer, message_data.data(), message_data.size());
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = buffer;
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  fml::AutoResetWaitableEvent released;
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message,
+      [](void* user_data) {
+        reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+      },
+      &released);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // The payload is owned by the Dart heap until the isolate is torn down.
+  engine.reset();
+  released.Wait();
+  free(buffer);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that the payload handed to a zero-copy send is released even if the
+/// message could not be sent.
+///
+TEST_F(EmbedderTest, NoCopyPlatformMessagePayloadIsReleasedOnFailure) {
+  uint8_t buffer[16] = {};
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = buffer;
+  platform_message.message_size = sizeof(buffer);
+
+  size_t release_count = 0;
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      nullptr, &platform_message,
+      [](void* user_data) { (*reinterpret_cast<size_t*>(user_data))++; },
+      &release_count);
+  ASSERT_EQ(result, kInvalidArguments);
+  ASSERT_EQ(release_count, 1u);
+
+  result = FlutterEngineSendPlatformMessageNoCopy(nullptr, &platform_message,
+                                                  nullptr, nullptr);
+  ASSERT_EQ(result, kInvalidArguments);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
@@ -1053,6 +1137,67 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanSendGradedMemoryPressureNotifications) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  std::vector<fml::MemoryPressureLevel> levels;
+  auto registration = fml::MemoryPressureManager::GetInstance().Register(
+      "EmbedderTestCache", nullptr,
+      [&levels](fml::MemoryPressureLevel level) { levels.push_back(level); });
+
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(
+                engine.get(), kFlutterMemoryPressureLevelModerate),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(
+                engine.get(), kFlutterMemoryPressureLevelCritical),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(
+                engine.get(), static_cast<FlutterMemoryPressureLevel>(-1)),
+            kInvalidArguments);
+  ASSERT_EQ(levels, (std::vector<fml::MemoryPressureLevel>{
+                        fml::MemoryPressureLevel::kModerate,
+                        fml::MemoryPressureLevel::kCritical}));
+}
+
+TEST_F(EmbedderTest, CanGetFrameTimingStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), nullptr),
+            kInvalidArguments);
+
+  FlutterFrameTimingStatistics statistics = {};
+  statistics.struct_size = sizeof(FlutterFrameTimingStatistics);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), &statistics),
+            kSuccess);
+  ASSERT_EQ(statistics.struct_size, sizeof(FlutterFrameTimingStatistics));
+  ASSERT_EQ(statistics.frame_count, 0u);
+  ASSERT_EQ(statistics.slow_frame_count, 0u);
+
+  // Embedders that only know of the leading members are not written past.
+  FlutterFrameTimingStatistics truncated = {};
+  truncated.struct_size = offsetof(FlutterFrameTimingStatistics, build);
+  truncated.slow_frame_count = 42;
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), &truncated),
+            kSuccess);
+  ASSERT_EQ(truncated.struct_size,
+            offsetof(FlutterFrameTimingStatistics, build));
+  ASSERT_EQ(truncated.slow_frame_count, 42u);
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
@@ -1587,6 +1732,122 @@ TEST_F(EmbedderTest, BackToBackKeyEventResponsesCorrectlyInvoked) {
   shutdown_latch.Wait();
 }
 
+TEST_F(EmbedderTest, InputEventBatchesAreDispatchedInOrder) {
+  UniqueEngine engine;
+  fml::AutoResetWaitableEvent sync_latch;
+  fml::AutoResetWaitableEvent ready;
+  std::vector<uint64_t> echoed_logical;
+
+  // One of the threads that the key data callback will be posted to is the
+  // platform thread. So we cannot wait for assertions to complete on the
+  // platform thread. Create a new thread to manage the engine instance and wait
+  // for assertions on the test thread.
+  auto platform_task_runner = CreateNewThread("platform_thread");
+
+  platform_task_runner->PostTask([&]() {
+    auto& context =
+        GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig();
+    builder.SetDartEntrypoint("key_data_echo");
+    context.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+    context.AddNativeCallback(
+        "EchoKeyEvent",
+        CREATE_NATIVE_ENTRY([&echoed_logical](Dart_NativeArguments args) {
+          echoed_logical.push_back(
+              tonic::DartConverter<uint64_t>::FromDart(
+                  Dart_GetNativeArgument(args, 3)));
+        }));
+
+    engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    sync_latch.Signal();
+  });
+  sync_latch.Wait();
+  ready.Wait();
+
+  FlutterPointerEvent pointer_event = {};
+  pointer_event.struct_size = sizeof(FlutterPointerEvent);
+  pointer_event.phase = kAdd;
+  pointer_event.device_kind = kFlutterPointerDeviceKindMouse;
+
+  FlutterKeyEvent key_event_a{
+      .struct_size = sizeof(FlutterKeyEvent),
+      .timestamp = 1000,
+      .type = kFlutterKeyEventTypeDown,
+      .physical = 0x00070004,
+      .logical = 0x00000000061,
+      .character = nullptr,
+      .synthesized = false,
+  };
+  FlutterKeyEvent key_event_b = key_event_a;
+  key_event_b.physical = 0x00070005;
+  key_event_b.logical = 0x00000000062;
+
+  KeyEventUserData user_data_a{
+      .latch = std::make_shared<fml::AutoResetWaitableEvent>(),
+      .returned = false,
+  };
+  KeyEventUserData user_data_b{
+      .latch = std::make_shared<fml::AutoResetWaitableEvent>(),
+      .returned = false,
+  };
+  auto callback = [](bool handled, void* untyped_user_data) {
+    KeyEventUserData* user_data =
+        reinterpret_cast<KeyEventUserData*>(untyped_user_data);
+    EXPECT_EQ(handled, false);
+    user_data->returned = true;
+    user_data->latch->Signal();
+  };
+
+  FlutterInputEvent events[3] = {};
+  events[0].struct_size = sizeof(FlutterInputEvent);
+  events[0].type = kFlutterInputEventTypeKey;
+  events[0].key_event = &key_event_a;
+  events[0].key_callback = callback;
+  events[0].key_callback_user_data = &user_data_a;
+  events[1].struct_size = sizeof(FlutterInputEvent);
+  events[1].type = kFlutterInputEventTypePointer;
+  events[1].pointer_event = &pointer_event;
+  events[2].struct_size = sizeof(FlutterInputEvent);
+  events[2].type = kFlutterInputEventTypeKey;
+  events[2].key_event = &key_event_b;
+  events[2].key_callback = callback;
+  events[2].key_callback_user_data = &user_data_b;
+
+  platform_task_runner->PostTask([&]() {
+    ASSERT_EQ(FlutterEngineSendInputEvents(engine.get(), events, 3),
+              kSuccess);
+  });
+  user_data_a.latch->Wait();
+  user_data_b.latch->Wait();
+
+  EXPECT_TRUE(user_data_a.returned);
+  EXPECT_TRUE(user_data_b.returned);
+  ASSERT_EQ(echoed_logical.size(), 2u);
+  EXPECT_EQ(echoed_logical[0], key_event_a.logical);
+  EXPECT_EQ(echoed_logical[1], key_event_b.logical);
+
+  fml::AutoResetWaitableEvent shutdown_latch;
+  platform_task_runner->PostTask([&]() {
+    // An event of an unknown type rejects the whole batch.
+    FlutterInputEvent invalid = {};
+    invalid.struct_size = sizeof(FlutterInputEvent);
+    ASSERT_EQ(FlutterEngineSendInputEvents(engine.get(), &invalid, 1),
+              kInvalidArguments);
+
+    engine.reset();
+    shutdown_latch.Signal();
+  });
+  shutdown_latch.Wait();
+}
+
 // This test schedules a frame for the future and asserts that vsync waiter
 // posts the event at the right frame start time (which is in the future).
 TEST_F(EmbedderTest, VsyncCallbackPostedIntoFuture) {
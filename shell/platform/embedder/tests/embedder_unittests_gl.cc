@@ -3030,6 +3030,63 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, CompositorDoesNotUpdateUnchangedRenderTargets) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.GetCompositor().reuse_unchanged_backing_stores = true;
+  builder.SetDartEntrypoint("render_targets_are_recycled");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(2);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  // Every frame of the scene has the same contents, so only the backing stores
+  // of the first frame are rendered into.
+  size_t frame_count = 0;
+  context.GetCompositor().SetPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 20u);
+
+        frame_count++;
+        size_t backing_stores_count = 0;
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type == kFlutterLayerContentTypeBackingStore) {
+            backing_stores_count++;
+            ASSERT_EQ(layers[i]->backing_store->did_update, frame_count == 1);
+          }
+        }
+        ASSERT_EQ(backing_stores_count, 10u);
+
+        if (frame_count == 4) {
+          latch.CountDown();
+        }
+      },
+      false  // one shot
+  );
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 10u);
+}
+
 TEST_F(EmbedderTest, FrameInfoContainsValidWidthAndHeight) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
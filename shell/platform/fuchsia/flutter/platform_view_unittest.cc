@@ -106,6 +106,8 @@ class MockPlatformViewDelegate : public flutter::PlatformView::Delegate {
       std::unique_ptr<flutter::KeyDataPacket> packet,
       std::function<void(bool)> callback) {}
   // |flutter::PlatformView::Delegate|
+  void OnPlatformViewDispatchInputEventBatch(flutter::InputEventBatch batch) {}
+  // |flutter::PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(int32_t id,
                                              flutter::SemanticsAction action,
                                              fml::MallocMapping args) {}
@@ -342,8 +342,9 @@ void FlutterTizenEngine::SendPlatformMessageResponse(
   embedder_api_.SendPlatformMessageResponse(engine_, handle, data, data_length);
 }
 
-void FlutterTizenEngine::SendPointerEvent(const FlutterPointerEvent& event) {
-  embedder_api_.SendPointerEvent(engine_, &event, 1);
+void FlutterTizenEngine::SendPointerEvents(const FlutterPointerEvent* events,
+                                           size_t events_count) {
+  embedder_api_.SendPointerEvent(engine_, events, events_count);
 }
 
 void FlutterTizenEngine::SendWindowMetrics(int32_t x,
@@ -132,8 +132,10 @@ class FlutterTizenEngine : public TizenRenderer::Delegate {
       const uint8_t* data,
       size_t data_length);
 
-  // Informs the engine of an incoming pointer event.
-  void SendPointerEvent(const FlutterPointerEvent& event);
+  // Informs the engine of incoming pointer events. The events are dispatched
+  // to the framework in a single packet.
+  void SendPointerEvents(const FlutterPointerEvent* events,
+                         size_t events_count);
 
   // Sends a window metrics update to the Flutter engine using current window
   // dimensions in physical
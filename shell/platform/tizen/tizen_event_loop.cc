@@ -22,12 +22,18 @@ TizenEventLoop::TizenEventLoop(std::thread::id main_thread_id,
   ecore_pipe_ = ecore_pipe_add(
       [](void* data, void* buffer, unsigned int nbyte) -> void {
         auto* self = reinterpret_cast<TizenEventLoop*>(data);
+        // Clear the flag before draining so that tasks posted while draining
+        // wake the loop again.
+        self->wakeup_pending_ = false;
         self->ExecuteTaskEvents();
       },
       this);
 }
 
 TizenEventLoop::~TizenEventLoop() {
+  if (timer_) {
+    ecore_timer_del(timer_);
+  }
   if (ecore_pipe_) {
     ecore_pipe_del(ecore_pipe_);
   }
@@ -39,21 +45,26 @@ bool TizenEventLoop::RunsTasksOnCurrentThread() const {
 
 void TizenEventLoop::ExecuteTaskEvents() {
   const auto now = TaskTimePoint::clock::now();
+  auto next_fire_time = TaskTimePoint::max();
   {
-    std::lock_guard<std::mutex> lock1(task_queue_mutex_);
-    std::lock_guard<std::mutex> lock2(expired_tasks_mutex_);
+    std::lock_guard<std::mutex> lock(task_queue_mutex_);
     while (!task_queue_.empty()) {
       const auto& top = task_queue_.top();
 
       if (top.fire_time > now) {
+        next_fire_time = top.fire_time;
         break;
       }
 
-      expired_tasks_.push_back(task_queue_.top());
+      expired_tasks_.push_back(top);
       task_queue_.pop();
     }
+    next_drain_time_ = next_fire_time;
+  }
+  ScheduleTimer(next_fire_time, now);
+  if (!expired_tasks_.empty()) {
+    OnTaskExpired();
   }
-  OnTaskExpired();
 }
 
 TizenEventLoop::TaskTimePoint TizenEventLoop::TimePointFromFlutterTime(
@@ -66,32 +77,56 @@ TizenEventLoop::TaskTimePoint TizenEventLoop::TimePointFromFlutterTime(
 void TizenEventLoop::PostTask(FlutterTask flutter_task,
                               uint64_t flutter_target_time_nanos) {
   Task task;
-  task.order = ++task_order_;
   task.fire_time = TimePointFromFlutterTime(flutter_target_time_nanos);
   task.task = flutter_task;
+  bool needs_wakeup = false;
   {
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
+    task.order = ++task_order_;
     task_queue_.push(task);
+    // The main loop already drains the queue at |next_drain_time_|. Only a
+    // task that is due earlier needs to wake it up.
+    if (task.fire_time < next_drain_time_) {
+      next_drain_time_ = task.fire_time;
+      needs_wakeup = true;
+    }
   }
+  if (needs_wakeup) {
+    WakeUp();
+  }
+}
 
-  const auto flutter_duration =
-      static_cast<double>(flutter_target_time_nanos) - get_current_time_();
-  if (flutter_duration > 0) {
-    ecore_timer_add(
-        flutter_duration / 1000000000.0,
-        [](void* data) -> Eina_Bool {
-          auto* self = reinterpret_cast<TizenEventLoop*>(data);
-          if (self->ecore_pipe_) {
-            ecore_pipe_write(self->ecore_pipe_, nullptr, 0);
-          }
-          return ECORE_CALLBACK_CANCEL;
-        },
-        this);
-  } else {
-    if (ecore_pipe_) {
-      ecore_pipe_write(ecore_pipe_, nullptr, 0);
+void TizenEventLoop::WakeUp() {
+  if (!wakeup_pending_.exchange(true) && ecore_pipe_) {
+    ecore_pipe_write(ecore_pipe_, nullptr, 0);
+  }
+}
+
+void TizenEventLoop::ScheduleTimer(TaskTimePoint fire_time,
+                                   TaskTimePoint now) {
+  if (fire_time == TaskTimePoint::max()) {
+    if (timer_) {
+      ecore_timer_del(timer_);
+      timer_ = nullptr;
     }
+    return;
+  }
+
+  const double delay = std::chrono::duration<double>(fire_time - now).count();
+  if (timer_) {
+    ecore_timer_interval_set(timer_, delay);
+    ecore_timer_reset(timer_);
+    return;
   }
+  timer_ = ecore_timer_add(
+      delay,
+      [](void* data) -> Eina_Bool {
+        auto* self = reinterpret_cast<TizenEventLoop*>(data);
+        self->timer_ = nullptr;
+        self->ExecuteTaskEvents();
+        return ECORE_CALLBACK_CANCEL;
+      },
+      this);
 }
 
 TizenPlatformEventLoop::TizenPlatformEventLoop(
@@ -120,13 +155,10 @@ TizenRenderEventLoop::TizenRenderEventLoop(std::thread::id main_thread_id,
       static_cast<TizenRendererEvasGL*>(renderer_)->GetImageHandle(),
       [](void* data, Evas_Object* o) {  // Render callback
         TizenRenderEventLoop* self = static_cast<TizenRenderEventLoop*>(data);
-        {
-          std::lock_guard<std::mutex> lock(self->expired_tasks_mutex_);
-          for (const auto& task : self->expired_tasks_) {
-            self->on_task_expired_(&task.task);
-          }
-          self->expired_tasks_.clear();
+        for (const auto& task : self->expired_tasks_) {
+          self->on_task_expired_(&task.task);
         }
+        self->expired_tasks_.clear();
         self->has_pending_renderer_callback_ = false;
       },
       this);
@@ -135,7 +167,6 @@ TizenRenderEventLoop::TizenRenderEventLoop(std::thread::id main_thread_id,
 TizenRenderEventLoop::~TizenRenderEventLoop() {}
 
 void TizenRenderEventLoop::OnTaskExpired() {
-  std::lock_guard<std::mutex> lock(expired_tasks_mutex_);
   if (!has_pending_renderer_callback_ && !expired_tasks_.empty()) {
     evas_object_image_pixels_dirty_set(
         static_cast<TizenRendererEvasGL*>(renderer_)->GetImageHandle(),
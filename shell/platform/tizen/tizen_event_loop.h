@@ -10,11 +10,11 @@
 
 #include <atomic>
 #include <chrono>
-#include <deque>
 #include <functional>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "flutter/shell/platform/embedder/embedder.h"
 
@@ -68,16 +68,39 @@ class TizenEventLoop {
   CurrentTimeProc get_current_time_;
   TaskExpiredCallback on_task_expired_;
   std::mutex task_queue_mutex_;
-  std::priority_queue<Task, std::deque<Task>, Task::Comparer> task_queue_;
+  std::priority_queue<Task, std::vector<Task>, Task::Comparer> task_queue_;
+  uint64_t task_order_ = 0;
+
+  // The tasks taken from |task_queue_| that are ready to run. Only accessed
+  // on the main thread.
   std::vector<Task> expired_tasks_;
-  std::mutex expired_tasks_mutex_;
-  std::atomic<std::uint64_t> task_order_{0};
 
  private:
   Ecore_Pipe* ecore_pipe_;
 
+  // Whether a wakeup has been written to |ecore_pipe_| and not handled yet.
+  // At most one wakeup is pending at a time, however many tasks are posted.
+  std::atomic_bool wakeup_pending_{false};
+
+  // The time at which the main loop is next going to drain |task_queue_|,
+  // either because a wakeup is pending or because |timer_| fires. Only tasks
+  // that are due earlier need to wake the main loop. Guarded by
+  // |task_queue_mutex_|.
+  TaskTimePoint next_drain_time_ = TaskTimePoint::max();
+
+  // The single timer for the earliest delayed task. Only accessed on the main
+  // thread.
+  Ecore_Timer* timer_ = nullptr;
+
   // Returns a TaskTimePoint computed from the given target time from Flutter.
   TaskTimePoint TimePointFromFlutterTime(uint64_t flutter_target_time_nanos);
+
+  // Wakes the main loop unless a wakeup is already pending.
+  void WakeUp();
+
+  // Arms |timer_| to fire at |fire_time|, or disarms it if |fire_time| is
+  // TaskTimePoint::max().
+  void ScheduleTimer(TaskTimePoint fire_time, TaskTimePoint now);
 };
 
 class TizenPlatformEventLoop : public TizenEventLoop {
@@ -103,7 +126,7 @@ class TizenRenderEventLoop : public TizenEventLoop {
 
  private:
   TizenRenderer* renderer_{nullptr};
-  std::atomic_bool has_pending_renderer_callback_{false};
+  bool has_pending_renderer_callback_{false};
 };
 #endif  // TIZEN_RENDERER_EVAS_GL
 
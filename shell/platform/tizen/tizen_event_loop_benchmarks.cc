@@ -0,0 +1,80 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/tizen/tizen_event_loop.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+namespace benchmarking {
+
+namespace {
+
+uint64_t GetCurrentTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Posts |num_tasks_per_producer| tasks from each of |num_producers| threads,
+// each due |delay_nanos| after it is posted, and runs the Ecore main loop on
+// the calling thread until all of them have been executed.
+void PostAndRunTasks(benchmark::State& state,
+                     int num_producers,
+                     int num_tasks_per_producer,
+                     uint64_t delay_nanos) {
+  ecore_init();
+  {
+    std::atomic<int64_t> executed{0};
+    TizenPlatformEventLoop loop(
+        std::this_thread::get_id(), GetCurrentTime,
+        [&executed](const FlutterTask* task) { executed++; });
+    const int64_t num_tasks = num_producers * num_tasks_per_producer;
+
+    while (state.KeepRunning()) {
+      executed = 0;
+      std::vector<std::thread> producers;
+      for (int i = 0; i < num_producers; i++) {
+        producers.emplace_back([&loop, num_tasks_per_producer, delay_nanos]() {
+          for (int j = 0; j < num_tasks_per_producer; j++) {
+            FlutterTask task = {nullptr, static_cast<uint64_t>(j)};
+            loop.PostTask(task, GetCurrentTime() + delay_nanos);
+          }
+        });
+      }
+      while (executed < num_tasks) {
+        ecore_main_loop_iterate();
+      }
+      for (auto& producer : producers) {
+        producer.join();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * num_tasks);
+  }
+  ecore_shutdown();
+}
+
+}  // namespace
+
+static void BM_TizenEventLoopPostTasks(benchmark::State& state) {  // NOLINT
+  PostAndRunTasks(state, state.range(0), 1000, 0);
+}
+
+BENCHMARK(BM_TizenEventLoopPostTasks)->Arg(1)->Arg(4)->Arg(16);
+
+// NOLINTNEXTLINE
+static void BM_TizenEventLoopPostDelayedTasks(benchmark::State& state) {
+  const uint64_t one_millisecond = 1000000;
+  PostAndRunTasks(state, state.range(0), 100, one_millisecond);
+}
+
+BENCHMARK(BM_TizenEventLoopPostDelayedTasks)->Arg(1)->Arg(4);
+
+}  // namespace benchmarking
+}  // namespace flutter
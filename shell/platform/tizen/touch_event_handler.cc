@@ -29,6 +29,10 @@ TouchEventHandler::~TouchEventHandler() {
     ecore_event_handler_del(handler);
   }
   touch_event_handlers_.clear();
+  if (flush_idle_enterer_) {
+    ecore_idle_enterer_del(flush_idle_enterer_);
+    flush_idle_enterer_ = nullptr;
+  }
 }
 
 void TouchEventHandler::SendFlutterPointerEvent(FlutterPointerPhase phase,
@@ -69,7 +73,25 @@ void TouchEventHandler::SendFlutterPointerEvent(FlutterPointerPhase phase,
   event.device = device_id;
   event.device_kind = kFlutterPointerDeviceKindTouch;
 
-  engine_->SendPointerEvent(event);
+  pending_events_.push_back(event);
+  if (!flush_idle_enterer_) {
+    flush_idle_enterer_ = ecore_idle_enterer_add(OnIdleEnterer, this);
+  }
+}
+
+void TouchEventHandler::FlushPendingEvents() {
+  if (pending_events_.empty()) {
+    return;
+  }
+  engine_->SendPointerEvents(pending_events_.data(), pending_events_.size());
+  pending_events_.clear();
+}
+
+Eina_Bool TouchEventHandler::OnIdleEnterer(void* data) {
+  auto* self = reinterpret_cast<TouchEventHandler*>(data);
+  self->flush_idle_enterer_ = nullptr;
+  self->FlushPendingEvents();
+  return ECORE_CALLBACK_CANCEL;
 }
 
 Eina_Bool TouchEventHandler::OnTouch(void* data, int type, void* event) {
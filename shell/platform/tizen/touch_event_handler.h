@@ -31,6 +31,11 @@ class TouchEventHandler {
   bool pointer_state_ = false;
   uintptr_t window_id_ = 0;
 
+  // Pointer events received in the current main loop iteration. They are
+  // sent to the engine in a single call when the loop is about to idle.
+  std::vector<FlutterPointerEvent> pending_events_;
+  Ecore_Idle_Enterer* flush_idle_enterer_ = nullptr;
+
   void SendFlutterPointerEvent(FlutterPointerPhase phase,
                                double x,
                                double y,
@@ -39,7 +44,11 @@ class TouchEventHandler {
                                size_t timestamp,
                                int device_id);
 
+  void FlushPendingEvents();
+
   static Eina_Bool OnTouch(void* data, int type, void* event);
+
+  static Eina_Bool OnIdleEnterer(void* data);
 };
 
 }  // namespace flutter
@@ -256,6 +256,11 @@ sk_sp<GrDirectContext> TestGLSurface::GetGrContext() {
 }
 
 sk_sp<GrDirectContext> TestGLSurface::CreateGrContext() {
+  return CreateGrContext(GrContextOptions{});
+}
+
+sk_sp<GrDirectContext> TestGLSurface::CreateGrContext(
+    const GrContextOptions& options) {
   if (!MakeCurrent()) {
     return nullptr;
   }
@@ -287,7 +292,7 @@ sk_sp<GrDirectContext> TestGLSurface::CreateGrContext() {
     return nullptr;
   }
 
-  context_ = GrDirectContext::MakeGL(interface);
+  context_ = GrDirectContext::MakeGL(interface, options);
   return context_;
 }
 
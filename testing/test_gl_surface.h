@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -39,6 +40,8 @@ class TestGLSurface {
 
   sk_sp<GrDirectContext> CreateGrContext();
 
+  sk_sp<GrDirectContext> CreateGrContext(const GrContextOptions& options);
+
   sk_sp<SkImage> GetRasterSurfaceSnapshot();
 
   uint32_t GetWindowFBOId() const;
@@ -581,4 +581,12 @@ uint32_t FontCollection::getId() const {
   return mId;
 }
 
+size_t FontCollection::getEstimatedByteSize() const {
+  return sizeof(FontCollection) +
+         mFamilies.capacity() * sizeof(std::shared_ptr<FontFamily>) +
+         mRanges.capacity() * sizeof(Range) +
+         mFamilyVec.capacity() * sizeof(uint8_t) +
+         mVSFamilyVec.capacity() * sizeof(std::shared_ptr<FontFamily>);
+}
+
 }  // namespace minikin
@@ -76,6 +76,11 @@ class FontCollection {
 
   uint32_t getId() const;
 
+  // libtxt extension: An estimate of the memory used by the coverage tables
+  // of this collection, not counting the font families it shares with other
+  // collections.
+  size_t getEstimatedByteSize() const;
+
   void set_fallback_font_provider(std::unique_ptr<FallbackFontProvider> ffp) {
     mFallbackFontProvider = std::move(ffp);
   }
@@ -41,6 +41,8 @@
 #include "LayoutUtils.h"
 #include "MinikinInternal.h"
 
+#include "flutter/fml/memory/memory_pressure_manager.h"
+
 namespace minikin {
 
 const int kDirection_Mask = 0x1;
@@ -98,6 +100,7 @@ class LayoutCacheKey {
     delete[] mChars;
     mChars = NULL;
   }
+  size_t textSize() const { return mNchars * sizeof(uint16_t); }
 
   void doLayout(Layout* layout,
                 LayoutContext* ctx,
@@ -131,12 +134,25 @@ class LayoutCacheKey {
 
 class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
+  LayoutCache() : mCache(kMaxEntries), mBytes(0) {
     mCache.setOnEntryRemovedListener(this);
+    // The cache is guarded by gMinikinLock, so it can be trimmed from any
+    // thread.
+    mRegistration = fml::MemoryPressureManager::GetInstance().Register(
+        "TextLayoutCache", nullptr,
+        [this](fml::MemoryPressureLevel level) { trim(level); });
   }
 
+  struct Usage {
+    size_t bytes;
+    size_t entries;
+  };
+
   void clear() { mCache.clear(); }
 
+  // Must be called with gMinikinLock held.
+  Usage getUsageLocked() const { return {mBytes, mCache.size()}; }
+
   Layout* get(LayoutCacheKey& key,
               LayoutContext* ctx,
               const std::shared_ptr<FontCollection>& collection) {
@@ -145,19 +161,53 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
       key.copyText();
       layout = new Layout();
       key.doLayout(layout, ctx, collection);
+      mBytes += key.textSize() + layout->getMemoryUsage();
       mCache.put(key, layout);
     }
     return layout;
   }
 
+  // Must be called without holding gMinikinLock. A cache over its budget is
+  // trimmed synchronously, and the trim acquires gMinikinLock while the
+  // memory pressure manager holds the trim lock of the registration, so
+  // holding gMinikinLock here would invert the lock order.
+  void publishUsage(Usage usage) {
+    mRegistration->SetUsage(usage.bytes, usage.entries);
+  }
+
  private:
+  // The least recently used layouts are evicted until the cache fits its
+  // budget. Moderate pressure signaled by the embedder while the cache is
+  // within its budget, or without one, halves it. Only critical pressure
+  // clears the layouts and the HarfBuzz font cache.
+  void trim(fml::MemoryPressureLevel level) {
+    if (level == fml::MemoryPressureLevel::kCritical) {
+      Layout::purgeCaches();
+      return;
+    }
+    Usage usage;
+    {
+      std::scoped_lock _l(gMinikinLock);
+      const size_t budget = mRegistration->GetBudget();
+      const size_t max_bytes =
+          budget > 0 && mBytes > budget ? budget : mBytes / 2;
+      while (mBytes > max_bytes && mCache.removeOldest()) {
+      }
+      usage = getUsageLocked();
+    }
+    publishUsage(usage);
+  }
+
   // callback for OnEntryRemoved
   void operator()(LayoutCacheKey& key, Layout*& value) {
+    mBytes -= key.textSize() + value->getMemoryUsage();
     key.freeText();
     delete value;
   }
 
   android::LruCache<LayoutCacheKey, Layout*> mCache;
+  size_t mBytes;
+  std::unique_ptr<fml::MemoryPressureManager::Registration> mRegistration;
 
   // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
   // Layout*>::kUnlimitedCapacity;
@@ -588,19 +638,25 @@ void Layout::doLayout(const uint16_t* buf,
                       const FontStyle& style,
                       const MinikinPaint& paint,
                       const std::shared_ptr<FontCollection>& collection) {
-  std::scoped_lock _l(gMinikinLock);
+  LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
+  LayoutCache::Usage usage;
+  {
+    std::scoped_lock _l(gMinikinLock);
 
-  LayoutContext ctx;
-  ctx.style = style;
-  ctx.paint = paint;
+    LayoutContext ctx;
+    ctx.style = style;
+    ctx.paint = paint;
 
-  reset();
-  mAdvances.resize(count, 0);
+    reset();
+    mAdvances.resize(count, 0);
 
-  doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, start, collection,
-                    this, NULL);
+    doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, start,
+                      collection, this, NULL);
 
-  ctx.clearHbFonts();
+    ctx.clearHbFonts();
+    usage = layoutCache.getUsageLocked();
+  }
+  layoutCache.publishUsage(usage);
 }
 
 float Layout::measureText(const uint16_t* buf,
@@ -612,16 +668,23 @@ float Layout::measureText(const uint16_t* buf,
                           const MinikinPaint& paint,
                           const std::shared_ptr<FontCollection>& collection,
                           float* advances) {
-  std::scoped_lock _l(gMinikinLock);
+  LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
+  LayoutCache::Usage usage;
+  float advance;
+  {
+    std::scoped_lock _l(gMinikinLock);
 
-  LayoutContext ctx;
-  ctx.style = style;
-  ctx.paint = paint;
+    LayoutContext ctx;
+    ctx.style = style;
+    ctx.paint = paint;
 
-  float advance = doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, 0,
-                                    collection, NULL, advances);
+    advance = doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, 0,
+                                collection, NULL, advances);
 
-  ctx.clearHbFonts();
+    ctx.clearHbFonts();
+    usage = layoutCache.getUsageLocked();
+  }
+  layoutCache.publishUsage(usage);
   return advance;
 }
 
@@ -1192,11 +1255,22 @@ void Layout::getBounds(MinikinRect* bounds) const {
   bounds->set(mBounds);
 }
 
+size_t Layout::getMemoryUsage() const {
+  return sizeof(Layout) + mGlyphs.capacity() * sizeof(LayoutGlyph) +
+         mAdvances.capacity() * sizeof(float) +
+         mFaces.capacity() * sizeof(FakedFont);
+}
+
 void Layout::purgeCaches() {
-  std::scoped_lock _l(gMinikinLock);
   LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
-  layoutCache.clear();
-  purgeHbFontCacheLocked();
+  LayoutCache::Usage usage;
+  {
+    std::scoped_lock _l(gMinikinLock);
+    layoutCache.clear();
+    purgeHbFontCacheLocked();
+    usage = layoutCache.getUsageLocked();
+  }
+  layoutCache.publishUsage(usage);
 }
 
 }  // namespace minikin
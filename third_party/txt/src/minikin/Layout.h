@@ -114,6 +114,9 @@ class Layout {
 
   void getBounds(MinikinRect* rect) const;
 
+  // The approximate number of bytes owned by this layout. libtxt extension.
+  size_t getMemoryUsage() const;
+
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
@@ -166,7 +166,8 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   FamilyKey family_key(font_families, locale);
   auto cached = font_collections_cache_.find(family_key);
   if (cached != font_collections_cache_.end()) {
-    return cached->second;
+    cached->second.last_use = ++font_collections_cache_uses_;
+    return cached->second.collection;
   }
 
   std::vector<std::shared_ptr<minikin::FontFamily>> minikin_families;
@@ -194,8 +195,7 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   }
   // Default font family also not found. We fail to get a FontCollection.
   if (minikin_families.empty()) {
-    font_collections_cache_[family_key] = nullptr;
-    return nullptr;
+    return CacheFontCollection(family_key, nullptr);
   }
   if (enable_font_fallback_) {
     for (const std::string& fallback_family :
@@ -210,8 +210,7 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   auto font_collection =
       minikin::FontCollection::Create(std::move(minikin_families));
   if (!font_collection) {
-    font_collections_cache_[family_key] = nullptr;
-    return nullptr;
+    return CacheFontCollection(family_key, nullptr);
   }
   if (enable_font_fallback_) {
     font_collection->set_fallback_font_provider(
@@ -219,9 +218,17 @@ FontCollection::GetMinikinFontCollectionForFamilies(
   }
 
   // Cache the font collection for future queries.
-  font_collections_cache_[family_key] = font_collection;
+  return CacheFontCollection(family_key, std::move(font_collection));
+}
 
-  return font_collection;
+const std::shared_ptr<minikin::FontCollection>&
+FontCollection::CacheFontCollection(
+    const FamilyKey& family_key,
+    std::shared_ptr<minikin::FontCollection> font_collection) {
+  CachedFontCollection& cached = font_collections_cache_[family_key];
+  cached.collection = std::move(font_collection);
+  cached.last_use = ++font_collections_cache_uses_;
+  return cached.collection;
 }
 
 std::shared_ptr<minikin::FontFamily> FontCollection::FindFontFamilyInManagers(
@@ -413,6 +420,56 @@ void FontCollection::ClearFontFamilyCache() {
 #endif
 }
 
+void FontCollection::TrimFontFamilyCache(size_t max_bytes) {
+  size_t bytes = GetCacheByteSize();
+  if (bytes <= max_bytes) {
+    return;
+  }
+
+  std::vector<decltype(font_collections_cache_)::iterator> entries;
+  entries.reserve(font_collections_cache_.size());
+  for (auto it = font_collections_cache_.begin();
+       it != font_collections_cache_.end(); ++it) {
+    entries.push_back(it);
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a->second.last_use < b->second.last_use;
+  });
+  for (const auto& entry : entries) {
+    if (bytes <= max_bytes) {
+      break;
+    }
+    bytes -= GetCachedFontCollectionByteSize(entry->first, entry->second);
+    font_collections_cache_.erase(entry);
+  }
+}
+
+size_t FontCollection::GetCacheEntryCount() const {
+  return font_collections_cache_.size() + fallback_match_cache_.size();
+}
+
+size_t FontCollection::GetCacheByteSize() const {
+  size_t bytes = 0;
+  for (const auto& item : font_collections_cache_) {
+    bytes += GetCachedFontCollectionByteSize(item.first, item.second);
+  }
+  bytes += fallback_match_cache_.size() *
+           sizeof(decltype(fallback_match_cache_)::value_type);
+  return bytes;
+}
+
+size_t FontCollection::GetCachedFontCollectionByteSize(
+    const FamilyKey& family_key,
+    const CachedFontCollection& cached) {
+  size_t bytes =
+      sizeof(decltype(font_collections_cache_)::value_type) +
+      family_key.font_families.capacity() + family_key.locale.capacity();
+  if (cached.collection) {
+    bytes += cached.collection->getEstimatedByteSize();
+  }
+  return bytes;
+}
+
 #if FLUTTER_ENABLE_SKSHAPER
 
 sk_sp<skia::textlayout::FontCollection>
@@ -68,6 +68,19 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Remove the least recently used entries of the font family cache until
+  // the cache takes no more than |max_bytes|, as measured by
+  // |GetCacheByteSize|.
+  void TrimFontFamilyCache(size_t max_bytes);
+
+  // The number of font family and fallback font lookups that are cached.
+  size_t GetCacheEntryCount() const;
+
+  // An estimate of the memory used by the cached font family and fallback font
+  // lookups. The fonts themselves are owned by the font managers and are not
+  // counted.
+  size_t GetCacheByteSize() const;
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
@@ -90,14 +103,20 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
     };
   };
 
+  struct CachedFontCollection {
+    std::shared_ptr<minikin::FontCollection> collection;
+    // The value of |font_collections_cache_uses_| when the entry was last
+    // looked up.
+    uint64_t last_use = 0;
+  };
+
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
-  std::unordered_map<FamilyKey,
-                     std::shared_ptr<minikin::FontCollection>,
-                     FamilyKey::Hasher>
+  std::unordered_map<FamilyKey, CachedFontCollection, FamilyKey::Hasher>
       font_collections_cache_;
+  uint64_t font_collections_cache_uses_ = 0;
   // Cache that stores the results of MatchFallbackFont to ensure lag-free emoji
   // font fallback matching.
   std::unordered_map<uint32_t, const std::shared_ptr<minikin::FontFamily>*>
@@ -121,6 +140,15 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
 
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  // Adds the font collection to the cache and returns it.
+  const std::shared_ptr<minikin::FontCollection>& CacheFontCollection(
+      const FamilyKey& family_key,
+      std::shared_ptr<minikin::FontCollection> font_collection);
+
+  static size_t GetCachedFontCollectionByteSize(
+      const FamilyKey& family_key,
+      const CachedFontCollection& cached);
+
   std::shared_ptr<minikin::FontFamily> FindFontFamilyInManagers(
       const std::string& family_name);
 
@@ -131,6 +159,7 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Sorts in-place a group of SkTypeface from an SkTypefaceSet into a
   // reasonable order for future queries.
   FRIEND_TEST(FontCollectionTest, CheckSkTypefacesSorting);
+  FRIEND_TEST(FontCollectionTest, TrimEvictsLeastRecentlyUsedCollections);
   static void SortSkTypefaces(std::vector<sk_sp<SkTypeface>>& sk_typefaces);
 
   const std::shared_ptr<minikin::FontFamily>& GetFallbackFontFamily(
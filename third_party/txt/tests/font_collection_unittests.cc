@@ -138,6 +138,37 @@ TEST(FontCollectionTest, CheckSkTypefacesSorting) {
             SkFontStyle::kExpanded_Width);
 }
 
+TEST(FontCollectionTest, TrimEvictsLeastRecentlyUsedCollections) {
+  // Without font managers every lookup fails, and the failures are cached.
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  font_collection->DisableFontFallback();
+  ASSERT_EQ(font_collection->GetMinikinFontCollectionForFamilies({"a"}, ""),
+            nullptr);
+  ASSERT_EQ(font_collection->GetMinikinFontCollectionForFamilies({"b"}, ""),
+            nullptr);
+  ASSERT_EQ(font_collection->GetMinikinFontCollectionForFamilies({"c"}, ""),
+            nullptr);
+  ASSERT_EQ(font_collection->GetMinikinFontCollectionForFamilies({"a"}, ""),
+            nullptr);
+  ASSERT_EQ(font_collection->GetCacheEntryCount(), 3u);
+
+  // Trimming to the current size evicts nothing.
+  font_collection->TrimFontFamilyCache(font_collection->GetCacheByteSize());
+  ASSERT_EQ(font_collection->GetCacheEntryCount(), 3u);
+
+  // One byte less evicts "b", which was used least recently.
+  font_collection->TrimFontFamilyCache(font_collection->GetCacheByteSize() -
+                                       1);
+  ASSERT_EQ(font_collection->GetCacheEntryCount(), 2u);
+  const auto& cache = font_collection->font_collections_cache_;
+  ASSERT_EQ(cache.count(FontCollection::FamilyKey({"a"}, "")), 1u);
+  ASSERT_EQ(cache.count(FontCollection::FamilyKey({"b"}, "")), 0u);
+  ASSERT_EQ(cache.count(FontCollection::FamilyKey({"c"}, "")), 1u);
+
+  font_collection->TrimFontFamilyCache(0);
+  ASSERT_EQ(font_collection->GetCacheEntryCount(), 0u);
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {
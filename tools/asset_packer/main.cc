@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Packs the assets of a flutter_assets directory into a single archive that
+// the engine reads with one mapping, instead of opening and mapping a file per
+// asset. The engine uses the archive in place of the directory when it is
+// named assets.flutterpack and stored in the assets directory.
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "flutter/assets/packed_asset_archive.h"
+#include "flutter/assets/packed_asset_archive_builder.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+
+namespace flutter {
+namespace {
+
+void PrintUsage() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "asset_packer --input=<flutter_assets directory> "
+               "--output=<archive> [--startup-assets=<list file>]"
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << "Every file in the input directory and its subdirectories is "
+               "added to the archive, which will be overwritten if it exists "
+               "already. The list file names the assets read when the "
+               "application launches, one per line. They are prefetched when "
+               "the archive is opened."
+            << std::endl;
+}
+
+// Adds the files of the directory to the archive, with names relative to the
+// assets directory.
+bool AddDirectory(const fml::UniqueFD& directory,
+                  const std::string& prefix,
+                  PackedAssetArchiveBuilder& builder) {
+  bool success = true;
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& dir,
+                                 const std::string& file_name) {
+    std::string name = prefix + file_name;
+    if (name == kPackedAssetArchiveFileName) {
+      return true;
+    }
+    if (fml::IsDirectory(dir, file_name.c_str())) {
+      fml::UniqueFD subdirectory =
+          fml::OpenDirectoryReadOnly(dir, file_name.c_str());
+      success = AddDirectory(subdirectory, name + "/", builder);
+      return success;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(dir, file_name);
+    if (!mapping) {
+      std::cerr << "Could not read '" << name << "'." << std::endl;
+      success = false;
+      return false;
+    }
+    builder.AddAsset(name, std::move(mapping));
+    return true;
+  });
+  return success;
+}
+
+bool MarkStartupAssets(const std::string& list_path,
+                       PackedAssetArchiveBuilder& builder) {
+  auto list = fml::FileMapping::CreateReadOnly(list_path);
+  if (!list) {
+    std::cerr << "Could not read '" << list_path << "'." << std::endl;
+    return false;
+  }
+  std::istringstream lines(
+      std::string(reinterpret_cast<const char*>(list->GetMapping()),
+                  list->GetSize()));
+  std::string name;
+  while (std::getline(lines, name)) {
+    if (!name.empty() && name.back() == '\r') {
+      name.pop_back();
+    }
+    if (name.empty()) {
+      continue;
+    }
+    if (!builder.SetStartupCritical(name)) {
+      std::cerr << "Startup asset '" << name << "' is not in the input."
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WriteArchive(const std::string& output_path,
+                  const fml::Mapping& archive) {
+  std::string absolute_path = fml::paths::AbsolutePath(output_path);
+  std::string directory_path = fml::paths::GetDirectoryName(absolute_path);
+  std::string file_name = absolute_path.substr(directory_path.size() + 1);
+  fml::UniqueFD directory = fml::OpenDirectory(
+      directory_path.c_str(), false, fml::FilePermission::kReadWrite);
+  return directory.is_valid() &&
+         fml::WriteAtomically(directory, file_name.c_str(), archive);
+}
+
+int AssetPackerMain(const fml::CommandLine& command_line) {
+  std::string input_path;
+  std::string output_path;
+  if (command_line.HasOption("help") ||
+      !command_line.GetOptionValue("input", &input_path) ||
+      !command_line.GetOptionValue("output", &output_path)) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+
+  fml::UniqueFD input = fml::OpenDirectory(input_path.c_str(), false,
+                                           fml::FilePermission::kRead);
+  if (!input.is_valid()) {
+    std::cerr << "Could not open '" << input_path << "'." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  PackedAssetArchiveBuilder builder;
+  if (!AddDirectory(input, "", builder)) {
+    return EXIT_FAILURE;
+  }
+
+  std::string startup_assets_path;
+  if (command_line.GetOptionValue("startup-assets", &startup_assets_path) &&
+      !MarkStartupAssets(startup_assets_path, builder)) {
+    return EXIT_FAILURE;
+  }
+
+  auto archive = builder.Build();
+  if (!WriteArchive(output_path, *archive)) {
+    std::cerr << "Could not write '" << output_path << "'." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Wrote " << builder.GetAssetCount() << " assets ("
+            << archive->GetSize() << " bytes) to '" << output_path << "'."
+            << std::endl;
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char* argv[]) {
+  return flutter::AssetPackerMain(fml::CommandLineFromArgcArgv(argc, argv));
+}
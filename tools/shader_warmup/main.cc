@@ -0,0 +1,230 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays recorded frames on an offscreen SwiftShader GL context and writes the
+// SkSL of every shader Skia compiled for them into an io.flutter.shaders.json
+// bundle. Shipping the bundle with an application precompiles those shaders on
+// its first run, without having to train the SkSL cache on a device.
+//
+// The frames are SKPs, as written by `--dump-skp-on-shader-compilation` or the
+// `_flutter.screenshotSkp` service extension, or serialized display lists
+// (.dl files), as written by the `_flutter.screenshotDisplayList` service
+// extension.
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/display_list_serialization.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/common/context_options.h"
+#include "flutter/testing/test_gl_surface.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace {
+
+constexpr char kDefaultPlatform[] = "android";
+constexpr int kDefaultSurfaceSize = 1024;
+
+void PrintUsage() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "shader_warmup --output=<io.flutter.shaders.json> "
+               "[--platform=<name>] [--width=<pixels>] [--height=<pixels>] "
+               "<file.skp, file.dl or directory>..."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << "Every SKP or serialized display list given, and every .skp "
+               "and .dl file in the directories given, is drawn once into an "
+               "offscreen surface of the given size. The "
+               "SkSL of the shaders compiled to draw them is written to the "
+               "output bundle, which will be overwritten if it exists already."
+            << std::endl;
+  std::cout << "The platform is recorded in the bundle and defaults to '"
+            << kDefaultPlatform << "'. The surface defaults to "
+            << kDefaultSurfaceSize << "x" << kDefaultSurfaceSize << "."
+            << std::endl;
+}
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+bool IsDisplayListFile(const std::string& file_name) {
+  return EndsWith(file_name, ".dl");
+}
+
+// Draws the frame in the mapping, which is a serialized display list if
+// |is_display_list| is set and an SKP otherwise.
+bool ReplayFrame(const fml::Mapping& mapping,
+                 bool is_display_list,
+                 SkSurface* surface,
+                 GrDirectContext* context) {
+  SkCanvas* canvas = surface->getCanvas();
+  if (is_display_list) {
+    sk_sp<DisplayList> display_list =
+        DeserializeDisplayList(mapping.GetMapping(), mapping.GetSize());
+    if (!display_list) {
+      return false;
+    }
+    canvas->clear(SK_ColorTRANSPARENT);
+    display_list->RenderTo(canvas);
+  } else {
+    sk_sp<SkPicture> picture =
+        SkPicture::MakeFromData(mapping.GetMapping(), mapping.GetSize());
+    if (!picture) {
+      return false;
+    }
+    canvas->clear(SK_ColorTRANSPARENT);
+    canvas->drawPicture(picture);
+  }
+  context->flushAndSubmit(/*syncCpu=*/true);
+  return true;
+}
+
+// Replays the frame at the path, or every .skp and .dl file in the directory
+// at the path. Returns the number of frames replayed, or -1 if the path could
+// not be read.
+int ReplayPath(const std::string& path,
+               SkSurface* surface,
+               GrDirectContext* context) {
+  fml::UniqueFD directory =
+      fml::OpenDirectory(path.c_str(), false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    auto mapping = fml::FileMapping::CreateReadOnly(path);
+    if (!mapping ||
+        !ReplayFrame(*mapping, IsDisplayListFile(path), surface, context)) {
+      std::cerr << "Could not replay '" << path << "'." << std::endl;
+      return -1;
+    }
+    return 1;
+  }
+
+  int replayed = 0;
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& dir,
+                                 const std::string& file_name) {
+    bool is_display_list = IsDisplayListFile(file_name);
+    if (!is_display_list && !EndsWith(file_name, ".skp")) {
+      return true;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(dir, file_name);
+    if (mapping && ReplayFrame(*mapping, is_display_list, surface, context)) {
+      replayed++;
+    } else {
+      std::cerr << "Skipping '" << file_name << "' in '" << path
+                << "', which is not a valid "
+                << (is_display_list ? "serialized DisplayList" : "SKP") << "."
+                << std::endl;
+    }
+    return true;
+  });
+  return replayed;
+}
+
+bool WriteBundle(const std::string& output_path, const std::string& bundle) {
+  std::string absolute_path = fml::paths::AbsolutePath(output_path);
+  std::string directory_path = fml::paths::GetDirectoryName(absolute_path);
+  std::string file_name = absolute_path.substr(directory_path.size() + 1);
+  fml::UniqueFD directory = fml::OpenDirectory(
+      directory_path.c_str(), false, fml::FilePermission::kReadWrite);
+  fml::DataMapping mapping(bundle);
+  return directory.is_valid() &&
+         fml::WriteAtomically(directory, file_name.c_str(), mapping);
+}
+
+int ShaderWarmUpMain(const fml::CommandLine& command_line) {
+  std::string output_path;
+  if (command_line.HasOption("help") ||
+      !command_line.GetOptionValue("output", &output_path) ||
+      command_line.positional_args().empty()) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+  std::string platform =
+      command_line.GetOptionValueWithDefault("platform", kDefaultPlatform);
+  int width = std::strtol(
+      command_line.GetOptionValueWithDefault("width", "").c_str(), nullptr, 10);
+  int height = std::strtol(
+      command_line.GetOptionValueWithDefault("height", "").c_str(), nullptr,
+      10);
+  if (width <= 0) {
+    width = kDefaultSurfaceSize;
+  }
+  if (height <= 0) {
+    height = kDefaultSurfaceSize;
+  }
+
+  // Skia hands the SkSL of every shader it compiles to the persistent cache,
+  // which writes it to a fresh directory on the worker thread.
+  fml::ScopedTemporaryDirectory cache_directory;
+  PersistentCache::SetCacheDirectoryPath(cache_directory.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+  PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
+  auto worker = std::make_unique<fml::Thread>("io.flutter.shader_warmup");
+  persistent_cache->AddWorkerTaskRunner(worker->GetTaskRunner());
+
+  // The engine's options for OpenGL affect the shaders that are generated.
+  // With SkSL caching enabled above, they also hand every compiled shader to
+  // the persistent cache.
+  GrContextOptions options =
+      MakeDefaultContextOptions(ContextType::kRender, GrBackendApi::kOpenGL);
+
+  const SkISize size = SkISize::Make(width, height);
+  testing::TestGLSurface gl_surface(size);
+  sk_sp<GrDirectContext> context = gl_surface.CreateGrContext(options);
+  if (!context) {
+    std::cerr << "Could not create the GL context." << std::endl;
+    return EXIT_FAILURE;
+  }
+  sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+      context.get(), SkBudgeted::kNo, SkImageInfo::MakeN32Premul(size));
+  if (!surface) {
+    std::cerr << "Could not create the offscreen surface." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int replayed = 0;
+  for (const auto& path : command_line.positional_args()) {
+    int result = ReplayPath(path, surface.get(), context.get());
+    if (result < 0) {
+      return EXIT_FAILURE;
+    }
+    replayed += result;
+  }
+
+  // Wait for the worker to write out the SkSLs of the last frames.
+  persistent_cache->RemoveWorkerTaskRunner(worker->GetTaskRunner());
+  worker.reset();
+
+  std::vector<PersistentCache::SkSLCache> sksls =
+      persistent_cache->LoadSkSLs();
+  if (!WriteBundle(output_path,
+                   PersistentCache::SerializeSkSLBundle(sksls, platform))) {
+    std::cerr << "Could not write '" << output_path << "'." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Wrote " << sksls.size() << " shaders from " << replayed
+            << " frames to '" << output_path << "'." << std::endl;
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char* argv[]) {
+  return flutter::ShaderWarmUpMain(fml::CommandLineFromArgcArgv(argc, argv));
+}